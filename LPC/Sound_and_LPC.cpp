@@ -37,14 +37,6 @@
 #define LPC_METHOD_BURG 3
 #define LPC_METHOD_MARPLE 4
 
-/* Markel&Gray, LP of S, page 219
-work[1..3*m+2]
-r = & work[1]; // r[1..m+1]
-a= & work[m+1+1]; // a[1..m+1]
-rc = & work[m+1+m+1+1]; // rc[1..m]
-for (i=1; i<= m+1+m+1+m;i++) work[i] = 0;
-*/
-
 #define LPC_METHOD_AUTO_WINDOW_CORRECTION 1
 
 static void LPC_Frame_and_Sound_filter (LPC_Frame me, Sound thee, int channel) {
@@ -72,160 +64,32 @@ void LPC_Frame_and_Sound_filterInverse (LPC_Frame me, Sound thee, int channel) {
 	}
 }
 
-static int Sound_into_LPC_Frame_auto (Sound me, LPC_Frame thee) {
-	long i = 1; // For error condition at end
-	long m = thy nCoefficients;
-
-	autoNUMvector<double> r (1, m + 1);
-	autoNUMvector<double> a (1, m + 1);
-	autoNUMvector<double> rc (1, m);
-
-	double  *x = my z[1];
-	for (i = 1; i <= m + 1; i++) {
-		for (long j = 1; j <= my nx - i + 1; j++) {
-			r[i] += x[j] * x[j + i - 1];
-		}
-	}
-	if (r[1] == 0) {
-		i = 1; /* ! */ goto end;
-	}
-	a[1] = 1; a[2] = rc[1] = - r[2] / r[1];
-	thy gain = r[1] + r[2] * rc[1];
-	for (i = 2; i <= m; i++) {
-		double s = 0;
-		for (long j = 1; j <= i; j++) {
-			s += r[i - j + 2] * a[j];
-		}
-		rc[i] = - s / thy gain;
-		for (long j = 2; j <= i / 2 + 1; j++) {
-			double at = a[j] + rc[i] * a[i - j + 2];
-			a[i - j + 2] += rc[i] * a[j];
-			a[j] = at;
-		}
-		a[i + 1] = rc[i]; thy gain += rc[i] * s;
-		if (thy gain <= 0) {
-			goto end;
-		}
-	}
-end:
-	i--;
-	for (long j = 1; j <= i; j++) {
-		thy a[j] = a[j + 1];
-	}
-	if (i == m) {
+/*
+	The kernels may deliver fewer coefficients than asked for; the frame then gets shortened.
+*/
+static int LPC_Frame_truncate (LPC_Frame me, int numberOfCoefficients) {
+	if (numberOfCoefficients == my nCoefficients) {
 		return 1;
 	}
-	thy nCoefficients = i;
-	for (long j = i + 1; j <= m; j++) {
-		thy a[j] = 0;
+	for (long j = numberOfCoefficients + 1; j <= my nCoefficients; j++) {
+		my a[j] = 0;
 	}
+	my nCoefficients = numberOfCoefficients;
 	return 0; // Melder_warning ("Less coefficienst than asked for.");
 }
 
-/* Markel&Gray, LP of S, page 221
-	work[1..m(m+1)/2+m+m+1+m+m+1]
-	b = & work[1]
-	grc = & work[m*(m+1)/2+1];
-	a = & work[m*(m+1)/2+m+1];
-	beta = & work [m+1)/2+m+m+1+1];
-	cc = & work[m+1)/2+m+m+1+m+1]
-	for (i=1; i<=m(m+1)/2+m+m+1+m+m+1;i++) work[i] = 0;
-*/
-static int Sound_into_LPC_Frame_covar (Sound me, LPC_Frame thee) {
-	long i = 1, n = my nx, m = thy nCoefficients;
-	double *x = my z[1];
-
-	autoNUMvector<double> b (1, m * (m + 1) / 2);
-	autoNUMvector<double> grc (1, m);
-	autoNUMvector<double> a (1, m + 1);
-	autoNUMvector<double> beta (1, m);
-	autoNUMvector<double> cc (1, m + 1);
-
-	thy gain = 0;
-	for (i = m + 1; i <= n; i++) {
-		thy gain += x[i] * x[i];
-		cc[1] += x[i] * x[i - 1];
-		cc[2] += x[i - 1] * x[i - 1];
-	}
-
-	if (thy gain == 0) {
-		i = 1; /* ! */ goto end;
-	}
-
-	b[1] = 1;
-	beta[1] = cc[2];
-	a[1] = 1;
-	a[2] = grc[1] = -cc[1] / cc[2];
-	thy gain += grc[1] * cc[1];
-
-	for (i = 2; i <= m; i++) { /*130*/
-		double s = 0; /* 20 */
-		for (long j = 1; j <= i; j++) {
-			cc[i - j + 2] = cc[i - j + 1] + x[m - i + 1] * x[m - i + j] - x[n - i + 1] * x[n - i + j];
-		}
-		cc[1] = 0;
-		for (long j = m + 1; j <= n; j++) {
-			cc[1] += x[j - i] * x[j]; /* 30 */
-		}
-		b[i * (i + 1) / 2] = 1;
-		for (long j = 1; j <= i - 1; j++) { /* 70 */
-			double gam = 0;
-			if (beta[j] < 0) {
-				goto end;
-			} else if (beta[j] == 0) {
-				continue;
-			}
-			for (long k = 1; k <= j; k++) {
-				gam += cc[k + 1] * b[j * (j - 1) / 2 + k]; /*50*/
-			}
-			gam /= beta[j];
-			for (long k = 1; k <= j; k++) {
-				b[i * (i - 1) / 2 + k] -= gam * b[j * (j - 1) / 2 + k]; /*60*/
-			}
-		}
-
-		beta[i] = 0;
-		for (long j = 1; j <= i; j++) {
-			beta[i] += cc[j + 1] * b[i * (i - 1) / 2 + j]; /*80*/
-		}
-		if (beta[i] <= 0) {
-			goto end;
-		}
-
-		for (long j = 1; j <= i; j++) {
-			s += cc[j] * a[j]; /*100*/
-		}
-		grc[i] = -s / beta[i];
-
-		for (long j = 2; j <= i; j++) {
-			a[j] += grc[i] * b[i * (i - 1) / 2 + j - 1]; /*110*/
-		}
-		a[i + 1] = grc[i];
-		s = grc[i] * grc[i] * beta[i];
-		thy gain -= s;
-		if (thy gain <= 0) {
-			goto end;
-		}
-	}
-end:
-	i--;
-
-	for (long j = 1; j <= i; j++) {
-		thy a[j] = a[j + 1];
-	}
-	if (i == m) {
-		return 1;
-	}
+static int Sound_into_LPC_Frame_auto (Sound me, LPC_Frame thee, NUMlpc_Workspace workspace) {
+	int numberOfCoefficients = NUMlpc_autocorrelation (workspace, & my z[1][1], my nx, & thy a[1], thy nCoefficients, & thy gain);
+	return LPC_Frame_truncate (thee, numberOfCoefficients);
+}
 
-	thy nCoefficients = i;
-	for (long j = i + 1; j <= m; j++) {
-		thy a[j] = 0;
-	}
-	return 0; // Melder_warning ("Less coefficienst than asked for.");
+static int Sound_into_LPC_Frame_covar (Sound me, LPC_Frame thee, NUMlpc_Workspace workspace) {
+	int numberOfCoefficients = NUMlpc_covariance (workspace, & my z[1][1], my nx, & thy a[1], thy nCoefficients, & thy gain);
+	return LPC_Frame_truncate (thee, numberOfCoefficients);
 }
 
-static int Sound_into_LPC_Frame_burg (Sound me, LPC_Frame thee) {
-	int status = NUMburg (my z[1], my nx, thy a, thy nCoefficients, &thy gain);
+static int Sound_into_LPC_Frame_burg (Sound me, LPC_Frame thee, NUMlpc_Workspace workspace) {
+	int status = NUMlpc_burg (workspace, & my z[1][1], my nx, & thy a[1], thy nCoefficients, &thy gain);
 	thy gain *= my nx;
 	for (long i = 1; i <= thy nCoefficients; i++) {
 		thy a[i] = -thy a[i];
@@ -387,6 +251,8 @@ static LPC _Sound_to_LPC (Sound me, int predictionOrder, double analysisWidth, d
 	autoSound sframe = Sound_createSimple (1, windowDuration, samplingFrequency);
 	autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
 	autoLPC thee = LPC_create (my xmin, my xmax, nFrames, dt, t1, predictionOrder, my dx);
+	autoNUMlpc_Workspace workspace;
+	NUMlpc_Workspace_init (& workspace, sframe -> nx, predictionOrder);
 
 	autoMelderProgress progress (U"LPC analysis");
 
@@ -402,15 +268,15 @@ static LPC _Sound_to_LPC (Sound me, int predictionOrder, double analysisWidth, d
 		Vector_subtractMean (sframe.peek());
 		Sounds_multiply (sframe.peek(), window.peek());
 		if (method == LPC_METHOD_AUTO) {
-			if (! Sound_into_LPC_Frame_auto (sframe.peek(), lpcframe)) {
+			if (! Sound_into_LPC_Frame_auto (sframe.peek(), lpcframe, & workspace)) {
 				frameErrorCount++;
 			}
 		} else if (method == LPC_METHOD_COVAR) {
-			if (! Sound_into_LPC_Frame_covar (sframe.peek(), lpcframe)) {
+			if (! Sound_into_LPC_Frame_covar (sframe.peek(), lpcframe, & workspace)) {
 				frameErrorCount++;
 			}
 		} else if (method == LPC_METHOD_BURG) {
-			if (! Sound_into_LPC_Frame_burg (sframe.peek(), lpcframe)) {
+			if (! Sound_into_LPC_Frame_burg (sframe.peek(), lpcframe, & workspace)) {
 				frameErrorCount++;
 			}
 		} else if (method == LPC_METHOD_MARPLE) {
@@ -34,6 +34,7 @@
 #include "SVD.h"
 #include "Vector.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 struct huber_struct {
 	Sound e;
@@ -172,11 +173,70 @@ void LPC_Frames_and_Sound_huber (LPC_Frame me, Sound thee, LPC_Frame him, struct
 }
 
 
+Thing_define (LPC_and_Sound_into_LPC_robust_Args, Thing) { public:
+	LPC lpc, lpcRobust;
+	Sound sound, window;
+	double windowDuration;
+	/*
+	 * The scratch space and the counts of one thread.
+	 */
+	struct huber_struct huber;
+	autoSound sframe;
+	long iter, frameErrorCount;
+
+	void v_destroy ()
+		override { huber_struct_destroy (& huber); structThing :: v_destroy (); }
+};
+
+Thing_implement (LPC_and_Sound_into_LPC_robust_Args, Thing, 0);
+
+static LPC_and_Sound_into_LPC_robust_Args LPC_and_Sound_into_LPC_robust_Args_create (LPC lpc, LPC lpcRobust,
+	Sound sound, Sound window, double windowDuration, double k, int itermax, double tol, double tol_svd, double location, int wantlocation)
+{
+	autoLPC_and_Sound_into_LPC_robust_Args me = Thing_new (LPC_and_Sound_into_LPC_robust_Args);
+	my lpc = lpc;
+	my lpcRobust = lpcRobust;
+	my sound = sound;
+	my window = window;
+	my windowDuration = windowDuration;
+	double samplingFrequency = 1.0 / sound -> dx;
+	my sframe.reset (Sound_createSimple (1, windowDuration, samplingFrequency));
+	huber_struct_init (& my huber, windowDuration, lpc -> maxnCoefficients, samplingFrequency, location, wantlocation);
+	my huber.k = k;
+	my huber.tol = tol;
+	my huber.tol_svd = tol_svd;
+	my huber.itermax = itermax;
+	return me.transfer();
+}
+
+static void LPC_and_Sound_into_LPC_robust (LPC_and_Sound_into_LPC_robust_Args me, long firstFrame, long lastFrame) {
+	for (long i = firstFrame; i <= lastFrame; i++) {
+		LPC_Frame lpc = (LPC_Frame) & my lpc -> d_frames[i];
+		LPC_Frame lpcto = (LPC_Frame) & my lpcRobust -> d_frames[i];
+		double t = Sampled_indexToX (my lpc, i);
+
+		Sound_into_Sound (my sound, my sframe.peek(), t - my windowDuration / 2);
+		Vector_subtractMean (my sframe.peek());
+		Sounds_multiply (my sframe.peek(), my window);
+
+		try {
+			LPC_Frames_and_Sound_huber (lpc, my sframe.peek(), lpcto, & my huber);
+		} catch (MelderError) {
+			my frameErrorCount++;
+		}
+
+		my iter += my huber.iter;
+	}
+}
+
+static void LPC_and_Sound_into_LPC_robust_progress (LPC_and_Sound_into_LPC_robust_Args me, double fraction) {
+	Melder_progress (fraction, U"LPC analysis of ", my lpc -> nx, U" frames.");
+}
+
 LPC LPC_and_Sound_to_LPC_robust (LPC thee, Sound me, double analysisWidth, double preEmphasisFrequency, double k,
 	int itermax, double tol, int wantlocation) {
-	struct huber_struct struct_huber = { 0 };
 	try {
-		double t1, samplingFrequency = 1.0 / my dx, tol_svd = 0.000001;
+		double t1, tol_svd = 0.000001;
 		double location = 0, windowDuration = 2 * analysisWidth; /* Gaussian window */
 		long nFrames, frameErrorCount = 0, iter = 0;
 		long p = thy maxnCoefficients;
@@ -196,51 +256,34 @@ LPC LPC_and_Sound_to_LPC_robust (LPC thee, Sound me, double analysisWidth, doubl
 		}
 
 		autoSound sound = Data_copy (me);
-		autoSound sframe = Sound_createSimple (1, windowDuration, samplingFrequency);
-		autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
+		autoSound window = Sound_createGaussian (windowDuration, 1.0 / my dx);
 		autoLPC him = Data_copy (thee);
-		huber_struct_init (&struct_huber, windowDuration, p, samplingFrequency, location, wantlocation);
-
-		struct_huber.k = k;
-		struct_huber.tol = tol;
-		struct_huber.tol_svd = tol_svd;
-		struct_huber.itermax = itermax;
 
 		autoMelderProgress progess (U"LPC analysis");
 
 		Sound_preEmphasis (sound.peek(), preEmphasisFrequency);
 
-		for (long i = 1; i <= nFrames; i++) {
-			LPC_Frame lpc = (LPC_Frame) & thy d_frames[i];
-			LPC_Frame lpcto = (LPC_Frame) & his d_frames[i];
-			double t = Sampled_indexToX (thee, i);
-
-			Sound_into_Sound (sound.peek(), sframe.peek(), t - windowDuration / 2);
-			Vector_subtractMean (sframe.peek());
-			Sounds_multiply (sframe.peek(), window.peek());
-
-			try {
-				LPC_Frames_and_Sound_huber (lpc, sframe.peek(), lpcto, & struct_huber);
-			} catch (MelderError) {
-				frameErrorCount++;
-			}
-
-			iter += struct_huber.iter;
-
-			if ( (i % 10) == 1) {
-				Melder_progress ( (double) i / nFrames, U"LPC analysis of frame ",
-				                   i, U" out of ", nFrames, U".");
-			}
+		/*
+		 * The frames are independent, so they can be analysed in parallel;
+		 * every thread has its own frame, Huber workspace and SVD.
+		 */
+		const int numberOfThreads = MelderThread_computeNumberOfThreads (nFrames, 10);
+		autoLPC_and_Sound_into_LPC_robust_Args args [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+		for (int ithread = 0; ithread < numberOfThreads; ithread ++)
+			args [ithread].reset (LPC_and_Sound_into_LPC_robust_Args_create (thee, him.peek(), sound.peek(), window.peek(),
+				windowDuration, k, itermax, tol, tol_svd, location, wantlocation));
+		MelderThread_run (LPC_and_Sound_into_LPC_robust, args, numberOfThreads, 1, nFrames, 4, LPC_and_Sound_into_LPC_robust_progress);
+		for (int ithread = 0; ithread < numberOfThreads; ithread ++) {
+			iter += args [ithread] -> iter;
+			frameErrorCount += args [ithread] -> frameErrorCount;
 		}
 
 		if (frameErrorCount) Melder_warning (U"Results of ", frameErrorCount,
 			U" frame(s) out of ", nFrames, U" could not be optimised.");
 		MelderInfo_writeLine (U"Number of iterations: ", iter,
 			U"\n   Average per frame: ", ((double) iter) / nFrames);
-		huber_struct_destroy (&struct_huber);
 		return him.transfer();
 	} catch (MelderError) {
-		huber_struct_destroy (&struct_huber);
 		Melder_throw (me, U": no robust LPC created.");
 	}
 }
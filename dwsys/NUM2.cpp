@@ -2066,27 +2066,30 @@ double NUMformantfilter_amplitude (double fc, double bw, double f) {
 	return 1.0 / (dq * dq + 1.0);
 }
 
+void NUMlpc_Workspace_init (NUMlpc_Workspace me, long maximumNumberOfSamples, int maximumOrder) {
+	/*
+		Burg needs 2 * n + m, the covariance method m * (m + 1) / 2 + 4 * m + 2, the autocorrelation method less.
+	*/
+	long size = 2 * maximumNumberOfSamples + maximumOrder + maximumOrder * (maximumOrder + 1) / 2 + 4 * maximumOrder + 2;
+	NUMvector_free (my work, 0);
+	my work = NUMvector <double> (0, size - 1);
+	my maximumNumberOfSamples = maximumNumberOfSamples;
+	my maximumOrder = maximumOrder;
+}
+
 /* Childers (1978), Modern Spectrum analysis, IEEE Press, 252-255) */
-/* work[1..n+n+n];
-b1 = & work[1];
-b2 = & work[n+1];
-aa = & work[n+n+1];
-for (i=1; i<=n+n+n; i++) work[i]=0;
-*/
-int NUMburg (double x[], long n, double a[], int m, double *xms) {
-	for (long j = 1; j <= m; j++) {
-		a[j] = 0;
+int NUMlpc_burg (NUMlpc_Workspace workspace, const double x [], long n, double a [], int m, double *xms) {
+	Melder_assert (n <= workspace -> maximumNumberOfSamples && m <= workspace -> maximumOrder);
+	double *b1 = workspace -> work, *b2 = b1 + n, *aa = b2 + n;
+	for (int j = 0; j < m; j ++) {
+		a [j] = 0.0;
 	}
 
-	autoNUMvector<double> b1 (1, n);
-	autoNUMvector<double> b2 (1, n);
-	autoNUMvector<double> aa (1, m);
-
 	// (3)
 
 	double p = 0.0;
-	for (long j = 1; j <= n; j++) {
-		p += x[j] * x[j];
+	for (long j = 0; j < n; j ++) {
+		p += x [j] * x [j];
 	}
 
 	*xms = p / n;
@@ -2096,53 +2099,187 @@ int NUMburg (double x[], long n, double a[], int m, double *xms) {
 
 	// (9)
 
-	b1[1] = x[1];
-	b2[n - 1] = x[n];
-	for (long j = 2; j <= n - 1; j++) {
-		b1[j] = b2[j - 1] = x[j];
+	for (long j = 0; j < n - 1; j ++) {
+		b1 [j] = x [j];
+		b2 [j] = x [j + 1];
 	}
 
-	for (long i = 1; i <= m; i++) {
+	for (int i = 1; i <= m; i ++) {
 		// (7)
 
 		double num = 0.0, denum = 0.0;
-		for (long j = 1; j <= n - i; j++) {
-			num += b1[j] * b2[j];
-			denum += b1[j] * b1[j] + b2[j] * b2[j];
+		for (long j = 0; j < n - i; j ++) {
+			num += b1 [j] * b2 [j];
+			denum += b1 [j] * b1 [j] + b2 [j] * b2 [j];
 		}
 
 		if (denum <= 0) {
 			return 0;    // warning ill-conditioned
 		}
 
-		a[i] = 2.0 * num / denum;
+		double ai = a [i - 1] = 2.0 * num / denum;
 
 		// (10)
 
-		*xms *= 1.0 - a[i] * a[i];
+		*xms *= 1.0 - ai * ai;
 
 		// (5)
 
-		for (long j = 1; j <= i - 1; j++) {
-			a[j] = aa[j] - a[i] * aa[i - j];
+		for (int j = 0; j < i - 1; j ++) {
+			a [j] = aa [j] - ai * aa [i - 2 - j];
 		}
 
 		if (i < m) {
 
 			// (8)  Watch out: i -> i+1
 
-			for (long j = 1; j <= i; j++) {
-				aa[j] = a[j];
+			for (int j = 0; j < i; j ++) {
+				aa [j] = a [j];
 			}
-			for (long j = 1; j <= n - i - 1; j++) {
-				b1[j] -= aa[i] * b2[j];
-				b2[j] = b2[j + 1] - aa[i] * b1[j + 1];
+			for (long j = 0; j < n - i - 1; j ++) {
+				b1 [j] -= ai * b2 [j];
+				b2 [j] = b2 [j + 1] - ai * b1 [j + 1];
 			}
 		}
 	}
 	return 1;
 }
 
+int NUMburg (double x[], long n, double a[], int m, double *xms) {
+	autoNUMlpc_Workspace workspace;
+	NUMlpc_Workspace_init (& workspace, n, m);
+	return NUMlpc_burg (& workspace, x + 1, n, a + 1, m, xms);
+}
+
+/* Markel & Gray, Linear Prediction of Speech, page 219 */
+int NUMlpc_autocorrelation (NUMlpc_Workspace workspace, const double x [], long n, double a [], int m, double *gain) {
+	Melder_assert (n <= workspace -> maximumNumberOfSamples && m <= workspace -> maximumOrder);
+	double *r = workspace -> work, *aw = r + m + 1, *rc = aw + m + 1;   // r [0..m], aw [0..m], rc [0..m-1]
+	int i;
+	for (i = 0; i <= m; i ++) {
+		r [i] = 0.0;
+		for (long j = 0; j < n - i; j ++) {
+			r [i] += x [j] * x [j + i];
+		}
+	}
+	if (r [0] == 0.0) {
+		return 0;
+	}
+	aw [0] = 1.0;
+	aw [1] = rc [0] = - r [1] / r [0];
+	*gain = r [0] + r [1] * rc [0];
+	for (i = 2; i <= m; i ++) {
+		double s = 0.0;
+		for (int j = 0; j < i; j ++) {
+			s += r [i - j] * aw [j];
+		}
+		double rci = rc [i - 1] = - s / *gain;
+		for (int j = 1; j <= i / 2; j ++) {
+			double at = aw [j] + rci * aw [i - j];
+			aw [i - j] += rci * aw [j];
+			aw [j] = at;
+		}
+		aw [i] = rci;
+		*gain += rci * s;
+		if (*gain <= 0.0) {
+			break;
+		}
+	}
+	int numberOfCoefficients = i - 1;
+	for (int j = 0; j < numberOfCoefficients; j ++) {
+		a [j] = aw [j + 1];
+	}
+	return numberOfCoefficients;
+}
+
+/* Markel & Gray, Linear Prediction of Speech, page 221 */
+int NUMlpc_covariance (NUMlpc_Workspace workspace, const double x [], long n, double a [], int m, double *gain) {
+	Melder_assert (n <= workspace -> maximumNumberOfSamples && m <= workspace -> maximumOrder);
+	/*
+		b [0..m(m+1)/2-1] holds the lower-triangular matrix row by row: row i (1..m) starts at i(i-1)/2.
+	*/
+	double *b = workspace -> work, *grc = b + m * (m + 1) / 2, *aw = grc + m, *beta = aw + m + 1, *cc = beta + m;
+	for (long j = 0; j < m * (m + 1) / 2 + 4 * m + 2; j ++) {
+		b [j] = 0.0;
+	}
+	int i = 1;
+
+	*gain = 0.0;
+	for (long k = m; k < n; k ++) {
+		*gain += x [k] * x [k];
+		cc [0] += x [k] * x [k - 1];
+		cc [1] += x [k - 1] * x [k - 1];
+	}
+
+	if (*gain == 0.0) {
+		return 0;
+	}
+
+	b [0] = 1.0;
+	beta [0] = cc [1];
+	aw [0] = 1.0;
+	aw [1] = grc [0] = - cc [0] / cc [1];
+	*gain += grc [0] * cc [0];
+
+	for (i = 2; i <= m; i ++) {
+		double s = 0.0;
+		double *bi = & b [i * (i - 1) / 2];
+		for (int j = 1; j <= i; j ++) {
+			cc [i - j + 1] = cc [i - j] + x [m - i] * x [m - i + j - 1] - x [n - i] * x [n - i + j - 1];
+		}
+		cc [0] = 0.0;
+		for (long k = m; k < n; k ++) {
+			cc [0] += x [k - i] * x [k];
+		}
+		bi [i - 1] = 1.0;
+		for (int j = 1; j <= i - 1; j ++) {
+			double *bj = & b [j * (j - 1) / 2];
+			double gam = 0.0;
+			if (beta [j - 1] < 0.0) {
+				goto end;
+			} else if (beta [j - 1] == 0.0) {
+				continue;
+			}
+			for (int k = 0; k < j; k ++) {
+				gam += cc [k + 1] * bj [k];
+			}
+			gam /= beta [j - 1];
+			for (int k = 0; k < j; k ++) {
+				bi [k] -= gam * bj [k];
+			}
+		}
+
+		beta [i - 1] = 0.0;
+		for (int j = 0; j < i; j ++) {
+			beta [i - 1] += cc [j + 1] * bi [j];
+		}
+		if (beta [i - 1] <= 0.0) {
+			goto end;
+		}
+
+		for (int j = 0; j < i; j ++) {
+			s += cc [j] * aw [j];
+		}
+		double grci = grc [i - 1] = - s / beta [i - 1];
+
+		for (int j = 1; j < i; j ++) {
+			aw [j] += grci * bi [j - 1];
+		}
+		aw [i] = grci;
+		s = grci * grci * beta [i - 1];
+		*gain -= s;
+		if (*gain <= 0.0) {
+			goto end;
+		}
+	}
+end:
+	int numberOfCoefficients = i - 1;
+	for (int j = 0; j < numberOfCoefficients; j ++) {
+		a [j] = aw [j + 1];
+	}
+	return numberOfCoefficients;
+}
+
 void NUMdmatrix_to_dBs (double **m, long rb, long re, long cb, long ce, double ref, double factor, double floor) {
 	double ref_db, factor10 = factor * 10;
 	double max = m[rb][cb], min = max;
@@ -953,6 +953,63 @@ int NUMburg (double x[], long n, double a[], int m, double *xms);
 	Calculates linear prediction coefficients according to the algorithm
 	from J.P. Burg as described by N.Anderson in Childers, D. (ed), Modern
 	Spectrum Analysis, IEEE Press, 1978, 252-255.
+	Allocates its own workspace; for frame-by-frame analyses use NUMlpc_burg instead.
+*/
+
+/********************** linear prediction kernels ********************/
+
+struct structNUMlpc_Workspace
+{
+	long maximumNumberOfSamples;
+	int maximumOrder;
+	double *work;   // one contiguous block, 0-based
+};
+
+typedef struct structNUMlpc_Workspace *NUMlpc_Workspace;
+
+void NUMlpc_Workspace_init (NUMlpc_Workspace me, long maximumNumberOfSamples, int maximumOrder);
+/*
+	Reserves enough space for any of the kernels below
+	with n <= maximumNumberOfSamples and m <= maximumOrder.
+*/
+
+struct autoNUMlpc_Workspace : public structNUMlpc_Workspace {
+	autoNUMlpc_Workspace () throw () {
+		maximumNumberOfSamples = 0;
+		maximumOrder = 0;
+		work = 0;
+	}
+	~autoNUMlpc_Workspace () {
+		NUMvector_free (work, 0);
+	}
+};
+
+/*
+	The kernels below work on 0-based arrays: the signal x [0..n-1] and the
+	prediction coefficients a [0..m-1]. They do not allocate, so that they can be
+	called for every frame of an analysis with a workspace owned by the caller
+	(one workspace per thread). The sums are accumulated in the same order as in
+	the 1-based versions, so that the results do not change.
+*/
+
+int NUMlpc_burg (NUMlpc_Workspace workspace, const double x [], long n, double a [], int m, double *xms);
+/*
+	Burg's method, as NUMburg: x [n] = sum (i=0..m-1, a [i] * x [n-1-i]) + e [n].
+	Returns 0 if the signal is empty or the recursion is ill-conditioned.
+*/
+
+int NUMlpc_autocorrelation (NUMlpc_Workspace workspace, const double x [], long n, double a [], int m, double *gain);
+/*
+	Autocorrelation method (Markel & Gray 1976: 219), with the inverse-filter sign convention:
+	e [n] = x [n] + sum (i=0..m-1, a [i] * x [n-1-i]).
+	Returns the number of coefficients that could be computed (m if all went well);
+	the remaining coefficients are unspecified.
+	*gain is left unchanged if the signal consists of zeroes only.
+*/
+
+int NUMlpc_covariance (NUMlpc_Workspace workspace, const double x [], long n, double a [], int m, double *gain);
+/*
+	Covariance method (Markel & Gray 1976: 221), with the same conventions as NUMlpc_autocorrelation.
 */
 
 void NUMdmatrix_to_dBs (double **m, long rb, long re, long cb, long ce,
@@ -1106,6 +1163,10 @@ struct structNUMfft_Table
   long n;
   double *trigcache;
   long *splitcache;
+  long chirpSize; /* Length of the convolution that replaces a transform with large prime factors, or 0 */
+  double *chirp;
+  double *chirpTrigcache;
+  long *chirpSplitcache;
 };
 
 typedef struct structNUMfft_Table_f *NUMfft_Table_f;
@@ -1115,6 +1176,9 @@ void NUMfft_Table_init_f (NUMfft_Table_f table, long n);
 void NUMfft_Table_init (NUMfft_Table table, long n);
 /*
 	n : data size
+	Sizes whose prime factors are small are transformed directly, with mixed radices.
+	Sizes with a large prime factor, for which the direct transform takes time proportional to n times that factor,
+	are computed as a convolution with a chirp (Bluestein's algorithm), which takes time proportional to n log n.
 */
 
 struct autoNUMfft_Table : public structNUMfft_Table {
@@ -1122,10 +1186,17 @@ struct autoNUMfft_Table : public structNUMfft_Table {
                 n = 0;
                 trigcache = 0;
                 splitcache = 0;
+                chirpSize = 0;
+                chirp = 0;
+                chirpTrigcache = 0;
+                chirpSplitcache = 0;
         }
         ~autoNUMfft_Table () {
                 NUMvector_free (trigcache, 0);
                 NUMvector_free (splitcache, 0);
+                NUMvector_free (chirp, 0);
+                NUMvector_free (chirpTrigcache, 0);
+                NUMvector_free (chirpSplitcache, 0);
         }
 };
 
@@ -1217,6 +1288,17 @@ void NUMfft_backward (NUMfft_Table table, double *data);
              sequence by n.
 */
 
+void NUMfft_forward_batch (NUMfft_Table table, long numberOfTransforms, double *data [], double *workspace);
+void NUMfft_backward_batch (NUMfft_Table table, long numberOfTransforms, double *data [], double *workspace);
+/*
+	Same as NUMfft_forward (table, data [i]) or NUMfft_backward (table, data [i])
+	for i = 0 .. numberOfTransforms - 1, with identical results,
+	but two transforms at a time on the vector unit of the processor (if the compiler supports vector types;
+	tables that use a chirp transform one signal at a time).
+	Every data [i] is an array [1..n]. The workspace is an array [0..4n-1] that belongs to the caller,
+	so that a loop over many batches does not have to allocate anything.
+*/
+
 /**** Compatibility with NR fft's */
 
 void NUMforwardRealFastFourierTransform_f (float  *data, long n);
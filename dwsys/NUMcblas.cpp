@@ -12,6 +12,9 @@
  djmw 20020813 GPL header
  djmw 20071201 Latest modification
  pb 20100120 dlamc3_: declare volatile double ret_val to prevent optimization!
+
+ The local variables, which f2c had made static, are automatic,
+ so that the routines can be called from several threads at the same time.
 */
 
 
@@ -36,7 +39,7 @@ int NUMblas_daxpy (long *n, double *da, double *dx, long *incx, double *dy, long
 	long i__1;
 
 	/* Local variables */
-	static long i__, m, ix, iy, mp1;
+	long i__, m, ix, iy, mp1;
 
 	--dy;
 	--dx;
@@ -99,7 +102,7 @@ int NUMblas_dcopy (long *n, double *dx, long *incx, double *dy, long *incy) {
 	long i__1;
 
 	/* Local variables */
-	static long i__, m, ix, iy, mp1;
+	long i__, m, ix, iy, mp1;
 
 	--dy;
 	--dx;
@@ -163,9 +166,9 @@ double NUMblas_ddot (long *n, double *dx, long *incx, double *dy, long *incy) {
 	double ret_val;
 
 	/* Local variables */
-	static long i__, m;
-	static double dtemp;
-	static long ix, iy, mp1;
+	long i__, m;
+	double dtemp;
+	long ix, iy, mp1;
 
 	/* Parameter adjustments */
 	--dy;
@@ -231,11 +234,11 @@ int NUMblas_dgemm (const char *transa, const char *transb, long *m, long *n, lon
 	long a_dim1, a_offset, b_dim1, b_offset, c_dim1, c_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long info;
-	static long nota, notb;
-	static double temp;
-	static long i__, j, l, ncola;
-	static long nrowa, nrowb;
+	long info;
+	long nota, notb;
+	double temp;
+	long i__, j, l, ncola;
+	long nrowa, nrowb;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 #define b_ref(a_1,a_2) b[(a_2)*b_dim1 + a_1]
@@ -444,9 +447,9 @@ int NUMblas_dger (long *m, long *n, double *alpha, double *x, long *incx, double
 	long a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static long info;
-	static double temp;
-	static long i__, j, ix, jy, kx;
+	long info;
+	double temp;
+	long i__, j, ix, jy, kx;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 	/* Test the input parameters. Parameter adjustments */
@@ -530,10 +533,10 @@ int NUMblas_dgemv (const char *trans, long *m, long *n, double *alpha, double *a
 	long a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static long info;
-	static double temp;
-	static long lenx, leny, i__, j;
-	static long ix, iy, jx, jy, kx, ky;
+	long info;
+	double temp;
+	long lenx, leny, i__, j;
+	long ix, iy, jx, jy, kx, ky;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 
@@ -696,7 +699,7 @@ int NUMblas_dgemv (const char *trans, long *m, long *n, double *alpha, double *a
 
 #undef a_ref
 
-double NUMblas_dlamch (const char *cmach) {
+static double dlamch_ (const char *cmach) {
 	/* Initialized data */
 	static long first = TRUE;
 
@@ -711,7 +714,8 @@ double NUMblas_dlamch (const char *cmach) {
 	static double emin, prec, emax;
 	static long imin, imax;
 	static long lrnd;
-	static double rmin, rmax, t, rmach;
+	static double rmin, rmax, t;
+	double rmach = 0.0;
 	static double smal, sfmin;
 	static long it;
 	static double rnd, eps;
@@ -768,6 +772,16 @@ double NUMblas_dlamch (const char *cmach) {
 
 	ret_val = rmach;
 	return ret_val;
+}								/* dlamch_ */
+
+double NUMblas_dlamch (const char *cmach) {
+	/*
+		The first call computes and caches the machine parameters.
+		A function-local static is initialized exactly once, even if several threads arrive here at the same time.
+	*/
+	static const double eps = dlamch_ ("E");
+	(void) eps;
+	return dlamch_ (cmach);
 }								/* NUMblas_dlamch */
 
 static int dlamc1_ (long *beta, long *t, long *rnd, long *ieee1) {
@@ -1396,9 +1410,9 @@ double NUMblas_dnrm2 (long *n, double *x, long *incx) {
 	double ret_val, d__1;
 
 	/* Local variables */
-	static double norm, scale, absxi;
-	static long ix;
-	static double ssq;
+	double norm, scale, absxi;
+	long ix;
+	double ssq;
 
 	--x;
 	/* Function Body */
@@ -1440,9 +1454,9 @@ int NUMblas_drot (long *n, double *dx, long *incx, double *dy, long *incy, doubl
 	long i__1;
 
 	/* Local variables */
-	static long i__;
-	static double dtemp;
-	static long ix, iy;
+	long i__;
+	double dtemp;
+	long ix, iy;
 
 	/* applies a plane rotation. jack dongarra, linpack, 3/11/78. modified
 	   12/3/93, array(1) declarations changed to array(*) Parameter
@@ -1493,7 +1507,7 @@ int NUMblas_dscal (long *n, double *da, double *dx, long *incx) {
 	long i__1, i__2;
 
 	/* Local variables */
-	static long i__, m, nincx, mp1;
+	long i__, m, nincx, mp1;
 
 	/* Parameter adjustments */
 	--dx;
@@ -1546,9 +1560,9 @@ int NUMblas_dswap (long *n, double *dx, long *incx, double *dy, long *incy) {
 	long i__1;
 
 	/* Local variables */
-	static long i__, m;
-	static double dtemp;
-	static long ix, iy, mp1;
+	long i__, m;
+	double dtemp;
+	long ix, iy, mp1;
 
 	/* interchanges two vectors. uses unrolled loops for increments equal
 	   one. jack dongarra, linpack, 3/11/78. modified 12/3/93, array(1)
@@ -1621,10 +1635,10 @@ int NUMblas_dsymv (const char *uplo, long *n, double *alpha, double *a, long *ld
 	long a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static long info;
-	static double temp1, temp2;
-	static long i__, j;
-	static long ix, iy, jx, jy, kx, ky;
+	long info;
+	double temp1, temp2;
+	long i__, j;
+	long ix, iy, jx, jy, kx, ky;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 
@@ -1797,10 +1811,10 @@ int NUMblas_dsyr2 (const char *uplo, long *n, double *alpha, double *x, long *in
 	long a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static long info;
-	static double temp1, temp2;
-	static long i__, j;
-	static long ix, iy, jx, jy, kx, ky;
+	long info;
+	double temp1, temp2;
+	long i__, j;
+	long ix, iy, jx = 0, jy = 0, kx = 0, ky = 0;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 
@@ -1934,11 +1948,11 @@ int NUMblas_dsyr2k (const char *uplo, const char *trans, long *n, long *k, doubl
 	long a_dim1, a_offset, b_dim1, b_offset, c_dim1, c_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long info;
-	static double temp1, temp2;
-	static long i__, j, l;
-	static long nrowa;
-	static long upper;
+	long info;
+	double temp1, temp2;
+	long i__, j, l;
+	long nrowa;
+	long upper;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 #define b_ref(a_1,a_2) b[(a_2)*b_dim1 + a_1]
@@ -2162,13 +2176,13 @@ int NUMblas_dtrmm (const char *side, const char *uplo, const char *transa, const
 	long a_dim1, a_offset, b_dim1, b_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long info;
-	static double temp;
-	static long i__, j, k;
-	static long lside;
-	static long nrowa;
-	static long upper;
-	static long nounit;
+	long info;
+	double temp;
+	long i__, j, k;
+	long lside;
+	long nrowa;
+	long upper;
+	long nounit;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 #define b_ref(a_1,a_2) b[(a_2)*b_dim1 + a_1]
@@ -2443,11 +2457,11 @@ int NUMblas_dtrmv (const char *uplo, const char *trans, const char *diag, long *
 	long a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static long info;
-	static double temp;
-	static long i__, j;
-	static long ix, jx, kx;
-	static long nounit;
+	long info;
+	double temp;
+	long i__, j;
+	long ix, jx, kx = 0;
+	long nounit;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 	/* -- Written on 22-October-1986. Jack Dongarra, Argonne National Lab.
@@ -2652,13 +2666,13 @@ int NUMblas_dtrsm (const char *side, const char *uplo, const char *transa, const
 	long a_dim1, a_offset, b_dim1, b_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long info;
-	static double temp;
-	static long i__, j, k;
-	static long lside;
-	static long nrowa;
-	static long upper;
-	static long nounit;
+	long info;
+	double temp;
+	long i__, j, k;
+	long lside;
+	long nrowa;
+	long upper;
+	long nounit;
 
 #define a_ref(a_1,a_2) a[(a_2)*a_dim1 + a_1]
 #define b_ref(a_1,a_2) b[(a_2)*b_dim1 + a_1]
@@ -2959,8 +2973,8 @@ long NUMblas_idamax (long *n, double *dx, long *incx) {
 	double d__1;
 
 	/* Local variables */
-	static double dmax__;
-	static long i__, ix;
+	double dmax__;
+	long i__, ix;
 
 	/* finds the index of element having max. absolute value. jack
 	   dongarra, linpack, 3/11/78. modified 3/93 to return if incx .le. 0.
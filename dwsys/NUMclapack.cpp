@@ -8,6 +8,9 @@
 	Adapted by David Weenink 20021201
 
  djmw 20030205 Latest modification
+
+ The local variables, which f2c had made static, are automatic,
+ so that the routines can be called from several threads at the same time.
 */
 /* #include "blaswrap.h" */
 #include "NUMf2c.h"
@@ -53,32 +56,32 @@ int NUMlapack_dbdsqr (const char *uplo, long *n, long *ncvt, long *nru, long *nc
 	double d__1, d__2, d__3, d__4;
 
 	/* Local variables */
-	static double abse;
-	static long idir;
-	static double abss;
-	static long oldm;
-	static double cosl;
-	static long isub, iter;
-	static double unfl, sinl, cosr, smin, smax, sinr;
-	static double f, g, h__;
-	static long i__, j, m;
-	static double r__;
-	static double oldcs;
-	static long oldll;
-	static double shift, sigmn, oldsn;
-	static long maxit;
-	static double sminl, sigmx;
-	static long lower;
-	static double cs;
-	static long ll;
-	static double sn, mu;
-	static double sminoa, thresh;
-	static long rotate;
-	static double sminlo;
-	static long nm1;
-	static double tolmul;
-	static long nm12, nm13, lll;
-	static double eps, sll, tol;
+	double abse;
+	long idir;
+	double abss;
+	long oldm;
+	double cosl;
+	long isub, iter;
+	double unfl, sinl, cosr, smin, smax, sinr;
+	double f, g, h__;
+	long i__, j, m;
+	double r__;
+	double oldcs;
+	long oldll;
+	double shift, sigmn, oldsn;
+	long maxit;
+	double sminl, sigmx;
+	long lower;
+	double cs;
+	long ll;
+	double sn, mu;
+	double sminoa, thresh;
+	long rotate;
+	double sminlo;
+	long nm1;
+	double tolmul;
+	long nm12, nm13, lll;
+	double eps, sll, tol;
 
 	/* Parameter adjustments */
 	--d__;
@@ -752,7 +755,7 @@ int NUMlapack_dgebd2 (long *m, long *n, double *a, long *lda, double *d__, doubl
 	long a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static long i__;
+	long i__;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -888,11 +891,11 @@ int NUMlapack_dgebak (const char *job, const char *side, long *n, long *ilo, lon
 	long v_dim1, v_offset, i__1;
 
 	/* Local variables */
-	static long i__, k;
-	static double s;
-	static int leftv;
-	static long ii;
-	static int rightv;
+	long i__, k;
+	double s;
+	int leftv;
+	long ii;
+	int rightv;
 
 #define v_ref(a_1,a_2) v[(a_2)*v_dim1 + a_1]
 
@@ -1029,13 +1032,13 @@ int NUMlapack_dgebal (const char *job, long *n, double *a, long *lda, long *ilo,
 	double d__1, d__2;
 
 	/* Local variables */
-	static long iexc;
-	static double c__, f, g;
-	static long i__, j, k, l, m;
-	static double r__, s;
-	static double sfmin1, sfmin2, sfmax1, sfmax2, ca, ra;
-	static int noconv;
-	static long ica, ira;
+	long iexc;
+	double c__, f, g;
+	long i__, j, k, l, m;
+	double r__, s;
+	double sfmin1, sfmin2, sfmax1, sfmax2, ca, ra;
+	int noconv;
+	long ica, ira;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -1298,13 +1301,13 @@ int NUMlapack_dgebrd (long *m, long *n, double *a, long *lda, double *d__, doubl
 	long a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static long i__, j;
-	static long nbmin, iinfo, minmn;
-	static long nb;
-	static long nx;
-	static double ws;
-	static long ldwrkx, ldwrky, lwkopt;
-	static long lquery;
+	long i__, j;
+	long nbmin, iinfo, minmn;
+	long nb;
+	long nx;
+	double ws;
+	long ldwrkx, ldwrky, lwkopt;
+	long lquery;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -1453,29 +1456,29 @@ int NUMlapack_dgeev (const char *jobvl, const char *jobvr, long *n, double *a, l
 	double d__1, d__2;
 
 	/* Local variables */
-	static long ibal;
-	static char side[1];
-	static long maxb;
-	static double anrm;
-	static long ierr, itau;
-	static long iwrk, nout;
-	static long i__, k;
-	static double r__;
-	static double cs;
-	static int scalea;
-	static double cscale;
-	static double sn;
-	static int select[1];
-	static double bignum;
-	static long minwrk, maxwrk;
-	static int wantvl;
-	static double smlnum;
-	static long hswork;
-	static int lquery, wantvr;
-	static long ihi;
-	static double scl;
-	static long ilo;
-	static double dum[1], eps;
+	long ibal;
+	char side[1];
+	long maxb;
+	double anrm;
+	long ierr, itau;
+	long iwrk, nout;
+	long i__, k;
+	double r__;
+	double cs;
+	int scalea;
+	double cscale;
+	double sn;
+	int select[1];
+	double bignum;
+	long minwrk, maxwrk;
+	int wantvl;
+	double smlnum;
+	long hswork;
+	int lquery, wantvr;
+	long ihi;
+	double scl;
+	long ilo;
+	double dum[1], eps;
 
 #define vl_ref(a_1,a_2) vl[(a_2)*vl_dim1 + a_1]
 #define vr_ref(a_1,a_2) vr[(a_2)*vr_dim1 + a_1]
@@ -1810,8 +1813,8 @@ int NUMlapack_dgehd2 (long *n, long *ilo, long *ihi, double *a, long *lda, doubl
 	long a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__;
-	static double aii;
+	long i__;
+	double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -1884,16 +1887,16 @@ int NUMlapack_dgehrd (long *n, long *ilo, long *ihi, double *a, long *lda, doubl
 	long a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static long i__;
-	static double t[4160] /* was [65][64] */ ;
-	static long nbmin, iinfo;
-	static long ib;
-	static double ei;
-	static long nb, nh;
-	static long nx;
-	static long ldwork, lwkopt;
-	static int lquery;
-	static long iws;
+	long i__;
+	double t[4160] /* was [65][64] */ ;
+	long nbmin, iinfo;
+	long ib;
+	double ei;
+	long nb, nh;
+	long nx = 0;
+	long ldwork, lwkopt;
+	int lquery;
+	long iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -2047,8 +2050,8 @@ int NUMlapack_dgelq2 (long *m, long *n, double *a, long *lda, double *tau, doubl
 	long a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__, k;
-	static double aii;
+	long i__, k;
+	double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -2111,12 +2114,12 @@ int NUMlapack_dgelqf (long *m, long *n, double *a, long *lda, double *tau, doubl
 	long a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static long i__, k, nbmin, iinfo;
-	static long ib, nb;
-	static long nx;
-	static long ldwork, lwkopt;
-	static long lquery;
-	static long iws;
+	long i__, k, nbmin, iinfo;
+	long ib, nb;
+	long nx;
+	long ldwork, lwkopt;
+	long lquery;
+	long iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -2243,24 +2246,24 @@ int NUMlapack_dgelss (long *m, long *n, long *nrhs, double *a, long *lda, double
 	double d__1;
 
 	/* Local variables */
-	static double anrm, bnrm;
-	static long itau;
-	static double vdum[1];
-	static long i__;
-	static long iascl, ibscl;
-	static long chunk;
-	static double sfmin;
-	static long minmn;
-	static long maxmn, itaup, itauq, mnthr, iwork;
-	static long bl, ie, il;
-	static long mm;
-	static long bdspac;
-	static double bignum;
-	static long ldwork;
-	static long minwrk, maxwrk;
-	static double smlnum;
-	static long lquery;
-	static double eps, thr;
+	double anrm, bnrm;
+	long itau;
+	double vdum[1];
+	long i__;
+	long iascl, ibscl;
+	long chunk;
+	double sfmin;
+	long minmn;
+	long maxmn, itaup, itauq, mnthr, iwork;
+	long bl, ie, il;
+	long mm;
+	long bdspac;
+	double bignum;
+	long ldwork;
+	long minwrk, maxwrk;
+	double smlnum;
+	long lquery;
+	double eps, thr;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -2852,13 +2855,13 @@ int NUMlapack_dgeqpf (long *m, long *n, double *a, long *lda, long *jpvt, double
 	double d__1, d__2;
 
 	/* Local variables */
-	static double temp;
-	static double temp2;
-	static long i__, j;
-	static long itemp;
-	static long ma, mn;
-	static double aii;
-	static long pvt;
+	double temp;
+	double temp2;
+	long i__, j;
+	long itemp;
+	long ma, mn;
+	double aii;
+	long pvt;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -3013,8 +3016,8 @@ int NUMlapack_dgeqr2 (long *m, long *n, double *a, long *lda, double *tau, doubl
 	long a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__, k;
-	static double aii;
+	long i__, k;
+	double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -3077,12 +3080,12 @@ int NUMlapack_dgeqrf (long *m, long *n, double *a, long *lda, double *tau, doubl
 	long a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static long i__, k, nbmin, iinfo;
-	static long ib, nb;
-	static long nx;
-	static long ldwork, lwkopt;
-	static long lquery;
-	static long iws;
+	long i__, k, nbmin, iinfo;
+	long ib, nb;
+	long nx;
+	long ldwork, lwkopt;
+	long lquery;
+	long iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -3205,8 +3208,8 @@ int NUMlapack_dgerq2 (long *m, long *n, double *a, long *lda, double *tau, doubl
 	long a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static long i__, k;
-	static double aii;
+	long i__, k;
+	double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -3307,20 +3310,20 @@ int NUMlapack_dgesvd (const char *jobu, const char *jobvt, long *m, long *n, dou
 	char ch__1[2];
 
 	/* Local variables */
-	static long iscl;
-	static double anrm;
-	static long ierr, itau, ncvt, nrvt, i__;
-	static long chunk, minmn, wrkbl, itaup, itauq, mnthr, iwork;
-	static long wntua, wntva, wntun, wntuo, wntvn, wntvo, wntus, wntvs;
-	static long ie;
-	static long ir, bdspac, iu;
-	static double bignum;
-	static long ldwrkr, minwrk, ldwrku, maxwrk;
-	static double smlnum;
-	static long lquery, wntuas, wntvas;
-	static long blk, ncu;
-	static double dum[1], eps;
-	static long nru;
+	long iscl;
+	double anrm;
+	long ierr, itau, ncvt, nrvt, i__;
+	long chunk, minmn, wrkbl = 0, itaup, itauq, mnthr, iwork;
+	long wntua, wntva, wntun, wntuo, wntvn, wntvo, wntus, wntvs;
+	long ie = 0;
+	long ir, bdspac = 0, iu;
+	double bignum;
+	long ldwrkr, minwrk, ldwrku, maxwrk = 0;
+	double smlnum;
+	long lquery, wntuas, wntvas;
+	long blk, ncu;
+	double dum[1], eps;
+	long nru;
 
 	/* Parameter adjustments */
 	a_dim1 = *lda;
@@ -6845,8 +6848,8 @@ int NUMlapack_dgetf2 (long *m, long *n, double *a, long *lda, long *ipiv, long *
 	double d__1;
 
 	/* Local variables */
-	static long j;
-	static long jp;
+	long j;
+	long jp;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -6929,13 +6932,13 @@ int NUMlapack_dgetri (long *n, double *a, long *lda, long *ipiv, double *work, l
 	long a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__, j;
-	static long nbmin;
-	static long jb, nb, jj, jp, nn;
-	static long ldwork;
-	static long lwkopt;
-	static long lquery;
-	static long iws;
+	long i__, j;
+	long nbmin;
+	long jb, nb, jj, jp, nn;
+	long ldwork;
+	long lwkopt;
+	long lquery;
+	long iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -7083,9 +7086,9 @@ int NUMlapack_dgetrf (long *m, long *n, double *a, long *lda, long *ipiv, long *
 	long a_dim1, a_offset, i__1, i__2, i__3, i__4, i__5;
 
 	/* Local variables */
-	static long i__, j;
-	static long iinfo;
-	static long jb, nb;
+	long i__, j;
+	long iinfo;
+	long jb, nb;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -7197,7 +7200,7 @@ int NUMlapack_dgetrs (const char *trans, long *n, long *nrhs, double *a, long *l
 	long a_dim1, a_offset, b_dim1, b_offset, i__1;
 
 	/* Local variables */
-	static long notran;
+	long notran;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -7281,15 +7284,15 @@ int NUMlapack_dggsvd (const char *jobu, const char *jobv, const char *jobq, long
 	long a_dim1, a_offset, b_dim1, b_offset, q_dim1, q_offset, u_dim1, u_offset, v_dim1, v_offset, i__1, i__2;
 
 	/* Local variables */
-	static long ibnd;
-	static double tola;
-	static long isub;
-	static double tolb, unfl, temp, smax;
-	static long i__, j;
-	static double anorm, bnorm;
-	static long wantq, wantu, wantv;
-	static long ncycle;
-	static double ulp;
+	long ibnd;
+	double tola;
+	long isub;
+	double tolb, unfl, temp, smax;
+	long i__, j;
+	double anorm, bnorm;
+	long wantq, wantu, wantv;
+	long ncycle;
+	double ulp;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -7423,9 +7426,9 @@ int NUMlapack_dggsvp (const char *jobu, const char *jobv, const char *jobq, long
 	double d__1;
 
 	/* Local variables */
-	static long i__, j;
-	static long wantq, wantu, wantv;
-	static long forwrd;
+	long i__, j;
+	long wantq, wantu, wantv;
+	long forwrd;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -7747,25 +7750,25 @@ int NUMlapack_dhseqr (const char *job, const char *compz, long *n, long *ilo, lo
 	char ch__1[2];
 
 	/* Local variables */
-	static long maxb;
-	static double absw;
-	static long ierr;
-	static double unfl, temp, ovfl;
-	static long i__, j, k, l;
-	static double s[225] /* was [15][15] */ , v[16];
-	static long itemp;
-	static long i1, i2;
-	static int initz, wantt, wantz;
-	static long ii, nh;
-	static long nr, ns;
-	static long nv;
-	static double vv[16];
-	static double smlnum;
-	static int lquery;
-	static long itn;
-	static double tau;
-	static long its;
-	static double ulp, tst1;
+	long maxb;
+	double absw;
+	long ierr;
+	double unfl, temp, ovfl;
+	long i__, j, k, l;
+	double s[225] /* was [15][15] */ , v[16];
+	long itemp;
+	long i1, i2 = 0;
+	int initz, wantt, wantz;
+	long ii, nh;
+	long nr, ns;
+	long nv;
+	double vv[16];
+	double smlnum;
+	int lquery;
+	long itn;
+	double tau;
+	long its;
+	double ulp, tst1;
 
 #define h___ref(a_1,a_2) h__[(a_2)*h_dim1 + a_1]
 #define s_ref(a_1,a_2) s[(a_2)*15 + a_1 - 16]
@@ -8188,7 +8191,7 @@ int NUMlapack_dlabrd (long *m, long *n, long *nb, double *a, long *lda, double *
 	long a_dim1, a_offset, x_dim1, x_offset, y_dim1, y_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__;
+	long i__;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -8418,7 +8421,7 @@ int NUMlapack_dlacpy (const char *uplo, long *m, long *n, double *a, long *lda,
 	long a_dim1, a_offset, b_dim1, b_offset, i__1, i__2;
 
 	/* Local variables */
-	static long i__, j;
+	long i__, j;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -8466,7 +8469,7 @@ int NUMlapack_dlacpy (const char *uplo, long *m, long *n, double *a, long *lda,
 
 
 int NUMlapack_dladiv (double *a, double *b, double *c, double *d, double *p, double *q) {
-	static double e, f;
+	double e, f;
 
 	if (fabs (*d) < fabs (*c)) {
 		e = *d / *c;
@@ -8489,7 +8492,7 @@ int NUMlapack_dlae2 (double *a, double *b, double *c__, double *rt1, double *rt2
 	double d__1;
 
 	/* Local variables */
-	static double acmn, acmx, ab, df, tb, sm, rt, adf;
+	double acmn, acmx, ab, df, tb, sm, rt, adf;
 	sm = *a + *c__;
 	df = *a - *c__;
 	adf = fabs (df);
@@ -8546,8 +8549,8 @@ int NUMlapack_dlaev2 (double *a, double *b, double *c__, double *rt1, double *rt
 	double d__1;
 
 	/* Local variables */
-	static double acmn, acmx, ab, df, cs, ct, tb, sm, tn, rt, adf, acs;
-	static long sgn1, sgn2;
+	double acmn, acmx, ab, df, cs, ct, tb, sm, tn, rt, adf, acs;
+	long sgn1, sgn2;
 
 	sm = *a + *c__;
 	df = *a - *c__;
@@ -8638,9 +8641,9 @@ int NUMlapack_dlags2 (long *upper, double *a1, double *a2, double *a3, double *b
 	double d__1;
 
 	/* Local variables */
-	static double aua11, aua12, aua21, aua22, avb11, avb12, avb21, avb22;
+	double aua11, aua12, aua21, aua22, avb11, avb12, avb21, avb22;
 	double ua11r, ua22r, vb11r, vb22r, a, b, c__, d__, r__, s1, s2;
-	static double ua11, ua12, ua21, ua22, vb11, vb12, vb21, vb22, csl, csr, snl, snr;
+	double ua11, ua12, ua21, ua22, vb11, vb12, vb21, vb22, csl, csr, snl, snr;
 
 	if (*upper) {
 
@@ -8822,21 +8825,21 @@ int NUMlapack_dlahqr (int *wantt, int *wantz, long *n, long *ilo, long *ihi, dou
 	double d__1, d__2;
 
 	/* Local variables */
-	static double h43h34, disc, unfl, ovfl;
-	static double work[1];
-	static long i__, j, k, l, m;
-	static double s, v[3];
-	static long i1, i2;
-	static double t1, t2, t3, v1, v2, v3;
-	static double h00, h10, h11, h12, h21, h22, h33, h44;
-	static long nh;
-	static double cs;
-	static long nr;
-	static double sn;
-	static long nz;
-	static double smlnum, ave, h33s, h44s;
-	static long itn, its;
-	static double ulp, sum, tst1;
+	double h43h34, disc, unfl, ovfl;
+	double work[1];
+	long i__, j, k, l, m;
+	double s, v[3];
+	long i1, i2 = 0;
+	double t1, t2, t3, v1, v2, v3;
+	double h00, h10, h11, h12, h21, h22, h33, h44;
+	long nh;
+	double cs;
+	long nr;
+	double sn;
+	long nz;
+	double smlnum, ave, h33s, h44s;
+	long itn, its;
+	double ulp, sum, tst1;
 
 #define h___ref(a_1,a_2) h__[(a_2)*h_dim1 + a_1]
 #define z___ref(a_1,a_2) z__[(a_2)*z_dim1 + a_1]
@@ -9211,8 +9214,8 @@ int NUMlapack_dlahrd (long *n, long *k, long *nb, double *a, long *lda, double *
 	double d__1;
 
 	/* Local variables */
-	static long i__;
-	static double ei;
+	long i__;
+	double ei = 0;
 
 #define t_ref(a_1,a_2) t[(a_2)*t_dim1 + a_1]
 #define y_ref(a_1,a_2) y[(a_2)*y_dim1 + a_1]
@@ -9346,21 +9349,21 @@ int NUMlapack_dlaln2 (int *ltrans, long *na, long *nw, double *smin, double *ca,
 	/* System generated locals */
 	long a_dim1, a_offset, b_dim1, b_offset, x_dim1, x_offset;
 	double d__1, d__2, d__3, d__4, d__5, d__6;
-	static double equiv_0[4], equiv_1[4];
+	double equiv_0[4], equiv_1[4];
 
 	/* Local variables */
-	static double bbnd, cmax, ui11r, ui12s, temp, ur11r, ur12s;
-	static long j;
-	static double u22abs;
-	static long icmax;
-	static double bnorm, cnorm, smini;
+	double bbnd, cmax, ui11r, ui12s, temp, ur11r, ur12s;
+	long j;
+	double u22abs;
+	long icmax;
+	double bnorm, cnorm, smini;
 
 #define ci (equiv_0)
 #define cr (equiv_1)
-	static double bignum, bi1, bi2, br1, br2, smlnum, xi1, xi2, xr1, xr2, ci21, ci22, cr21, cr22, li21, csi,
+	double bignum, bi1, bi2, br1, br2, smlnum, xi1, xi2, xr1, xr2, ci21, ci22, cr21, cr22, li21, csi,
 	       ui11, lr21, ui12, ui22;
 #define civ (equiv_0)
-	static double csr, ur11, ur12, ur22;
+	double csr, ur11, ur12, ur22;
 
 #define crv (equiv_1)
 #define b_ref(a_1,a_2) b[(a_2)*b_dim1 + a_1]
@@ -9757,10 +9760,10 @@ double NUMlapack_dlange (const char *norm, long *m, long *n, double *a, long *ld
 	double ret_val, d__1, d__2, d__3;
 
 	/* Local variables */
-	static long i__, j;
-	static double scale;
-	static double value;
-	static double sum;
+	long i__, j;
+	double scale;
+	double value = 0;
+	double sum;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -9856,10 +9859,10 @@ double NUMlapack_dlanhs (const char *norm, long *n, double *a, long *lda, double
 	double ret_val, d__1, d__2, d__3;
 
 	/* Local variables */
-	static long i__, j;
-	static double scale;
-	static double value;
-	static double sum;
+	long i__, j;
+	double scale;
+	double value = 0;
+	double sum;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -9962,10 +9965,10 @@ double NUMlapack_dlanst (const char *norm, long *n, double *d__, double *e) {
 	/* System generated locals */
 	long i__1;
 	double ret_val, d__1, d__2, d__3, d__4, d__5;
-	static long i__;
-	static double scale;
-	static double anorm;
-	static double sum;
+	long i__;
+	double scale;
+	double anorm = 0;
+	double sum;
 
 	--e;
 	--d__;
@@ -10036,11 +10039,11 @@ double NUMlapack_dlansy (const char *norm, const char *uplo, long *n, double *a,
 	double ret_val, d__1, d__2, d__3;
 
 	/* Local variables */
-	static double absa;
-	static long i__, j;
-	static double scale;
-	static double value;
-	static double sum;
+	double absa;
+	long i__, j;
+	double scale;
+	double value = 0;
+	double sum;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -10167,9 +10170,9 @@ int NUMlapack_dlanv2 (double *a, double *b, double *c__, double *d__, double *rt
 	double d__1, d__2;
 
 	/* Local variables */
-	static double temp, p, scale, bcmax, z__, bcmis, sigma;
-	static double aa, bb, cc, dd;
-	static double cs1, sn1, sab, sac, eps, tau;
+	double temp, p, scale, bcmax, z__, bcmis, sigma;
+	double aa, bb, cc, dd;
+	double cs1, sn1, sab, sac, eps, tau;
 
 	eps = NUMblas_dlamch ("P");
 	if (*c__ == 0.) {
@@ -10312,9 +10315,9 @@ int NUMlapack_dlapll (long *n, double *x, long *incx, double *y, long *incy, dou
 	long i__1;
 
 	/* Local variables */
-	static double c__;
-	static double ssmax, a11, a12, a22;
-	static double tau;
+	double c__;
+	double ssmax, a11, a12, a22;
+	double tau;
 
 	--y;
 	--x;
@@ -10356,8 +10359,8 @@ int NUMlapack_dlapmt (long *forwrd, long *m, long *n, double *x, long *ldx, long
 	long x_dim1, x_offset, i__1, i__2;
 
 	/* Local variables */
-	static double temp;
-	static long i__, j, ii, in;
+	double temp;
+	long i__, j, ii, in;
 
 	x_dim1 = *ldx;
 	x_offset = 1 + x_dim1 * 1;
@@ -10462,7 +10465,7 @@ double NUMlapack_dlapy2 (double *x, double *y) {
 	double ret_val, d__1;
 
 	/* Local variables */
-	static double xabs, yabs, w, z__;
+	double xabs, yabs, w, z__;
 
 	xabs = fabs (*x);
 	yabs = fabs (*y);
@@ -10493,8 +10496,8 @@ int NUMlapack_dlarfb (const char *side, const char *trans, const char *direct, c
 	long work_dim1, work_offset, i__1, i__2;
 
 	/* Local variables */
-	static long i__, j;
-	static char transt[1];
+	long i__, j;
+	char transt[1];
 
 	v_dim1 = *ldv;
 	v_offset = 1 + v_dim1 * 1;
@@ -11100,11 +11103,11 @@ int NUMlapack_dlarfg (long *n, double *alpha, double *x, long *incx, double *tau
 	double d__1;
 
 	/* Local variables */
-	static double beta;
-	static long j;
-	static double xnorm;
-	static double safmin, rsafmn;
-	static long knt;
+	double beta;
+	long j;
+	double xnorm;
+	double safmin, rsafmn;
+	long knt;
 
 	--x;
 
@@ -11190,8 +11193,8 @@ int NUMlapack_dlarft (const char *direct, const char *storev, long *n, long *k,
 	double d__1;
 
 	/* Local variables */
-	static long i__, j;
-	static double vii;
+	long i__, j;
+	double vii;
 
 	v_dim1 = *ldv;
 	v_offset = 1 + v_dim1 * 1;
@@ -11315,30 +11318,29 @@ int NUMlapack_dlarft (const char *direct, const char *storev, long *n, long *k,
 #undef v_ref
 #undef t_ref
 
+static double dlartg_safmn2 () {
+	double safmin = NUMblas_dlamch ("S");
+	double eps = NUMblas_dlamch ("E");
+	double d__1 = NUMblas_dlamch ("B");
+	long i__1 = (long) (log (safmin / eps) / log (NUMblas_dlamch ("B")) / 2.);
+	return pow_di (&d__1, &i__1);
+}
+
 int NUMlapack_dlartg (double *f, double *g, double *cs, double *sn, double *r__) {
-	/* Initialized data */
-	static long first = TRUE;
+	/* Initialized data (computed once; a function-local static is initialized exactly once, even with several threads) */
+	static const double safmn2 = dlartg_safmn2 ();
+	static const double safmx2 = 1. / safmn2;
 
 	/* System generated locals */
 	long i__1;
 	double d__1, d__2;
 
 	/* Local variables */
-	static long i__;
-	static double scale;
-	static long count;
-	static double f1, g1, safmn2, safmx2;
-	static double safmin, eps;
-
-	if (first) {
-		first = FALSE;
-		safmin = NUMblas_dlamch ("S");
-		eps = NUMblas_dlamch ("E");
-		d__1 = NUMblas_dlamch ("B");
-		i__1 = (long) (log (safmin / eps) / log (NUMblas_dlamch ("B")) / 2.);
-		safmn2 = pow_di (&d__1, &i__1);
-		safmx2 = 1. / safmn2;
-	}
+	long i__;
+	double scale;
+	long count;
+	double f1, g1;
+
 	if (*g == 0.) {
 		*cs = 1.;
 		*sn = 0.;
@@ -11431,8 +11433,8 @@ int NUMlapack_dlarfx (const char *side, long *m, long *n, double *v, double *tau
 	double d__1;
 
 	/* Local variables */
-	static long j;
-	static double t1, t2, t3, t4, t5, t6, t7, t8, t9, v1, v2, v3, v4, v5, v6, v7, v8, v9, t10, v10, sum;
+	long j;
+	double t1, t2, t3, t4, t5, t6, t7, t8, t9, v1, v2, v3, v4, v5, v6, v7, v8, v9, t10, v10, sum;
 
 	--v;
 	c_dim1 = *ldc;
@@ -12087,7 +12089,7 @@ int NUMlapack_dlas2 (double *f, double *g, double *h__, double *ssmin, double *s
 	double d__1, d__2;
 
 	/* Local variables */
-	static double fhmn, fhmx, c__, fa, ga, ha, as, at, au;
+	double fhmn, fhmx, c__, fa, ga, ha, as, at, au;
 
 	fa = fabs (*f);
 	ga = fabs (*g);
@@ -12146,13 +12148,13 @@ int NUMlapack_dlascl (const char *type__, long *kl, long *ku, double *cfrom, dou
 	long a_dim1, a_offset, i__1, i__2, i__3, i__4, i__5;
 
 	/* Local variables */
-	static long done;
-	static double ctoc;
-	static long i__, j;
-	static long itype, k1, k2, k3, k4;
-	static double cfrom1;
-	static double cfromc;
-	static double bignum, smlnum, mul, cto1;
+	long done;
+	double ctoc;
+	long i__, j;
+	long itype, k1, k2, k3, k4;
+	double cfrom1;
+	double cfromc;
+	double bignum, smlnum, mul, cto1;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -12372,7 +12374,7 @@ int NUMlapack_dlaset (const char *uplo, long *m, long *n, double *alpha, double
 	long a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__, j;
+	long i__, j;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -12443,13 +12445,13 @@ int NUMlapack_dlasq1 (long *n, double *d__, double *e, double *work, long *info)
 	double d__1, d__2, d__3;
 
 	/* Local variables */
-	static long i__;
-	static double scale;
-	static long iinfo;
-	static double sigmn;
-	static double sigmx;
-	static double safmin;
-	static double eps;
+	long i__;
+	double scale;
+	long iinfo;
+	double sigmn;
+	double sigmx;
+	double safmin;
+	double eps;
 
 	/* Parameter adjustments */
 	--work;
@@ -12548,23 +12550,23 @@ int NUMlapack_dlasq2 (long *n, double *z__, long *info) {
 	double d__1, d__2;
 
 	/* Local variables */
-	static long ieee;
-	static long nbig;
-	static double dmin__, emin, emax;
-	static long ndiv, iter;
-	static double qmin, temp, qmax, zmax;
-	static long splt;
-	static double d__, e;
-	static long k;
-	static double s, t;
-	static long nfail;
-	static double desig, trace, sigma;
-	static long iinfo, i0, i4, n0;
-	static long pp, iwhila, iwhilb;
-	static double oldemn, safmin;
-	static double eps, tol;
-	static long ipn4;
-	static double tol2;
+	long ieee;
+	long nbig;
+	double dmin__, emin, emax;
+	long ndiv, iter;
+	double qmin, temp, qmax, zmax;
+	long splt;
+	double d__, e;
+	long k;
+	double s, t;
+	long nfail;
+	double desig, trace, sigma;
+	long iinfo, i0, i4, n0;
+	long pp, iwhila, iwhilb;
+	double oldemn, safmin;
+	double eps, tol;
+	long ipn4;
+	double tol2;
 
 	/* Parameter adjustments */
 	--z__;
@@ -12965,26 +12967,26 @@ L150:
 
 int NUMlapack_dlasq3 (long *i0, long *n0, double *z__, long *pp, double *dmin__, double *sigma, double *desig,
                       double *qmax, long *nfail, long *iter, long *ndiv, long *ieee) {
-	/* Initialized data */
-	static long ttype = 0;
-	static double dmin1 = 0.;
-	static double dmin2 = 0.;
-	static double dn = 0.;
-	static double dn1 = 0.;
-	static double dn2 = 0.;
-	static double tau = 0.;
+	/* Initialized data (saved between calls; per thread, so that several threads can do SVDs at the same time) */
+	static thread_local long ttype = 0;
+	static thread_local double dmin1 = 0.;
+	static thread_local double dmin2 = 0.;
+	static thread_local double dn = 0.;
+	static thread_local double dn1 = 0.;
+	static thread_local double dn2 = 0.;
+	static thread_local double tau = 0.;
 
 	/* System generated locals */
 	long i__1;
 	double d__1, d__2;
 
 	/* Local variables */
-	static double temp, s, t;
-	static long j4;
-	static long nn;
-	static double safmin, eps, tol;
-	static long n0in, ipn4;
-	static double tol2;
+	double temp, s, t;
+	long j4;
+	long nn;
+	double safmin, eps, tol;
+	long n0in, ipn4;
+	double tol2;
 
 	--z__;
 
@@ -13201,18 +13203,18 @@ L100:
 
 int NUMlapack_dlasq4 (long *i0, long *n0, double *z__, long *pp, long *n0in, double *dmin__, double *dmin1,
                       double *dmin2, double *dn, double *dn1, double *dn2, double *tau, long *ttype) {
-	/* Initialized data */
+	/* Initialized data (saved between calls; per thread) */
 
-	static double g = 0.;
+	static thread_local double g = 0.;
 
 	/* System generated locals */
 	long i__1;
 	double d__1, d__2;
 
 	/* Local variables */
-	static double s, a2, b1, b2;
-	static long i4, nn, np;
-	static double gam, gap1, gap2;
+	double s = 0, a2, b1, b2;
+	long i4, nn, np;
+	double gam, gap1, gap2;
 
 	/* Parameter adjustments */
 	--z__;
@@ -13511,8 +13513,8 @@ int NUMlapack_dlasq5 (long *i0, long *n0, double *z__, long *pp, double *tau, do
 	double d__1, d__2;
 
 	/* Local variables */
-	static double emin, temp, d__;
-	static long j4, j4p2;
+	double emin, temp, d__;
+	long j4, j4p2;
 
 	--z__;
 
@@ -13657,10 +13659,10 @@ int NUMlapack_dlasq6 (long *i0, long *n0, double *z__, long *pp, double *dmin__,
 	double d__1, d__2;
 
 	/* Local variables */
-	static double emin, temp, d__;
-	static long j4;
-	static double safmin;
-	static long j4p2;
+	double emin, temp, d__;
+	long j4;
+	double safmin;
+	long j4p2;
 
 	/* Parameter adjustments */
 	--z__;
@@ -13776,10 +13778,10 @@ int NUMlapack_dlasr (const char *side, const char *pivot, const char *direct, lo
 	long a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static long info;
-	static double temp;
-	static long i__, j;
-	static double ctemp, stemp;
+	long info;
+	double temp;
+	long i__, j;
+	double ctemp, stemp;
 
 	--c__;
 	--s;
@@ -14032,12 +14034,12 @@ int NUMlapack_dlasrt (const char *id, long *n, double *d__, long *info) {
 	long i__1, i__2;
 
 	/* Local variables */
-	static long endd, i__, j;
-	static long stack[64] /* was [2][32] */ ;
-	static double dmnmx, d1, d2, d3;
-	static long start;
-	static long stkpnt, dir;
-	static double tmp;
+	long endd, i__, j;
+	long stack[64] /* was [2][32] */ ;
+	double dmnmx, d1, d2, d3;
+	long start;
+	long stkpnt, dir;
+	double tmp;
 
 	--d__;
 
@@ -14241,8 +14243,8 @@ int NUMlapack_dlassq (long *n, double *x, long *incx, double *scale, double *sum
 	double d__1;
 
 	/* Local variables */
-	static double absxi;
-	static long ix;
+	double absxi;
+	long ix;
 
 	--x;
 
@@ -14280,13 +14282,13 @@ int NUMlapack_dlasv2 (double *f, double *g, double *h__, double *ssmin, double *
 	double d__1;
 
 	/* Local variables */
-	static long pmax;
-	static double temp;
-	static long swap;
-	static double a, d__, l, m, r__, s, t, tsign, fa, ga, ha;
-	static double ft, gt, ht, mm;
-	static long gasmal;
-	static double tt, clt, crt, slt, srt;
+	long pmax;
+	double temp;
+	long swap;
+	double a, d__, l, m, r__, s, t, tsign, fa, ga, ha;
+	double ft, gt, ht, mm;
+	long gasmal;
+	double tt, clt, crt, slt, srt;
 
 	ft = *f;
 	fa = fabs (ft);
@@ -14441,8 +14443,8 @@ int NUMlapack_dlaswp (long *n, double *a, long *lda, long *k1, long *k2, long *i
 	long a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static double temp;
-	static long i__, j, k, i1, i2, n32, ip, ix, ix0, inc;
+	double temp;
+	long i__, j, k, i1, i2, n32, ip, ix, ix0, inc;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -14525,9 +14527,9 @@ int NUMlapack_dlatrd (const char *uplo, long *n, long *nb, double *a, long *lda,
 	long a_dim1, a_offset, w_dim1, w_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__;
-	static double alpha;
-	static long iw;
+	long i__;
+	double alpha;
+	long iw;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -14682,8 +14684,8 @@ int NUMlapack_dorg2l (long *m, long *n, long *k, double *a, long *lda, double *t
 	double d__1;
 
 	/* Local variables */
-	static long i__, j, l;
-	static long ii;
+	long i__, j, l;
+	long ii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -14763,7 +14765,7 @@ int NUMlapack_dorg2r (long *m, long *n, long *k, double *a, long *lda, double *t
 	double d__1;
 
 	/* Local variables */
-	static long i__, j, l;
+	long i__, j, l;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -14847,12 +14849,12 @@ int NUMlapack_dorgbr (const char *vect, long *m, long *n, long *k, double *a, lo
 	long a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__, j;
-	static long iinfo;
-	static long wantq;
-	static long nb, mn;
-	static long lwkopt;
-	static long lquery;
+	long i__, j;
+	long iinfo;
+	long wantq;
+	long nb, mn;
+	long lwkopt;
+	long lquery;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15006,9 +15008,9 @@ int NUMlapack_dorghr (long *n, long *ilo, long *ihi, double *a, long *lda, doubl
 	long a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static long i__, j, iinfo, nb, nh;
-	static long lwkopt;
-	static int lquery;
+	long i__, j, iinfo, nb, nh;
+	long lwkopt;
+	int lquery;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15115,7 +15117,7 @@ int NUMlapack_dorgl2 (long *m, long *n, long *k, double *a, long *lda, double *t
 	double d__1;
 
 	/* Local variables */
-	static long i__, j, l;
+	long i__, j, l;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15206,12 +15208,12 @@ int NUMlapack_dorglq (long *m, long *n, long *k, double *a, long *lda, double *t
 	long a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__, j, l, nbmin, iinfo;
-	static long ib, nb, ki, kk;
-	static long nx;
-	static long ldwork, lwkopt;
-	static long lquery;
-	static long iws;
+	long i__, j, l, nbmin, iinfo;
+	long ib, nb, ki, kk;
+	long nx;
+	long ldwork, lwkopt;
+	long lquery;
+	long iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15376,12 +15378,12 @@ int NUMlapack_dorgql (long *m, long *n, long *k, double *a, long *lda, double *t
 	long a_dim1, a_offset, i__1, i__2, i__3, i__4;
 
 	/* Local variables */
-	static long i__, j, l, nbmin, iinfo;
-	static long ib, nb, kk;
-	static long nx;
-	static long ldwork, lwkopt;
-	static long lquery;
-	static long iws;
+	long i__, j, l, nbmin, iinfo;
+	long ib, nb, kk;
+	long nx;
+	long ldwork, lwkopt;
+	long lquery;
+	long iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15545,12 +15547,12 @@ int NUMlapack_dorgqr (long *m, long *n, long *k, double *a, long *lda, double *t
 	long a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__, j, l, nbmin, iinfo;
-	static long ib, nb, ki, kk;
-	static long nx;
-	static long ldwork, lwkopt;
-	static long lquery;
-	static long iws;
+	long i__, j, l, nbmin, iinfo;
+	long ib, nb, ki, kk;
+	long nx;
+	long ldwork, lwkopt;
+	long lquery;
+	long iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15714,12 +15716,12 @@ int NUMlapack_dorgtr (const char *uplo, long *n, double *a, long *lda, double *t
 	long a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__, j;
-	static long iinfo;
-	static long upper;
-	static long nb;
-	static long lwkopt;
-	static long lquery;
+	long i__, j;
+	long iinfo;
+	long upper;
+	long nb;
+	long lwkopt;
+	long lquery;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15856,11 +15858,11 @@ int NUMlapack_dorm2r (const char *side, const char *trans, long *m, long *n, lon
 	long a_dim1, a_offset, c_dim1, c_offset, i__1, i__2;
 
 	/* Local variables */
-	static long left;
-	static long i__;
-	static long i1, i2, i3, ic, jc, mi, ni, nq;
-	static long notran;
-	static double aii;
+	long left;
+	long i__;
+	long i1, i2, i3, ic, jc, mi, ni, nq;
+	long notran;
+	double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -15969,13 +15971,13 @@ int NUMlapack_dormbr (const char *vect, const char *side, const char *trans, lon
 	char ch__1[2];
 
 	/* Local variables */
-	static long left;
-	static long iinfo, i1, i2, nb, mi, ni, nq, nw;
-	static long notran;
-	static long applyq;
-	static char transt[1];
-	static long lwkopt;
-	static long lquery;
+	long left;
+	long iinfo, i1, i2, nb, mi, ni, nq, nw;
+	long notran;
+	long applyq;
+	char transt[1];
+	long lwkopt;
+	long lquery;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16157,11 +16159,11 @@ int NUMlapack_dorml2 (const char *side, const char *trans, long *m, long *n, lon
 	long a_dim1, a_offset, c_dim1, c_offset, i__1, i__2;
 
 	/* Local variables */
-	static long left;
-	static long i__;
-	static long i1, i2, i3, ic, jc, mi, ni, nq;
-	static long notran;
-	static double aii;
+	long left;
+	long i__;
+	long i1, i2, i3, ic, jc, mi, ni, nq;
+	long notran;
+	double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16272,18 +16274,18 @@ int NUMlapack_dormlq (const char *side, const char *trans, long *m, long *n, lon
 	char ch__1[2];
 
 	/* Local variables */
-	static long left;
-	static long i__;
-	static double t[4160] /* was [65][64] */ ;
-	static long nbmin, iinfo, i1, i2, i3;
-	static long ib, ic, jc, nb, mi, ni;
-	static long nq, nw;
-	static long notran;
-	static long ldwork;
-	static char transt[1];
-	static long lwkopt;
-	static long lquery;
-	static long iws;
+	long left;
+	long i__;
+	double t[4160] /* was [65][64] */ ;
+	long nbmin, iinfo, i1, i2, i3;
+	long ib, ic, jc, nb, mi, ni;
+	long nq, nw;
+	long notran;
+	long ldwork;
+	char transt[1];
+	long lwkopt;
+	long lquery;
+	long iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16459,16 +16461,16 @@ int NUMlapack_dormqr (const char *side, const char *trans, long *m, long *n, lon
 	char ch__1[2];
 
 	/* Local variables */
-	static long left;
-	static long i__;
-	static double t[4160] /* was [65][64] */ ;
-	static long nbmin, iinfo, i1, i2, i3;
-	static long ib, ic, jc, nb, mi, ni;
-	static long nq, nw;
-	static long notran;
-	static long ldwork, lwkopt;
-	static long lquery;
-	static long iws;
+	long left;
+	long i__;
+	double t[4160] /* was [65][64] */ ;
+	long nbmin, iinfo, i1, i2, i3;
+	long ib, ic, jc, nb, mi, ni;
+	long nq, nw;
+	long notran;
+	long ldwork, lwkopt;
+	long lquery;
+	long iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16631,11 +16633,11 @@ int NUMlapack_dormr2 (const char *side, const char *trans, long *m, long *n, lon
 	long a_dim1, a_offset, c_dim1, c_offset, i__1, i__2;
 
 	/* Local variables */
-	static long left;
-	static long i__;
-	static long i1, i2, i3, mi, ni, nq;
-	static long notran;
-	static double aii;
+	long left;
+	long i__;
+	long i1, i2, i3, mi, ni, nq;
+	long notran;
+	double aii;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16737,9 +16739,9 @@ int NUMlapack_dpotf2 (const char *uplo, long *n, double *a, long *lda, long *inf
 	double d__1;
 
 	/* Local variables */
-	static long j;
-	static int upper;
-	static double ajj;
+	long j;
+	int upper;
+	double ajj;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -16840,10 +16842,10 @@ L40:
 }				/* NUMlapack_dpotf2_ */
 
 int NUMlapack_drscl (long *n, double *sa, double *sx, long *incx) {
-	static double cden;
-	static long done;
-	static double cnum, cden1, cnum1;
-	static double bignum, smlnum, mul;
+	double cden;
+	long done;
+	double cnum, cden1, cnum1;
+	double bignum, smlnum, mul;
 
 	--sx;
 
@@ -16915,25 +16917,25 @@ int NUMlapack_dsteqr (const char *compz, long *n, double *d__, double *e, double
 	double d__1, d__2;
 
 	/* Local variables */
-	static long lend, jtot;
-	static double b, c__, f, g;
-	static long i__, j, k, l, m;
-	static double p, r__, s;
-	static double anorm;
-	static long l1;
-	static long lendm1, lendp1;
-	static long ii;
-	static long mm, iscale;
-	static double safmin;
-	static double safmax;
-	static long lendsv;
-	static double ssfmin;
-	static long nmaxit, icompz;
-	static double ssfmax;
-	static long lm1, mm1, nm1;
-	static double rt1, rt2, eps;
-	static long lsv;
-	static double tst, eps2;
+	long lend, jtot;
+	double b, c__, f, g;
+	long i__, j, k, l, m;
+	double p, r__, s;
+	double anorm;
+	long l1;
+	long lendm1, lendp1;
+	long ii;
+	long mm, iscale;
+	double safmin;
+	double safmax;
+	long lendsv;
+	double ssfmin;
+	long nmaxit, icompz;
+	double ssfmax;
+	long lm1, mm1, nm1;
+	double rt1, rt2, eps;
+	long lsv;
+	double tst, eps2;
 
 	--d__;
 	--e;
@@ -17390,22 +17392,22 @@ int NUMlapack_dsterf (long *n, double *d__, double *e, long *info) {
 	double d__1, d__2, d__3;
 
 	/* Local variables */
-	static double oldc;
-	static long lend, jtot;
-	static double c__;
-	static long i__, l, m;
-	static double p, gamma, r__, s, alpha, sigma, anorm;
-	static long l1;
-	static double bb;
-	static long iscale;
-	static double oldgam, safmin;
-	static double safmax;
-	static long lendsv;
-	static double ssfmin;
-	static long nmaxit;
-	static double ssfmax, rt1, rt2, eps, rte;
-	static long lsv;
-	static double eps2;
+	double oldc;
+	long lend, jtot;
+	double c__;
+	long i__, l, m;
+	double p, gamma, r__, s, alpha, sigma, anorm;
+	long l1;
+	double bb;
+	long iscale;
+	double oldgam, safmin;
+	double safmax;
+	long lendsv;
+	double ssfmin;
+	long nmaxit;
+	double ssfmax, rt1, rt2, eps, rte;
+	long lsv;
+	double eps2;
 
 	--e;
 	--d__;
@@ -17757,25 +17759,25 @@ int NUMlapack_dsyev (const char *jobz, const char *uplo, long *n, double *a, lon
 	double d__1;
 
 	/* Local variables */
-	static long inde;
-	static double anrm;
-	static long imax;
-	static double rmin, rmax;
-	static long lopt;
-	static double sigma;
-	static long iinfo;
-	static long lower, wantz;
-	static long nb;
-	static long iscale;
-	static double safmin;
-	static double bignum;
-	static long indtau;
-	static long indwrk;
-	static long llwork;
-	static double smlnum;
-	static long lwkopt;
-	static long lquery;
-	static double eps;
+	long inde;
+	double anrm;
+	long imax;
+	double rmin, rmax;
+	long lopt;
+	double sigma;
+	long iinfo;
+	long lower, wantz;
+	long nb;
+	long iscale;
+	double safmin;
+	double bignum;
+	long indtau;
+	long indwrk;
+	long llwork;
+	double smlnum;
+	long lwkopt;
+	long lquery;
+	double eps;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -17911,10 +17913,10 @@ int NUMlapack_dsytd2 (const char *uplo, long *n, double *a, long *lda, double *d
 	long a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static double taui;
-	static long i__;
-	static double alpha;
-	static long upper;
+	double taui;
+	long i__;
+	double alpha;
+	long upper;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -18053,13 +18055,13 @@ int NUMlapack_dsytrd (const char *uplo, long *n, double *a, long *lda, double *d
 	long a_dim1, a_offset, i__1, i__2, i__3;
 
 	/* Local variables */
-	static long i__, j;
-	static long nbmin, iinfo;
-	static long upper;
-	static long nb, kk, nx;
-	static long ldwork, lwkopt;
-	static long lquery;
-	static long iws;
+	long i__, j;
+	long nbmin, iinfo;
+	long upper;
+	long nb, kk, nx;
+	long ldwork, lwkopt;
+	long lquery;
+	long iws;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -18247,17 +18249,17 @@ int NUMlapack_dtgsja (const char *jobu, const char *jobv, const char *jobq, long
 	double d__1;
 
 	/* Local variables */
-	static long i__, j;
-	static double gamma;
-	static double a1;
-	static long initq;
-	static double a2, a3, b1;
-	static long initu, initv, wantq, upper;
-	static double b2, b3;
-	static long wantu, wantv;
-	static double error, ssmin;
-	static long kcycle;
-	static double csq, csu, csv, snq, rwk, snu, snv;
+	long i__, j;
+	double gamma;
+	double a1;
+	long initq;
+	double a2, a3, b1;
+	long initu, initv, wantq, upper;
+	double b2, b3;
+	long wantu, wantv;
+	double error, ssmin;
+	long kcycle;
+	double csq, csu, csv, snq, rwk, snu, snv;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -18565,28 +18567,28 @@ int NUMlapack_dtrevc (const char *side, const char *howmny, int *select, long *n
 	double d__1, d__2, d__3, d__4, d__5, d__6;
 
 	/* Local variables */
-	static double beta, emax;
-	static int pair;
-	static int allv;
-	static long ierr;
-	static double unfl, ovfl, smin;
-	static int over;
-	static double vmax;
-	static long jnxt, i__, j, k;
-	static double scale, x[4] /* was [2][2] */ ;
-	static double remax;
-	static int leftv, bothv;
-	static double vcrit;
-	static int somev;
-	static long j1, j2, n2;
-	static double xnorm;
-	static long ii, ki;
-	static long ip, is;
-	static double wi;
-	static double wr;
-	static double bignum;
-	static int rightv;
-	static double smlnum, rec, ulp;
+	double beta, emax;
+	int pair;
+	int allv;
+	long ierr;
+	double unfl, ovfl, smin;
+	int over;
+	double vmax;
+	long jnxt, i__, j, k;
+	double scale, x[4] /* was [2][2] */ ;
+	double remax;
+	int leftv, bothv;
+	double vcrit;
+	int somev;
+	long j1, j2, n2;
+	double xnorm;
+	long ii, ki;
+	long ip, is;
+	double wi;
+	double wr;
+	double bignum;
+	int rightv;
+	double smlnum, rec, ulp;
 
 #define t_ref(a_1,a_2) t[(a_2)*t_dim1 + a_1]
 #define x_ref(a_1,a_2) x[(a_2)*2 + a_1 - 3]
@@ -19541,10 +19543,10 @@ int NUMlapack_dtrti2 (const char *uplo, const char *diag, long *n, double *a, lo
 	long a_dim1, a_offset, i__1, i__2;
 
 	/* Local variables */
-	static long j;
-	static long upper;
-	static long nounit;
-	static double ajj;
+	long j;
+	long upper;
+	long nounit;
+	double ajj;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -19632,10 +19634,10 @@ int NUMlapack_dtrtri (const char *uplo, const char *diag, long *n, double *a, lo
 	char ch__1[2];
 
 	/* Local variables */
-	static long j;
-	static long upper;
-	static long jb, nb, nn;
-	static long nounit;
+	long j;
+	long upper;
+	long jb, nb, nn;
+	long nounit;
 
 	a_dim1 = *lda;
 	a_offset = 1 + a_dim1 * 1;
@@ -19757,7 +19759,7 @@ long NUMlapack_ieeeck (long *ispec, float *zero, float *one) {
 	long ret_val;
 
 	/* Local variables */
-	static float neginf, posinf, negzro, newzro, nan1, nan2, nan3, nan4, nan5, nan6;
+	float neginf, posinf, negzro, newzro, nan1, nan2, nan3, nan4, nan5, nan6;
 
 	ret_val = 1;
 
@@ -19872,13 +19874,13 @@ long NUMlapack_ilaenv (long *ispec, const char *name__, const char *opts, long *
 	long ret_val;
 
 	/* Local variables */
-	static long i__;
-	static long cname, sname;
-	static long nbmin;
-	static char c1[1], c2[2], c3[3], c4[2];
-	static long ic, nb;
-	static long iz, nx;
-	static char subnam[6];
+	long i__;
+	long cname, sname;
+	long nbmin;
+	char c1[1], c2[2], c3[3], c4[2];
+	long ic, nb;
+	long iz, nx;
+	char subnam[6];
 
 	(void) opts;
 	(void) n3;
@@ -0,0 +1,105 @@
+/* NUMfft_batch.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+/*
+	Many real FFTs of the same size, two at a time.
+
+	The butterflies of NUMfft_core.h are compiled once more, now on a vector type
+	that holds the same sample of two different transforms (SSE2 on x86, NEON on ARM).
+	The twiddle factors stay scalar and come from the ordinary NUMfft_Table.
+	Every lane performs exactly the arithmetic of the scalar code,
+	so the results are identical to those of NUMfft_forward and NUMfft_backward,
+	but the two transforms take little more time than one.
+*/
+
+#include "NUM2.h"
+#include "melder.h"
+
+#define my me ->
+
+/*
+	Beyond this size, the interleaved work buffers (64 bytes per sample) no longer fit in the cache,
+	and two separate transforms are faster than one pair.
+*/
+#define NUMfft_MAXIMUM_PAIRED_SIZE  (1L << 19)
+
+static void NUMfft_singles (NUMfft_Table me, long numberOfTransforms, double *data [], bool forward) {
+	for (long itransform = 0; itransform < numberOfTransforms; itransform ++) {
+		if (forward)
+			NUMfft_forward (me, data [itransform]);
+		else
+			NUMfft_backward (me, data [itransform]);
+	}
+}
+
+#if defined (__GNUC__)
+	/*
+		aligned (8): the workspace comes from NUMvector, which guarantees the alignment of a double only.
+	*/
+	typedef double NUMfft_pair __attribute__ ((vector_size (16), aligned (8)));
+
+	#define FFT_DATA_TYPE NUMfft_pair
+	#define FFT_TWIDDLE_TYPE double
+	#define FFT_COMPUTE_TYPE NUMfft_pair
+	#define FFT_BUTTERFLIES_ONLY
+	#include "NUMfft_core.h"
+
+	static void NUMfft_pairs (NUMfft_Table me, long numberOfTransforms, double *data [], double *workspace, bool forward) {
+		long n = my n;
+		if (n > NUMfft_MAXIMUM_PAIRED_SIZE || my chirpSize > 0 || numberOfTransforms < 2) {
+			NUMfft_singles (me, numberOfTransforms, data, forward);
+			return;
+		}
+		NUMfft_pair *c = reinterpret_cast <NUMfft_pair *> (workspace), *ch = c + n;
+		long itransform = 0;
+		for (; itransform + 1 < numberOfTransforms; itransform += 2) {
+			double *x = data [itransform], *y = data [itransform + 1];
+			for (long i = 0; i < n; i ++) {
+				c [i] [0] = x [i + 1];
+				c [i] [1] = y [i + 1];
+			}
+			if (forward)
+				drftf1 (n, c, ch, my trigcache + n, my splitcache);
+			else
+				drftb1 (n, c, ch, my trigcache + n, my splitcache);
+			for (long i = 0; i < n; i ++) {
+				x [i + 1] = c [i] [0];
+				y [i + 1] = c [i] [1];
+			}
+		}
+		if (itransform < numberOfTransforms)
+			NUMfft_singles (me, 1, & data [itransform], forward);
+	}
+#else
+	static void NUMfft_pairs (NUMfft_Table me, long numberOfTransforms, double *data [], double * /* workspace */, bool forward) {
+		NUMfft_singles (me, numberOfTransforms, data, forward);
+	}
+#endif
+
+void NUMfft_forward_batch (NUMfft_Table me, long numberOfTransforms, double *data [], double *workspace) {
+	if (my n == 1) return;
+	NUMfft_pairs (me, numberOfTransforms, data, workspace, true);
+}
+
+void NUMfft_backward_batch (NUMfft_Table me, long numberOfTransforms, double *data [], double *workspace) {
+	if (my n == 1) return;
+	NUMfft_pairs (me, numberOfTransforms, data, workspace, false);
+}
+
+/* End of file NUMfft_batch.cpp */
@@ -27,7 +27,21 @@
    original fortran), these routines can work on arbitrary length vectors
    that need not be powers of two in length. */
 
-static void drfti1 (long n, FFT_DATA_TYPE * wa, long *ifac)
+/* The including file defines FFT_DATA_TYPE. It may also define
+   FFT_TWIDDLE_TYPE (the type of the precomputed sines and cosines; default FFT_DATA_TYPE)
+   and FFT_COMPUTE_TYPE (the type of the temporaries; default double),
+   e.g. to run the same butterflies on a vector type that holds several transforms.
+   If FFT_BUTTERFLIES_ONLY is defined, the twiddle initialization is left out. */
+#ifndef FFT_TWIDDLE_TYPE
+	#define FFT_TWIDDLE_TYPE FFT_DATA_TYPE
+#endif
+#ifndef FFT_COMPUTE_TYPE
+	#define FFT_COMPUTE_TYPE double
+#endif
+
+#ifndef FFT_BUTTERFLIES_ONLY   /* defined by including files that get their twiddles elsewhere */
+
+static void drfti1 (long n, FFT_TWIDDLE_TYPE * wa, long *ifac)
 {
 	static long ntryh[4] = { 4, 2, 3, 5 };
 	static double tpi = 6.28318530717958647692528676655900577;
@@ -108,7 +122,7 @@ static void drfti1 (long n, FFT_DATA_TYPE * wa, long *ifac)
 	}
 }
 
-static void NUMrffti (long n, FFT_DATA_TYPE * wsave, long *ifac)
+static void NUMrffti (long n, FFT_TWIDDLE_TYPE * wsave, long *ifac)
 {
 
 	if (n == 1)
@@ -116,6 +130,8 @@ static void NUMrffti (long n, FFT_DATA_TYPE * wsave, long *ifac)
 	drfti1 (n, wsave + n, ifac);
 }
 
+#endif
+
 /* void NUMcosqi(long n, FFT_DATA_TYPE *wsave, long *ifac){ static
    double pih = 1.57079632679489661923132169163975; static long k;
    static double fk, dt;
@@ -124,10 +140,10 @@ static void NUMrffti (long n, FFT_DATA_TYPE * wsave, long *ifac)
 
    NUMrffti(n, wsave+n,ifac); } */
 
-static void dradf2 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa1)
+static void dradf2 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_TWIDDLE_TYPE * wa1)
 {
 	long i, k;
-	double ti2, tr2;
+	FFT_COMPUTE_TYPE ti2, tr2;
 	long t0, t1, t2, t3, t4, t5, t6;
 
 	t1 = 0;
@@ -187,12 +203,12 @@ static void dradf2 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, F
 	}
 }
 
-static void dradf4 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa1,
-	FFT_DATA_TYPE * wa2, FFT_DATA_TYPE * wa3)
+static void dradf4 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_TWIDDLE_TYPE * wa1,
+	FFT_TWIDDLE_TYPE * wa2, FFT_TWIDDLE_TYPE * wa3)
 {
 	static double hsqt2 = .70710678118654752440084436210485;
 	long i, k, t0, t1, t2, t3, t4, t5, t6;
-	double ci2, ci3, ci4, cr2, cr3, cr4, ti1, ti2, ti3, ti4, tr1, tr2, tr3, tr4;
+	FFT_COMPUTE_TYPE ci2, ci3, ci4, cr2, cr3, cr4, ti1, ti2, ti3, ti4, tr1, tr2, tr3, tr4;
 
 	t0 = l1 * ido;
 
@@ -293,7 +309,7 @@ static void dradf4 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, F
 }
 
 static void dradfg (long ido, long ip, long l1, long idl1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * c1,
-	FFT_DATA_TYPE * c2, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * ch2, FFT_DATA_TYPE * wa)
+	FFT_DATA_TYPE * c2, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * ch2, FFT_TWIDDLE_TYPE * wa)
 {
 
 	static double tpi = 6.28318530717958647692528676655900577;
@@ -641,7 +657,7 @@ static void dradfg (long ido, long ip, long l1, long idl1, FFT_DATA_TYPE * cc, F
 	}
 }
 
-static void drftf1 (long n, FFT_DATA_TYPE * c, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa, long *ifac)
+static void drftf1 (long n, FFT_DATA_TYPE * c, FFT_DATA_TYPE * ch, FFT_TWIDDLE_TYPE * wa, long *ifac)
 {
 	long i, k1, l1, l2;
 	long na, kh, nf;
@@ -711,10 +727,10 @@ static void drftf1 (long n, FFT_DATA_TYPE * c, FFT_DATA_TYPE * ch, FFT_DATA_TYPE
 		c[i] = ch[i];
 }
 
-static void dradb2 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa1)
+static void dradb2 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_TWIDDLE_TYPE * wa1)
 {
 	long i, k, t0, t1, t2, t3, t4, t5, t6;
-	double ti2, tr2;
+	FFT_COMPUTE_TYPE ti2, tr2;
 
 	t0 = l1 * ido;
 
@@ -771,13 +787,13 @@ static void dradb2 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, F
 	}
 }
 
-static void dradb3 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa1,
-	FFT_DATA_TYPE * wa2)
+static void dradb3 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_TWIDDLE_TYPE * wa1,
+	FFT_TWIDDLE_TYPE * wa2)
 {
 	static double taur = -.5;
 	static double taui = .86602540378443864676372317075293618;
 	long i, k, t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10;
-	double ci2, ci3, di2, di3, cr2, cr3, dr2, dr3, ti2, tr2;
+	FFT_COMPUTE_TYPE ci2, ci3, di2, di3, cr2, cr3, dr2, dr3, ti2, tr2;
 
 	t0 = l1 * ido;
 
@@ -840,12 +856,12 @@ static void dradb3 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, F
 	}
 }
 
-static void dradb4 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa1,
-	FFT_DATA_TYPE * wa2, FFT_DATA_TYPE * wa3)
+static void dradb4 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_TWIDDLE_TYPE * wa1,
+	FFT_TWIDDLE_TYPE * wa2, FFT_TWIDDLE_TYPE * wa3)
 {
 	static double sqrt2 = 1.4142135623730950488016887242097;
 	long i, k, t0, t1, t2, t3, t4, t5, t6, t7, t8;
-	double ci2, ci3, ci4, cr2, cr3, cr4, ti1, ti2, ti3, ti4, tr1, tr2, tr3, tr4;
+	FFT_COMPUTE_TYPE ci2, ci3, ci4, cr2, cr3, cr4, ti1, ti2, ti3, ti4, tr1, tr2, tr3, tr4;
 
 	t0 = l1 * ido;
 
@@ -941,7 +957,7 @@ static void dradb4 (long ido, long l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, F
 }
 
 static void dradbg (long ido, long ip, long l1, long idl1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * c1,
-	FFT_DATA_TYPE * c2, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * ch2, FFT_DATA_TYPE * wa)
+	FFT_DATA_TYPE * c2, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * ch2, FFT_TWIDDLE_TYPE * wa)
 {
 	static double tpi = 6.28318530717958647692528676655900577;
 	long idij, ipph, i, j, k, l, ik, is, t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12;
@@ -1296,7 +1312,7 @@ static void dradbg (long ido, long ip, long l1, long idl1, FFT_DATA_TYPE * cc, F
 	}
 }
 
-static void drftb1 (long n, FFT_DATA_TYPE * c, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa, long *ifac)
+static void drftb1 (long n, FFT_DATA_TYPE * c, FFT_DATA_TYPE * ch, FFT_TWIDDLE_TYPE * wa, long *ifac)
 {
 	long i, k1, l1, l2;
 	long na;
@@ -24,6 +24,7 @@
 
 #include "NUM2.h"
 #include "melder.h"
+#include "MelderThread.h"
 
 #define my me ->
 
@@ -61,10 +62,102 @@ void NUMreverseRealFastFourierTransform (double *data, long n) {
 	NUMfft_backward (& table, data);
 }
 
+/*
+	Bluestein's algorithm. Since jk = (j^2 + k^2 - (k-j)^2) / 2, the forward transform
+		X [k] = sum over j of x [j] exp (-2 pi i j k / n)
+	can be written with the chirp w [j] = exp (pi i j^2 / n) as
+		X [k] = conj (w [k]) sum over j of (x [j] conj (w [j])) w [k-j],
+	i.e. as a convolution, which is computed with transforms of a size m >= 2n-1.
+	The backward transform is the same with w and conj (w) swapped.
+	The real and imaginary parts of the convolution each take a real transform of size m there and back;
+	the transforms of the chirp itself, divided by m, are computed once, in NUMfft_Table_init.
+	Layout of my chirp [0..2n+4m-1]: the real and imaginary parts of w [0..n-1],
+	the transforms of the real and imaginary parts of w [-(n-1)..n-1] wrapped around to m, and two buffers of m for the convolution.
+*/
+
+static void NUMfft_multiplyHalfcomplex (long m, double *a, double *b, const double *c, const double *d, double sign) {
+	/*
+		a + ib := (a + ib) * (c + i sign d), where a, b, c and d are transforms of real sequences
+		in the layout of drftf1: a real first element, then pairs of real and imaginary parts,
+		and (if m is even) a real last element.
+	*/
+	double a0 = a [0], b0 = b [0], c0 = c [0], d0 = sign * d [0];
+	a [0] = a0 * c0 - b0 * d0;
+	b [0] = a0 * d0 + b0 * c0;
+	long i = 1;
+	for (; i + 1 < m; i += 2) {
+		double ar = a [i], ai = a [i + 1], br = b [i], bi = b [i + 1];
+		double cr = c [i], ci = c [i + 1], dr = sign * d [i], di = sign * d [i + 1];
+		a [i] = (ar * cr - ai * ci) - (br * dr - bi * di);
+		a [i + 1] = (ar * ci + ai * cr) - (br * di + bi * dr);
+		b [i] = (ar * dr - ai * di) + (br * cr - bi * ci);
+		b [i + 1] = (ar * di + ai * dr) + (br * ci + bi * cr);
+	}
+	if (i < m) {
+		double am = a [i], bm = b [i], cm = c [i], dm = sign * d [i];
+		a [i] = am * cm - bm * dm;
+		b [i] = am * dm + bm * cm;
+	}
+}
+
+static void NUMfft_chirp (NUMfft_Table me, double *x, bool forward) {
+	long n = my n, m = my chirpSize;
+	double *wr = my chirp, *wi = wr + n, *fr = wi + n, *fi = fr + m, *a = fi + m, *b = a + m;
+	if (forward) {
+		for (long j = 0; j < n; j ++) {
+			a [j] = x [j] * wr [j];
+			b [j] = - x [j] * wi [j];
+		}
+	} else {
+		/*
+			The spectrum of a real signal is conjugate symmetric: X [n-k] = conj (X [k]).
+		*/
+		a [0] = x [0] * wr [0];
+		b [0] = x [0] * wi [0];
+		for (long k = 1; 2 * k < n; k ++) {
+			double re = x [2 * k - 1], im = x [2 * k];
+			a [k] = re * wr [k] - im * wi [k];
+			b [k] = re * wi [k] + im * wr [k];
+			a [n - k] = re * wr [n - k] + im * wi [n - k];
+			b [n - k] = re * wi [n - k] - im * wr [n - k];
+		}
+		if (n % 2 == 0) {
+			a [n / 2] = x [n - 1] * wr [n / 2];
+			b [n / 2] = x [n - 1] * wi [n / 2];
+		}
+	}
+	for (long j = n; j < m; j ++) {
+		a [j] = b [j] = 0.0;
+	}
+	drftf1 (m, a, my chirpTrigcache, my chirpTrigcache + m, my chirpSplitcache);
+	drftf1 (m, b, my chirpTrigcache, my chirpTrigcache + m, my chirpSplitcache);
+	NUMfft_multiplyHalfcomplex (m, a, b, fr, fi, forward ? 1.0 : -1.0);
+	drftb1 (m, a, my chirpTrigcache, my chirpTrigcache + m, my chirpSplitcache);
+	drftb1 (m, b, my chirpTrigcache, my chirpTrigcache + m, my chirpSplitcache);
+	if (forward) {
+		x [0] = a [0] * wr [0] + b [0] * wi [0];
+		for (long k = 1; 2 * k < n; k ++) {
+			x [2 * k - 1] = a [k] * wr [k] + b [k] * wi [k];
+			x [2 * k] = b [k] * wr [k] - a [k] * wi [k];
+		}
+		if (n % 2 == 0) {
+			x [n - 1] = a [n / 2] * wr [n / 2] + b [n / 2] * wi [n / 2];
+		}
+	} else {
+		for (long j = 0; j < n; j ++) {
+			x [j] = a [j] * wr [j] - b [j] * wi [j];
+		}
+	}
+}
+
 void NUMfft_forward (NUMfft_Table me, double *data) {
 	if (my n == 1) {
 		return;
 	}
+	if (my chirpSize > 0) {
+		NUMfft_chirp (me, &data[1], true);
+		return;
+	}
 	drftf1 (my n, &data[1], my trigcache, my trigcache + my n, my splitcache);
 }
 
@@ -72,14 +165,179 @@ void NUMfft_backward (NUMfft_Table me, double *data) {
 	if (my n == 1) {
 		return;
 	}
+	if (my chirpSize > 0) {
+		NUMfft_chirp (me, &data[1], false);
+		return;
+	}
 	drftb1 (my n, &data[1], my trigcache, my trigcache + my n, my splitcache);
 }
 
-void NUMfft_Table_init (NUMfft_Table me, long n) {
+/*
+	The twiddle factors and the factorization depend on n only, so analyses that create
+	many tables of the same size (spectrograms, pitch, spectra in scripts) need not recompute them:
+	a process-wide cache keeps the most recently computed sizes, and a new table gets a copy.
+	The first n elements of trigcache are scratch space for NUMfft_forward and NUMfft_backward,
+	so a table itself cannot be shared between threads; only its contents are cached.
+	Only sizes up to NUMfft_MAXIMUM_CACHED_SIZE are cached, so that the cache never holds more than
+	NUMfft_CACHE_SIZE * 2 * NUMfft_MAXIMUM_CACHED_SIZE doubles (16 MB);
+	the occasional transform of a whole long sound is computed without it.
+	The lock protects only the slots and the user counts; the copying is done outside it,
+	and an entry that is replaced while a thread is copying from it is deleted by the last of its users.
+*/
+#define NUMfft_CACHE_SIZE  16
+#define NUMfft_MAXIMUM_CACHED_SIZE  65536
+
+struct NUMfft_CacheEntry {
+	long n;
+	double *twiddles;   // [0..2*n-1]
+	long *factors;   // [0..31]
+	long numberOfUsers;
+	bool replaced;
+};
+static NUMfft_CacheEntry *theFftCache [NUMfft_CACHE_SIZE];
+static int theFftCacheNextSlot;
+static MelderThread_SpinLock theFftCacheLock;
+
+static void NUMfft_CacheEntry_delete (NUMfft_CacheEntry *entry) {
+	NUMvector_free (entry -> twiddles, 0);
+	NUMvector_free (entry -> factors, 0);
+	Melder_free (entry);
+}
+
+static void NUMfft_CacheEntry_release (NUMfft_CacheEntry *entry) {
+	bool lastUser;
+	{// scope
+		autoMelderThread_SpinLock lock (& theFftCacheLock);
+		entry -> numberOfUsers -= 1;
+		lastUser = entry -> replaced && entry -> numberOfUsers == 0;
+	}
+	if (lastUser)
+		NUMfft_CacheEntry_delete (entry);
+}
+
+static void NUMfft_Table_initDirect (NUMfft_Table me, long n) {
 	my n = n;
 	my trigcache = NUMvector <double> (0, 3 * n - 1);
 	my splitcache = NUMvector <long> (0, 31);
+	if (n > NUMfft_MAXIMUM_CACHED_SIZE) {
+		NUMrffti (n, my trigcache, my splitcache);
+		return;
+	}
+	NUMfft_CacheEntry *entry = NULL;
+	{// scope
+		autoMelderThread_SpinLock lock (& theFftCacheLock);
+		for (int islot = 0; islot < NUMfft_CACHE_SIZE; islot ++) {
+			if (theFftCache [islot] && theFftCache [islot] -> n == n) {
+				entry = theFftCache [islot];
+				entry -> numberOfUsers += 1;
+				break;
+			}
+		}
+	}
+	if (entry) {
+		NUMvector_copyElements (entry -> twiddles, my trigcache + n, 0, 2 * n - 1);
+		NUMvector_copyElements (entry -> factors, my splitcache, 0, 31);
+		NUMfft_CacheEntry_release (entry);
+		return;
+	}
 	NUMrffti (n, my trigcache, my splitcache);
+	/*
+		Remember the new size, replacing the oldest one.
+	*/
+	autoNUMvector <double> twiddles (0L, 2 * n - 1);
+	autoNUMvector <long> factors (0L, 31);
+	NUMvector_copyElements (my trigcache + n, twiddles.peek(), 0, 2 * n - 1);
+	NUMvector_copyElements (my splitcache, factors.peek(), 0, 31);
+	entry = Melder_calloc (NUMfft_CacheEntry, 1);
+	entry -> n = n;
+	entry -> twiddles = twiddles.transfer();
+	entry -> factors = factors.transfer();
+	NUMfft_CacheEntry *oldEntry;
+	{// scope
+		autoMelderThread_SpinLock lock (& theFftCacheLock);
+		int islot = theFftCacheNextSlot;
+		theFftCacheNextSlot = (theFftCacheNextSlot + 1) % NUMfft_CACHE_SIZE;
+		oldEntry = theFftCache [islot];
+		theFftCache [islot] = entry;
+		if (oldEntry && oldEntry -> numberOfUsers > 0) {
+			oldEntry -> replaced = true;   // its last user deletes it
+			oldEntry = NULL;
+		}
+	}
+	if (oldEntry)
+		NUMfft_CacheEntry_delete (oldEntry);
+}
+
+/*
+	The direct transform spends time proportional to n times the sum of the factors of n.
+	The chirp transform takes about as long as a direct transform of size m would if that sum were NUMfft_CHIRP_COST times larger
+	(measured for prime sizes from 61 to 100003), so only sizes with a large prime factor use the chirp.
+	The size m is a power of two, because the radices 3 and 5 have no fast forward butterflies.
+*/
+#define NUMfft_CHIRP_COST  1.5
+
+static long NUMfft_largestFactor (long n) {
+	for (long p = 2; p <= 5; p ++) {
+		while (n % p == 0 && n > p) n /= p;
+	}
+	return n;
+}
+
+static long NUMfft_chirpSize (long n) {
+	long m = 1;
+	while (m < 2 * n - 1) m *= 2;
+	return m;
+}
+
+static double NUMfft_cost (long n, long *factors) {
+	double sumOfFactors = 0.0;
+	for (long ifactor = 1; ifactor <= factors [1]; ifactor ++) {
+		sumOfFactors += factors [ifactor + 1];
+	}
+	return (double) n * sumOfFactors;
+}
+
+void NUMfft_Table_init (NUMfft_Table me, long n) {
+	NUMfft_Table_initDirect (me, n);
+	if (n < 2 || NUMfft_largestFactor (n) <= 5) return;
+	long m = NUMfft_chirpSize (n);
+	autoNUMfft_Table convolution;
+	NUMfft_Table_initDirect (& convolution, m);
+	if (NUMfft_cost (n, my splitcache) <= NUMfft_CHIRP_COST * NUMfft_cost (m, convolution.splitcache)) return;
+	autoNUMvector <double> chirp (0L, 2 * n + 4 * m - 1);
+	double *wr = chirp.peek(), *wi = wr + n, *fr = wi + n, *fi = fr + m;
+	/*
+		w [j] = exp (pi i j^2 / n), with j^2 reduced modulo 2n so that the angle stays small.
+	*/
+	for (long j = 0, jsquaredModulo2n = 0; j < n; j ++) {
+		double angle = NUMpi * jsquaredModulo2n / n;
+		wr [j] = cos (angle);
+		wi [j] = sin (angle);
+		jsquaredModulo2n += 2 * j + 1;
+		if (jsquaredModulo2n >= 2 * n) jsquaredModulo2n -= 2 * n;
+	}
+	/*
+		w [-j] = w [j], wrapped around to m, divided by m because drftb1 does not normalize.
+	*/
+	for (long j = 0; j < n; j ++) {
+		fr [j] = wr [j] / m;
+		fi [j] = wi [j] / m;
+	}
+	for (long j = n; j <= m - n; j ++) {
+		fr [j] = fi [j] = 0.0;
+	}
+	for (long j = 1; j < n; j ++) {
+		fr [m - j] = fr [j];
+		fi [m - j] = fi [j];
+	}
+	drftf1 (m, fr, convolution.trigcache, convolution.trigcache + m, convolution.splitcache);
+	drftf1 (m, fi, convolution.trigcache, convolution.trigcache + m, convolution.splitcache);
+	my chirpSize = m;
+	my chirp = chirp.transfer();
+	my chirpTrigcache = convolution.trigcache;
+	my chirpSplitcache = convolution.splitcache;
+	convolution.trigcache = NULL;
+	convolution.splitcache = NULL;
 }
 
 void NUMrealft (double *data, long n, int isign) {
@@ -47,9 +47,9 @@
 #include <errno.h>
 
 /*
-  Precondition: size (my buffer) >= nbuf
+  Precondition: size (samples) >= nbuf
 */
-static void _LongSound_to_multichannel_buffer (LongSound me, short *buffer, long nbuf,
+static void _LongSound_to_multichannel_buffer (LongSound me, short *samples, short *buffer, long nbuf,
         int nchannels, int ichannel, long ibuf) {
 	long numberOfReads = (my nx - 1) / nbuf + 1;
 	long n_to_read = 0;
@@ -57,10 +57,10 @@ static void _LongSound_to_multichannel_buffer (LongSound me, short *buffer, long
 	if (ibuf <= numberOfReads) {
 		n_to_read = ibuf == numberOfReads ? (my nx - 1) % nbuf + 1 : nbuf;
 		long imin = (ibuf - 1) * nbuf + 1;
-		LongSound_readAudioToShort (me, my buffer, imin, n_to_read);
+		LongSound_readAudioToShort (me, samples, imin, n_to_read);
 
 		for (long i = 1; i <= n_to_read; i++) {
-			buffer[nchannels * (i - 1) + ichannel] = my buffer[i];
+			buffer[nchannels * (i - 1) + ichannel] = samples[i - 1];
 		}
 	}
 	if (ibuf >= numberOfReads) {
@@ -93,14 +93,15 @@ void LongSounds_writeToStereoAudioFile16 (LongSound me, LongSound thee, int audi
 
 		long nchannels = 2;
 		autoNUMvector<short> buffer (1, nchannels * nbuf);
+		autoNUMvector<short> samples ((long) 0, nbuf - 1);
 
 		autoMelderFile f  = MelderFile_create (file);
 		MelderFile_writeAudioFileHeader (file, audioFileType, (long) floor (my sampleRate), nx, nchannels, numberOfBitsPerSamplePoint);
 
 		for (long i = 1; i <= numberOfReads; i++) {
 			long n_to_write = i == numberOfReads ? (nx - 1) % nbuf + 1 : nbuf;
-			_LongSound_to_multichannel_buffer (me, buffer.peek(), nbuf, nchannels, 1, i);
-			_LongSound_to_multichannel_buffer (thee, buffer.peek(), nbuf, nchannels, 2, i);
+			_LongSound_to_multichannel_buffer (me, samples.peek(), buffer.peek(), nbuf, nchannels, 1, i);
+			_LongSound_to_multichannel_buffer (thee, samples.peek(), buffer.peek(), nbuf, nchannels, 2, i);
 			MelderFile_writeShortToAudio (file, nchannels, Melder_defaultAudioFileEncoding (audioFileType,
                 numberOfBitsPerSamplePoint), buffer.peek(), n_to_write);
 		}
@@ -165,19 +166,15 @@ static void writePartToOpenFile16 (LongSound me, int audioFileType, long imin, l
 	long numberOfBuffers = (n - 1) / my nmax + 1, numberOfBitsPerSamplePoint = 16;
 	long numberOfSamplesInLastBuffer = (n - 1) % my nmax + 1;
 	if (file -> filePointer) {
+		autoNUMvector<short> buffer ((long) 0, my nmax * my numberOfChannels - 1);
 		for (long ibuffer = 1; ibuffer <= numberOfBuffers; ibuffer ++) {
 			long numberOfSamplesToCopy = ibuffer < numberOfBuffers ? my nmax : numberOfSamplesInLastBuffer;
-			LongSound_readAudioToShort (me, my buffer, offset, numberOfSamplesToCopy);
+			LongSound_readAudioToShort (me, buffer.peek(), offset, numberOfSamplesToCopy);
 			offset += numberOfSamplesToCopy;
 			MelderFile_writeShortToAudio (file, my numberOfChannels,
-			    Melder_defaultAudioFileEncoding (audioFileType, numberOfBitsPerSamplePoint), my buffer, numberOfSamplesToCopy);
+			    Melder_defaultAudioFileEncoding (audioFileType, numberOfBitsPerSamplePoint), buffer.peek(), numberOfSamplesToCopy);
 		}
 	}
-	/*
-	 * We "have" no samples any longer.
-	 */
-	my imin = 1;
-	my imax = 0;
 }
 
 void LongSounds_appendToExistingSoundFile (Collection me, MelderFile file) {
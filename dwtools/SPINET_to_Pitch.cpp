@@ -50,7 +50,7 @@ Pitch SPINET_to_Pitch (SPINET me, double harmonicFallOffSlope, double ceiling, i
 			Melder_throw (U"Ceiling is smaller than centre frequency of lowest filter.");
 		}
 
-		autoPitch thee = Pitch_create (my xmin, my xmax, my nx, my dx, my x1, ceiling, maxnCandidates);
+		autoPitch thee = Pitch_createPacked (my xmin, my xmax, my nx, my dx, my x1, ceiling, maxnCandidates);
 		autoNUMvector<double> power (1, my nx);
 		autoNUMvector<double> pitch (1, nFrequencyPoints);
 		autoNUMvector<double> sumspec (1, nFrequencyPoints);
@@ -101,7 +101,7 @@ Pitch Sound_to_Pitch_shs (Sound me, double timeStep, double minimumPitch,
 		Sampled_shortTermAnalysis (sound.peek(), windowDuration, timeStep, &numberOfFrames, &firstTime);
 		autoSound frame = Sound_createSimple (1, frameDuration, newSamplingFrequency);
 		autoSound hamming = Sound_createHamming (nx / newSamplingFrequency, newSamplingFrequency);
-		autoPitch thee = Pitch_create (my xmin, my xmax, numberOfFrames, timeStep, firstTime,
+		autoPitch thee = Pitch_createPacked (my xmin, my xmax, numberOfFrames, timeStep, firstTime,
 		                               ceiling, maxnCandidates);
 		autoNUMvector<double> cc (1, numberOfFrames);
 		autoNUMvector<double> specAmp (1, nfft2);
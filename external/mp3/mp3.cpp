@@ -35,10 +35,16 @@
  *
  * - If there is a Xing header, read it to get the number of frames.
  * - Otherwise *estimate* the number of frames.
- * - Keep a reasonably (?) sized table of "key" offsets.
- * - Scan all the headers and keep required offsets in the table.
+ * - Keep a table with the offset of every frame (8 bytes per frame, i.e. some
+ *   300 kilobytes per hour of sound), so that a seek has to decode no more than
+ *   the two frames before the requested sample.
+ * - Scan all the headers and keep their offsets in the table.
  * - After the scan, we also know the precise number of frames and samples.
  *
+ * Since the scan reads the whole file, the caller can save the table with
+ * mp3f_frame_offsets () and give it back to a later MP3_FILE for the same file
+ * with mp3f_set_frame_offsets (), instead of calling mp3f_analyze () again.
+ *
  * TODO: Find exactly what the encoder delay is.
  *       (see http://mp3decoders.mp3-tech.org/decoders_lame.html)
  * TODO: Compensate for end padding.
@@ -58,7 +64,7 @@ extern "C" {
 }
 
 #define MP3F_BUFFER_SIZE (8 * 1024)
-#define MP3F_MAX_LOCATIONS 1024
+#define MP3F_MIN_LOCATIONS 1024
 
 /*
  * MP3 encoders and decoders add a number of silent samples at the beginning.
@@ -93,9 +99,9 @@ struct _MP3_FILE
 	unsigned samples_per_frame;
 	MP3F_OFFSET samples;
 
-	MP3F_OFFSET locations[MP3F_MAX_LOCATIONS]; 
+	MP3F_OFFSET *locations;   /* one per frame */
 	unsigned num_locations;
-	unsigned frames_per_location;
+	unsigned max_locations;
 
 	unsigned delay;
 
@@ -119,6 +125,26 @@ static int mp3f_check_xing (MP3_FILE mp3f, struct mad_stream const *stream);
 static enum mad_flow mp3f_mad_scan_header (void *context, struct mad_header const *header);
 static enum mad_flow mp3f_mad_report_samples (void *context, struct mad_header const *header, struct mad_pcm *pcm);
 
+/*
+ * Makes room for at least `n` locations.
+ * Does not throw, because it is called from within libMAD.
+ */
+static int mp3f_reserve_locations (MP3_FILE mp3f, unsigned n)
+{
+	if (n <= mp3f -> max_locations)
+		return 1;
+	if (n < 2 * mp3f -> max_locations)
+		n = 2 * mp3f -> max_locations;
+	try {
+		mp3f -> locations = (MP3F_OFFSET *) Melder_realloc (mp3f -> locations, n * (int64) sizeof (MP3F_OFFSET));
+	} catch (MelderError) {
+		Melder_clearError ();
+		return 0;
+	}
+	mp3f -> max_locations = n;
+	return 1;
+}
+
 int mp3_recognize (int nread, const char *data)
 {
 	const unsigned char *bytes = (const unsigned char *)data;
@@ -156,6 +182,8 @@ MP3_FILE mp3f_new (void)
 
 void mp3f_delete (MP3_FILE mp3f)
 {
+	if (mp3f)
+		Melder_free (mp3f -> locations);
 	Melder_free (mp3f);
 }
 
@@ -177,7 +205,7 @@ int mp3f_analyze (MP3_FILE mp3f)
 	struct mad_decoder *decoder = & mp3f -> decoder;
 	int status;
 #ifdef MP3_DEBUG
-	unsigned estimate, last;
+	unsigned estimate;
 #endif /* MP3_DEBUG */
 
 	if (! mp3f || ! mp3f -> f)
@@ -192,6 +220,8 @@ int mp3f_analyze (MP3_FILE mp3f)
 	mp3f -> samples = 0;
 	mp3f -> samples_per_frame = 0;
 	mp3f -> num_locations = 0;
+	if (! mp3f_reserve_locations (mp3f, MP3F_MIN_LOCATIONS))
+		return 0;
 
 	/* Read first frames to get basic parameters and hopefully Xing */
 	mad_decoder_init (decoder, 
@@ -230,16 +260,13 @@ int mp3f_analyze (MP3_FILE mp3f)
 		MP3_DPRINTF (("Estimated frames: %lu\n", (unsigned long)mp3f -> frames));
 	}
 
-	/* Calculate how many frames can fit in a "location" */
-	if (mp3f -> frames <= MP3F_MAX_LOCATIONS)
-		mp3f -> frames_per_location = 1;
-	else
-		mp3f -> frames_per_location = (mp3f -> frames + MP3F_MAX_LOCATIONS - 1) / MP3F_MAX_LOCATIONS;
+	/*
+	 * Make room for all frames at once. If the estimate is too low (or absurdly high),
+	 * the scan grows the table as needed.
+	 */
+	(void) mp3f_reserve_locations (mp3f, mp3f -> frames + mp3f -> frames / 16 + 1);
 
-	MP3_DPRINTF (("MP3: Each location is %u frame(s) (%.3fs), each %u samples\n",
-				mp3f -> frames_per_location,
-				mp3f -> frames_per_location * mp3f -> samples_per_frame / (float)mp3f -> frequency,
-				mp3f -> samples_per_frame));
+	MP3_DPRINTF (("MP3: Each frame is %u samples\n", mp3f -> samples_per_frame));
 
 	/* Read all frames to get offsets*/
 #ifdef MP3_DEBUG
@@ -265,13 +292,9 @@ int mp3f_analyze (MP3_FILE mp3f)
 		       	mp3f -> frames,
 		       	estimate,
 			MP3_PERCENT (mp3f -> frames, estimate)));
-#ifdef MP3_DEBUG
-	last = mp3f -> frames - (mp3f -> frames_per_location * (mp3f -> num_locations - 1));
-	MP3_DPRINTF (("MP3F: Last location frames = %u (%+.2f%%) = %.3fs\n",
-				last,
-				MP3_PERCENT (mp3f -> frames_per_location, last),
-				last * mp3f -> samples_per_frame / (float)mp3f -> frequency));
-#endif /* MP3_DEBUG */
+
+	if (mp3f -> num_locations == 0)   // not a single usable frame
+		status = -1;
 
 if(status!=-1)   // ppgb 2015-01-17
 	mp3f_seek (mp3f, 0);
@@ -297,6 +320,40 @@ MP3F_OFFSET mp3f_samples (MP3_FILE mp3f)
 	return mp3f -> samples - mp3f -> delay;
 }
 
+unsigned mp3f_frames (MP3_FILE mp3f)
+{
+	return mp3f -> num_locations;
+}
+
+unsigned mp3f_samples_per_frame (MP3_FILE mp3f)
+{
+	return mp3f -> samples_per_frame;
+}
+
+const MP3F_OFFSET * mp3f_frame_offsets (MP3_FILE mp3f)
+{
+	return mp3f -> locations;
+}
+
+int mp3f_set_frame_offsets (MP3_FILE mp3f, unsigned channels, unsigned frequency,
+		unsigned samples_per_frame, unsigned frames, const MP3F_OFFSET *offsets)
+{
+	if (! mp3f || ! mp3f -> f || channels < 1 || channels > MP3F_MAX_CHANNELS ||
+			frequency == 0 || samples_per_frame == 0 || frames == 0)
+		return 0;
+	mp3f -> num_locations = 0;
+	if (! mp3f_reserve_locations (mp3f, frames))
+		return 0;
+	memcpy (mp3f -> locations, offsets, frames * sizeof (MP3F_OFFSET));
+	mp3f -> xing = 0;
+	mp3f -> channels = channels;
+	mp3f -> frequency = frequency;
+	mp3f -> samples_per_frame = samples_per_frame;
+	mp3f -> num_locations = mp3f -> frames = frames;
+	mp3f -> samples = (MP3F_OFFSET) frames * samples_per_frame;
+	return mp3f_seek (mp3f, 0);
+}
+
 void mp3f_set_callback (MP3_FILE mp3f,
 	       	MP3F_CALLBACK callback, void *context)
 {
@@ -311,7 +368,7 @@ int mp3f_seek (MP3_FILE mp3f, MP3F_OFFSET sample)
 	if (! mp3f || ! mp3f -> f)
 		return 0;
 
-	if (! mp3f -> frames_per_location)
+	if (! mp3f -> num_locations)
 		if (! mp3f_analyze (mp3f))
 			return 0;
 
@@ -324,12 +381,11 @@ int mp3f_seek (MP3_FILE mp3f, MP3F_OFFSET sample)
 		-- frame; 
 	if ( frame ) /* ...and the first frame it decodes is useless */
 		-- frame; 
-Melder_assert (mp3f -> frames_per_location > 0);
 Melder_assert (mp3f -> num_locations > 0);
-	location = frame / mp3f -> frames_per_location;
+	location = frame;
 	if (location >= mp3f -> num_locations)
 		location = mp3f -> num_locations - 1;
-	frame = location * mp3f -> frames_per_location;
+	frame = location;
 	base = frame * mp3f -> samples_per_frame;
 
 Melder_assert (location >= 0);
@@ -489,7 +545,8 @@ static enum mad_flow mp3f_mad_first_header(void *context, struct mad_header cons
 	mp3f -> frequency = header -> samplerate;
 	mp3f -> samples_per_frame = 32 * MAD_NSBSAMPLES (header);
 	/* Just in case there is no Xing header: */
-	mp3f -> locations [mp3f -> num_locations ++] = header -> offset;
+	if (mp3f -> num_locations < mp3f -> max_locations)
+		mp3f -> locations [mp3f -> num_locations ++] = header -> offset;
 
 	return MAD_FLOW_CONTINUE;
 }
@@ -526,10 +583,10 @@ static enum mad_flow mp3f_mad_scan_header(void *context, struct mad_header const
 	if (mp3f -> samples_per_frame != 32 * MAD_NSBSAMPLES (header))
 		return MAD_FLOW_BREAK;
 
-	/* Check whether to log this offset in the table */
-	if ((mp3f -> frames % mp3f -> frames_per_location) == 0 &&
-			mp3f -> num_locations < MP3F_MAX_LOCATIONS)
-		mp3f -> locations [mp3f -> num_locations ++] = header -> offset;
+	/* Log this offset in the table */
+	if (! mp3f_reserve_locations (mp3f, mp3f -> num_locations + 1))
+		return MAD_FLOW_BREAK;
+	mp3f -> locations [mp3f -> num_locations ++] = header -> offset;
 
 	/* Count this frame */
 	++ mp3f -> frames;
@@ -54,6 +54,18 @@ unsigned mp3f_channels (MP3_FILE mp3f);
 unsigned mp3f_frequency (MP3_FILE mp3f);
 MP3F_OFFSET mp3f_samples (MP3_FILE mp3f);
 
+/*
+ * The seek index that mp3f_analyze builds: the file offset of every frame.
+ * It can be saved and given to a later MP3_FILE for the same (unchanged) file,
+ * which then does not have to scan the whole file again.
+ * mp3f_set_frame_offsets replaces mp3f_analyze.
+ */
+unsigned mp3f_frames (MP3_FILE mp3f);
+unsigned mp3f_samples_per_frame (MP3_FILE mp3f);
+const MP3F_OFFSET * mp3f_frame_offsets (MP3_FILE mp3f);   /* [0 .. mp3f_frames - 1] */
+int mp3f_set_frame_offsets (MP3_FILE mp3f, unsigned channels, unsigned frequency,
+		unsigned samples_per_frame, unsigned frames, const MP3F_OFFSET *offsets);
+
 void mp3f_set_callback (MP3_FILE mp3f,
 		MP3F_CALLBACK callback, void *context);
 int mp3f_seek (MP3_FILE mp3f, MP3F_OFFSET sample);
@@ -44,13 +44,54 @@
 
 #include "LongSound.h"
 #include "Preferences.h"
+#include "MelderThread.h"
 #include "flac_FLAC_stream_decoder.h"
 #include "mp3.h"
+#if defined (_WIN32)
+	#include <io.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
 
 Thing_implement (LongSound, Sampled, 0);
 
 #define MARGIN  0.01
-#define USE_MEMMOVE  1
+
+/*
+	Reading ahead.
+	After every read, the stretch that follows it (or precedes it, if the reads go backwards)
+	is prepared: the operating system is asked to page in that part of a mapped file,
+	or a background thread decodes it from a compressed file.
+	The stretch is as long as the last read, but at least LongSound_READ_AHEAD_MINIMUM_DURATION.
+	The thread decodes in pieces of LongSound_READ_AHEAD_PIECE_DURATION,
+	which is therefore about the longest that a read has to wait before it can use the decoder itself.
+*/
+#define LongSound_READ_AHEAD_MINIMUM_DURATION  10.0
+#define LongSound_READ_AHEAD_PIECE_DURATION  0.5
+
+struct LongSound_Mapping {
+	const unsigned char *data;   // the whole file
+	size_t size;
+	#if defined (_WIN32)
+		HANDLE fileMapping;
+	#endif
+	long previousFirstSample;
+};
+
+struct LongSound_ReadAhead {
+	MelderThread_Monitor *monitor;   // protects everything below, except `interrupted`
+	MelderThread_Background *thread;
+	double **samples;   // [1..numberOfChannels][1..capacity]
+	double **rows;   // [1..numberOfChannels], scratch for the thread
+	long capacity;
+	long firstSample, lastSample;   // the contents of `samples`, which are complete if the thread is not busy; none if lastSample < firstSample
+	long requestedFirstSample, requestedLastSample;   // the next stretch for the thread; none if requestedLastSample < requestedFirstSample
+	long previousFirstSample;
+	bool busy, stopping;
+	std::atomic <bool> interrupted;
+};
 
 static long prefs_bufferLength;
 
@@ -67,6 +108,30 @@ void structLongSound :: v_destroy () {
 	 * That pointer is about to dangle, so kill the playback.
 	 */
 	MelderAudio_stopPlaying (MelderAudio_IMPLICIT);
+	if (readAhead) {
+		/*
+		 * The thread uses the decoder, so stop it first.
+		 */
+		MelderThread_Monitor_lock (readAhead -> monitor);
+		readAhead -> stopping = true;
+		readAhead -> interrupted = true;
+		MelderThread_Monitor_signalAll (readAhead -> monitor);
+		MelderThread_Monitor_unlock (readAhead -> monitor);
+		MelderThread_Background_join (readAhead -> thread);
+		MelderThread_Monitor_delete (readAhead -> monitor);
+		NUMmatrix_free <double> (readAhead -> samples, 1, 1);
+		NUMvector_free <double *> (readAhead -> rows, 1);
+		delete readAhead;
+	}
+	if (mapping) {
+		#if defined (_WIN32)
+			UnmapViewOfFile (mapping -> data);
+			CloseHandle (mapping -> fileMapping);
+		#else
+			munmap ((void *) mapping -> data, mapping -> size);
+		#endif
+		Melder_free (mapping);
+	}
 	if (mp3f)
 		mp3f_delete (mp3f);
 	if (flacDecoder) {
@@ -74,7 +139,7 @@ void structLongSound :: v_destroy () {
 		FLAC__stream_decoder_delete (flacDecoder);
 	}
 	else if (f) fclose (f);
-	NUMvector_free <short> (buffer, 0);
+	NUMmatrix_free <double> (buffer, 1, 1);
 	LongSound_Parent :: v_destroy ();
 }
 
@@ -96,6 +161,9 @@ void structLongSound :: v_info () {
 	MelderInfo_writeLine (U"Sampling frequency: ", sampleRate, U" Hz");
 	MelderInfo_writeLine (U"Size: ", nx, U" samples");
 	MelderInfo_writeLine (U"Start of sample data: ", startOfData, U" bytes from the start of the file");
+	MelderInfo_writeLine (U"Sample access: ", mapping ? U"mapped into memory" : flacDecoder || mp3f ? U"decoded, with read-ahead" : U"read from file");
+	if (mp3f)
+		MelderInfo_writeLine (U"Seek index: ", mp3f_frames (mp3f), U" MP3 frames");
 }
 
 static void _LongSound_FLAC_convertFloats (LongSound me, const FLAC__int32 * const samples[], long bitsPerSample, long numberOfSamples) {
@@ -197,6 +265,46 @@ static void _LongSound_MP3_convert (const MP3F_SAMPLE *channels[MP3F_MAX_CHANNEL
 	my compressedSamplesLeft -= numberOfSamples;
 }
 
+/*
+	Maps the whole file into memory, for reading the samples without system calls or copying.
+	Returns NULL if the file cannot be mapped (e.g. if it is larger than the address space);
+	the samples will then be read with fread ().
+*/
+static LongSound_Mapping * LongSound_Mapping_create (FILE *f) {
+	LongSound_Mapping *me = Melder_calloc (LongSound_Mapping, 1);
+	#if defined (_WIN32)
+		HANDLE file = (HANDLE) _get_osfhandle (_fileno (f));
+		LARGE_INTEGER fileSize;
+		if (file != INVALID_HANDLE_VALUE && GetFileSizeEx (file, & fileSize) &&
+			fileSize. QuadPart > 0 && (unsigned long long) fileSize. QuadPart <= SIZE_MAX)
+		{
+			my fileMapping = CreateFileMapping (file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (my fileMapping) {
+				my data = (const unsigned char *) MapViewOfFile (my fileMapping, FILE_MAP_READ, 0, 0, 0);
+				if (my data) {
+					my size = (size_t) fileSize. QuadPart;
+					return me;
+				}
+				CloseHandle (my fileMapping);
+			}
+		}
+	#else
+		struct stat fileStatus;
+		if (fstat (fileno (f), & fileStatus) == 0 &&
+			fileStatus. st_size > 0 && (unsigned long long) fileStatus. st_size <= SIZE_MAX)
+		{
+			void *data = mmap (NULL, (size_t) fileStatus. st_size, PROT_READ, MAP_SHARED, fileno (f), 0);
+			if (data != MAP_FAILED) {
+				my data = (const unsigned char *) data;
+				my size = (size_t) fileStatus. st_size;
+				return me;
+			}
+		}
+	#endif
+	Melder_free (me);
+	return NULL;
+}
+
 static void LongSound_init (LongSound me, MelderFile file) {
 	MelderFile_copy (file, & my file);
 	MelderFile_open (file);   // BUG: should be auto, but that requires an implemented .transfer()
@@ -213,9 +321,9 @@ static void LongSound_init (LongSound me, MelderFile file) {
 	my numberOfBytesPerSamplePoint = Melder_bytesPerSamplePoint (my encoding);
 	my bufferLength = prefs_bufferLength;
 	for (;;) {
-		my nmax = my bufferLength * my numberOfChannels * my sampleRate * (1 + 3 * MARGIN);
+		my nmax = my bufferLength * my sampleRate * (1 + 3 * MARGIN);   // per channel, because every channel has its own row
 		try {
-			my buffer = NUMvector <short> (0, my nmax * my numberOfChannels);
+			my buffer = NUMmatrix <double> (1, my numberOfChannels, 1, my nmax);
 			break;
 		} catch (MelderError) {
 			my bufferLength *= 0.5;   // try 30, 15, or 7.5 seconds
@@ -226,6 +334,10 @@ static void LongSound_init (LongSound me, MelderFile file) {
 	}
 	my imin = 1;
 	my imax = 0;
+	my mapping = NULL;
+	my readAhead = NULL;
+	if (my audioFileType != Melder_FLAC && my audioFileType != Melder_MP3)
+		my mapping = LongSound_Mapping_create (my f);
 	my flacDecoder = NULL;
 	if (my audioFileType == Melder_FLAC) {
 		my flacDecoder = FLAC__stream_decoder_new ();
@@ -236,8 +348,7 @@ static void LongSound_init (LongSound me, MelderFile file) {
 		my mp3f = mp3f_new ();
 		mp3f_set_file (my mp3f, my f);
 		mp3f_set_callback (my mp3f, _LongSound_MP3_convert, me);
-		if (! mp3f_analyze (my mp3f))
-			Melder_throw (U"Unable to analyze MP3 file.");
+		MelderFile_analyzeMp3 (file, my mp3f, true);   // from the seek index of an earlier open, or scanned and saved for the next open
 		Melder_warning (U"Time measurements in MP3 files can be off by several tens of milliseconds. "
 			U"Please convert to WAV file if you need time precision or annotation.");
 	}
@@ -247,6 +358,8 @@ void structLongSound :: v_copy (thou) {
 	thouart (LongSound);
 	thy f = NULL;
 	thy buffer = NULL;
+	thy mapping = NULL;
+	thy readAhead = NULL;
 	LongSound_init (thee, & file);
 }
 
@@ -260,56 +373,252 @@ LongSound LongSound_open (MelderFile file) {
 	}
 }
 
-static void _LongSound_FLAC_process (LongSound me, long firstSample, long numberOfSamples) {
-	my compressedSamplesLeft = numberOfSamples - 1;
-	if (! FLAC__stream_decoder_seek_absolute (my flacDecoder, firstSample))
-		Melder_throw (U"Cannot seek in FLAC file ", & my file, U".");
-	while (my compressedSamplesLeft > 0) {
-		if (FLAC__stream_decoder_get_state (my flacDecoder) == FLAC__STREAM_DECODER_END_OF_STREAM)
-			Melder_throw (U"FLAC file ", & my file, U" too short.");
-		if (! FLAC__stream_decoder_process_single (my flacDecoder))
-			Melder_throw (U"Error decoding FLAC file ", & my file, U".");
+/*
+	Decodes the samples firstSample .. firstSample + numberOfSamples - 1 of a FLAC or MP3 file
+	to where compressedFloats or compressedShorts point (according to compressedMode).
+	Returns NULL, or the start of an error message that should be completed with the file name.
+	Does not throw, because the read-ahead thread uses it as well.
+*/
+static const char32 * _LongSound_COMPRESSED_process (LongSound me, long firstSample, long numberOfSamples) {
+	if (my encoding == Melder_FLAC_COMPRESSION_16) {
+		my compressedSamplesLeft = numberOfSamples;   // before seeking, which already decodes the first frame
+		if (! FLAC__stream_decoder_seek_absolute (my flacDecoder, firstSample - 1))   // FLAC counts from 0
+			return U"Cannot seek in FLAC file ";
+		while (my compressedSamplesLeft > 0) {
+			if (FLAC__stream_decoder_get_state (my flacDecoder) == FLAC__STREAM_DECODER_END_OF_STREAM)
+				return U"Too few samples in FLAC file ";
+			if (! FLAC__stream_decoder_process_single (my flacDecoder))
+				return U"Error decoding FLAC file ";
+		}
+	} else {
+		if (! mp3f_seek (my mp3f, firstSample - 1))   // MP3 counts from 0
+			return U"Cannot seek in MP3 file ";
+		my compressedSamplesLeft = numberOfSamples;
+		if (! mp3f_read (my mp3f, numberOfSamples))
+			return U"Error decoding MP3 file ";
 	}
+	return NULL;
 }
 
-static void _LongSound_FILE_seekSample (LongSound me, long firstSample) {
-	if (fseek (my f, my startOfData + (firstSample - 1) * my numberOfChannels * my numberOfBytesPerSamplePoint, SEEK_SET))
-		Melder_throw (U"Cannot seek in file ", & my file, U".");
+static const char32 * _LongSound_COMPRESSED_decodeFloats (LongSound me, double **buffer, long firstSample, long numberOfSamples) {
+	my compressedMode = COMPRESSED_MODE_READ_FLOAT;
+	for (int ichan = 1; ichan <= my numberOfChannels && ichan <= 2; ichan ++)
+		my compressedFloats [ichan - 1] = & buffer [ichan] [1];
+	return _LongSound_COMPRESSED_process (me, firstSample, numberOfSamples);
 }
 
-static void _LongSound_FLAC_readAudioToShort (LongSound me, short *buffer, long firstSample, long numberOfSamples) {
-	my compressedMode = COMPRESSED_MODE_READ_SHORT;
-	my compressedShorts = buffer + 1;
-	_LongSound_FLAC_process (me, firstSample, numberOfSamples);
+static void _LongSound_COMPRESSED_readFloats (LongSound me, double **buffer, long firstSample, long numberOfSamples) {
+	if (const char32 *problem = _LongSound_COMPRESSED_decodeFloats (me, buffer, firstSample, numberOfSamples))
+		Melder_throw (problem, & my file, U".");
 }
 
-static void _LongSound_MP3_process (LongSound me, long firstSample, long numberOfSamples) {
-	if (! mp3f_seek (my mp3f, firstSample))
-		Melder_throw (U"Cannot seek in MP3 file ", & my file, U".");
-	my compressedSamplesLeft = numberOfSamples;
-	if (! mp3f_read (my mp3f, numberOfSamples))
-		Melder_throw (U"Error decoding MP3 file ", & my file, U".");
+static void LongSound_ReadAhead_threadMain (void *void_me) {
+	iam (LongSound);
+	LongSound_ReadAhead *thee = my readAhead;
+	long numberOfSamplesPerPiece = (long) ceil (LongSound_READ_AHEAD_PIECE_DURATION * my sampleRate);
+	MelderThread_Monitor_lock (thy monitor);
+	for (;;) {
+		while (! thy stopping && thy requestedLastSample < thy requestedFirstSample)
+			MelderThread_Monitor_wait (thy monitor);
+		if (thy stopping) break;
+		long firstSample = thy requestedFirstSample, lastSample = thy requestedLastSample;
+		thy requestedFirstSample = 1;
+		thy requestedLastSample = 0;
+		thy firstSample = firstSample;
+		thy lastSample = firstSample - 1;
+		thy busy = true;
+		MelderThread_Monitor_unlock (thy monitor);
+		for (long pieceStart = firstSample; pieceStart <= lastSample && ! thy interrupted; pieceStart += numberOfSamplesPerPiece) {
+			long numberOfSamples = lastSample - pieceStart + 1;
+			if (numberOfSamples > numberOfSamplesPerPiece) numberOfSamples = numberOfSamplesPerPiece;
+			for (int ichan = 1; ichan <= my numberOfChannels; ichan ++)
+				thy rows [ichan] = thy samples [ichan] + (pieceStart - firstSample);
+			if (_LongSound_COMPRESSED_decodeFloats (me, thy rows, pieceStart, numberOfSamples))
+				break;   // the reader will decode these samples itself, and report the problem
+			MelderThread_Monitor_lock (thy monitor);
+			thy lastSample = pieceStart + numberOfSamples - 1;
+			MelderThread_Monitor_unlock (thy monitor);
+		}
+		MelderThread_Monitor_lock (thy monitor);
+		thy busy = false;
+		MelderThread_Monitor_signalAll (thy monitor);
+	}
+	MelderThread_Monitor_unlock (thy monitor);
 }
 
-static void _LongSound_MP3_readAudioToShort (LongSound me, short *buffer, long firstSample, long numberOfSamples) {
-	my compressedMode = COMPRESSED_MODE_READ_SHORT;
-	my compressedShorts = buffer + 1;
-	_LongSound_MP3_process (me, firstSample, numberOfSamples - 1);
+/*
+	Starts the read-ahead thread, if it does not exist yet.
+	Returns NULL if there can be no reading ahead (no threads, or no memory for the samples);
+	the samples are then decoded when they are needed.
+*/
+static LongSound_ReadAhead * _LongSound_getReadAhead (LongSound me) {
+	if (my readAhead) return my readAhead;
+	LongSound_ReadAhead *thee = new LongSound_ReadAhead;
+	thy capacity = (long) ceil (my bufferLength * my sampleRate);
+	thy samples = NULL;
+	thy rows = NULL;
+	thy firstSample = 1, thy lastSample = 0;
+	thy requestedFirstSample = 1, thy requestedLastSample = 0;
+	thy previousFirstSample = 1;
+	thy busy = thy stopping = false;
+	thy interrupted = false;
+	try {
+		thy samples = NUMmatrix <double> (1, my numberOfChannels, 1, thy capacity);
+		thy rows = NUMvector <double *> (1, my numberOfChannels);
+	} catch (MelderError) {
+		Melder_clearError ();
+		NUMmatrix_free <double> (thy samples, 1, 1);
+		delete thee;
+		return NULL;
+	}
+	thy monitor = MelderThread_Monitor_create ();
+	my readAhead = thee;
+	thy thread = MelderThread_Background_start (LongSound_ReadAhead_threadMain, me);
+	if (! thy thread) {
+		my readAhead = NULL;
+		MelderThread_Monitor_delete (thy monitor);
+		NUMmatrix_free <double> (thy samples, 1, 1);
+		NUMvector_free <double *> (thy rows, 1);
+		delete thee;
+		return NULL;
+	}
+	return thee;
 }
 
-void LongSound_readAudioToFloat (LongSound me, double **buffer, long firstSample, long numberOfSamples) {
-	if (my encoding == Melder_FLAC_COMPRESSION_16) {
-		my compressedMode = COMPRESSED_MODE_READ_FLOAT;
-		for (int ichan = 1; ichan <= my numberOfChannels; ichan ++) {
-			my compressedFloats [ichan - 1] = & buffer [ichan] [1];
+/*
+	Makes the thread stop decoding (after the current piece), so that the caller can use the decoder.
+	Afterwards, samples firstSample .. lastSample are available without locking, until the next request.
+*/
+static void _LongSound_interruptReadAhead (LongSound me) {
+	LongSound_ReadAhead *thee = my readAhead;
+	if (! thee) return;
+	MelderThread_Monitor_lock (thy monitor);
+	thy requestedFirstSample = 1;
+	thy requestedLastSample = 0;
+	thy interrupted = true;
+	while (thy busy)
+		MelderThread_Monitor_wait (thy monitor);
+	thy interrupted = false;
+	MelderThread_Monitor_unlock (thy monitor);
+}
+
+/*
+	Which stretch to prepare after a read of firstSample .. lastSample.
+	Returns false if the stretch would be empty (the read reached the edge of the file).
+*/
+static bool _LongSound_getReadAheadStretch (LongSound me, long *previousFirstSample, long firstSample, long lastSample, long capacity,
+	long *out_first, long *out_last, bool *out_backwards)
+{
+	long numberOfSamples = lastSample - firstSample + 1;
+	long minimumNumberOfSamples = (long) ceil (LongSound_READ_AHEAD_MINIMUM_DURATION * my sampleRate);
+	if (numberOfSamples < minimumNumberOfSamples) numberOfSamples = minimumNumberOfSamples;
+	if (numberOfSamples > capacity) numberOfSamples = capacity;
+	bool backwards = *out_backwards = firstSample < *previousFirstSample;
+	*previousFirstSample = firstSample;
+	if (backwards) {
+		*out_last = firstSample - 1;
+		*out_first = firstSample - numberOfSamples;
+		if (*out_first < 1) *out_first = 1;
+	} else {
+		*out_first = lastSample + 1;
+		*out_last = lastSample + numberOfSamples;
+		if (*out_last > my nx) *out_last = my nx;
+	}
+	return *out_last >= *out_first;
+}
+
+static void _LongSound_requestReadAhead (LongSound me, long firstSample, long lastSample) {
+	LongSound_ReadAhead *thee = my readAhead;
+	long first, last;
+	bool backwards;
+	if (! _LongSound_getReadAheadStretch (me, & thy previousFirstSample, firstSample, lastSample, thy capacity, & first, & last, & backwards))
+		return;
+	/*
+	 * If at least the nearer half of the stretch is ready already, let the thread rest.
+	 */
+	long half = (last - first) / 2;
+	if (backwards ? thy firstSample <= last - half && thy lastSample >= last : thy firstSample <= first && thy lastSample >= first + half)
+		return;
+	MelderThread_Monitor_lock (thy monitor);
+	thy requestedFirstSample = first;
+	thy requestedLastSample = last;
+	MelderThread_Monitor_signalAll (thy monitor);
+	MelderThread_Monitor_unlock (thy monitor);
+}
+
+static void _LongSound_COMPRESSED_readAudioToFloat (LongSound me, double **buffer, long firstSample, long numberOfSamples) {
+	long lastSample = firstSample + numberOfSamples - 1;
+	LongSound_ReadAhead *thee = _LongSound_getReadAhead (me);
+	if (! thee) {
+		_LongSound_COMPRESSED_readFloats (me, buffer, firstSample, numberOfSamples);
+		return;
+	}
+	_LongSound_interruptReadAhead (me);
+	/*
+	 * Copy what the thread has decoded, and decode the rest on both sides.
+	 */
+	long firstReady = firstSample > thy firstSample ? firstSample : thy firstSample;
+	long lastReady = lastSample < thy lastSample ? lastSample : thy lastSample;
+	if (lastReady < firstReady) {
+		_LongSound_COMPRESSED_readFloats (me, buffer, firstSample, numberOfSamples);
+	} else {
+		for (int ichan = 1; ichan <= my numberOfChannels; ichan ++)
+			memcpy (& buffer [ichan] [firstReady - firstSample + 1], & thy samples [ichan] [firstReady - thy firstSample + 1],
+				(lastReady - firstReady + 1) * sizeof (double));
+		if (firstSample < firstReady)
+			_LongSound_COMPRESSED_readFloats (me, buffer, firstSample, firstReady - firstSample);
+		if (lastReady < lastSample) {
+			autoNUMvector <double *> rows (1, my numberOfChannels);
+			for (int ichan = 1; ichan <= my numberOfChannels; ichan ++)
+				rows [ichan] = buffer [ichan] + (lastReady - firstSample + 1);
+			_LongSound_COMPRESSED_readFloats (me, rows.peek(), lastReady + 1, lastSample - lastReady);
 		}
-		_LongSound_FLAC_process (me, firstSample, numberOfSamples);
-	} else if (my encoding == Melder_MPEG_COMPRESSION_16) {
-		my compressedMode = COMPRESSED_MODE_READ_FLOAT;
-		for (int ichan = 1; ichan <= my numberOfChannels; ichan ++) {
-			my compressedFloats [ichan - 1] = & buffer [ichan] [1];
+	}
+	_LongSound_requestReadAhead (me, firstSample, lastSample);
+}
+
+static void _LongSound_MAPPED_readAudioToFloat (LongSound me, double **buffer, long firstSample, long numberOfSamples) {
+	LongSound_Mapping *mapping = my mapping;
+	size_t numberOfBytesPerFrame = (size_t) my numberOfChannels * my numberOfBytesPerSamplePoint;
+	size_t offset = my startOfData + (size_t) (firstSample - 1) * numberOfBytesPerFrame;
+	long numberOfSamplesInFile = offset >= mapping -> size ? 0 : (long) ((mapping -> size - offset) / numberOfBytesPerFrame);
+	long numberOfSamplesToDecode = numberOfSamples < numberOfSamplesInFile ? numberOfSamples : numberOfSamplesInFile;
+	Melder_decodeAudioToFloat (mapping -> data + offset, my numberOfChannels, my encoding, buffer, numberOfSamplesToDecode);
+	if (numberOfSamplesToDecode < numberOfSamples) {
+		for (int ichan = 1; ichan <= my numberOfChannels; ichan ++)
+			for (long isamp = numberOfSamplesToDecode + 1; isamp <= numberOfSamples; isamp ++)
+				buffer [ichan] [isamp] = 0.0;
+		Melder_warning (U"File too small (", my numberOfChannels, U"-channel ", 8 * my numberOfBytesPerSamplePoint, U"-bit).\n"
+			U"Missing samples set to zero.");
+	}
+	/*
+	 * Ask the system to page in the next stretch, so that the next read does not have to wait for the disk.
+	 */
+	#if ! defined (_WIN32)
+		long first, last;
+		bool backwards;
+		if (_LongSound_getReadAheadStretch (me, & mapping -> previousFirstSample, firstSample, firstSample + numberOfSamples - 1, my nmax, & first, & last, & backwards)) {
+			size_t pageSize = (size_t) sysconf (_SC_PAGESIZE);
+			size_t firstByte = my startOfData + (size_t) (first - 1) * numberOfBytesPerFrame;
+			size_t endByte = my startOfData + (size_t) last * numberOfBytesPerFrame;
+			if (endByte > mapping -> size) endByte = mapping -> size;
+			firstByte -= firstByte % pageSize;
+			if (endByte > firstByte)
+				(void) madvise ((void *) (mapping -> data + firstByte), endByte - firstByte, MADV_WILLNEED);
 		}
-		_LongSound_MP3_process (me, firstSample, numberOfSamples);
+	#endif
+}
+
+static void _LongSound_FILE_seekSample (LongSound me, long firstSample) {
+	if (fseek (my f, my startOfData + (firstSample - 1) * my numberOfChannels * my numberOfBytesPerSamplePoint, SEEK_SET))
+		Melder_throw (U"Cannot seek in file ", & my file, U".");
+}
+
+void LongSound_readAudioToFloat (LongSound me, double **buffer, long firstSample, long numberOfSamples) {
+	if (my encoding == Melder_FLAC_COMPRESSION_16 || my encoding == Melder_MPEG_COMPRESSION_16) {
+		_LongSound_COMPRESSED_readAudioToFloat (me, buffer, firstSample, numberOfSamples);
+	} else if (my mapping) {
+		_LongSound_MAPPED_readAudioToFloat (me, buffer, firstSample, numberOfSamples);
 	} else {
 		_LongSound_FILE_seekSample (me, firstSample);
 		Melder_readAudioToFloat (my f, my numberOfChannels, my encoding, buffer, numberOfSamples);
@@ -317,10 +626,12 @@ void LongSound_readAudioToFloat (LongSound me, double **buffer, long firstSample
 }
 
 void LongSound_readAudioToShort (LongSound me, short *buffer, long firstSample, long numberOfSamples) {
-	if (my encoding == Melder_FLAC_COMPRESSION_16) {
-		_LongSound_FLAC_readAudioToShort (me, buffer, firstSample, numberOfSamples);
-	} else if (my encoding == Melder_MPEG_COMPRESSION_16) {
-		_LongSound_MP3_readAudioToShort (me, buffer, firstSample, numberOfSamples);
+	if (my encoding == Melder_FLAC_COMPRESSION_16 || my encoding == Melder_MPEG_COMPRESSION_16) {
+		_LongSound_interruptReadAhead (me);
+		my compressedMode = COMPRESSED_MODE_READ_SHORT;
+		my compressedShorts = buffer;
+		if (const char32 *problem = _LongSound_COMPRESSED_process (me, firstSample, numberOfSamples))
+			Melder_throw (problem, & my file, U".");
 	} else {
 		_LongSound_FILE_seekSample (me, firstSample);
 		Melder_readAudioToShort (my f, my numberOfChannels, my encoding, buffer, numberOfSamples);
@@ -344,10 +655,19 @@ Sound LongSound_extractPart (LongSound me, double tmin, double tmax, int preserv
 	}
 }
 
-static void _LongSound_readSamples (LongSound me, short *buffer, long imin, long imax) {
-	LongSound_readAudioToShort (me, buffer, imin, imax - imin + 1);
+/*
+	Reads the samples imin..imax into my buffer, starting at my buffer [channel] [offset + 1].
+*/
+static void _LongSound_readSamples (LongSound me, long offset, long imin, long imax) {
+	autoNUMvector <double *> rows (1, my numberOfChannels);
+	for (int ichan = 1; ichan <= my numberOfChannels; ichan ++)
+		rows [ichan] = my buffer [ichan] + offset;
+	LongSound_readAudioToFloat (me, rows.peek(), imin, imax - imin + 1);
 }
 
+/*
+	numberOfChannels_override: 0 = all channels, -1 = only the left channel, -2 = only the right channel.
+*/
 static void writePartToOpenFile (LongSound me, int audioFileType, long imin, long n, MelderFile file, int numberOfChannels_override, int numberOfBitsPerSamplePoint) {
 	long ibuffer, offset, numberOfBuffers, numberOfSamplesInLastBuffer;
 	offset = imin;
@@ -355,9 +675,14 @@ static void writePartToOpenFile (LongSound me, int audioFileType, long imin, lon
 	numberOfSamplesInLastBuffer = (n - 1) % my nmax + 1;
 	if (file -> filePointer) for (ibuffer = 1; ibuffer <= numberOfBuffers; ibuffer ++) {
 		long numberOfSamplesToCopy = ibuffer < numberOfBuffers ? my nmax : numberOfSamplesInLastBuffer;
-		LongSound_readAudioToShort (me, my buffer, offset, numberOfSamplesToCopy);
+		LongSound_readAudioToFloat (me, my buffer, offset, numberOfSamplesToCopy);
 		offset += numberOfSamplesToCopy;
-		MelderFile_writeShortToAudio (file, numberOfChannels_override ? numberOfChannels_override : my numberOfChannels, Melder_defaultAudioFileEncoding (audioFileType, numberOfBitsPerSamplePoint), my buffer, numberOfSamplesToCopy);
+		if (numberOfChannels_override < 0)
+			MelderFile_writeFloatToAudio (file, 1, Melder_defaultAudioFileEncoding (audioFileType, numberOfBitsPerSamplePoint),
+				my buffer + (- numberOfChannels_override - 1), numberOfSamplesToCopy, false);
+		else
+			MelderFile_writeFloatToAudio (file, my numberOfChannels, Melder_defaultAudioFileEncoding (audioFileType, numberOfBitsPerSamplePoint),
+				my buffer, numberOfSamplesToCopy, false);
 	}
 	/*
 	 * We "have" no samples any longer.
@@ -400,6 +725,14 @@ void LongSound_writeChannelToAudioFile (LongSound me, int audioFileType, int cha
 	}
 }
 
+/*
+	Moves numberOfSamples samples of each channel of my buffer from offset `from` to offset `to`.
+*/
+static void _LongSound_shiftBuffer (LongSound me, long from, long to, long numberOfSamples) {
+	for (int ichan = 1; ichan <= my numberOfChannels; ichan ++)
+		memmove (& my buffer [ichan] [to + 1], & my buffer [ichan] [from + 1], numberOfSamples * sizeof (double));
+}
+
 static void _LongSound_haveSamples (LongSound me, long imin, long imax) {
 	long n = imax - imin + 1;
 	Melder_assert (n <= my nmax);
@@ -411,7 +744,7 @@ static void _LongSound_haveSamples (LongSound me, long imin, long imax) {
 	 * Extendable?
 	 */
 	if (imin >= my imin && imax - my imin + 1 <= my nmax) {
-		_LongSound_readSamples (me, my buffer + (my imax - my imin + 1) * my numberOfChannels, my imax + 1, imax);
+		_LongSound_readSamples (me, my imax - my imin + 1, my imax + 1, imax);
 		my imax = imax;
 		return;
 	}
@@ -433,7 +766,7 @@ static void _LongSound_haveSamples (LongSound me, long imin, long imax) {
 		/*
 		 * No overlap.
 		 */
-		_LongSound_readSamples (me, my buffer, imin, imax);
+		_LongSound_readSamples (me, 0, imin, imax);
 	} else if (imin < my imin) {
 		/*
 		 * Left overlap.
@@ -442,40 +775,22 @@ static void _LongSound_haveSamples (LongSound me, long imin, long imax) {
 			/*
 			 * Only left overlap (e.g. scrolling up).
 			 */
-			long nshift = (imax - my imin + 1) * my numberOfChannels, shift = (my imin - imin) * my numberOfChannels;
-			#if USE_MEMMOVE
-				memmove (my buffer + shift, my buffer, nshift * sizeof (short));
-			#else
-				for (i = nshift - 1; i >= 0; i --)
-					my buffer [i + shift] = my buffer [i];
-			#endif
-			_LongSound_readSamples (me, my buffer, imin, my imin - 1);
+			_LongSound_shiftBuffer (me, 0, my imin - imin, imax - my imin + 1);
+			_LongSound_readSamples (me, 0, imin, my imin - 1);
 		} else {
 			/*
 			 * Left and right overlap (e.g. zooming out).
 			 */
-			long nshift = (my imax - my imin + 1) * my numberOfChannels, shift = (my imin - imin) * my numberOfChannels;
-			#if USE_MEMMOVE
-				memmove (my buffer + shift, my buffer, nshift * sizeof (short));
-			#else
-				for (i = nshift - 1; i >= 0; i --)
-					my buffer [i + shift] = my buffer [i];
-			#endif
-			_LongSound_readSamples (me, my buffer, imin, my imin - 1);
-			_LongSound_readSamples (me, my buffer + (my imax - imin + 1) * my numberOfChannels, my imax + 1, imax);
+			_LongSound_shiftBuffer (me, 0, my imin - imin, my imax - my imin + 1);
+			_LongSound_readSamples (me, 0, imin, my imin - 1);
+			_LongSound_readSamples (me, my imax - imin + 1, my imax + 1, imax);
 		}
 	} else {
 		/*
 		 * Only right overlap (e.g. scrolling down).
 		 */
-		long nshift = (my imax - imin + 1) * my numberOfChannels, shift = (imin - my imin) * my numberOfChannels;
-		#if USE_MEMMOVE
-			memmove (my buffer, my buffer + shift, nshift * sizeof (short));
-		#else
-			for (i = 0; i < nshift; i ++)
-				my buffer [i] = my buffer [i + shift];
-		#endif
-		_LongSound_readSamples (me, my buffer + (my imax - imin + 1) * my numberOfChannels, my imax + 1, imax);
+		_LongSound_shiftBuffer (me, imin - my imin, 0, my imax - imin + 1);
+		_LongSound_readSamples (me, my imax - imin + 1, my imax + 1, imax);
 	}
 	my imin = imin, my imax = imax;
 }
@@ -490,7 +805,6 @@ bool LongSound_haveWindow (LongSound me, double tmin, double tmax) {
 
 void LongSound_getWindowExtrema (LongSound me, double tmin, double tmax, int channel, double *minimum, double *maximum) {
 	long imin, imax;
-	long i, minimum_int = 32767, maximum_int = -32768;
 	(void) Sampled_getWindowSamples (me, tmin, tmax, & imin, & imax);
 	*minimum = 1.0;
 	*maximum = -1.0;
@@ -500,13 +814,18 @@ void LongSound_getWindowExtrema (LongSound me, double tmin, double tmax, int cha
 		Melder_clearError ();
 		return;
 	}
-	for (i = imin; i <= imax; i ++) {
-		long value = my buffer [(i - my imin) * my numberOfChannels + channel - 1];
-		if (value < minimum_int) minimum_int = value;
-		if (value > maximum_int) maximum_int = value;
+	double *samples = my buffer [channel] + 1 - my imin;   // samples [imin..imax]
+	if (imax >= imin) *minimum = *maximum = samples [imin];
+	for (long i = imin + 1; i <= imax; i ++) {
+		double value = samples [i];
+		if (value < *minimum) *minimum = value;
+		if (value > *maximum) *maximum = value;
 	}
-	*minimum = minimum_int / 32768.0;
-	*maximum = maximum_int / 32768.0;
+}
+
+static short _LongSound_toShort (double value) {
+	value = round (value * 32768.0);
+	return value < -32768.0 ? -32768 : value > 32767.0 ? 32767 : (short) value;
 }
 
 static struct LongSoundPlay {
@@ -560,23 +879,20 @@ void LongSound_playPart (LongSound me, double tmin, double tmax,
 			thy silenceBefore = (long) (my sampleRate * MelderAudio_getOutputSilenceBefore ());
 			thy silenceAfter = (long) (my sampleRate * MelderAudio_getOutputSilenceAfter ());
 			if (thy callback) thy callback (thy closure, 1, tmin, tmax, tmin);
-			if (thy silenceBefore > 0 || thy silenceAfter > 0 || 1) {
-				thy resampledBuffer = Melder_calloc (short, (thy silenceBefore + thy numberOfSamples + thy silenceAfter) * my numberOfChannels);
-				memcpy (& thy resampledBuffer [thy silenceBefore * my numberOfChannels], & my buffer [(i1 - my imin) * my numberOfChannels],
-					thy numberOfSamples * sizeof (short) * my numberOfChannels);
-				MelderAudio_play16 (thy resampledBuffer, my sampleRate, thy silenceBefore + thy numberOfSamples + thy silenceAfter,
-					my numberOfChannels, melderPlayCallback, thee);
-			} else {
-				MelderAudio_play16 (my buffer + (i1 - my imin) * my numberOfChannels, my sampleRate,
-				   thy numberOfSamples, my numberOfChannels, melderPlayCallback, thee);
-			}
+			thy resampledBuffer = Melder_calloc (short, (thy silenceBefore + thy numberOfSamples + thy silenceAfter) * my numberOfChannels);
+			short *to = & thy resampledBuffer [thy silenceBefore * my numberOfChannels];
+			for (long i = 0; i < thy numberOfSamples; i ++)
+				for (int ichan = 1; ichan <= my numberOfChannels; ichan ++)
+					* to ++ = _LongSound_toShort (my buffer [ichan] [i1 - my imin + 1 + i]);
+			MelderAudio_play16 (thy resampledBuffer, my sampleRate, thy silenceBefore + thy numberOfSamples + thy silenceAfter,
+				my numberOfChannels, melderPlayCallback, thee);
 		} else {
 			long newSampleRate = bestSampleRate;
 			long newN = ((double) n * newSampleRate) / my sampleRate - 1, i;
 			long silenceBefore = (long) (newSampleRate * MelderAudio_getOutputSilenceBefore ());
 			long silenceAfter = (long) (newSampleRate * MelderAudio_getOutputSilenceAfter ());
 			short *resampledBuffer = Melder_calloc (short, (silenceBefore + newN + silenceAfter) * my numberOfChannels);
-			short *from = my buffer + (i1 - my imin) * my numberOfChannels;   /* Guaranteed: from [0 .. (my imax - my imin + 1) * nchan] */
+			long from = i1 - my imin + 1;   // my buffer [channel] [from ..] are the samples i1 ..
 			double t1 = my x1, dt = 1.0 / newSampleRate;
 			thy numberOfSamples = newN;
 			thy dt = dt;
@@ -586,34 +902,15 @@ void LongSound_playPart (LongSound me, double tmin, double tmax,
 			thy silenceBefore = silenceBefore;
 			thy silenceAfter = silenceAfter;
 			thy resampledBuffer = resampledBuffer;
-			if (my numberOfChannels == 1) {
-				for (i = 0; i < newN; i ++) {
-					double t = t1 + i * dt;   /* From t1 to t1 + (newN-1) * dt */
-					double index = (t - t1) * my sampleRate;   /* From 0. */
-					long flore = index;   /* DANGEROUS: Implicitly rounding down... */
-					double fraction = index - flore;
-					resampledBuffer [i + silenceBefore] = (1 - fraction) * from [flore] + fraction * from [flore + 1];
-				}
-			} else if (my numberOfChannels == 2) {
-				for (i = 0; i < newN; i ++) {
-					double t = t1 + i * dt;
-					double index = (t - t1) * newSampleRate;
-					long flore = index;
-					double fraction = index - flore;
-					long ii = i + silenceBefore;
-					resampledBuffer [ii + ii] = (1 - fraction) * from [flore + flore] + fraction * from [flore + flore + 2];
-					resampledBuffer [ii + ii + 1] = (1 - fraction) * from [flore + flore + 1] + fraction * from [flore + flore + 3];
-				}
-			} else {
-				for (i = 0; i < newN; i ++) {
-					double t = t1 + i * dt;
-					double index = (t - t1) * newSampleRate;
-					long flore = index;
-					double fraction = index - flore;
-					long ii = (i + silenceBefore) * my numberOfChannels;
-					for (long chan = 0; chan < my numberOfChannels; chan ++) {
-						resampledBuffer [ii + chan] = (1 - fraction) * from [flore + flore + chan] + fraction * from [flore + flore + chan + my numberOfChannels];
-					}
+			for (i = 0; i < newN; i ++) {
+				double t = t1 + i * dt;   /* From t1 to t1 + (newN-1) * dt */
+				double index = (t - t1) * my sampleRate;   /* From 0. */
+				long flore = index;   /* DANGEROUS: Implicitly rounding down... */
+				double fraction = index - flore;
+				short *to = & resampledBuffer [(i + silenceBefore) * my numberOfChannels];
+				for (int ichan = 1; ichan <= my numberOfChannels; ichan ++) {
+					double *samples = & my buffer [ichan] [from + flore];
+					to [ichan - 1] = _LongSound_toShort ((1 - fraction) * samples [0] + fraction * samples [1]);
 				}
 			}
 			if (thy callback) thy callback (thy closure, 1, tmin, tmax, tmin);
@@ -28,6 +28,8 @@
 struct FLAC__StreamDecoder;
 struct FLAC__StreamEncoder;
 struct _MP3_FILE;
+struct LongSound_Mapping;
+struct LongSound_ReadAhead;
 
 Thing_define (LongSound, Sampled) {
 	structMelderFile file;
@@ -36,7 +38,7 @@ Thing_define (LongSound, Sampled) {
 	double sampleRate;
 	long startOfData;
 	double bufferLength;
-	short *buffer;
+	double **buffer;   // [1..numberOfChannels][1..nmax]: the samples imin..imax
 	long imin, imax, nmax;
 	struct FLAC__StreamDecoder *flacDecoder;
 	struct _MP3_FILE *mp3f;
@@ -44,6 +46,8 @@ Thing_define (LongSound, Sampled) {
 	long compressedSamplesLeft;
 	double *compressedFloats [2];
 	short *compressedShorts;
+	struct LongSound_Mapping *mapping;   // the whole file in memory, for uncompressed files; NULL if the file could not be mapped
+	struct LongSound_ReadAhead *readAhead;   // the decoding thread, for compressed files; NULL until the first read
 
 	void v_destroy ()
 		override;
@@ -64,6 +68,7 @@ Sound LongSound_extractPart (LongSound me, double tmin, double tmax, int preserv
 bool LongSound_haveWindow (LongSound me, double tmin, double tmax);
 /*
  * Returns 0 if error or if window exceeds buffer, otherwise 1;
+ * after a 1, my buffer [channel] [i - my imin + 1] is sample i, for all i in the window.
  */
 
 void LongSound_getWindowExtrema (LongSound me, double tmin, double tmax, int channel, double *minimum, double *maximum);
@@ -75,6 +80,13 @@ void LongSound_writePartToAudioFile (LongSound me, int audioFileType, double tmi
 void LongSound_writeChannelToAudioFile (LongSound me, int audioFileType, int channel, MelderFile file);
 
 void LongSound_readAudioToFloat (LongSound me, double **buffer, long firstSample, long numberOfSamples);
+/*
+ * Reads the samples firstSample .. firstSample + numberOfSamples - 1 into buffer [channel] [1..numberOfSamples].
+ * Uncompressed files are decoded straight from memory, if the file could be mapped.
+ * For compressed files (FLAC, MP3), a background thread decodes the stretch that follows
+ * (or, when reading backwards, precedes) the last stretch that was read,
+ * so that sequential reading and scrolling do not have to wait for the decoder.
+ */
 void LongSound_readAudioToShort (LongSound me, short *buffer, long firstSample, long numberOfSamples);
 
 void LongSound_concatenate (Collection collection, MelderFile file, int audioFileType, int numberOfBitsPerSamplePoint);
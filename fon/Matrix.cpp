@@ -628,15 +628,9 @@ void Matrix_writeToHeaderlessSpreadsheetFile (Matrix me, MelderFile file) {
 
 void Matrix_formula (Matrix me, const char32 *expression, Interpreter interpreter, Matrix target) {
 	try {
-		struct Formula_Result result;
 		Formula_compile (interpreter, me, expression, kFormula_EXPRESSION_TYPE_NUMERIC, TRUE);
 		if (target == NULL) target = me;
-		for (long irow = 1; irow <= my ny; irow ++) {
-			for (long icol = 1; icol <= my nx; icol ++) {
-				Formula_run (irow, icol, & result);
-				target -> z [irow] [icol] = result. result.numericResult;
-			}
-		}
+		Formula_runRows (1, my ny, 1, my nx, target -> z);
 	} catch (MelderError) {
 		Melder_throw (me, U": formula not completed.");
 	}
@@ -651,15 +645,9 @@ void Matrix_formula_part (Matrix me, double xmin, double xmax, double ymin, doub
 		long ixmin, ixmax, iymin, iymax;
 		(void) Matrix_getWindowSamplesX (me, xmin, xmax, & ixmin, & ixmax);
 		(void) Matrix_getWindowSamplesY (me, ymin, ymax, & iymin, & iymax);
-		struct Formula_Result result;
 		Formula_compile (interpreter, me, expression, kFormula_EXPRESSION_TYPE_NUMERIC, TRUE);
 		if (target == NULL) target = me;
-		for (long irow = iymin; irow <= iymax; irow ++) {
-			for (long icol = ixmin; icol <= ixmax; icol ++) {
-				Formula_run (irow, icol, & result);
-				target -> z [irow] [icol] = result. result.numericResult;
-			}
-		}
+		Formula_runRows (iymin, iymax, ixmin, ixmax, target -> z);
 	} catch (MelderError) {
 		Melder_throw (me, U": formula not completed.");
 	}
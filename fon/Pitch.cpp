@@ -379,6 +379,14 @@ void structPitch :: v_info () {
 }
 
 void Pitch_Frame_init (Pitch_Frame me, int nCandidates) {
+	if (nCandidates <= my packedCapacity) {
+		for (long icand = 1; icand <= nCandidates; icand ++) {
+			my candidate [icand]. frequency = 0.0;
+			my candidate [icand]. strength = 0.0;
+		}
+		my nCandidates = nCandidates;
+		return;
+	}
 	/*
 	 * Create without change.
 	 */
@@ -386,11 +394,36 @@ void Pitch_Frame_init (Pitch_Frame me, int nCandidates) {
 	/*
 	 * Change without error.
 	 */
-	NUMvector_free (my candidate, 1);
+	if (! my packedCapacity)
+		NUMvector_free (my candidate, 1);
 	my candidate = candidate.transfer();
+	my packedCapacity = 0;
 	my nCandidates = nCandidates;
 }
 
+void Pitch_packFrames (Pitch me) {
+	long numberOfCandidates = 0;
+	for (long iframe = 1; iframe <= my nx; iframe ++)
+		numberOfCandidates += my frame [iframe]. nCandidates;
+	if (numberOfCandidates < 1) return;
+	autoNUMvector <structPitch_Candidate> block (0L, numberOfCandidates - 1);
+	long used = 0;
+	for (long iframe = 1; iframe <= my nx; iframe ++) {
+		Pitch_Frame frame = & my frame [iframe];
+		if (frame -> nCandidates < 1) continue;
+		Pitch_Candidate slot = & block [used] - 1;   // base 1
+		for (long icand = 1; icand <= frame -> nCandidates; icand ++)
+			slot [icand] = frame -> candidate [icand];
+		if (! frame -> packedCapacity)
+			NUMvector_free (frame -> candidate, 1);
+		frame -> candidate = slot;
+		frame -> packedCapacity = frame -> nCandidates;
+		used += frame -> nCandidates;
+	}
+	NUMvector_free (my packedCandidates, 0);
+	my packedCandidates = block.transfer();
+}
+
 Pitch Pitch_create (double tmin, double tmax, long nt, double dt, double t1,
 	double ceiling, int maxnCandidates)
 {
@@ -412,6 +445,31 @@ Pitch Pitch_create (double tmin, double tmax, long nt, double dt, double t1,
 	}
 }
 
+Pitch Pitch_createPacked (double tmin, double tmax, long nt, double dt, double t1,
+	double ceiling, int maxnCandidates)
+{
+	try {
+		autoPitch me = Thing_new (Pitch);
+		Sampled_init (me.peek(), tmin, tmax, nt, dt, t1);
+		my ceiling = ceiling;
+		my maxnCandidates = maxnCandidates;
+		my frame = NUMvector <structPitch_Frame> (1, nt);
+		my packedCandidates = NUMvector <structPitch_Candidate> (0L, nt * maxnCandidates - 1);
+
+		/* Put one candidate in every frame (unvoiced, silent), with room for maxnCandidates. */
+		for (long it = 1; it <= nt; it ++) {
+			Pitch_Frame frame = & my frame [it];
+			frame -> candidate = & my packedCandidates [(it - 1) * maxnCandidates] - 1;   // base 1
+			frame -> packedCapacity = maxnCandidates;
+			frame -> nCandidates = 1;
+		}
+
+		return me.transfer();
+	} catch (MelderError) {
+		Melder_throw (U"Pitch not created.");
+	}
+}
+
 void Pitch_setCeiling (Pitch me, double ceiling) {
 	my ceiling = ceiling;
 }
@@ -425,9 +483,11 @@ int Pitch_getMaxnCandidates (Pitch me) {
 	return result;
 }
 
-void Pitch_pathFinder (Pitch me, double silenceThreshold, double voicingThreshold,
+Thing_implement (Pitch_PathFinder, Thing, 0);
+
+Pitch_PathFinder Pitch_PathFinder_create (Pitch pitch, double silenceThreshold, double voicingThreshold,
 	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost,
-	double ceiling, int pullFormants)
+	double ceiling, int pullFormants, long maximumLookahead)
 {
 	if (Melder_debug == 33)
 		Melder_casual (U"Pitch path finder:"
@@ -439,144 +499,274 @@ void Pitch_pathFinder (Pitch me, double silenceThreshold, double voicingThreshol
 			U"\nCeiling = ", ceiling,
 			U"\nPull formants = ", pullFormants);
 	try {
-		long maxnCandidates = Pitch_getMaxnCandidates (me);
-		long place;
-		volatile double maximum, value;
-		double ceiling2 = pullFormants ? 2 * ceiling : ceiling;
+		autoPitch_PathFinder me = Thing_new (Pitch_PathFinder);
+		my pitch = pitch;
+		my silenceThreshold = silenceThreshold;
+		my voicingThreshold = voicingThreshold;
+		my octaveCost = octaveCost;
+		my ceiling = ceiling;
+		my ceiling2 = pullFormants ? 2 * ceiling : ceiling;
 		/* Next three lines 20011015 */
-		double timeStepCorrection = 0.01 / my dx;
-		octaveJumpCost *= timeStepCorrection;
-		voicedUnvoicedCost *= timeStepCorrection;
+		double timeStepCorrection = 0.01 / pitch -> dx;
+		my octaveJumpCost = octaveJumpCost * timeStepCorrection;
+		my voicedUnvoicedCost = voicedUnvoicedCost * timeStepCorrection;
 
-		my ceiling = ceiling;
-		autoNUMmatrix <double> delta (1, my nx, 1, maxnCandidates);
-		autoNUMmatrix <long> psi (1, my nx, 1, maxnCandidates);
-
-		for (long iframe = 1; iframe <= my nx; iframe ++) {
-			Pitch_Frame frame = & my frame [iframe];
-			double unvoicedStrength = silenceThreshold <= 0 ? 0 :
-				2 - frame->intensity / (silenceThreshold / (1 + voicingThreshold));
-			unvoicedStrength = voicingThreshold + (unvoicedStrength > 0 ? unvoicedStrength : 0);
-			for (long icand = 1; icand <= frame->nCandidates; icand ++) {
-				Pitch_Candidate candidate = & frame->candidate [icand];
-				int voiceless = candidate->frequency == 0 || candidate->frequency > ceiling2;
-				delta [iframe] [icand] = voiceless ? unvoicedStrength :
-					candidate->strength - octaveCost * NUMlog2 (ceiling / candidate->frequency);
-			}
-		}
+		pitch -> ceiling = ceiling;
+		my streaming = maximumLookahead > 0;
+		/*
+		 * While streaming, the frames to come do not exist yet,
+		 * so we have to rely on the maximum number of candidates as promised by the Pitch.
+		 */
+		my maxnCandidates = my streaming ? pitch -> maxnCandidates : Pitch_getMaxnCandidates (pitch);
+		my capacity = my streaming ? (maximumLookahead < 2 ? 2 : maximumLookahead) : pitch -> nx + 1;
+		my delta.reset (0, my capacity - 1, 1, my maxnCandidates);
+		my psi.reset (0, my capacity - 1, 1, my maxnCandidates);
+		my places.reset (1, my maxnCandidates);
+		my nextPlaces.reset (1, my maxnCandidates);
+		my stamps.reset (0, my maxnCandidates);
+		my firstUndecidedFrame = 1;
+		my lastFrame = 0;
+		return me.transfer();
+	} catch (MelderError) {
+		Melder_throw (pitch, U": path finder not created.");
+	}
+}
 
-		/* Look for the most probable path through the maxima. */
-		/* There is a cost for the voiced/unvoiced transition, */
-		/* and a cost for a frequency jump. */
-
-		for (long iframe = 2; iframe <= my nx; iframe ++) {
-			Pitch_Frame prevFrame = & my frame [iframe - 1], curFrame = & my frame [iframe];
-			double *prevDelta = delta [iframe - 1], *curDelta = delta [iframe];
-			long *curPsi = psi [iframe];
-			for (long icand2 = 1; icand2 <= curFrame -> nCandidates; icand2 ++) {
-				double f2 = curFrame -> candidate [icand2]. frequency;
-				maximum = -1e30;
-				place = 0;
-				for (long icand1 = 1; icand1 <= prevFrame -> nCandidates; icand1 ++) {
-					double f1 = prevFrame -> candidate [icand1]. frequency;
-					double transitionCost;
-					bool previousVoiceless = f1 <= 0 || f1 >= ceiling2;
-					bool currentVoiceless = f2 <= 0 || f2 >= ceiling2;
-					if (currentVoiceless) {
-						if (previousVoiceless) {
-							transitionCost = 0;   // both voiceless
-						} else {
-							transitionCost = voicedUnvoicedCost;   // voiced-to-unvoiced transition
-						}
-					} else {
-						if (previousVoiceless) {
-							transitionCost = voicedUnvoicedCost;   // unvoiced-to-voiced transition
-							if (Melder_debug == 30) {
-								/*
-								 * Try to take into account a frequency jump across a voiceless stretch.
-								 */
-								long place1 = icand1;
-								for (long jframe = iframe - 2; jframe >= 1; jframe --) {
-									place1 = psi [jframe + 1] [place1];
-									f1 = my frame [jframe]. candidate [place1]. frequency;
-									if (f1 > 0 && f1 < ceiling) {
-										transitionCost += octaveJumpCost * fabs (NUMlog2 (f1 / f2)) / (iframe - jframe);
-										break;
-									}
-								}
+static void Pitch_PathFinder_computeLocalScores (Pitch_PathFinder me, long iframe) {
+	Pitch_Frame frame = & my pitch -> frame [iframe];
+	double *delta = my delta [iframe % my capacity];
+	double unvoicedStrength = my silenceThreshold <= 0 ? 0 :
+		2 - frame->intensity / (my silenceThreshold / (1 + my voicingThreshold));
+	unvoicedStrength = my voicingThreshold + (unvoicedStrength > 0 ? unvoicedStrength : 0);
+	for (long icand = 1; icand <= frame->nCandidates; icand ++) {
+		Pitch_Candidate candidate = & frame->candidate [icand];
+		int voiceless = candidate->frequency == 0 || candidate->frequency > my ceiling2;
+		delta [icand] = voiceless ? unvoicedStrength :
+			candidate->strength - my octaveCost * NUMlog2 (my ceiling / candidate->frequency);
+	}
+}
+
+/*
+	Look for the most probable path through the maxima.
+	There is a cost for the voiced/unvoiced transition,
+	and a cost for a frequency jump.
+*/
+static void Pitch_PathFinder_computeTransitions (Pitch_PathFinder me, long iframe) {
+	long place;
+	volatile double maximum, value;
+	Pitch_Frame prevFrame = & my pitch -> frame [iframe - 1], curFrame = & my pitch -> frame [iframe];
+	double *prevDelta = my delta [(iframe - 1) % my capacity], *curDelta = my delta [iframe % my capacity];
+	long *curPsi = my psi [iframe % my capacity];
+	for (long icand2 = 1; icand2 <= curFrame -> nCandidates; icand2 ++) {
+		double f2 = curFrame -> candidate [icand2]. frequency;
+		maximum = -1e30;
+		place = 0;
+		for (long icand1 = 1; icand1 <= prevFrame -> nCandidates; icand1 ++) {
+			double f1 = prevFrame -> candidate [icand1]. frequency;
+			double transitionCost;
+			bool previousVoiceless = f1 <= 0 || f1 >= my ceiling2;
+			bool currentVoiceless = f2 <= 0 || f2 >= my ceiling2;
+			if (currentVoiceless) {
+				if (previousVoiceless) {
+					transitionCost = 0;   // both voiceless
+				} else {
+					transitionCost = my voicedUnvoicedCost;   // voiced-to-unvoiced transition
+				}
+			} else {
+				if (previousVoiceless) {
+					transitionCost = my voicedUnvoicedCost;   // unvoiced-to-voiced transition
+					if (Melder_debug == 30) {
+						/*
+						 * Try to take into account a frequency jump across a voiceless stretch.
+						 * Decided frames have lost their losing candidates, so we cannot look back beyond them.
+						 */
+						long place1 = icand1;
+						for (long jframe = iframe - 2; jframe >= my firstUndecidedFrame; jframe --) {
+							place1 = my psi [(jframe + 1) % my capacity] [place1];
+							f1 = my pitch -> frame [jframe]. candidate [place1]. frequency;
+							if (f1 > 0 && f1 < my ceiling) {
+								transitionCost += my octaveJumpCost * fabs (NUMlog2 (f1 / f2)) / (iframe - jframe);
+								break;
 							}
-						} else {
-							transitionCost = octaveJumpCost * fabs (NUMlog2 (f1 / f2));   // both voiced
 						}
 					}
-					value = prevDelta [icand1] - transitionCost + curDelta [icand2];
-					//if (Melder_debug == 33) Melder_casual ("Frame %ld, current candidate %ld (delta %g), previous candidate %ld (delta %g), "
-					//	"transition cost %g, value %g, maximum %g", iframe, icand2, curDelta [icand2], icand1, prevDelta [icand1], transitionCost, value, maximum);
-					if (value > maximum) {
-						maximum = value;
-						place = icand1;
-					} else if (value == maximum) {
-						if (Melder_debug == 33)
-							Melder_casual (
-								U"A tie in frame ", iframe,
-								U", current candidate ", icand2,
-								U", previous candidate ", icand1
-							);
-					}
+				} else {
+					transitionCost = my octaveJumpCost * fabs (NUMlog2 (f1 / f2));   // both voiced
 				}
-				curDelta [icand2] = maximum;
-				curPsi [icand2] = place;
+			}
+			value = prevDelta [icand1] - transitionCost + curDelta [icand2];
+			if (value > maximum) {
+				maximum = value;
+				place = icand1;
+			} else if (value == maximum) {
+				if (Melder_debug == 33)
+					Melder_casual (
+						U"A tie in frame ", iframe,
+						U", current candidate ", icand2,
+						U", previous candidate ", icand1
+					);
 			}
 		}
+		curDelta [icand2] = maximum;
+		curPsi [icand2] = place;
+	}
+}
 
-		/* Find the end of the most probable path. */
+static long Pitch_PathFinder_getBestPlace (Pitch_PathFinder me, long iframe) {
+	double *delta = my delta [iframe % my capacity];
+	long place = 1;
+	volatile double maximum = delta [place];
+	for (long icand = 2; icand <= my pitch -> frame [iframe]. nCandidates; icand ++) {
+		if (delta [icand] > maximum) {
+			place = icand;
+			maximum = delta [place];
+		}
+	}
+	return place;
+}
 
-		place = 1;
-		maximum = delta [my nx] [place];
-		for (long icand = 2; icand <= my frame [my nx]. nCandidates; icand ++) {
-			if (delta [my nx] [icand] > maximum) {
-				place = icand;
-				maximum = delta [my nx] [place];
+/*
+	Decide the frames from the first undecided frame up to and including `lastDecidedFrame`,
+	by following the path backwards from candidate `place` of `lastDecidedFrame`.
+*/
+static void Pitch_PathFinder_decide (Pitch_PathFinder me, long lastDecidedFrame, long place) {
+	Pitch pitch = my pitch;
+	for (long iframe = lastDecidedFrame; iframe >= my firstUndecidedFrame; iframe --) {
+		if (Melder_debug == 33)
+			Melder_casual (
+				U"Frame ", iframe, U":",
+				U" swapping candidates 1 and ", place
+			);
+		Pitch_Frame frame = & pitch -> frame [iframe];
+		structPitch_Candidate help = frame -> candidate [1];
+		frame -> candidate [1] = frame -> candidate [place];
+		frame -> candidate [place] = help;
+		place = my psi [iframe % my capacity] [place];   // This assignment is challenging to CodeWarrior 11.
+	}
+
+	/* Pull formants: devoice frames with frequencies between ceiling and ceiling2. */
+
+	if (my ceiling2 > my ceiling) {
+		if (Melder_debug == 33)
+			Melder_casual (U"Pulling formants...");
+		for (long iframe = lastDecidedFrame; iframe >= my firstUndecidedFrame; iframe --) {
+			Pitch_Frame frame = & pitch -> frame [iframe];
+			Pitch_Candidate winner = & frame -> candidate [1];
+			double f = winner -> frequency;
+			if (f > my ceiling && f <= my ceiling2) {
+				for (long icand = 2; icand <= frame -> nCandidates; icand ++) {
+					Pitch_Candidate loser = & frame -> candidate [icand];
+					if (loser -> frequency == 0.0) {
+						structPitch_Candidate help = * winner;
+						* winner = * loser;
+						* loser = help;
+						break;
+					}
+				}
 			}
 		}
+	}
 
-		/* Backtracking: follow the path backwards. */
-
-		for (long iframe = my nx; iframe >= 1; iframe --) {
-			if (Melder_debug == 33)
-				Melder_casual (
-					U"Frame ", iframe, U":",
-					U" swapping candidates 1 and ", place
-				);
-			Pitch_Frame frame = & my frame [iframe];
-			structPitch_Candidate help = frame -> candidate [1];
-			frame -> candidate [1] = frame -> candidate [place];
-			frame -> candidate [place] = help;
-			place = psi [iframe] [place];   // This assignment is challenging to CodeWarrior 11.
+	if (my streaming) {
+		for (long iframe = my firstUndecidedFrame; iframe <= lastDecidedFrame; iframe ++) {
+			Pitch_Frame frame = & pitch -> frame [iframe];
+			structPitch_Candidate winner = frame -> candidate [1];
+			Pitch_Frame_init (frame, 1);
+			frame -> candidate [1] = winner;
 		}
+	}
+	my firstUndecidedFrame = lastDecidedFrame + 1;
+}
 
-		/* Pull formants: devoice frames with frequencies between ceiling and ceiling2. */
-
-		if (ceiling2 > ceiling) {
-			if (Melder_debug == 33)
-				Melder_casual (U"Pulling formants...");
-			for (long iframe = my nx; iframe >= 1; iframe --) {
-				Pitch_Frame frame = & my frame [iframe];
-				Pitch_Candidate winner = & frame -> candidate [1];
-				double f = winner -> frequency;
-				if (f > ceiling && f <= ceiling2) {
-					for (long icand = 2; icand <= frame -> nCandidates; icand ++) {
-						Pitch_Candidate loser = & frame -> candidate [icand];
-						if (loser -> frequency == 0.0) {
-							structPitch_Candidate help = * winner;
-							* winner = * loser;
-							* loser = help;
-							break;
-						}
-					}
-				}
+/*
+	Trace the best paths towards all candidates of the last frame back to where they meet.
+	The last frame itself is never decided here, because the next frame still needs all of its candidates.
+*/
+static void Pitch_PathFinder_decideConvergedFrames (Pitch_PathFinder me) {
+	long *places = my places.peek(), *nextPlaces = my nextPlaces.peek();
+	long numberOfPlaces = my pitch -> frame [my lastFrame]. nCandidates;
+	for (long icand = 1; icand <= numberOfPlaces; icand ++)
+		places [icand] = icand;
+	for (long iframe = my lastFrame; iframe > my firstUndecidedFrame; iframe --) {
+		long *psi = my psi [iframe % my capacity];
+		long numberOfNextPlaces = 0;
+		my stamp ++;
+		for (long i = 1; i <= numberOfPlaces; i ++) {
+			long previousPlace = psi [places [i]];
+			if (my stamps [previousPlace] != my stamp) {
+				my stamps [previousPlace] = my stamp;
+				nextPlaces [++ numberOfNextPlaces] = previousPlace;
 			}
 		}
+		if (numberOfNextPlaces == 1) {
+			Pitch_PathFinder_decide (me, iframe - 1, nextPlaces [1]);
+			return;
+		}
+		long *help = places; places = nextPlaces; nextPlaces = help;
+		numberOfPlaces = numberOfNextPlaces;
+	}
+}
+
+/*
+	The window is full without the paths having converged:
+	decide the older half along the path that is best so far,
+	and recompute the scores of the newer half as continuations of that decision.
+*/
+static void Pitch_PathFinder_forceDecision (Pitch_PathFinder me) {
+	long lastDecidedFrame = my firstUndecidedFrame + my capacity / 2 - 1;
+	long place = Pitch_PathFinder_getBestPlace (me, my lastFrame);
+	for (long iframe = my lastFrame; iframe > lastDecidedFrame; iframe --)
+		place = my psi [iframe % my capacity] [place];
+	double score = my delta [lastDecidedFrame % my capacity] [place];
+	Pitch_PathFinder_decide (me, lastDecidedFrame, place);
+	my delta [lastDecidedFrame % my capacity] [1] = score;
+	for (long iframe = lastDecidedFrame + 1; iframe <= my lastFrame; iframe ++) {
+		Pitch_PathFinder_computeLocalScores (me, iframe);
+		Pitch_PathFinder_computeTransitions (me, iframe);
+	}
+}
+
+void Pitch_PathFinder_addFrames (Pitch_PathFinder me, long lastFrame) {
+	try {
+		Melder_assert (lastFrame <= my pitch -> nx);
+		for (long iframe = my lastFrame + 1; iframe <= lastFrame; iframe ++) {
+			Melder_assert (my pitch -> frame [iframe]. nCandidates <= my maxnCandidates);
+			if (iframe - my firstUndecidedFrame >= my capacity)
+				Pitch_PathFinder_forceDecision (me);
+			Pitch_PathFinder_computeLocalScores (me, iframe);
+			if (iframe > 1)
+				Pitch_PathFinder_computeTransitions (me, iframe);
+			my lastFrame = iframe;
+			if (my streaming)
+				Pitch_PathFinder_decideConvergedFrames (me);
+		}
+	} catch (MelderError) {
+		Melder_throw (my pitch, U": path not extended.");
+	}
+}
+
+void Pitch_PathFinder_finish (Pitch_PathFinder me) {
+	try {
+		Melder_assert (my lastFrame == my pitch -> nx);
+
+		/* Find the end of the most probable path, and follow the path backwards. */
+
+		if (my lastFrame >= my firstUndecidedFrame)
+			Pitch_PathFinder_decide (me, my lastFrame, Pitch_PathFinder_getBestPlace (me, my lastFrame));
+	} catch (MelderError) {
+		Melder_throw (my pitch, U": path not finished.");
+	}
+}
+
+void Pitch_pathFinder (Pitch me, double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost,
+	double ceiling, int pullFormants)
+{
+	try {
+		autoPitch_PathFinder pathFinder = Pitch_PathFinder_create (me, silenceThreshold, voicingThreshold,
+			octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling, pullFormants, 0);
+		Pitch_PathFinder_addFrames (pathFinder.peek(), my nx);
+		Pitch_PathFinder_finish (pathFinder.peek());
 	} catch (MelderError) {
 		Melder_throw (me, U": path not found.");
 	}
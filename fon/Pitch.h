@@ -52,10 +52,32 @@ Pitch Pitch_create (double tmin, double tmax, long nt, double dt, double t1,
 		my frame [1..nt]. intensity == 0.0; // silent
 */
 
+Pitch Pitch_createPacked (double tmin, double tmax, long nt, double dt, double t1,
+	double ceiling, int maxnCandidates);
+/*
+	Function:
+		as Pitch_create, but with the candidates of all frames in one block (see Pitch_packFrames),
+		with room for maxnCandidates candidates per frame, so that Pitch_Frame_init needs no allocation.
+	Preconditions:
+		as with Pitch_create, and maxnCandidates >= 1.
+*/
+
+void Pitch_packFrames (Pitch me);
+/*
+	Function:
+		move the candidates of all frames into one contiguous block, with exactly the room they need.
+		This replaces one allocation per frame, and frees the room left unused by the analysis.
+		The candidates are still accessed as my frame [iframe]. candidate [icand];
+		a frame that gets more candidates than it has room for (see Pitch_Frame_init)
+		moves to a space of its own.
+		Pitch objects read from binary files, and copies of Pitch objects, are packed as well.
+*/
+
 void Pitch_Frame_init (Pitch_Frame me, int nCandidates);
 /*
 	Function:
-		create space for a number of candidates; space already there is disposed of.
+		create space for a number of candidates; space already there is disposed of,
+		unless the frame is packed and its space is large enough, in which case that space is reused.
 	Preconditions:
 		nCandidates >= 1;
 	Postconditions:
@@ -125,6 +147,52 @@ void Pitch_pathFinder (Pitch me, double silenceThreshold, double voicingThreshol
 	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost,
 	double ceiling, int pullFormants);
 
+/*
+	The path finder, frame by frame.
+	Pitch_pathFinder () is the same as creating a Pitch_PathFinder with a maximumLookahead of 0,
+	adding all frames at once, and finishing.
+
+	With a maximumLookahead of N > 0, the path finder keeps the Viterbi scores of at most N undecided frames.
+	After each added frame, it traces the best paths towards all candidates of the newest frame back
+	until they converge on a single candidate; from that frame back, the best path can no longer change,
+	so these frames are decided right away, and each of them keeps only its winning candidate.
+	Such decisions are identical to those of Pitch_pathFinder ().
+	Only if the paths do not converge within N frames is the older half of these frames decided
+	along the currently best path, which may then differ from what Pitch_pathFinder () would have found.
+	Memory thus stays bounded for recordings of any length, except for the winning candidates themselves.
+
+	The candidates of the frames must have been computed before the frames are added.
+*/
+Thing_define (Pitch_PathFinder, Thing) { public:
+	Pitch pitch;
+	double silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling, ceiling2;
+	long maxnCandidates, capacity;
+	bool streaming;
+	long firstUndecidedFrame, lastFrame;
+	autoNUMmatrix <double> delta;   // [iframe % capacity] [icand]
+	autoNUMmatrix <long> psi;
+	autoNUMvector <long> places, nextPlaces, stamps;
+	long stamp;
+};
+
+Pitch_PathFinder Pitch_PathFinder_create (Pitch pitch, double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost,
+	double ceiling, int pullFormants, long maximumLookahead);
+/*
+	maximumLookahead == 0: no decisions before Pitch_PathFinder_finish ().
+	The Pitch should stay alive for as long as the path finder exists.
+*/
+
+void Pitch_PathFinder_addFrames (Pitch_PathFinder me, long lastFrame);
+/*
+	Adds the frames after those added before, up to and including `lastFrame`.
+*/
+
+void Pitch_PathFinder_finish (Pitch_PathFinder me);
+/*
+	Decides all remaining frames. All frames of the Pitch should have been added.
+*/
+
 /* Drawing methods. */
 #define Pitch_speckle_NO  false
 #define Pitch_speckle_YES  true
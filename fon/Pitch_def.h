@@ -54,6 +54,9 @@ oo_END_STRUCT (Pitch_Candidate)
 #define ooSTRUCT Pitch_Frame
 oo_DEFINE_STRUCT (Pitch_Frame)
 
+	#if oo_DECLARING
+		long packedCapacity;   // > 0 if the candidates lie in the packed block of the Pitch, which has room for this many
+	#endif
 	#if oo_READING_BINARY
 		if (localVersion < 0) {
 			oo_INT (nCandidates)
@@ -69,7 +72,32 @@ oo_DEFINE_STRUCT (Pitch_Frame)
 		oo_DOUBLE (intensity)
 		oo_LONG (nCandidates)
 	#endif
-	oo_STRUCT_VECTOR (Pitch_Candidate, candidate, nCandidates)
+	#if oo_DESTROYING
+		if (! our packedCapacity) {
+			oo_STRUCT_VECTOR (Pitch_Candidate, candidate, nCandidates)
+		}
+	#elif oo_COPYING
+		if (thy packedCapacity >= our nCandidates) {
+			for (long icand = 1; icand <= our nCandidates; icand ++)
+				our candidate [icand]. copy (& thy candidate [icand]);
+		} else {
+			thy packedCapacity = 0;
+			thy candidate = NULL;
+			oo_STRUCT_VECTOR (Pitch_Candidate, candidate, nCandidates)
+		}
+	#elif oo_READING_BINARY
+		if (our nCandidates >= 1 && our packedCapacity >= our nCandidates) {
+			for (long icand = 1; icand <= our nCandidates; icand ++)
+				our candidate [icand]. readBinary (f);
+			our packedCapacity = our nCandidates;
+		} else {
+			our packedCapacity = 0;
+			our candidate = NULL;
+			oo_STRUCT_VECTOR (Pitch_Candidate, candidate, nCandidates)
+		}
+	#else
+		oo_STRUCT_VECTOR (Pitch_Candidate, candidate, nCandidates)
+	#endif
 
 oo_END_STRUCT (Pitch_Frame)
 #undef ooSTRUCT
@@ -80,9 +108,56 @@ oo_DEFINE_CLASS (Pitch, Sampled)
 
 	oo_DOUBLE (ceiling)
 	oo_INT (maxnCandidates)
-	oo_STRUCT_VECTOR (Pitch_Frame, frame, nx)
+	#if oo_COPYING
+		if (our frame) {
+			/*
+			 * The copy is packed, with exactly the room that its candidates need.
+			 */
+			thy frame = NUMvector <structPitch_Frame> (1, our nx);
+			long numberOfCandidates = 0;
+			for (long iframe = 1; iframe <= our nx; iframe ++)
+				numberOfCandidates += our frame [iframe]. nCandidates;
+			if (numberOfCandidates > 0) {
+				thy packedCandidates = NUMvector <structPitch_Candidate> (0L, numberOfCandidates - 1);
+				long used = 0;
+				for (long iframe = 1; iframe <= our nx; iframe ++) {
+					long n = our frame [iframe]. nCandidates;
+					if (n < 1) continue;
+					thy frame [iframe]. candidate = & thy packedCandidates [used] - 1;   // base 1
+					thy frame [iframe]. packedCapacity = n;
+					used += n;
+				}
+			}
+			for (long iframe = 1; iframe <= our nx; iframe ++)
+				our frame [iframe]. copy (& thy frame [iframe]);
+		}
+	#elif oo_READING_BINARY
+		if (our nx >= 1) {
+			/*
+			 * Each frame takes the room that its candidates need from a block that is large enough
+			 * if no frame has more than maxnCandidates candidates; the rest of the block is never touched.
+			 */
+			our frame = NUMvector <structPitch_Frame> (1, our nx);
+			long capacity = our nx * (our maxnCandidates < 1 ? 1 : our maxnCandidates), used = 0;
+			our packedCandidates = NUMvector <structPitch_Candidate> (0L, capacity - 1);
+			for (long iframe = 1; iframe <= our nx; iframe ++) {
+				Pitch_Frame pitchFrame = & our frame [iframe];
+				pitchFrame -> candidate = & our packedCandidates [used] - 1;   // base 1
+				pitchFrame -> packedCapacity = capacity - used;
+				pitchFrame -> readBinary (f);
+				used += pitchFrame -> packedCapacity;
+			}
+		}
+	#else
+		oo_STRUCT_VECTOR (Pitch_Frame, frame, nx)
+	#endif
+	#if oo_DESTROYING
+		NUMvector_free <structPitch_Candidate> (our packedCandidates, 0);
+	#endif
 
 	#if oo_DECLARING
+		structPitch_Candidate *packedCandidates;   // NULL, or the packed block [0..]; see Pitch_packFrames ()
+
 		void v_info ()
 			override;
 		int v_domainQuantity ()
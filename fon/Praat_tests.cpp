@@ -10,6 +10,8 @@
 
 #include "Graphics.h"
 #include "praat.h"
+#include "NUM2.h"
+#include "Pitch.h"
 
 #include "enums_getText.h"
 #include "Praat_tests_enums.h"
@@ -17,6 +19,30 @@
 #include "Praat_tests_enums.h"
 #include <string>
 
+/*
+	Gives every candidate of every frame a value that tells where it belongs.
+*/
+static void Pitch_fillCandidates (Pitch me, long firstFrame, long lastFrame) {
+	for (long iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+		Pitch_Frame frame = & my frame [iframe];
+		for (long icand = 1; icand <= frame -> nCandidates; icand ++) {
+			frame -> candidate [icand]. frequency = 100.0 * iframe + icand;
+			frame -> candidate [icand]. strength = 1.0 / (iframe + icand);
+		}
+	}
+}
+
+static void Pitch_checkCandidates (Pitch me, const long nCandidates []) {
+	for (long iframe = 1; iframe <= my nx; iframe ++) {
+		Pitch_Frame frame = & my frame [iframe];
+		if (frame -> nCandidates != nCandidates [iframe - 1])
+			Melder_throw (U"Frame ", iframe, U" has ", frame -> nCandidates, U" candidates instead of ", nCandidates [iframe - 1], U".");
+		for (long icand = 1; icand <= frame -> nCandidates; icand ++)
+			if (frame -> candidate [icand]. frequency != 100.0 * iframe + icand || frame -> candidate [icand]. strength != 1.0 / (iframe + icand))
+				Melder_throw (U"Candidate ", icand, U" of frame ", iframe, U" has changed.");
+	}
+}
+
 int Praat_tests (int itest, char32 *arg1, char32 *arg2, char32 *arg3, char32 *arg4) {
 	int64 n = Melder_atoi (arg1);
 	double t;
@@ -215,6 +241,65 @@ int Praat_tests (int itest, char32 *arg1, char32 *arg2, char32 *arg3, char32 *ar
 			}
 			t = Melder_stopwatch ();
 		} break;
+		case kPraatTests_TIME_FFT:
+		case kPraatTests_TIME_FFT_BATCH: {
+			/*
+				n transforms of size m, in groups of `batchSize` signals that are refreshed before every group
+				(so that the timing includes one copy per transform for both methods).
+			*/
+			long m = Melder_atoi (arg2), batchSize = 16;
+			autoNUMfft_Table table;
+			NUMfft_Table_init (& table, m);
+			autoNUMvector <double> original (1, m);
+			for (long i = 1; i <= m; i ++)
+				original [i] = NUMrandomGauss (0.0, 1.0);
+			autoNUMmatrix <double> signals (0L, batchSize - 1, 1L, m);
+			autoNUMvector <double> workspace (0L, 4 * m - 1);
+			Melder_stopwatch ();
+			for (int64 done = 0; done < n; done += batchSize) {
+				long numberOfTransforms = n - done < batchSize ? (long) (n - done) : batchSize;
+				for (long itransform = 0; itransform < numberOfTransforms; itransform ++)
+					NUMvector_copyElements (original.peek(), signals [itransform], 1, m);
+				if (itest == kPraatTests_TIME_FFT_BATCH) {
+					NUMfft_forward_batch (& table, numberOfTransforms, signals.peek(), workspace.peek());
+				} else {
+					for (long itransform = 0; itransform < numberOfTransforms; itransform ++)
+						NUMfft_forward (& table, signals [itransform]);
+				}
+			}
+			t = Melder_stopwatch ();
+		} break;
+		case kPraatTests_CHECK_PITCH_PACKING: {
+			/*
+				Frames in the packed block of a Pitch that shrink, grow within their room, or outgrow it,
+				in the original and in copies, and copies that outlive their original.
+			*/
+			for (int64 i = 1; i <= n; i ++) {
+				autoPitch pitch = Pitch_createPacked (0.0, 1.0, 8, 0.1, 0.1, 600.0, 3);
+				long nCandidates [8] = { 1, 2, 3, 7, 2, 1, 1, 4 };
+				for (long iframe = 1; iframe <= 8; iframe ++)
+					Pitch_Frame_init (& pitch -> frame [iframe], nCandidates [iframe - 1]);   // frames 4 and 8 outgrow their room
+				Pitch_fillCandidates (pitch.peek(), 1, 8);
+				Pitch_checkCandidates (pitch.peek(), nCandidates);
+				autoPitch copy = Data_copy (pitch.peek());
+				if (! Data_equal (pitch.peek(), copy.peek()))
+					Melder_throw (U"Copy differs from original.");
+				Pitch_packFrames (pitch.peek());
+				Pitch_checkCandidates (pitch.peek(), nCandidates);
+				pitch.reset (NULL);   // the copy should not point into the block of the original
+				Pitch_checkCandidates (copy.peek(), nCandidates);
+				nCandidates [0] = 5, nCandidates [2] = 2, nCandidates [3] = 9;
+				Pitch_Frame_init (& copy -> frame [1], 5);   // the copy has exactly the room of each frame
+				Pitch_Frame_init (& copy -> frame [3], 2);
+				Pitch_Frame_init (& copy -> frame [4], 9);   // a frame that has its own array already
+				Pitch_fillCandidates (copy.peek(), 1, 8);
+				autoPitch copyOfCopy = Data_copy (copy.peek());
+				copy.reset (NULL);
+				Pitch_checkCandidates (copyOfCopy.peek(), nCandidates);
+			}
+			t = Melder_stopwatch ();
+			MelderInfo_writeLine (U"OK");
+		} break;
 	}
 	MelderInfo_writeLine (Melder_single (t / n * 1e9), U" nanoseconds");
 	MelderInfo_close ();
@@ -24,6 +24,9 @@ enums_begin (kPraatTests, 0)
 	enums_add (kPraatTests, 19, TIME_WCSCPY, U"TimeWcscpy")
 	enums_add (kPraatTests, 20, TIME_STR32CPY, U"TimeStr32cpy")
 	enums_add (kPraatTests, 21, TIME_GRAPHICS_TEXT_TOP, U"TimeGraphicsTextTop")
-enums_end (kPraatTests, 21, CHECK_RANDOM_1009_2009)
+	enums_add (kPraatTests, 22, TIME_FFT, U"TimeFft")
+	enums_add (kPraatTests, 23, TIME_FFT_BATCH, U"TimeFftBatch")
+	enums_add (kPraatTests, 24, CHECK_PITCH_PACKING, U"CheckPitchPacking")
+enums_end (kPraatTests, 24, CHECK_RANDOM_1009_2009)
 
 /* End of file Praat_tests_enums.h */
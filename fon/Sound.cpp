@@ -26,6 +26,7 @@
 #include "Sound.h"
 #include "Sound_extensions.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 #include "enums_getText.h"
 #include "Sound_enums.h"
@@ -364,61 +365,206 @@ Sound Sound_upsample (Sound me) {
 	}
 }
 
+/*
+ * Resampling with a Hann-windowed sinc that does the anti-aliasing and the interpolation in one step.
+ * The kernel is scaled to the lower of the two Nyquist frequencies and has `depth` zero crossings on either side;
+ * its weights are normalized to a sum of 1, so that a constant signal stays constant.
+ * Samples outside the Sound count as zero.
+ *
+ * If the ratio of the sampling frequencies is a fraction p/q with a small p (e.g. 160/441 for 44100 -> 16000 Hz),
+ * the output samples fall on only p different positions between input samples,
+ * and the weights for these p "phases" are computed once (the polyphase method).
+ * Otherwise the weights are computed anew for every output sample.
+ * Either way, the output is computed in blocks that can be handled by different threads,
+ * and no memory is needed beyond the two Sounds and the table of weights.
+ */
+#define Sound_resample_BLOCK_SIZE  8192
+#define Sound_resample_MAXIMUM_NUMBER_OF_PHASES  1000
+#define Sound_resample_MAXIMUM_TABLE_SIZE  2000000
+#define Sound_resample_MINIMUM_DOWNSAMPLING_DEPTH  4
+
+static void Sound_resample_computeWeights (double centre, long firstTap, long numberOfTaps, double cutoff, double depth, double weights []) {
+	double sum = 0.0;
+	for (long itap = 0; itap < numberOfTaps; itap ++) {
+		double u = (firstTap + itap - centre) * cutoff;   // in units of the longer of the two sampling periods
+		double weight;
+		if (fabs (u) >= depth) {
+			weight = 0.0;
+		} else if (u == 0.0) {
+			weight = 1.0;
+		} else {
+			double phase = NUMpi * u;
+			weight = sin (phase) / phase * 0.5 * (1.0 + cos (phase / depth));
+		}
+		weights [itap] = weight;
+		sum += weight;
+	}
+	for (long itap = 0; itap < numberOfTaps; itap ++) {
+		weights [itap] /= sum;
+	}
+}
+
+Thing_define (Sound_resample_Args, Thing) { public:
+	Sound original, resampled;
+	long numberOfBlocks;
+	bool linear;
+	double firstPosition, step;   // in input sample numbers
+	double cutoff, depth;
+	long firstTap, numberOfTaps;
+	/*
+	 * The polyphase table (shared by all threads), if the ratio of the sampling frequencies is p/q.
+	 */
+	long numberOfPhases, phaseIncrement;   // p, q
+	long firstBase;   // floor (firstPosition)
+	double **phaseWeights;   // [0..p-1][0..numberOfTaps-1]
+	long *phaseShift;   // [0..p-1]: 1 if the phase lies beyond the next input sample, else 0
+	/*
+	 * The scratch buffer of one thread, for the general ratio.
+	 */
+	autoNUMvector <double> weights;
+};
+
+Thing_implement (Sound_resample_Args, Thing, 0);
+
+static double Sound_resample_sum (double *from, long nx, long firstSample, double *weights, long numberOfTaps) {
+	double sum = 0.0;
+	if (firstSample >= 1 && firstSample + numberOfTaps - 1 <= nx) {
+		double *x = & from [firstSample];
+		for (long itap = 0; itap < numberOfTaps; itap ++)
+			sum += x [itap] * weights [itap];
+	} else {
+		long firstTap = firstSample >= 1 ? 0 : 1 - firstSample;
+		long lastTap = firstSample + numberOfTaps - 1 <= nx ? numberOfTaps - 1 : nx - firstSample;
+		for (long itap = firstTap; itap <= lastTap; itap ++)
+			sum += from [firstSample + itap] * weights [itap];
+	}
+	return sum;
+}
+
+static void Sound_resample_blocks (Sound_resample_Args me, long firstBlock, long lastBlock) {
+	Sound original = my original, resampled = my resampled;
+	for (long iblock = firstBlock; iblock <= lastBlock; iblock ++) {
+		long channel = (iblock - 1) / my numberOfBlocks + 1;
+		long firstSample = ((iblock - 1) % my numberOfBlocks) * Sound_resample_BLOCK_SIZE + 1;
+		long lastSample = firstSample + Sound_resample_BLOCK_SIZE - 1;
+		if (lastSample > resampled -> nx) lastSample = resampled -> nx;
+		double *from = original -> z [channel], *to = resampled -> z [channel];
+		if (my linear) {
+			for (long i = firstSample; i <= lastSample; i ++) {
+				double index = my firstPosition + (i - 1) * my step;
+				long leftSample = (long) floor (index);
+				double fraction = index - leftSample;
+				to [i] = leftSample < 1 || leftSample >= original -> nx ? 0.0 :
+					(1 - fraction) * from [leftSample] + fraction * from [leftSample + 1];
+			}
+		} else if (my numberOfPhases > 0) {
+			int64 numerator = (int64) (firstSample - 1) * my phaseIncrement;
+			long base = my firstBase + (long) (numerator / my numberOfPhases);
+			long phase = (long) (numerator % my numberOfPhases);
+			for (long i = firstSample; i <= lastSample; i ++) {
+				to [i] = Sound_resample_sum (from, original -> nx, base + my phaseShift [phase] + my firstTap,
+					my phaseWeights [phase], my numberOfTaps);
+				phase += my phaseIncrement;
+				base += phase / my numberOfPhases;
+				phase %= my numberOfPhases;
+			}
+		} else {
+			double *weights = my weights.peek();
+			for (long i = firstSample; i <= lastSample; i ++) {
+				double position = my firstPosition + (i - 1) * my step;
+				long base = (long) floor (position);
+				Sound_resample_computeWeights (position - base, my firstTap, my numberOfTaps, my cutoff, my depth, weights);
+				to [i] = Sound_resample_sum (from, original -> nx, base + my firstTap, weights, my numberOfTaps);
+			}
+		}
+	}
+}
+
 Sound Sound_resample (Sound me, double samplingFrequency, long precision) {
 	double upfactor = samplingFrequency * my dx;
-	if (fabs (upfactor - 2) < 1e-6) return Sound_upsample (me);
 	if (fabs (upfactor - 1) < 1e-6) return Data_copy (me);
 	try {
 		long numberOfSamples = lround ((my xmax - my xmin) * samplingFrequency);
 		if (numberOfSamples < 1)
 			Melder_throw (U"The resampled Sound would have no samples.");
-		autoSound filtered = NULL;
-		if (upfactor < 1.0) {   // need anti-aliasing filter?
-			long nfft = 1, antiTurnAround = 1000;
-			while (nfft < my nx + antiTurnAround * 2) nfft *= 2;
-			autoNUMvector <double> data (1, nfft);
-			filtered.reset (Sound_create (my ny, my xmin, my xmax, my nx, my dx, my x1));
-			for (long channel = 1; channel <= my ny; channel ++) {
-				for (long i = 1; i <= nfft; i ++) {
-					data [i] = 0;
-				}
-				NUMvector_copyElements (my z [channel], & data [antiTurnAround], 1, my nx);
-				NUMrealft (data.peek(), nfft, 1);   // go to the frequency domain
-				for (long i = (long) floor (upfactor * nfft); i <= nfft; i ++) {
-					data [i] = 0;   // filter away high frequencies
-				}
-				data [2] = 0.0;
-				NUMrealft (data.peek(), nfft, -1);   // return to the time domain
-				double factor = 1.0 / nfft;
-				double *to = filtered -> z [channel];
-				for (long i = 1; i <= my nx; i ++) {
-					to [i] = data [i + antiTurnAround] * factor;
-				}
-			}
-			me = filtered.peek();   // reference copy; remove at end
-		}
 		autoSound thee = Sound_create (my ny, my xmin, my xmax, numberOfSamples, 1.0 / samplingFrequency,
 			0.5 * (my xmin + my xmax - (numberOfSamples - 1) / samplingFrequency));
-		for (long channel = 1; channel <= my ny; channel ++) {
-			double *from = my z [channel];
-			double *to = thy z [channel];
-			if (precision <= 1) {
-				for (long i = 1; i <= numberOfSamples; i ++) {
-					double x = Sampled_indexToX (thee.peek(), i);
-					double index = Sampled_xToIndex (me, x);
-					long leftSample = (long) floor (index);
-					double fraction = index - leftSample;
-					to [i] = leftSample < 1 || leftSample >= my nx ? 0.0 :
-						(1 - fraction) * from [leftSample] + fraction * from [leftSample + 1];
+
+		/*
+		 * The positions of the new samples, in sample numbers of the original.
+		 */
+		double firstPosition = Sampled_xToIndex (me, thy x1), step = thy dx / my dx;
+
+		/*
+		 * The filter.
+		 */
+		bool linear = precision <= 1 && upfactor > 1.0;
+		double cutoff = upfactor < 1.0 ? upfactor : 1.0;
+		double depth = upfactor < 1.0 && precision < Sound_resample_MINIMUM_DOWNSAMPLING_DEPTH ?
+			Sound_resample_MINIMUM_DOWNSAMPLING_DEPTH : precision;
+		long halfWidth = (long) ceil (depth / cutoff);   // in samples of the original
+		long firstTap = - halfWidth, numberOfTaps = 2 * halfWidth + 2;
+
+		/*
+		 * Is the ratio of the sampling frequencies a fraction with a small numerator?
+		 */
+		long numberOfPhases = 0, phaseIncrement = 0;
+		if (! linear) {
+			for (long p = 1; p <= Sound_resample_MAXIMUM_NUMBER_OF_PHASES && p * numberOfTaps <= Sound_resample_MAXIMUM_TABLE_SIZE; p ++) {
+				double q = p * step;
+				long qround = lround (q);
+				if (qround >= 1 && fabs (q - qround) < 1e-12 * q) {
+					numberOfPhases = p;
+					phaseIncrement = qround;
+					break;
 				}
-			} else {
-				for (long i = 1; i <= numberOfSamples; i ++) {
-					double x = Sampled_indexToX (thee.peek(), i);
-					double index = Sampled_xToIndex (me, x);
-					to [i] = NUM_interpolate_sinc (my z [channel], my nx, index, precision);
+			}
+		}
+		long firstBase = (long) floor (firstPosition);
+		autoNUMmatrix <double> phaseWeights;
+		autoNUMvector <long> phaseShift;
+		if (numberOfPhases > 0) {
+			phaseWeights.reset (0, numberOfPhases - 1, 0, numberOfTaps - 1);
+			phaseShift.reset (0, numberOfPhases - 1);
+			double firstCentre = firstPosition - firstBase;
+			for (long phase = 0; phase < numberOfPhases; phase ++) {
+				double centre = firstCentre + (double) phase / numberOfPhases;
+				if (centre >= 1.0) {
+					centre -= 1.0;
+					phaseShift [phase] = 1;
 				}
+				Sound_resample_computeWeights (centre, firstTap, numberOfTaps, cutoff, depth, phaseWeights [phase]);
 			}
 		}
+
+		/*
+		 * The blocks of all channels are independent.
+		 */
+		long numberOfBlocks = (numberOfSamples - 1) / Sound_resample_BLOCK_SIZE + 1;
+		const int numberOfThreads = MelderThread_computeNumberOfThreads (my ny * numberOfBlocks, 1);
+		autoSound_resample_Args args [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+		for (int ithread = 0; ithread < numberOfThreads; ithread ++) {
+			autoSound_resample_Args arg = Thing_new (Sound_resample_Args);
+			arg -> original = me;
+			arg -> resampled = thee.peek();
+			arg -> numberOfBlocks = numberOfBlocks;
+			arg -> linear = linear;
+			arg -> firstPosition = firstPosition;
+			arg -> step = step;
+			arg -> cutoff = cutoff;
+			arg -> depth = depth;
+			arg -> firstTap = firstTap;
+			arg -> numberOfTaps = numberOfTaps;
+			arg -> numberOfPhases = numberOfPhases;
+			arg -> phaseIncrement = phaseIncrement;
+			arg -> firstBase = firstBase;
+			arg -> phaseWeights = phaseWeights.peek();
+			arg -> phaseShift = phaseShift.peek();
+			if (! linear && numberOfPhases == 0)
+				arg -> weights.reset (0, numberOfTaps - 1);
+			args [ithread].reset (arg.transfer());
+		}
+		MelderThread_run (Sound_resample_blocks, args, numberOfThreads, 1, my ny * numberOfBlocks, 1);
 		return thee.transfer();
 	} catch (MelderError) {
 		Melder_throw (me, U": not resampled.");
@@ -510,41 +656,173 @@ Sound Sounds_concatenate_e (Collection me, double overlapTime) {
 	}
 }
 
-Sound Sounds_convolve (Sound me, Sound thee, enum kSounds_convolve_scaling scaling, enum kSounds_convolve_signalOutsideTimeDomain signalOutsideTimeDomain) {
-	try {
-		if (my ny > 1 && thy ny > 1 && my ny != thy ny)
-			Melder_throw (U"The numbers of channels of the two sounds have to be equal or 1.");
-		if (my dx != thy dx)
-			Melder_throw (U"The sampling frequencies of the two sounds have to be equal.");
-		long n1 = my nx, n2 = thy nx;
-		long n3 = n1 + n2 - 1, nfft = 1;
-		while (nfft < n3) nfft *= 2;
-		autoNUMvector <double> data1 (1, nfft);
-		autoNUMvector <double> data2 (1, nfft);
-		long numberOfChannels = my ny > thy ny ? my ny : thy ny;
-		autoSound him = Sound_create (numberOfChannels, my xmin + thy xmin, my xmax + thy xmax, n3, my dx, my x1 + thy x1);
-		for (long channel = 1; channel <= numberOfChannels; channel ++) {
-			double *a = my z [my ny == 1 ? 1 : channel];
-			for (long i = n1; i > 0; i --) data1 [i] = a [i];
-			for (long i = n1 + 1; i <= nfft; i ++) data1 [i] = 0.0;
-			a = thy z [thy ny == 1 ? 1 : channel];
-			for (long i = n2; i > 0; i --) data2 [i] = a [i];
-			for (long i = n2 + 1; i <= nfft; i ++) data2 [i] = 0.0;
-			NUMrealft (data1.peek(), nfft, 1);
-			NUMrealft (data2.peek(), nfft, 1);
-			data2 [1] *= data1 [1];
-			data2 [2] *= data1 [2];
+/*
+ * Convolution and cross-correlation share one engine, which puts the unscaled result into `him`
+ * and returns the FFT size that the caller still has to divide by.
+ * Cross-correlating `me` with `thee` is convolving `me` reversed in time with `thee`.
+ *
+ * If one Sound is much shorter than the other (e.g. an impulse response and a long recording),
+ * the long Sound is cut into blocks that are convolved separately with the short one,
+ * with an FFT size of about four times the length of the short Sound
+ * (overlap-save, the variant of overlap-add in which every block computes its own part of the result,
+ * so that blocks of all channels can be handled by different threads without interference).
+ * Otherwise both Sounds are transformed in full.
+ */
+#define Sounds_convolve_MINIMUM_LENGTH_RATIO  8
+#define Sounds_convolve_MINIMUM_PARTITIONED_LENGTH  65536
+#define Sounds_convolve_MINIMUM_BLOCK_FFT_SIZE  1024
+
+Thing_define (Sounds_convolve_Args, Thing) { public:
+	Sound shortSound, longSound, result;
+	bool reverseShort, reverseLong;
+	double **filterSpectra;   // [1..shortSound -> ny][1..nfft], shared by all threads
+	long nfft, blockSize, numberOfBlocks;
+	/*
+	 * The scratch buffers of one thread.
+	 */
+	autoNUMvector <double> data;
+	autoNUMfft_Table fftTable;
+};
+
+Thing_implement (Sounds_convolve_Args, Thing, 0);
+
+static void Sounds_convolve_blocks (Sounds_convolve_Args me, long firstBlock, long lastBlock) {
+	Sound shortSound = my shortSound, longSound = my longSound, result = my result;
+	long nfft = my nfft, shortLength = shortSound -> nx, longLength = longSound -> nx;
+	double *data = my data.peek();
+	for (long iblock = firstBlock; iblock <= lastBlock; iblock ++) {
+		long channel = (iblock - 1) / my numberOfBlocks + 1;
+		long offset = ((iblock - 1) % my numberOfBlocks) * my blockSize;
+		double *x = longSound -> z [longSound -> ny == 1 ? 1 : channel];
+		double *filterSpectrum = my filterSpectra [shortSound -> ny == 1 ? 1 : channel];
+		/*
+		 * The block needs the shortLength - 1 samples before it as well.
+		 */
+		for (long j = 1; j <= nfft; j ++) {
+			long isample = offset + j - (shortLength - 1);
+			data [j] = isample < 1 || isample > longLength ? 0.0 : x [my reverseLong ? longLength + 1 - isample : isample];
+		}
+		NUMfft_forward (& my fftTable, data);
+		data [1] *= filterSpectrum [1];
+		for (long i = 2; i < nfft; i += 2) {
+			double temp = data [i] * filterSpectrum [i] - data [i + 1] * filterSpectrum [i + 1];
+			data [i + 1] = data [i] * filterSpectrum [i + 1] + data [i + 1] * filterSpectrum [i];
+			data [i] = temp;
+		}
+		data [nfft] *= filterSpectrum [nfft];
+		NUMfft_backward (& my fftTable, data);
+		/*
+		 * The first shortLength - 1 values are contaminated by the circularity of the FFT.
+		 */
+		double *to = result -> z [channel];
+		for (long j = shortLength; j <= nfft; j ++) {
+			long isample = offset + j - shortLength + 1;
+			if (isample > result -> nx) break;
+			to [isample] = data [j];
+		}
+	}
+}
+
+static long Sounds_convolveOrCrossCorrelate (Sound me, Sound thee, bool crossCorrelate, Sound him) {
+	long n1 = my nx, n2 = thy nx, n3 = n1 + n2 - 1;
+	long numberOfChannels = his ny;
+	Sound shortSound = n1 <= n2 ? me : thee, longSound = n1 <= n2 ? thee : me;
+	if (longSound -> nx >= Sounds_convolve_MINIMUM_PARTITIONED_LENGTH &&
+		longSound -> nx >= Sounds_convolve_MINIMUM_LENGTH_RATIO * shortSound -> nx)
+	{
+		long shortLength = shortSound -> nx, nfft = Sounds_convolve_MINIMUM_BLOCK_FFT_SIZE;
+		while (nfft < 4 * shortLength) nfft *= 2;
+		long blockSize = nfft - shortLength + 1;
+		long numberOfBlocks = (n3 - 1) / blockSize + 1;
+		bool reverseShort = crossCorrelate && shortSound == me, reverseLong = crossCorrelate && longSound == me;
+		autoNUMmatrix <double> filterSpectra (1, shortSound -> ny, 1, nfft);
+		{// scope
+			autoNUMfft_Table fftTable;
+			NUMfft_Table_init (& fftTable, nfft);
+			for (long channel = 1; channel <= shortSound -> ny; channel ++) {
+				double *from = shortSound -> z [channel], *filterSpectrum = filterSpectra [channel];
+				for (long i = 1; i <= shortLength; i ++)
+					filterSpectrum [i] = from [reverseShort ? shortLength + 1 - i : i];
+				NUMfft_forward (& fftTable, filterSpectrum);   // the rest was zeroed by NUMmatrix
+			}
+		}
+		const int numberOfThreads = MelderThread_computeNumberOfThreads (numberOfChannels * numberOfBlocks, 4);
+		autoSounds_convolve_Args args [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+		for (int ithread = 0; ithread < numberOfThreads; ithread ++) {
+			autoSounds_convolve_Args arg = Thing_new (Sounds_convolve_Args);
+			arg -> shortSound = shortSound;
+			arg -> longSound = longSound;
+			arg -> result = him;
+			arg -> reverseShort = reverseShort;
+			arg -> reverseLong = reverseLong;
+			arg -> filterSpectra = filterSpectra.peek();
+			arg -> nfft = nfft;
+			arg -> blockSize = blockSize;
+			arg -> numberOfBlocks = numberOfBlocks;
+			arg -> data.reset (1, nfft);
+			NUMfft_Table_init (& arg -> fftTable, nfft);
+			args [ithread].reset (arg.transfer());
+		}
+		MelderThread_run (Sounds_convolve_blocks, args, numberOfThreads, 1, numberOfChannels * numberOfBlocks, 1);
+		return nfft;
+	}
+	long nfft = 1;
+	while (nfft < n3) nfft *= 2;
+	autoNUMvector <double> data1 (1, nfft);
+	autoNUMvector <double> data2 (1, nfft);
+	for (long channel = 1; channel <= numberOfChannels; channel ++) {
+		double *a = my z [my ny == 1 ? 1 : channel];
+		for (long i = n1; i > 0; i --) data1 [i] = a [i];
+		for (long i = n1 + 1; i <= nfft; i ++) data1 [i] = 0.0;
+		a = thy z [thy ny == 1 ? 1 : channel];
+		for (long i = n2; i > 0; i --) data2 [i] = a [i];
+		for (long i = n2 + 1; i <= nfft; i ++) data2 [i] = 0.0;
+		NUMrealft (data1.peek(), nfft, 1);
+		NUMrealft (data2.peek(), nfft, 1);
+		data2 [1] *= data1 [1];
+		data2 [2] *= data1 [2];
+		if (crossCorrelate) {
+			for (long i = 3; i <= nfft; i += 2) {
+				double temp = data1 [i] * data2 [i] + data1 [i + 1] * data2 [i + 1];   // reverse me by taking the conjugate of data1
+				data2 [i + 1] = data1 [i] * data2 [i + 1] - data1 [i + 1] * data2 [i];   // reverse me by taking the conjugate of data1
+				data2 [i] = temp;
+			}
+		} else {
 			for (long i = 3; i <= nfft; i += 2) {
 				double temp = data1 [i] * data2 [i] - data1 [i + 1] * data2 [i + 1];
 				data2 [i + 1] = data1 [i] * data2 [i + 1] + data1 [i + 1] * data2 [i];
 				data2 [i] = temp;
 			}
-			NUMrealft (data2.peek(), nfft, -1);
-			a = him -> z [channel];
+		}
+		NUMrealft (data2.peek(), nfft, -1);
+		a = his z [channel];
+		if (crossCorrelate) {
+			for (long i = 1; i < n1; i ++) {
+				a [i] = data2 [i + (nfft - (n1 - 1))];   // data for the first part ("negative lags") is at the end of data2
+			}
+			for (long i = 1; i <= n2; i ++) {
+				a [i + (n1 - 1)] = data2 [i];   // data for the second part ("positive lags") is at the beginning of data2
+			}
+		} else {
 			for (long i = 1; i <= n3; i ++) {
 				a [i] = data2 [i];
 			}
 		}
+	}
+	return nfft;
+}
+
+Sound Sounds_convolve (Sound me, Sound thee, enum kSounds_convolve_scaling scaling, enum kSounds_convolve_signalOutsideTimeDomain signalOutsideTimeDomain) {
+	try {
+		if (my ny > 1 && thy ny > 1 && my ny != thy ny)
+			Melder_throw (U"The numbers of channels of the two sounds have to be equal or 1.");
+		if (my dx != thy dx)
+			Melder_throw (U"The sampling frequencies of the two sounds have to be equal.");
+		long n1 = my nx, n2 = thy nx;
+		long n3 = n1 + n2 - 1;
+		long numberOfChannels = my ny > thy ny ? my ny : thy ny;
+		autoSound him = Sound_create (numberOfChannels, my xmin + thy xmin, my xmax + thy xmax, n3, my dx, my x1 + thy x1);
+		long nfft = Sounds_convolveOrCrossCorrelate (me, thee, false, him.peek());
 		switch (signalOutsideTimeDomain) {
 			case kSounds_convolve_signalOutsideTimeDomain_ZERO: {
 				// do nothing
@@ -597,37 +875,10 @@ Sound Sounds_crossCorrelate (Sound me, Sound thee, enum kSounds_convolve_scaling
 			Melder_throw (U"The sampling frequencies of the two sounds have to be equal.");
 		long numberOfChannels = my ny > thy ny ? my ny : thy ny;
 		long n1 = my nx, n2 = thy nx;
-		long n3 = n1 + n2 - 1, nfft = 1;
-		while (nfft < n3) nfft *= 2;
-		autoNUMvector <double> data1 (1, nfft);
-		autoNUMvector <double> data2 (1, nfft);
+		long n3 = n1 + n2 - 1;
 		double my_xlast = my x1 + (n1 - 1) * my dx;
 		autoSound him = Sound_create (numberOfChannels, thy xmin - my xmax, thy xmax - my xmin, n3, my dx, thy x1 - my_xlast);
-		for (long channel = 1; channel <= numberOfChannels; channel ++) {
-			double *a = my z [my ny == 1 ? 1 : channel];
-			for (long i = n1; i > 0; i --) data1 [i] = a [i];
-			for (long i = n1 + 1; i <= nfft; i ++) data1 [i] = 0.0;
-			a = thy z [thy ny == 1 ? 1 : channel];
-			for (long i = n2; i > 0; i --) data2 [i] = a [i];
-			for (long i = n2 + 1; i <= nfft; i ++) data2 [i] = 0.0;
-			NUMrealft (data1.peek(), nfft, 1);
-			NUMrealft (data2.peek(), nfft, 1);
-			data2 [1] *= data1 [1];
-			data2 [2] *= data1 [2];
-			for (long i = 3; i <= nfft; i += 2) {
-				double temp = data1 [i] * data2 [i] + data1 [i + 1] * data2 [i + 1];   // reverse me by taking the conjugate of data1
-				data2 [i + 1] = data1 [i] * data2 [i + 1] - data1 [i + 1] * data2 [i];   // reverse me by taking the conjugate of data1
-				data2 [i] = temp;
-			}
-			NUMrealft (data2.peek(), nfft, -1);
-			a = him -> z [channel];
-			for (long i = 1; i < n1; i ++) {
-				a [i] = data2 [i + (nfft - (n1 - 1))];   // data for the first part ("negative lags") is at the end of data2
-			}
-			for (long i = 1; i <= n2; i ++) {
-				a [i + (n1 - 1)] = data2 [i];   // data for the second part ("positive lags") is at the beginning of data2
-			}
-		}
+		long nfft = Sounds_convolveOrCrossCorrelate (me, thee, true, him.peek());
 		switch (signalOutsideTimeDomain) {
 			case kSounds_convolve_signalOutsideTimeDomain_ZERO: {
 				// do nothing
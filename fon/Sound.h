@@ -113,8 +113,11 @@ Sound Sound_upsample (Sound me);   /* By a factor 2. */
 Sound Sound_resample (Sound me, double samplingFrequency, long precision);
 /*
 	Method:
-		precision <= 1: linear interpolation.
-		precision >= 2: sinx/x interpolation with maximum depth equal to 'precision'.
+		precision <= 1, upsampling: linear interpolation.
+		otherwise: windowed sinx/x filtering with 'precision' zero crossings on either side
+			(at least 4 if downsampling), which also removes frequencies above the new Nyquist frequency.
+		Works block by block (in parallel) without a Fourier transform of the whole signal,
+		and uses a precomputed polyphase table if the ratio of the sampling frequencies is a simple fraction.
 */
 
 Sound Sounds_append (Sound me, double silenceDuration, Sound thee);
@@ -150,6 +153,11 @@ Sound Sounds_convolve (Sound me, Sound thee, enum kSounds_convolve_scaling scali
 		for (i = 1..result -> nx)
 			result -> z [1] [i] == result -> dx *
 				sum (j = 1..i, my z [1] [j] * thy z [1] [i - j + 1])
+	Method:
+		if one Sound is at least 8 times as long as the other and has at least 65536 samples,
+		the long Sound is convolved with the short one in blocks (overlap-save), in parallel;
+		otherwise, by a single FFT of at least my nx + thy nx - 1 samples.
+		The same holds for Sounds_crossCorrelate.
 */
 Sound Sounds_crossCorrelate (Sound me, Sound thee, enum kSounds_convolve_scaling scaling, enum kSounds_convolve_signalOutsideTimeDomain signalOutsideTimeDomain);
 Sound Sounds_crossCorrelate_short (Sound me, Sound thee, double tmin, double tmax, int normalize);
@@ -0,0 +1,187 @@
+/* SoundFileBatch.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "SoundFileBatch.h"
+#include "Sound_to_Pitch.h"
+#include "Sound_to_Formant.h"
+#include "Sound_to_Intensity.h"
+#include "MelderThread.h"
+
+/*
+	The interpreter and the object list are shared by the whole program, so a script cannot analyse two files at a time.
+	The analyses themselves can, as long as every file has its own objects:
+	each file is read and analysed by a single thread, into the results of that file only,
+	and the tables are assembled afterwards, on the calling thread, in the order of the file list.
+	Error messages are kept per thread (see melder_error.cpp), so a file that fails does not spoil the messages of other files.
+*/
+
+#define SoundFileBatch_NUMBER_OF_MEASUREMENTS  6   /* time, F0, F1, F2, F3, intensity */
+
+struct SoundFileBatch_File {
+	structMelderFile file;
+	double duration, analysisTime;
+	long numberOfFrames;
+	autoNUMmatrix <double> measurements;   // [1..numberOfFrames] [1..SoundFileBatch_NUMBER_OF_MEASUREMENTS]
+	autostring32 error;
+};
+
+Thing_define (SoundFileBatch, Thing) { public:
+	long numberOfFiles;
+	SoundFileBatch_File *files;   // [0..numberOfFiles-1]
+	double timeStep, pitchFloor, pitchCeiling;
+	double maximumNumberOfFormants, maximumFormant, windowLength, preEmphasisFrequency;
+
+	void v_destroy ()
+		override;
+};
+
+Thing_implement (SoundFileBatch, Thing, 0);
+
+void structSoundFileBatch :: v_destroy () {
+	delete [] files;
+	SoundFileBatch_Parent :: v_destroy ();
+}
+
+Thing_define (SoundFileBatch_Args, Thing) { public:
+	SoundFileBatch batch;   // shared by all threads
+	long numberOfFiles;
+};
+
+Thing_implement (SoundFileBatch_Args, Thing, 0);
+
+static void SoundFileBatch_analyseFile (SoundFileBatch me, SoundFileBatch_File *thee) {
+	autoSound sound = Sound_readFromSoundFile (& thy file);
+	thy duration = sound -> xmax - sound -> xmin;
+	autoPitch pitch = Sound_to_Pitch (sound.peek(), my timeStep, my pitchFloor, my pitchCeiling);
+	autoFormant formant = Sound_to_Formant_burg (sound.peek(), pitch -> dx,
+		my maximumNumberOfFormants, my maximumFormant, my windowLength, my preEmphasisFrequency);
+	autoIntensity intensity = Sound_to_Intensity (sound.peek(), my pitchFloor, pitch -> dx, true);
+	thy measurements.reset (1, pitch -> nx, 1, SoundFileBatch_NUMBER_OF_MEASUREMENTS);
+	for (long iframe = 1; iframe <= pitch -> nx; iframe ++) {
+		double time = Sampled_indexToX (pitch.peek(), iframe);
+		double *measurement = thy measurements [iframe];
+		measurement [1] = time;
+		measurement [2] = Sampled_getValueAtSample (pitch.peek(), iframe, Pitch_LEVEL_FREQUENCY, kPitch_unit_HERTZ);
+		for (int iformant = 1; iformant <= 3; iformant ++)
+			measurement [2 + iformant] = Formant_getValueAtTime (formant.peek(), iformant, time, 0);
+		measurement [6] = Vector_getValueAtX (intensity.peek(), time, 1, Vector_VALUE_INTERPOLATION_LINEAR);
+	}
+	thy numberOfFrames = pitch -> nx;
+}
+
+static void SoundFileBatch_analyseFiles (SoundFileBatch_Args me, long firstFile, long lastFile) {
+	autoMelderProgressOff noProgress;   // the calling thread shows the progress of the whole batch instead
+	autoMelderWarningOff noWarnings;
+	for (long ifile = firstFile; ifile <= lastFile; ifile ++) {
+		SoundFileBatch_File *file = & my batch -> files [ifile - 1];
+		double startingTime = Melder_clock ();
+		try {
+			SoundFileBatch_analyseFile (my batch, file);
+		} catch (MelderError) {
+			/*
+				One line, for a table cell.
+			*/
+			autostring32 message = Melder_dup (Melder_getError ());
+			Melder_clearError ();
+			char32 *text = message.peek();
+			long length = str32len (text);
+			for (long i = 0; i < length; i ++)
+				if (text [i] == U'\n') text [i] = U' ';
+			while (length > 0 && text [length - 1] == U' ')
+				text [-- length] = U'\0';
+			file -> numberOfFrames = 0;
+			file -> error.reset (message.transfer());
+		}
+		file -> analysisTime = Melder_clock () - startingTime;
+	}
+}
+
+static void SoundFileBatch_showProgress (SoundFileBatch_Args me, double fraction) {
+	Melder_progress (fraction, U"Analysed ", (long) floor (fraction * my numberOfFiles + 0.5), U" of ", my numberOfFiles, U" sound files");
+}
+
+Table SoundFileBatch_analyse (Strings fileNames, const char32 *directory,
+	double timeStep, double pitchFloor, double pitchCeiling,
+	double maximumNumberOfFormants, double maximumFormant, double windowLength, double preEmphasisFrequency,
+	Table *out_files)
+{
+	try {
+		long numberOfFiles = fileNames -> numberOfStrings;
+		if (numberOfFiles < 1)
+			Melder_throw (U"No sound files.");
+		autoSoundFileBatch batch = Thing_new (SoundFileBatch);
+		batch -> files = new SoundFileBatch_File [numberOfFiles] ();   // zeroed
+		batch -> numberOfFiles = numberOfFiles;
+		batch -> timeStep = timeStep;
+		batch -> pitchFloor = pitchFloor;
+		batch -> pitchCeiling = pitchCeiling;
+		batch -> maximumNumberOfFormants = maximumNumberOfFormants;
+		batch -> maximumFormant = maximumFormant;
+		batch -> windowLength = windowLength;
+		batch -> preEmphasisFrequency = preEmphasisFrequency;
+		/*
+			Relative paths depend on the default directory, which belongs to the calling thread.
+		*/
+		for (long ifile = 1; ifile <= numberOfFiles; ifile ++) {
+			const char32 *fileName = fileNames -> strings [ifile];
+			Melder_relativePathToFile (directory && directory [0] != U'\0' ? Melder_cat (directory, U"/", fileName) : fileName,
+				& batch -> files [ifile - 1]. file);
+		}
+
+		int numberOfThreads = MelderThread_computeNumberOfThreads (numberOfFiles, 1);
+		autoSoundFileBatch_Args args [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+		for (int ithread = 0; ithread < numberOfThreads; ithread ++) {
+			args [ithread].reset (Thing_new (SoundFileBatch_Args));
+			args [ithread] -> batch = batch.peek();
+			args [ithread] -> numberOfFiles = numberOfFiles;
+		}
+		{// scope
+			autoMelderProgress progress (U"Analysing sound files...");
+			MelderThread_run (SoundFileBatch_analyseFiles, args, numberOfThreads, 1, numberOfFiles, 1, SoundFileBatch_showProgress);
+		}
+
+		long numberOfRows = 0;
+		for (long ifile = 1; ifile <= numberOfFiles; ifile ++)
+			numberOfRows += batch -> files [ifile - 1]. numberOfFrames;
+		autoTable frames = Table_createWithColumnNames (numberOfRows, U"file time F0 F1 F2 F3 intensity");
+		autoTable files = Table_createWithColumnNames (numberOfFiles, U"file duration frames analysisTime error");
+		long irow = 0;
+		for (long ifile = 1; ifile <= numberOfFiles; ifile ++) {
+			SoundFileBatch_File *file = & batch -> files [ifile - 1];
+			const char32 *fileName = fileNames -> strings [ifile];
+			for (long iframe = 1; iframe <= file -> numberOfFrames; iframe ++) {
+				irow ++;
+				Table_setStringValue (frames.peek(), irow, 1, fileName);
+				for (int imeasurement = 1; imeasurement <= SoundFileBatch_NUMBER_OF_MEASUREMENTS; imeasurement ++)
+					Table_setNumericValue (frames.peek(), irow, 1 + imeasurement, file -> measurements [iframe] [imeasurement]);
+			}
+			Table_setStringValue (files.peek(), ifile, 1, fileName);
+			Table_setNumericValue (files.peek(), ifile, 2, file -> error.peek() ? NUMundefined : file -> duration);
+			Table_setNumericValue (files.peek(), ifile, 3, file -> numberOfFrames);
+			Table_setNumericValue (files.peek(), ifile, 4, file -> analysisTime);
+			Table_setStringValue (files.peek(), ifile, 5, file -> error.peek() ? file -> error.peek() : U"");
+		}
+		*out_files = files.transfer();
+		return frames.transfer();
+	} catch (MelderError) {
+		Melder_throw (fileNames, U": sound files not analysed.");
+	}
+}
+
+/* End of file SoundFileBatch.cpp */
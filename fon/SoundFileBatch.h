@@ -0,0 +1,46 @@
+#ifndef _SoundFileBatch_h_
+#define _SoundFileBatch_h_
+/* SoundFileBatch.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Strings_.h"
+#include "Table.h"
+
+Table SoundFileBatch_analyse (Strings fileNames, const char32 *directory,
+	double timeStep, double pitchFloor, double pitchCeiling,
+	double maximumNumberOfFormants, double maximumFormant, double windowLength, double preEmphasisFrequency,
+	Table *out_files);
+/*
+	Performs, for every sound file in `fileNames` (relative to `directory`, if that is not empty),
+	what a script would do with
+		Read from file
+		To Pitch: timeStep, pitchFloor, pitchCeiling
+		To Formant (burg): (the time step of the Pitch), maximumNumberOfFormants, maximumFormant, windowLength, preEmphasisFrequency
+		To Intensity: pitchFloor, (the time step of the Pitch), "yes"
+	The files are analysed simultaneously, one file per thread;
+	the analyses themselves then run on a single thread.
+	Returns a table with one row per pitch frame (columns: file, time, F0, F1, F2, F3, intensity),
+	in the order of `fileNames` and of time, regardless of which file was ready first.
+	`out_files` receives a table with one row per file (columns: file, duration, frames, analysisTime, error).
+	A file that cannot be read or analysed contributes no frames, but has its error message in `out_files`;
+	it does not stop the analysis of the other files.
+*/
+
+/* End of file SoundFileBatch.h */
+#endif
@@ -35,12 +35,186 @@
 
 #include "Sound_and_Spectrogram.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 #include "enums_getText.h"
 #include "Sound_and_Spectrogram_enums.h"
 #include "enums_getValue.h"
 #include "Sound_and_Spectrogram_enums.h"
 
+/*
+ * Scripts and editors tend to ask for the same window over and over again,
+ * so the most recently computed windows are kept in a small process-wide cache.
+ * The analysis works on a copy, so that the cache can be updated by other threads in the meantime.
+ */
+#define WINDOW_CACHE_SIZE  8
+static struct {
+	enum kSound_to_Spectrogram_windowShape windowType;
+	long nsamp_window;
+	double nSamplesPerWindow_f;
+	double *window, windowssq;
+} theWindowCache [WINDOW_CACHE_SIZE];
+static int theWindowCacheNextSlot;
+static MelderThread_SpinLock theWindowCacheLock;
+
+static void computeWindow (enum kSound_to_Spectrogram_windowShape windowType, long nsamp_window, double nSamplesPerWindow_f,
+	double window [], double *windowssq)
+{
+	*windowssq = 0.0;
+	for (long i = 1; i <= nsamp_window; i ++) {
+		double phase = (double) i / nSamplesPerWindow_f;   // 0 .. 1
+		double value;
+		switch (windowType) {
+			case kSound_to_Spectrogram_windowShape_SQUARE:
+				value = 1.0;
+			break; case kSound_to_Spectrogram_windowShape_HAMMING:
+				value = 0.54 - 0.46 * cos (2.0 * NUMpi * phase);
+			break; case kSound_to_Spectrogram_windowShape_BARTLETT:
+				value = 1.0 - fabs ((2.0 * phase - 1.0));
+			break; case kSound_to_Spectrogram_windowShape_WELCH:
+				value = 1.0 - (2.0 * phase - 1.0) * (2.0 * phase - 1.0);
+			break; case kSound_to_Spectrogram_windowShape_HANNING:
+				value = 0.5 * (1.0 - cos (2.0 * NUMpi * phase));
+			break; case kSound_to_Spectrogram_windowShape_GAUSSIAN:
+			{
+				double imid = 0.5 * (double) (nsamp_window + 1), edge = exp (-12.0);
+				phase = ((double) i - imid) / nSamplesPerWindow_f;   /* -0.5 .. +0.5 */
+				value = (exp (-48.0 * phase * phase) - edge) / (1.0 - edge);
+				break;
+			}
+			break; default:
+				value = 1.0;
+		}
+		window [i] = (float) value;
+		*windowssq += value * value;
+	}
+}
+
+static void getWindow (enum kSound_to_Spectrogram_windowShape windowType, long nsamp_window, double nSamplesPerWindow_f,
+	double window [], double *windowssq)
+{
+	{// scope
+		autoMelderThread_SpinLock lock (& theWindowCacheLock);
+		for (int islot = 0; islot < WINDOW_CACHE_SIZE; islot ++) {
+			if (theWindowCache [islot]. window && theWindowCache [islot]. windowType == windowType &&
+				theWindowCache [islot]. nsamp_window == nsamp_window && theWindowCache [islot]. nSamplesPerWindow_f == nSamplesPerWindow_f)
+			{
+				NUMvector_copyElements (theWindowCache [islot]. window, window, 1, nsamp_window);
+				*windowssq = theWindowCache [islot]. windowssq;
+				return;
+			}
+		}
+	}
+	computeWindow (windowType, nsamp_window, nSamplesPerWindow_f, window, windowssq);
+	double *copy = NUMvector_copy (window, 1, nsamp_window);
+	autoMelderThread_SpinLock lock (& theWindowCacheLock);
+	int islot = theWindowCacheNextSlot;
+	theWindowCacheNextSlot = (theWindowCacheNextSlot + 1) % WINDOW_CACHE_SIZE;
+	NUMvector_free (theWindowCache [islot]. window, 1);
+	theWindowCache [islot]. windowType = windowType;
+	theWindowCache [islot]. nsamp_window = nsamp_window;
+	theWindowCache [islot]. nSamplesPerWindow_f = nSamplesPerWindow_f;
+	theWindowCache [islot]. window = copy;
+	theWindowCache [islot]. windowssq = *windowssq;
+}
+
+Thing_define (Sound_into_Spectrogram_Args, Thing) { public:
+	Sound sound;
+	Spectrogram spectrogram;
+	double *window, oneByBinWidth;
+	long nsamp_window, halfnsamp_window, nsampFFT, binWidth_samples;
+	/*
+	 * The scratch buffers of one thread.
+	 * Frames are analysed two at a time, so that their FFTs can share one pass of NUMfft_forward_batch ().
+	 */
+	autoNUMmatrix <double> frames, specs;
+	autoNUMfft_Table fftTable;
+	autoNUMvector <double> fftWorkspace;   // [0..4*nsampFFT-1]
+};
+
+Thing_implement (Sound_into_Spectrogram_Args, Thing, 0);
+
+static Sound_into_Spectrogram_Args Sound_into_Spectrogram_Args_create (Sound sound, Spectrogram spectrogram,
+	double *window, long nsamp_window, long halfnsamp_window, long nsampFFT, long binWidth_samples, double oneByBinWidth)
+{
+	autoSound_into_Spectrogram_Args me = Thing_new (Sound_into_Spectrogram_Args);
+	my sound = sound;
+	my spectrogram = spectrogram;
+	my window = window;
+	my nsamp_window = nsamp_window;
+	my halfnsamp_window = halfnsamp_window;
+	my nsampFFT = nsampFFT;
+	my binWidth_samples = binWidth_samples;
+	my oneByBinWidth = oneByBinWidth;
+	my frames.reset (0, 1, 1, nsampFFT);
+	my specs.reset (0, 1, 1, nsampFFT);
+	NUMfft_Table_init (& my fftTable, nsampFFT);
+	my fftWorkspace.reset (0, 4 * nsampFFT - 1);
+	return me.transfer();
+}
+
+static void Sound_into_Spectrogram (Sound_into_Spectrogram_Args me, long firstFrame, long lastFrame) {
+	Sound sound = my sound;
+	Spectrogram thee = my spectrogram;
+	double **frames = my frames.peek(), **specs = my specs.peek(), *window = my window;
+	long nsamp_window = my nsamp_window, nsampFFT = my nsampFFT, half_nsampFFT = nsampFFT / 2;
+	for (long iframe = firstFrame; iframe <= lastFrame; iframe += 2) {
+		long numberOfFrames = iframe < lastFrame ? 2 : 1;
+		for (long k = 0; k < numberOfFrames; k ++) {
+			for (long i = 1; i <= half_nsampFFT; i ++) {
+				specs [k] [i] = 0.0;
+			}
+		}
+		for (long channel = 1; channel <= sound -> ny; channel ++) {
+			for (long k = 0; k < numberOfFrames; k ++) {
+				double t = Sampled_indexToX (thee, iframe + k);
+				long leftSample = Sampled_xToLowIndex (sound, t), rightSample = leftSample + 1;
+				long startSample = rightSample - my halfnsamp_window;
+				long endSample = leftSample + my halfnsamp_window;
+				Melder_assert (startSample >= 1);
+				Melder_assert (endSample <= sound -> nx);
+				double *frame = frames [k];
+				for (long j = 1, i = startSample; j <= nsamp_window; j ++) {
+					frame [j] = sound -> z [channel] [i ++] * window [j];
+				}
+				for (long j = nsamp_window + 1; j <= nsampFFT; j ++) frame [j] = 0.0f;
+			}
+
+			/* Compute Fast Fourier Transform of the frames. */
+
+			NUMfft_forward_batch (& my fftTable, numberOfFrames, frames, my fftWorkspace.peek());   // complex spectra
+
+			/* Add power spectrum to spec [1..half_nsampFFT + 1]. */
+
+			for (long k = 0; k < numberOfFrames; k ++) {
+				double *frame = frames [k], *spec = specs [k];
+				spec [1] += frame [1] * frame [1];   // DC component
+				for (long i = 2; i <= half_nsampFFT; i ++)
+					spec [i] += frame [i + i - 2] * frame [i + i - 2] + frame [i + i - 1] * frame [i + i - 1];
+				spec [half_nsampFFT + 1] += frame [nsampFFT] * frame [nsampFFT];   // Nyquist frequency. Correct??
+			}
+		}
+		for (long k = 0; k < numberOfFrames; k ++) {
+			double *spec = specs [k];
+			if (sound -> ny > 1 ) for (long i = 1; i <= half_nsampFFT; i ++) {
+				spec [i] /= sound -> ny;
+			}
+
+			/* Bin into frame [1..nBands]. */
+			for (long iband = 1; iband <= thy ny; iband ++) {
+				long leftsample = (iband - 1) * my binWidth_samples + 1, rightsample = leftsample + my binWidth_samples;
+				float power = 0.0f;
+				for (long i = leftsample; i < rightsample; i ++) power += spec [i];
+				thy z [iband] [iframe + k] = power * my oneByBinWidth;
+			}
+		}
+	}
+}
+
+static void Sound_into_Spectrogram_progress (Sound_into_Spectrogram_Args me, double fraction) {
+	Melder_progress (fraction, U"Sound to Spectrogram: analysis of ", my spectrogram -> nx, U" frames");
+}
+
 Spectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, double fmax,
 	double minimumTimeStep1, double minimumFreqStep1, enum kSound_to_Spectrogram_windowShape windowType,
 	double maximumTimeOversampling, double maximumFreqOversampling)
@@ -82,7 +256,6 @@ Spectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, doubl
 		long nsampFFT = 1;
 		while (nsampFFT < nsamp_window || nsampFFT < 2 * numberOfFreqs * (nyquist / fmax))
 			nsampFFT *= 2;
-		long half_nsampFFT = nsampFFT / 2;
 
 		/*
 		 * Compute the frequency sampling of the spectrogram.
@@ -97,85 +270,21 @@ Spectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, doubl
 		autoSpectrogram thee = Spectrogram_create (my xmin, my xmax, numberOfTimes, timeStep, t1,
 				0.0, fmax, numberOfFreqs, freqStep, 0.5 * (freqStep - binWidth_hertz));
 
-		autoNUMvector <double> frame (1, nsampFFT);
-		autoNUMvector <double> spec (1, nsampFFT);
 		autoNUMvector <double> window (1, nsamp_window);
-		autoNUMfft_Table fftTable;
-		NUMfft_Table_init (& fftTable, nsampFFT);
-
-		autoMelderProgress progress (U"Sound to Spectrogram...");
-		for (long i = 1; i <= nsamp_window; i ++) {
-			double nSamplesPerWindow_f = physicalAnalysisWidth / my dx;
-			double phase = (double) i / nSamplesPerWindow_f;   // 0 .. 1
-			double value;
-			switch (windowType) {
-				case kSound_to_Spectrogram_windowShape_SQUARE:
-					value = 1.0;
-				break; case kSound_to_Spectrogram_windowShape_HAMMING:
-					value = 0.54 - 0.46 * cos (2.0 * NUMpi * phase);
-				break; case kSound_to_Spectrogram_windowShape_BARTLETT:
-					value = 1.0 - fabs ((2.0 * phase - 1.0));
-				break; case kSound_to_Spectrogram_windowShape_WELCH:
-					value = 1.0 - (2.0 * phase - 1.0) * (2.0 * phase - 1.0);
-				break; case kSound_to_Spectrogram_windowShape_HANNING:
-					value = 0.5 * (1.0 - cos (2.0 * NUMpi * phase));
-				break; case kSound_to_Spectrogram_windowShape_GAUSSIAN:
-				{
-					double imid = 0.5 * (double) (nsamp_window + 1), edge = exp (-12.0);
-					phase = ((double) i - imid) / nSamplesPerWindow_f;   /* -0.5 .. +0.5 */
-					value = (exp (-48.0 * phase * phase) - edge) / (1.0 - edge);
-					break;
-				}
-				break; default:
-					value = 1.0;
-			}
-			window [i] = (float) value;
-			windowssq += value * value;
-		}
+		getWindow (windowType, nsamp_window, physicalAnalysisWidth / my dx, window.peek(), & windowssq);
 		double oneByBinWidth = 1.0 / windowssq / binWidth_samples;
 
-		for (long iframe = 1; iframe <= numberOfTimes; iframe ++) {
-			double t = Sampled_indexToX (thee.peek(), iframe);
-			long leftSample = Sampled_xToLowIndex (me, t), rightSample = leftSample + 1;
-			long startSample = rightSample - halfnsamp_window;
-			long endSample = leftSample + halfnsamp_window;
-			Melder_assert (startSample >= 1);
-			Melder_assert (endSample <= my nx);
-			for (long i = 1; i <= half_nsampFFT; i ++) {
-				spec [i] = 0.0;
-			}
-			for (long channel = 1; channel <= my ny; channel ++) {
-				for (long j = 1, i = startSample; j <= nsamp_window; j ++) {
-					frame [j] = my z [channel] [i ++] * window [j];
-				}
-				for (long j = nsamp_window + 1; j <= nsampFFT; j ++) frame [j] = 0.0f;
-
-				Melder_progress (iframe / (numberOfTimes + 1.0),
-					U"Sound to Spectrogram: analysis of frame ", iframe, U" out of ", numberOfTimes);
-
-				/* Compute Fast Fourier Transform of the frame. */
-
-				NUMfft_forward (& fftTable, frame.peek());   // complex spectrum
-
-				/* Put power spectrum in frame [1..half_nsampFFT + 1]. */
-
-				spec [1] += frame [1] * frame [1];   // DC component
-				for (long i = 2; i <= half_nsampFFT; i ++)
-					spec [i] += frame [i + i - 2] * frame [i + i - 2] + frame [i + i - 1] * frame [i + i - 1];
-				spec [half_nsampFFT + 1] += frame [nsampFFT] * frame [nsampFFT];   // Nyquist frequency. Correct??
-			}
-			if (my ny > 1 ) for (long i = 1; i <= half_nsampFFT; i ++) {
-				spec [i] /= my ny;
-			}
+		autoMelderProgress progress (U"Sound to Spectrogram...");
 
-			/* Bin into frame [1..nBands]. */
-			for (long iband = 1; iband <= numberOfFreqs; iband ++) {
-				long leftsample = (iband - 1) * binWidth_samples + 1, rightsample = leftsample + binWidth_samples;
-				float power = 0.0f;
-				for (long i = leftsample; i < rightsample; i ++) power += spec [i];
-				thy z [iband] [iframe] = power * oneByBinWidth;
-			}
-		}
+		/*
+		 * The frames are independent; every thread has its own frame, spectrum and FFT scratch space.
+		 */
+		const int numberOfThreads = MelderThread_computeNumberOfThreads (numberOfTimes, 20);
+		autoSound_into_Spectrogram_Args args [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+		for (int ithread = 0; ithread < numberOfThreads; ithread ++)
+			args [ithread].reset (Sound_into_Spectrogram_Args_create (me, thee.peek(),
+				window.peek(), nsamp_window, halfnsamp_window, nsampFFT, binWidth_samples, oneByBinWidth));
+		MelderThread_run (Sound_into_Spectrogram, args, numberOfThreads, 1, numberOfTimes, 8, Sound_into_Spectrogram_progress);
 		return thee.transfer();
 	} catch (MelderError) {
 		Melder_throw (me, U": spectrogram analysis not performed.");
@@ -32,12 +32,13 @@
 #include "Sound_to_Formant.h"
 #include "NUM2.h"
 #include "Polynomial.h"
+#include "MelderThread.h"
 
-static void burg (double sample [], long nsamp_window, double cof [], int nPoles,
+static void burg (NUMlpc_Workspace workspace, double sample [], long nsamp_window, double cof [], int nPoles,
 	Formant_Frame frame, double nyquistFrequency, double safetyMargin)
 {
 	double a0;
-	NUMburg (sample, nsamp_window, cof, nPoles, & a0);
+	NUMlpc_burg (workspace, sample + 1, nsamp_window, cof + 1, nPoles, & a0);
 
 	/*
 	 * Convert LP coefficients to polynomial.
@@ -234,14 +235,6 @@ loopEnd:
 	return result;
 }
 
-static void Sound_preEmphasis (Sound me, double preEmphasisFrequency) {
-	double preEmphasis = exp (-2.0 * NUMpi * preEmphasisFrequency * my dx);
-	for (long channel = 1; channel <= my ny; channel ++) {
-		double *s = my z [channel]; 
-		for (long i = my nx; i >= 2; i --) s [i] -= preEmphasis * s [i - 1];
-	}
-}
-
 void Formant_sort (Formant me) {
 	for (long iframe = 1; iframe <= my nx; iframe ++) {
 		Formant_Frame frame = & my d_frames [iframe];
@@ -265,7 +258,93 @@ void Formant_sort (Formant me) {
 	}
 }
 
-static Formant Sound_to_Formant_any_inline (Sound me, double dt_in, int numberOfPoles,
+Thing_define (Sound_into_Formant_Args, Thing) { public:
+	Sound sound;
+	Formant formant;
+	int numberOfPoles, which;
+	long nsamp_window, halfnsamp_window;
+	double *window, preEmphasis, safetyMargin;
+	/*
+	 * The scratch buffers of one thread.
+	 */
+	autoNUMvector <double> frame, cof;
+	autoNUMlpc_Workspace lpcWorkspace;
+};
+
+Thing_implement (Sound_into_Formant_Args, Thing, 0);
+
+static Sound_into_Formant_Args Sound_into_Formant_Args_create (Sound sound, Formant formant,
+	int numberOfPoles, int which, long nsamp_window, long halfnsamp_window, double *window, double preEmphasis, double safetyMargin)
+{
+	autoSound_into_Formant_Args me = Thing_new (Sound_into_Formant_Args);
+	my sound = sound;
+	my formant = formant;
+	my numberOfPoles = numberOfPoles;
+	my which = which;
+	my nsamp_window = nsamp_window;
+	my halfnsamp_window = halfnsamp_window;
+	my window = window;
+	my preEmphasis = preEmphasis;
+	my safetyMargin = safetyMargin;
+	my frame.reset (1, nsamp_window);
+	my cof.reset (1, numberOfPoles);   // superfluous if which==2, but nobody uses that anyway
+	if (which == 1)
+		NUMlpc_Workspace_init (& my lpcWorkspace, nsamp_window, numberOfPoles);
+	return me.transfer();
+}
+
+static void Sound_into_Formant (Sound_into_Formant_Args me, long firstFrame, long lastFrame) {
+	Sound sound = my sound;
+	double *samples = sound -> z [1], *frame = my frame.peek(), *window = my window;
+	for (long iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+		double t = Sampled_indexToX (my formant, iframe);
+		long leftSample = Sampled_xToLowIndex (sound, t);
+		long rightSample = leftSample + 1;
+		long startSample = rightSample - my halfnsamp_window;
+		long endSample = leftSample + my halfnsamp_window;
+		double maximumIntensity = 0.0;
+		if (startSample < 1) startSample = 1;
+		if (endSample > sound -> nx) endSample = sound -> nx;
+		long numberOfSamples = endSample - startSample + 1;
+
+		/*
+		 * Pre-emphasize the samples on the fly, so that the Sound itself is not modified and need not be copied:
+		 * the same as s [i] -= preEmphasis * s [i - 1] for i from nx down to 2.
+		 */
+		for (long j = 1, i = startSample; j <= numberOfSamples; j ++, i ++) {
+			double value = i >= 2 ? samples [i] - my preEmphasis * samples [i - 1] : samples [i];
+			if (value * value > maximumIntensity) {
+				maximumIntensity = value * value;
+			}
+			frame [j] = value;
+		}
+		if (maximumIntensity == HUGE_VAL)
+			Melder_throw (U"Sound contains infinities.");
+		my formant -> d_frames [iframe]. intensity = maximumIntensity;
+		if (maximumIntensity == 0.0) continue;   // Burg cannot stand all zeroes
+
+		/* Window the pre-emphasized frame. */
+		for (long j = 1; j <= numberOfSamples; j ++)
+			frame [j] *= window [j];
+
+		if (my which == 1) {
+			burg (& my lpcWorkspace, frame, numberOfSamples, my cof.peek(), my numberOfPoles, & my formant -> d_frames [iframe], 0.5 / sound -> dx, my safetyMargin);
+		} else if (my which == 2) {
+			if (! splitLevinson (frame, numberOfSamples, my numberOfPoles, & my formant -> d_frames [iframe], 0.5 / sound -> dx)) {
+				Melder_casual (U"(Sound_to_Formant:)"
+					U" Analysis results of frame ", iframe,
+					U" will be wrong."
+				);
+			}
+		}
+	}
+}
+
+static void Sound_into_Formant_progress (Sound_into_Formant_Args me, double fraction) {
+	Melder_progress (fraction, U"Formant analysis: ", my formant -> nx, U" frames");
+}
+
+static Formant Sound_to_Formant_mono (Sound me, double dt_in, int numberOfPoles,
 	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin)
 {
 	double dt = dt_in > 0.0 ? dt_in : halfdt_window / 4.0;
@@ -283,15 +362,14 @@ static Formant Sound_to_Formant_any_inline (Sound me, double dt_in, int numberOf
 		dt_window = duration;
 		nsamp_window = my nx;
 	}
+	Melder_assert (my ny == 1);   // the frame loop reads the samples directly
 	autoFormant thee = Formant_create (my xmin, my xmax, nFrames, dt, t1, (numberOfPoles + 1) / 2);   // e.g. 11 poles -> maximally 6 formants
 	autoNUMvector <double> window (1, nsamp_window);
-	autoNUMvector <double> frame (1, nsamp_window);
-	autoNUMvector <double> cof (1, numberOfPoles);   // superfluous if which==2, but nobody uses that anyway
 
 	autoMelderProgress progress (U"Formant analysis...");
 
-	/* Pre-emphasis. */
-	Sound_preEmphasis (me, preemphasisFrequency);
+	/* Pre-emphasis factor; the filter itself is applied frame by frame. */
+	double preEmphasis = exp (-2.0 * NUMpi * preemphasisFrequency * my dx);
 
 	/* Gaussian window. */
 	for (long i = 1; i <= nsamp_window; i ++) {
@@ -299,43 +377,17 @@ static Formant Sound_to_Formant_any_inline (Sound me, double dt_in, int numberOf
 		window [i] = (exp (-48.0 * (i - imid) * (i - imid) / (nsamp_window + 1) / (nsamp_window + 1)) - edge) / (1 - edge);
 	}
 
-	for (long iframe = 1; iframe <= nFrames; iframe ++) {
-		double t = Sampled_indexToX (thee.peek(), iframe);
-		long leftSample = Sampled_xToLowIndex (me, t);
-		long rightSample = leftSample + 1;
-		long startSample = rightSample - halfnsamp_window;
-		long endSample = leftSample + halfnsamp_window;
-		double maximumIntensity = 0.0;
-		if (startSample < 1) startSample = 1;
-		if (endSample > my nx) endSample = my nx;
-		for (long i = startSample; i <= endSample; i ++) {
-			double value = Sampled_getValueAtSample (me, i, Sound_LEVEL_MONO, 0);
-			if (value * value > maximumIntensity) {
-				maximumIntensity = value * value;
-			}
-		}
-		if (maximumIntensity == HUGE_VAL)
-			Melder_throw (U"Sound contains infinities.");
-		thy d_frames [iframe]. intensity = maximumIntensity;
-		if (maximumIntensity == 0.0) continue;   // Burg cannot stand all zeroes
-
-		/* Copy a pre-emphasized window to a frame. */
-		for (long j = 1, i = startSample; j <= nsamp_window; j ++)
-			frame [j] = Sampled_getValueAtSample (me, i ++, Sound_LEVEL_MONO, 0) * window [j];
+	/*
+	 * The frames are independent, so they can be analysed in parallel;
+	 * every thread has its own frame and coefficient buffers.
+	 */
+	const int numberOfThreads = MelderThread_computeNumberOfThreads (nFrames, 10);
+	autoSound_into_Formant_Args args [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+	for (int ithread = 0; ithread < numberOfThreads; ithread ++)
+		args [ithread].reset (Sound_into_Formant_Args_create (me, thee.peek(),
+			numberOfPoles, which, nsamp_window, halfnsamp_window, window.peek(), preEmphasis, safetyMargin));
+	MelderThread_run (Sound_into_Formant, args, numberOfThreads, 1, nFrames, 4, Sound_into_Formant_progress);
 
-		if (which == 1) {
-			burg (frame.peek(), endSample - startSample + 1, cof.peek(), numberOfPoles, & thy d_frames [iframe], 0.5 / my dx, safetyMargin);
-		} else if (which == 2) {
-			if (! splitLevinson (frame.peek(), endSample - startSample + 1, numberOfPoles, & thy d_frames [iframe], 0.5 / my dx)) {
-				Melder_clearError ();
-				Melder_casual (U"(Sound_to_Formant:)"
-					U" Analysis results of frame ", iframe,
-					U" will be wrong."
-				);
-			}
-		}
-		Melder_progress ((double) iframe / (double) nFrames, U"Formant analysis: frame ", iframe);
-	}
 	Formant_sort (thee.peek());
 	return thee.transfer();
 }
@@ -344,13 +396,22 @@ Formant Sound_to_Formant_any (Sound me, double dt, int numberOfPoles, double max
 	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin)
 {
 	double nyquist = 0.5 / my dx;
-	autoSound sound = NULL;
-	if (maximumFrequency <= 0.0 || fabs (maximumFrequency / nyquist - 1) < 1.0e-12) {
-		sound.reset (Data_copy (me));   // will be modified
-	} else {
-		sound.reset (Sound_resample (me, maximumFrequency * 2, 50));
+	/*
+	 * Mix the channels down once, instead of averaging them for every sample of every frame.
+	 * This also means that only one channel has to be resampled.
+	 * A mono sound that need not be resampled is analysed as is, without a copy.
+	 */
+	autoSound mono = NULL, resampled = NULL;
+	Sound sound = me;
+	if (my ny > 1) {
+		mono.reset (Sound_convertToMono (me));
+		sound = mono.peek();
+	}
+	if (maximumFrequency > 0.0 && fabs (maximumFrequency / nyquist - 1) >= 1.0e-12) {
+		resampled.reset (Sound_resample (sound, maximumFrequency * 2, 50));
+		sound = resampled.peek();
 	}
-	autoFormant thee = Sound_to_Formant_any_inline (sound.peek(), dt, numberOfPoles, halfdt_window, which, preemphasisFrequency, safetyMargin);
+	autoFormant thee = Sound_to_Formant_mono (sound, dt, numberOfPoles, halfdt_window, which, preemphasisFrequency, safetyMargin);
 	return thee.transfer();
 }
 
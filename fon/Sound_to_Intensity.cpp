@@ -33,6 +33,153 @@
  */
 
 #include "Sound_to_Intensity.h"
+#include "MelderThread.h"
+
+/*
+ * The frames of one thread's chunk share the squared samples,
+ * which are computed only once, although the windows overlap eightfold with the default time step.
+ */
+#define Sound_to_Intensity_FRAMES_PER_CHUNK  32
+
+/*
+ * Weighted sums, each split into partial sums, so that the additions do not wait for each other.
+ */
+static double Sound_to_Intensity_dot (const double *x, const double *w, long n) {
+	double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+	long k = 0;
+	for (; k + 3 < n; k += 4) {
+		sum0 += x [k] * w [k];
+		sum1 += x [k + 1] * w [k + 1];
+		sum2 += x [k + 2] * w [k + 2];
+		sum3 += x [k + 3] * w [k + 3];
+	}
+	for (; k < n; k ++)
+		sum0 += x [k] * w [k];
+	return (sum0 + sum1) + (sum2 + sum3);
+}
+
+static void Sound_to_Intensity_sums (const double *x, const double *x2, const double *w, long n,
+	double *sumx, double *sumxw, double *sumx2w)
+{
+	double a0 = 0.0, a1 = 0.0, b0 = 0.0, b1 = 0.0, c0 = 0.0, c1 = 0.0;
+	long k = 0;
+	for (; k + 1 < n; k += 2) {
+		a0 += x [k];
+		a1 += x [k + 1];
+		b0 += x [k] * w [k];
+		b1 += x [k + 1] * w [k + 1];
+		c0 += x2 [k] * w [k];
+		c1 += x2 [k + 1] * w [k + 1];
+	}
+	if (k < n) {
+		a0 += x [k];
+		b0 += x [k] * w [k];
+		c0 += x2 [k] * w [k];
+	}
+	*sumx = a0 + a1;
+	*sumxw = b0 + b1;
+	*sumx2w = c0 + c1;
+}
+
+Thing_define (Sound_into_Intensity_Args, Thing) { public:
+	Sound sound;
+	Intensity intensity;
+	long halfWindowSamples;
+	double *window;   // [-halfWindowSamples..halfWindowSamples]
+	double windowSum;
+	bool subtractMeanPressure;
+	/*
+	 * The scratch buffers of one thread.
+	 */
+	long bufferSize;
+	autoNUMvector <double> amplitude, power, energy, weight;
+};
+
+Thing_implement (Sound_into_Intensity_Args, Thing, 0);
+
+static Sound_into_Intensity_Args Sound_into_Intensity_Args_create (Sound sound, Intensity intensity,
+	long halfWindowSamples, double *window, double windowSum, bool subtractMeanPressure)
+{
+	autoSound_into_Intensity_Args me = Thing_new (Sound_into_Intensity_Args);
+	my sound = sound;
+	my intensity = intensity;
+	my halfWindowSamples = halfWindowSamples;
+	my window = window;
+	my windowSum = windowSum;
+	my subtractMeanPressure = subtractMeanPressure;
+	my energy.reset (0, Sound_to_Intensity_FRAMES_PER_CHUNK - 1);
+	my weight.reset (0, Sound_to_Intensity_FRAMES_PER_CHUNK - 1);
+	return me.transfer();
+}
+
+/*
+ * Without mean subtraction, the intensity is the squared signal convolved with the window,
+ * sampled at the frame centres: a weighted sum of the squares, which are computed once per chunk.
+ * With mean subtraction, the same sums give
+ *    sum ((x - mean)^2 w) = sum (x^2 w) - 2 mean sum (x w) + mean^2 sum (w),
+ * in which the samples are first taken relative to the first sample of the chunk,
+ * so that a DC offset does not cost any precision.
+ */
+static void Sound_into_Intensity (Sound_into_Intensity_Args me, long firstFrame, long lastFrame) {
+	Sound sound = my sound;
+	Intensity intensity = my intensity;
+	long halfWindowSamples = my halfWindowSamples;
+	long firstSample = Sampled_xToNearestIndex (sound, Sampled_indexToX (intensity, firstFrame)) - halfWindowSamples;
+	long lastSample = Sampled_xToNearestIndex (sound, Sampled_indexToX (intensity, lastFrame)) + halfWindowSamples;
+	if (firstSample < 1) firstSample = 1;
+	if (lastSample > sound -> nx) lastSample = sound -> nx;
+	long numberOfSamples = lastSample - firstSample + 1;
+	if (numberOfSamples > my bufferSize) {
+		my amplitude.reset (0, numberOfSamples - 1);
+		my power.reset (0, numberOfSamples - 1);
+		my bufferSize = numberOfSamples;
+	}
+	double *amplitude = my amplitude.peek(), *power = my power.peek();
+	for (long iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+		my energy [iframe - firstFrame] = 0.0;
+		my weight [iframe - firstFrame] = 0.0;
+	}
+	for (long channel = 1; channel <= sound -> ny; channel ++) {
+		double *z = sound -> z [channel] + firstSample;   // base 0
+		double reference = my subtractMeanPressure ? z [0] : 0.0;
+		for (long j = 0; j < numberOfSamples; j ++) {
+			double value = z [j] - reference;
+			amplitude [j] = value;
+			power [j] = value * value;
+		}
+		for (long iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+			long midSample = Sampled_xToNearestIndex (sound, Sampled_indexToX (intensity, iframe));
+			long leftSample = midSample - halfWindowSamples, rightSample = midSample + halfWindowSamples;
+			if (leftSample < 1) leftSample = 1;
+			if (rightSample > sound -> nx) rightSample = sound -> nx;
+			long n = rightSample - leftSample + 1, offset = leftSample - firstSample;
+			double *w = & my window [leftSample - midSample];
+			double sumw = my windowSum;
+			if (n < 2 * halfWindowSamples + 1) {
+				sumw = 0.0;
+				for (long k = 0; k < n; k ++)
+					sumw += w [k];
+			}
+			double sumxw;
+			if (my subtractMeanPressure) {
+				double sumx, sumx1w, sumx2w;
+				Sound_to_Intensity_sums (amplitude + offset, power + offset, w, n, & sumx, & sumx1w, & sumx2w);
+				double mean = sumx / n;
+				sumxw = sumx2w - 2.0 * mean * sumx1w + mean * mean * sumw;
+				if (sumxw < 0.0) sumxw = 0.0;   // rounding
+			} else {
+				sumxw = Sound_to_Intensity_dot (power + offset, w, n);
+			}
+			my energy [iframe - firstFrame] += sumxw;
+			my weight [iframe - firstFrame] += sumw;
+		}
+	}
+	for (long iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+		double value = my energy [iframe - firstFrame] / my weight [iframe - firstFrame];
+		value /= 4e-10;
+		intensity -> z [1] [iframe] = value < 1e-30 ? -300 : 10 * log10 (value);
+	}
+}
 
 static Intensity Sound_to_Intensity_ (Sound me, double minimumPitch, double timeStep, int subtractMeanPressure) {
 	try {
@@ -53,12 +200,13 @@ static Intensity Sound_to_Intensity_ (Sound me, double minimumPitch, double time
 		Melder_assert (windowDuration > 0.0);
 		double halfWindowDuration = 0.5 * windowDuration;
 		long halfWindowSamples = (long) floor (halfWindowDuration / my dx);
-		autoNUMvector <double> amplitude (- halfWindowSamples, halfWindowSamples);
 		autoNUMvector <double> window (- halfWindowSamples, halfWindowSamples);
 
+		double windowSum = 0.0;
 		for (long i = - halfWindowSamples; i <= halfWindowSamples; i ++) {
 			double x = i * my dx / halfWindowDuration, root = 1 - x * x;
 			window [i] = root <= 0.0 ? 0.0 : NUMbessel_i0_f ((2 * NUMpi * NUMpi + 0.5) * sqrt (root));
+			windowSum += window [i];
 		}
 
 		long numberOfFrames;
@@ -70,37 +218,14 @@ static Intensity Sound_to_Intensity_ (Sound me, double minimumPitch, double time
 				U"i.e. at least ", 6.4 / minimumPitch, U" s, instead of ", my xmax - my xmin, U" s.");
 		}
 		autoIntensity thee = Intensity_create (my xmin, my xmax, numberOfFrames, timeStep, thyFirstTime);
-		for (long iframe = 1; iframe <= numberOfFrames; iframe ++) {
-			double midTime = Sampled_indexToX (thee.peek(), iframe);
-			long midSample = Sampled_xToNearestIndex (me, midTime);
-			long leftSample = midSample - halfWindowSamples, rightSample = midSample + halfWindowSamples;
-			double sumxw = 0.0, sumw = 0.0, intensity;
-			if (leftSample < 1) leftSample = 1;
-			if (rightSample > my nx) rightSample = my nx;
-
-			for (long channel = 1; channel <= my ny; channel ++) {
-				for (long i = leftSample; i <= rightSample; i ++) {
-					amplitude [i - midSample] = my z [channel] [i];
-				}
-				if (subtractMeanPressure) {
-					double sum = 0.0;
-					for (long i = leftSample; i <= rightSample; i ++) {
-						sum += amplitude [i - midSample];
-					}
-					double mean = sum / (rightSample - leftSample + 1);
-					for (long i = leftSample; i <= rightSample; i ++) {
-						amplitude [i - midSample] -= mean;
-					}
-				}
-				for (long i = leftSample; i <= rightSample; i ++) {
-					sumxw += amplitude [i - midSample] * amplitude [i - midSample] * window [i - midSample];
-					sumw += window [i - midSample];
-				}
-			}
-			intensity = sumxw / sumw;
-			intensity /= 4e-10;
-			thy z [1] [iframe] = intensity < 1e-30 ? -300 : 10 * log10 (intensity);
-		}
+
+		const int numberOfThreads = MelderThread_computeNumberOfThreads (numberOfFrames, 2 * Sound_to_Intensity_FRAMES_PER_CHUNK);
+		autoSound_into_Intensity_Args args [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+		for (int ithread = 0; ithread < numberOfThreads; ithread ++)
+			args [ithread].reset (Sound_into_Intensity_Args_create (me, thee.peek(),
+				halfWindowSamples, window.peek(), windowSum, subtractMeanPressure));
+		MelderThread_run (Sound_into_Intensity, args, numberOfThreads, 1, numberOfFrames, Sound_to_Intensity_FRAMES_PER_CHUNK);
+
 		return thee.transfer();
 	} catch (MelderError) {
 		Melder_throw (me, U": intensity analysis not performed.");
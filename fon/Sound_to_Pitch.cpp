@@ -42,16 +42,73 @@
 #define FCC_NORMAL  2
 #define FCC_ACCURATE  3
 
-static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
+/*
+ * A LongSound is read in chunks of 10 seconds of frames,
+ * and the path finder decides its frames at the latest 10 seconds after their analysis.
+ */
+#define LongSound_to_Pitch_CHUNK_DURATION  10.0
+#define LongSound_to_Pitch_MAXIMUM_LOOKAHEAD  10.0
+#define LongSound_to_Pitch_SAMPLES_PER_BLOCK  65536
+
+/*
+ * The inner loop of the cross-correlation methods:
+ * product [lag] += sum (j = 1..n, x [j] * y [j + lag]) for lag = 0..7.
+ * With GCC or Clang, pairs of neighbouring lags share one vector register;
+ * every lane does the same arithmetic as the scalar loop, so the results are identical.
+ */
+#define Sound_to_Pitch_LAG_BLOCK  8
+
+#if defined (__GNUC__)
+	typedef double Sound_to_Pitch_pair __attribute__ ((vector_size (16), aligned (8), __may_alias__));
+	static void crossCorrelateLagBlock (double *x, double *y, long n, double product []) {
+		Sound_to_Pitch_pair sum01 = { product [0], product [1] }, sum23 = { product [2], product [3] };
+		Sound_to_Pitch_pair sum45 = { product [4], product [5] }, sum67 = { product [6], product [7] };
+		for (long j = 1; j <= n; j ++) {
+			double xj = x [j];
+			Sound_to_Pitch_pair xx = { xj, xj };
+			sum01 += xx * * (Sound_to_Pitch_pair *) & y [j];
+			sum23 += xx * * (Sound_to_Pitch_pair *) & y [j + 2];
+			sum45 += xx * * (Sound_to_Pitch_pair *) & y [j + 4];
+			sum67 += xx * * (Sound_to_Pitch_pair *) & y [j + 6];
+		}
+		product [0] = sum01 [0], product [1] = sum01 [1], product [2] = sum23 [0], product [3] = sum23 [1];
+		product [4] = sum45 [0], product [5] = sum45 [1], product [6] = sum67 [0], product [7] = sum67 [1];
+	}
+#else
+	static void crossCorrelateLagBlock (double *x, double *y, long n, double product []) {
+		double sum0 = product [0], sum1 = product [1], sum2 = product [2], sum3 = product [3];
+		double sum4 = product [4], sum5 = product [5], sum6 = product [6], sum7 = product [7];
+		for (long j = 1; j <= n; j ++) {
+			double xj = x [j];
+			sum0 += xj * y [j];
+			sum1 += xj * y [j + 1];
+			sum2 += xj * y [j + 2];
+			sum3 += xj * y [j + 3];
+			sum4 += xj * y [j + 4];
+			sum5 += xj * y [j + 5];
+			sum6 += xj * y [j + 6];
+			sum7 += xj * y [j + 7];
+		}
+		product [0] = sum0, product [1] = sum1, product [2] = sum2, product [3] = sum3;
+		product [4] = sum4, product [5] = sum5, product [6] = sum6, product [7] = sum7;
+	}
+#endif
+
+/*
+	The samples of `me` are samples `sampleOffset + 1` through `sampleOffset + my nx` of `source`,
+	which is the Sound itself (with a zero offset) or a LongSound.
+	Sample numbers are computed in `source`, so that they do not depend on where `me` starts.
+*/
+static void Sound_into_PitchFrame (Sound me, Sampled source, long sampleOffset, Pitch_Frame pitchFrame, double t,
 	double minimumPitch, int maxnCandidates, int method, double voicingThreshold, double octaveCost,
 	NUMfft_Table fftTable, double dt_window, long nsamp_window, long halfnsamp_window,
 	long maximumLag, long nsampFFT, long nsamp_period, long halfnsamp_period,
 	long brent_ixmax, long brent_depth, double globalPeak,
-	double **frame, double *ac, double *window, double *windowR,
+	double **frame, double **centred, double *ac, double *window, double *windowR,
 	double *r, long *imax, double *localMean)
 {
 	double localPeak;
-	long leftSample = Sampled_xToLowIndex (me, t), rightSample = leftSample + 1;
+	long leftSample = Sampled_xToLowIndex (source, t) - sampleOffset, rightSample = leftSample + 1;
 	long startSample, endSample;
 
 	for (long channel = 1; channel <= my ny; channel ++) {
@@ -107,34 +164,60 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 	if (method >= FCC_NORMAL) {
 		double startTime = t - 0.5 * (1.0 / minimumPitch + dt_window);
 		long localSpan = maximumLag + nsamp_window, localMaximumLag, offset;
-		if ((startSample = Sampled_xToLowIndex (me, startTime)) < 1) startSample = 1;
-		if (localSpan > my nx + 1 - startSample) localSpan = my nx + 1 - startSample;
+		if ((startSample = Sampled_xToLowIndex (source, startTime)) < 1) startSample = 1;
+		if (localSpan > source -> nx + 1 - startSample) localSpan = source -> nx + 1 - startSample;
 		localMaximumLag = localSpan - nsamp_window;
-		offset = startSample - 1;
+		offset = startSample - 1 - sampleOffset;
+		Melder_assert (offset >= 0);
+		Melder_assert (offset + localSpan <= my nx);
+		/*
+		 * Subtract the local mean once, instead of for every lag.
+		 */
+		for (long channel = 1; channel <= my ny; channel ++) {
+			double *amp = my z [channel] + offset, *c = centred [channel];
+			for (long i = 1; i <= localSpan; i ++)
+				c [i] = amp [i] - localMean [channel];
+		}
 		double sumx2 = 0;   // sum of squares
 		for (long channel = 1; channel <= my ny; channel ++) {
-			double *amp = my z [channel] + offset;
+			double *c = centred [channel];
 			for (long i = 1; i <= nsamp_window; i ++) {
-				double x = amp [i] - localMean [channel];
+				double x = c [i];
 				sumx2 += x * x;
 			}
 		}
 		double sumy2 = sumx2;   // at zero lag, these are still equal
 		r [0] = 1.0;
-		for (long i = 1; i <= localMaximumLag; i ++) {
-			double product = 0.0;
+		/*
+		 * Several lags at a time: every window sample is loaded once for all of their products,
+		 * and the sums do not wait for each other.
+		 * Each sum is still accumulated in the same order as with one lag at a time.
+		 */
+		for (long i = 1; i <= localMaximumLag; i += Sound_to_Pitch_LAG_BLOCK) {
+			long numberOfLags = localMaximumLag - i + 1 < Sound_to_Pitch_LAG_BLOCK ? localMaximumLag - i + 1 : Sound_to_Pitch_LAG_BLOCK;
+			double product [Sound_to_Pitch_LAG_BLOCK] = { 0.0 };
 			for (long channel = 1; channel <= my ny; channel ++) {
-				double *amp = my z [channel] + offset;
-				double y0 = amp [i] - localMean [channel];
-				double yZ = amp [i + nsamp_window] - localMean [channel];
-				sumy2 += yZ * yZ - y0 * y0;
-				for (long j = 1; j <= nsamp_window; j ++) {
-					double x = amp [j] - localMean [channel];
-					double y = amp [i + j] - localMean [channel];
-					product += x * y;
+				double *c = centred [channel], *y = c + i;
+				if (numberOfLags == Sound_to_Pitch_LAG_BLOCK) {
+					crossCorrelateLagBlock (c, y, nsamp_window, product);
+				} else {
+					for (long lag = 0; lag < numberOfLags; lag ++) {
+						double sum = product [lag];
+						for (long j = 1; j <= nsamp_window; j ++)
+							sum += c [j] * y [j + lag];
+						product [lag] = sum;
+					}
+				}
+			}
+			for (long lag = 0; lag < numberOfLags; lag ++) {
+				for (long channel = 1; channel <= my ny; channel ++) {
+					double *c = centred [channel];
+					double y0 = c [i + lag];
+					double yZ = c [i + lag + nsamp_window];
+					sumy2 += yZ * yZ - y0 * y0;
 				}
+				r [- (i + lag)] = r [i + lag] = product [lag] / sqrt (sumx2 * sumy2);
 			}
-			r [- i] = r [i] = product / sqrt (sumx2 * sumy2);
 		}
 	} else {
 
@@ -245,32 +328,37 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 
 Thing_define (Sound_into_Pitch_Args, Thing) { public:
 	Sound sound;
+	Sampled source;
+	long sampleOffset;
 	Pitch pitch;
-	long firstFrame, lastFrame;
 	double minimumPitch;
 	int maxnCandidates, method;
 	double voicingThreshold, octaveCost, dt_window;
 	long nsamp_window, halfnsamp_window, maximumLag, nsampFFT, nsamp_period, halfnsamp_period, brent_ixmax, brent_depth;
 	double globalPeak, *window, *windowR;
-	bool isMainThread;
-	volatile int *cancelled;
+	/*
+	 * The scratch buffers of one thread.
+	 */
+	autoNUMfft_Table fftTable;
+	autoNUMmatrix <double> frame, centred;
+	autoNUMvector <double> ac, r, localMean;
+	autoNUMvector <long> imax;
 };
 
 Thing_implement (Sound_into_Pitch_Args, Thing, 0);
 
 static Sound_into_Pitch_Args Sound_into_Pitch_Args_create (Sound sound, Pitch pitch,
-	long firstFrame, long lastFrame, double minimumPitch, int maxnCandidates, int method,
+	double minimumPitch, int maxnCandidates, int method,
 	double voicingThreshold, double octaveCost,
 	double dt_window, long nsamp_window, long halfnsamp_window, long maximumLag, long nsampFFT,
 	long nsamp_period, long halfnsamp_period, long brent_ixmax, long brent_depth,
-	double globalPeak, double *window, double *windowR,
-	bool isMainThread, volatile int *cancelled)
+	double globalPeak, double *window, double *windowR)
 {
 	autoSound_into_Pitch_Args me = Thing_new (Sound_into_Pitch_Args);
 	my sound = sound;
+	my source = sound;
+	my sampleOffset = 0;
 	my pitch = pitch;
-	my firstFrame = firstFrame;
-	my lastFrame = lastFrame;
 	my minimumPitch = minimumPitch;
 	my maxnCandidates = maxnCandidates;
 	my method = method;
@@ -288,60 +376,101 @@ static Sound_into_Pitch_Args Sound_into_Pitch_Args_create (Sound sound, Pitch pi
 	my globalPeak = globalPeak;
 	my window = window;
 	my windowR = windowR;
-	my isMainThread = isMainThread;
-	my cancelled = cancelled;
+	if (method >= FCC_NORMAL) {   // cross-correlation
+		my frame.reset (1, sound -> ny, 1, nsamp_window);
+		my centred.reset (1, sound -> ny, 1, maximumLag + nsamp_window);
+	} else {   // autocorrelation
+		NUMfft_Table_init (& my fftTable, nsampFFT);
+		my frame.reset (1, sound -> ny, 1, nsampFFT);
+		my ac.reset (1, nsampFFT);
+	}
+	my r.reset (- nsamp_window, nsamp_window);
+	my imax.reset (1, maxnCandidates);
+	my localMean.reset (1, sound -> ny);
 	return me.transfer();
 }
 
-MelderThread_MUTEX (mutex);
-bool mutex_inited;
-
-static MelderThread_RETURN_TYPE Sound_into_Pitch (Sound_into_Pitch_Args me)
+static void Sound_into_Pitch (Sound_into_Pitch_Args me, long firstFrame, long lastFrame)
 {
-	autoNUMfft_Table fftTable;
-	autoNUMmatrix <double> frame;
-	autoNUMvector <double> ac, r, localMean;
-	autoNUMvector <long> imax;
-	{// scope
-		MelderThread_LOCK (mutex);
-		if (my method >= FCC_NORMAL) {   // cross-correlation
-			frame.reset (1, my sound -> ny, 1, my nsamp_window);
-		} else {   // autocorrelation
-			NUMfft_Table_init (& fftTable, my nsampFFT);
-			frame.reset (1, my sound -> ny, 1, my nsampFFT);
-			ac.reset (1, my nsampFFT);
-		}
-		r.reset (- my nsamp_window, my nsamp_window);
-		imax.reset (1, my maxnCandidates);
-		localMean.reset (1, my sound -> ny);
-		MelderThread_UNLOCK (mutex);
-	}
-	for (long iframe = my firstFrame; iframe <= my lastFrame; iframe ++) {
+	for (long iframe = firstFrame; iframe <= lastFrame; iframe ++) {
 		Pitch_Frame pitchFrame = & my pitch -> frame [iframe];
 		double t = Sampled_indexToX (my pitch, iframe);
-		if (my isMainThread) {
-			try {
-				Melder_progress (0.1 + 0.8 * (iframe - my firstFrame) / (my lastFrame - my firstFrame),
-					U"Sound to Pitch: analysing ", my lastFrame, U" frames");
-			} catch (MelderError) {
-				*my cancelled = 1;
-				throw;
-			}
-		} else if (*my cancelled) {
-			MelderThread_RETURN;
-		}
-		Sound_into_PitchFrame (my sound, pitchFrame, t,
+		Sound_into_PitchFrame (my sound, my source, my sampleOffset, pitchFrame, t,
 			my minimumPitch, my maxnCandidates, my method, my voicingThreshold, my octaveCost,
-			& fftTable, my dt_window, my nsamp_window, my halfnsamp_window,
+			& my fftTable, my dt_window, my nsamp_window, my halfnsamp_window,
 			my maximumLag, my nsampFFT, my nsamp_period, my halfnsamp_period,
 			my brent_ixmax, my brent_depth, my globalPeak,
-			frame.peek(), ac.peek(), my window, my windowR,
-			r.peek(), imax.peek(), localMean.peek());
+			my frame.peek(), my centred.peek(), my ac.peek(), my window, my windowR,
+			my r.peek(), my imax.peek(), my localMean.peek());
 	}
-	MelderThread_RETURN;
 }
 
-Pitch Sound_to_Pitch_any (Sound me,
+static void Sound_into_Pitch_progress (Sound_into_Pitch_Args me, double fraction) {
+	Melder_progress (0.1 + 0.8 * fraction, U"Sound to Pitch: analysing ", my pitch -> nx, U" frames");
+}
+
+/*
+	The samples that the analysis of a frame at time `t` looks at: the local mean, the window,
+	and for cross-correlation the lags after the window.
+*/
+static void Sound_to_Pitch_getFrameSamples (Sampled source, double t, int method,
+	double minimumPitch, double dt_window, long nsamp_window, long halfnsamp_window, long maximumLag, long nsamp_period,
+	long *firstSample, long *lastSample)
+{
+	long leftSample = Sampled_xToLowIndex (source, t), rightSample = leftSample + 1;
+	long margin = nsamp_period > halfnsamp_window ? nsamp_period : halfnsamp_window;
+	*firstSample = rightSample - margin;
+	*lastSample = leftSample + margin;
+	if (method >= FCC_NORMAL) {
+		long startSample = Sampled_xToLowIndex (source, t - 0.5 * (1.0 / minimumPitch + dt_window));
+		if (startSample < 1) startSample = 1;
+		if (startSample < *firstSample) *firstSample = startSample;
+		if (startSample + maximumLag + nsamp_window - 1 > *lastSample) *lastSample = startSample + maximumLag + nsamp_window - 1;
+	}
+	if (*firstSample < 1) *firstSample = 1;
+	if (*lastSample > source -> nx) *lastSample = source -> nx;
+}
+
+/*
+	The global absolute peak, computed block by block,
+	with the same result as computing it from the whole Sound.
+*/
+static double LongSound_getGlobalPeak (LongSound me) {
+	long numberOfSamplesPerBlock = LongSound_to_Pitch_SAMPLES_PER_BLOCK;
+	autoNUMmatrix <double> block (1, my numberOfChannels, 1, numberOfSamplesPerBlock);
+	autoNUMvector <double> sum (1, my numberOfChannels), minimum (1, my numberOfChannels), maximum (1, my numberOfChannels);
+	for (long firstSample = 1; firstSample <= my nx; firstSample += numberOfSamplesPerBlock) {
+		long numberOfSamples = my nx - firstSample + 1 < numberOfSamplesPerBlock ? my nx - firstSample + 1 : numberOfSamplesPerBlock;
+		LongSound_readAudioToFloat (me, block.peek(), firstSample, numberOfSamples);
+		for (long channel = 1; channel <= my numberOfChannels; channel ++) {
+			double *z = block [channel];
+			if (firstSample == 1) minimum [channel] = maximum [channel] = z [1];
+			for (long i = 1; i <= numberOfSamples; i ++) {
+				double value = z [i];
+				sum [channel] += value;
+				if (value < minimum [channel]) minimum [channel] = value;
+				if (value > maximum [channel]) maximum [channel] = value;
+			}
+		}
+	}
+	/*
+	 * The largest absolute deviation from the mean is found at the maximum or at the minimum.
+	 */
+	double globalPeak = 0.0;
+	for (long channel = 1; channel <= my numberOfChannels; channel ++) {
+		double mean = sum [channel] / my nx;
+		double value = maximum [channel] - mean;
+		if (value > globalPeak) globalPeak = value;
+		value = mean - minimum [channel];
+		if (value > globalPeak) globalPeak = value;
+	}
+	return globalPeak;
+}
+
+/*
+	The analysis of a Sound (`sound` is `me`) or of a LongSound (`longSound` is `me`).
+*/
+static Pitch Sampled_to_Pitch_any (Sampled me, Sound sound, LongSound longSound,
 	double dt, double minimumPitch, double periodsPerWindow, int maxnCandidates,
 	int method,
 	double silenceThreshold, double voicingThreshold,
@@ -432,30 +561,39 @@ Pitch Sound_to_Pitch_any (Sound me,
 		/*
 		 * Create the resulting pitch contour.
 		 */
-		autoPitch thee = Pitch_create (my xmin, my xmax, nFrames, dt, t1, ceiling, maxnCandidates);
+		autoPitch thee = sound ?
+			Pitch_createPacked (my xmin, my xmax, nFrames, dt, t1, ceiling, maxnCandidates) :
+			Pitch_create (my xmin, my xmax, nFrames, dt, t1, ceiling, maxnCandidates);
 
 		/*
-		 * Create (too much) space for candidates.
+		 * Create (too much) space for candidates; for a Sound, this space is already in the packed block.
+		 * A LongSound gets this space chunk by chunk, and each frame gives it back as soon as it has been decided.
 		 */
-		for (long iframe = 1; iframe <= nFrames; iframe ++) {
-			Pitch_Frame pitchFrame = & thy frame [iframe];
-			Pitch_Frame_init (pitchFrame, maxnCandidates);
+		if (sound) {
+			for (long iframe = 1; iframe <= nFrames; iframe ++) {
+				Pitch_Frame pitchFrame = & thy frame [iframe];
+				Pitch_Frame_init (pitchFrame, maxnCandidates);
+			}
 		}
 
 		/*
 		 * Compute the global absolute peak for determination of silence threshold.
 		 */
-		globalPeak = 0.0;
-		for (long channel = 1; channel <= my ny; channel ++) {
-			double mean = 0.0;
-			for (long i = 1; i <= my nx; i ++) {
-				mean += my z [channel] [i];
-			}
-			mean /= my nx;
-			for (long i = 1; i <= my nx; i ++) {
-				double value = fabs (my z [channel] [i] - mean);
-				if (value > globalPeak) globalPeak = value;
+		if (sound) {
+			globalPeak = 0.0;
+			for (long channel = 1; channel <= sound -> ny; channel ++) {
+				double mean = 0.0;
+				for (long i = 1; i <= my nx; i ++) {
+					mean += sound -> z [channel] [i];
+				}
+				mean /= my nx;
+				for (long i = 1; i <= my nx; i ++) {
+					double value = fabs (sound -> z [channel] [i] - mean);
+					if (value > globalPeak) globalPeak = value;
+				}
 			}
+		} else {
+			globalPeak = LongSound_getGlobalPeak (longSound);
 		}
 		if (globalPeak == 0.0) {
 			return thee.transfer();
@@ -518,38 +656,79 @@ Pitch Sound_to_Pitch_any (Sound me,
 			brent_ixmax = (long) floor (nsamp_window * interpolation_depth);
 		}
 
-		autoMelderProgress progress (U"Sound to Pitch...");
-
-		long numberOfFramesPerThread = 20;
-		int numberOfThreads = (nFrames - 1) / numberOfFramesPerThread + 1;
-		const int numberOfProcessors = MelderThread_getNumberOfProcessors ();
-		trace (numberOfProcessors, U" processors");
-		if (numberOfThreads > numberOfProcessors) numberOfThreads = numberOfProcessors;
-		if (numberOfThreads > 16) numberOfThreads = 16;
-		if (numberOfThreads < 1) numberOfThreads = 1;
-		numberOfFramesPerThread = (nFrames - 1) / numberOfThreads + 1;
-
-		if (! mutex_inited) { MelderThread_MUTEX_INIT (mutex); mutex_inited = true; }
-		autoSound_into_Pitch_Args args [16];
-		long firstFrame = 1, lastFrame = numberOfFramesPerThread;
-		volatile int cancelled = 0;
-		for (int ithread = 1; ithread <= numberOfThreads; ithread ++) {
-			if (ithread == numberOfThreads) lastFrame = nFrames;
-			args [ithread - 1].reset (Sound_into_Pitch_Args_create (me, thee.peek(),
-				firstFrame, lastFrame, minimumPitch, maxnCandidates, method,
-				voicingThreshold, octaveCost,
-				dt_window, nsamp_window, halfnsamp_window, maximumLag,
-				nsampFFT, nsamp_period, halfnsamp_period, brent_ixmax, brent_depth,
-				globalPeak, window.peek(), windowR.peek(),
-				ithread == numberOfThreads, & cancelled));
-			firstFrame = lastFrame + 1;
-			lastFrame += numberOfFramesPerThread;
+		if (sound) {
+			autoMelderProgress progress (U"Sound to Pitch...");
+
+			const int numberOfThreads = MelderThread_computeNumberOfThreads (nFrames, 20);
+			trace (MelderThread_getNumberOfProcessors (), U" processors, ", numberOfThreads, U" threads");
+			autoSound_into_Pitch_Args args [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+			for (int ithread = 0; ithread < numberOfThreads; ithread ++) {
+				args [ithread].reset (Sound_into_Pitch_Args_create (sound, thee.peek(),
+					minimumPitch, maxnCandidates, method,
+					voicingThreshold, octaveCost,
+					dt_window, nsamp_window, halfnsamp_window, maximumLag,
+					nsampFFT, nsamp_period, halfnsamp_period, brent_ixmax, brent_depth,
+					globalPeak, window.peek(), windowR.peek()));
+			}
+			MelderThread_run (Sound_into_Pitch, args, numberOfThreads, 1, nFrames, 4, Sound_into_Pitch_progress);
+
+			Melder_progress (0.95, U"Sound to Pitch: path finder");
+			Pitch_pathFinder (thee.peek(), silenceThreshold, voicingThreshold,
+				octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling, Melder_debug == 31 ? true : false);
+		} else {
+			/*
+			 * Read, analyse and decide the frames chunk by chunk.
+			 * Only the samples of the current chunk are in memory,
+			 * and the path finder keeps the scores of the undecided frames only.
+			 */
+			autoMelderProgress progress (U"LongSound to Pitch...");
+			long numberOfFramesPerChunk = (long) ceil (LongSound_to_Pitch_CHUNK_DURATION / dt);
+			if (numberOfFramesPerChunk > nFrames) numberOfFramesPerChunk = nFrames;
+			long maximumLookahead = (long) ceil (LongSound_to_Pitch_MAXIMUM_LOOKAHEAD / dt);
+			autoPitch_PathFinder pathFinder = Pitch_PathFinder_create (thee.peek(), silenceThreshold, voicingThreshold,
+				octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling, Melder_debug == 31 ? true : false, maximumLookahead);
+
+			const int numberOfThreads = MelderThread_computeNumberOfThreads (numberOfFramesPerChunk, 20);
+			autoSound_into_Pitch_Args args [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+			for (long firstFrame = 1; firstFrame <= nFrames; firstFrame += numberOfFramesPerChunk) {
+				long lastFrame = firstFrame + numberOfFramesPerChunk - 1;
+				if (lastFrame > nFrames) lastFrame = nFrames;
+				long firstSample, lastSample, dummy;
+				Sound_to_Pitch_getFrameSamples (me, Sampled_indexToX (thee.peek(), firstFrame), method,
+					minimumPitch, dt_window, nsamp_window, halfnsamp_window, maximumLag, nsamp_period, & firstSample, & dummy);
+				Sound_to_Pitch_getFrameSamples (me, Sampled_indexToX (thee.peek(), lastFrame), method,
+					minimumPitch, dt_window, nsamp_window, halfnsamp_window, maximumLag, nsamp_period, & dummy, & lastSample);
+				long numberOfSamples = lastSample - firstSample + 1;
+				autoSound chunk = Sound_create (longSound -> numberOfChannels,
+					my x1 + (firstSample - 1.5) * my dx, my x1 + (lastSample - 0.5) * my dx,
+					numberOfSamples, my dx, my x1 + (firstSample - 1) * my dx);
+				LongSound_readAudioToFloat (longSound, chunk -> z, firstSample, numberOfSamples);
+
+				for (long iframe = firstFrame; iframe <= lastFrame; iframe ++)
+					Pitch_Frame_init (& thy frame [iframe], maxnCandidates);
+				for (int ithread = 0; ithread < numberOfThreads; ithread ++) {
+					if (! args [ithread].peek())
+						args [ithread].reset (Sound_into_Pitch_Args_create (chunk.peek(), thee.peek(),
+							minimumPitch, maxnCandidates, method,
+							voicingThreshold, octaveCost,
+							dt_window, nsamp_window, halfnsamp_window, maximumLag,
+							nsampFFT, nsamp_period, halfnsamp_period, brent_ixmax, brent_depth,
+							globalPeak, window.peek(), windowR.peek()));
+					args [ithread] -> sound = chunk.peek();
+					args [ithread] -> source = me;
+					args [ithread] -> sampleOffset = firstSample - 1;
+				}
+				MelderThread_run (Sound_into_Pitch, args, numberOfThreads, firstFrame, lastFrame, 4);
+				Pitch_PathFinder_addFrames (pathFinder.peek(), lastFrame);
+				Melder_progress ((double) lastFrame / nFrames, U"LongSound to Pitch: analysed ", lastFrame, U" of ", nFrames, U" frames");
+			}
+			Pitch_PathFinder_finish (pathFinder.peek());
 		}
-		MelderThread_run (Sound_into_Pitch, args, numberOfThreads);
 
-		Melder_progress (0.95, U"Sound to Pitch: path finder");
-		Pitch_pathFinder (thee.peek(), silenceThreshold, voicingThreshold,
-			octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling, Melder_debug == 31 ? true : false);
+		/*
+		 * Give back the room of the candidates that were not found.
+		 */
+		Pitch_packFrames (thee.peek());
 
 		return thee.transfer();
 	} catch (MelderError) {
@@ -557,6 +736,26 @@ Pitch Sound_to_Pitch_any (Sound me,
 	}
 }
 
+Pitch Sound_to_Pitch_any (Sound me,
+	double dt, double minimumPitch, double periodsPerWindow, int maxnCandidates,
+	int method,
+	double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double ceiling)
+{
+	return Sampled_to_Pitch_any (me, me, NULL, dt, minimumPitch, periodsPerWindow, maxnCandidates, method,
+		silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling);
+}
+
+Pitch LongSound_to_Pitch_any (LongSound me,
+	double dt, double minimumPitch, double periodsPerWindow, int maxnCandidates,
+	int method,
+	double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double ceiling)
+{
+	return Sampled_to_Pitch_any (me, NULL, me, dt, minimumPitch, periodsPerWindow, maxnCandidates, method,
+		silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling);
+}
+
 Pitch Sound_to_Pitch (Sound me, double timeStep, double minimumPitch, double maximumPitch) {
 	return Sound_to_Pitch_ac (me, timeStep, minimumPitch,
 		3.0, 15, FALSE, 0.03, 0.45, 0.01, 0.35, 0.14, maximumPitch);
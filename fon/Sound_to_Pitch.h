@@ -19,6 +19,7 @@
 
 #include "Sound.h"
 #include "Pitch.h"
+#include "LongSound.h"
 
 Pitch Sound_to_Pitch (Sound me, double timeStep,
 	double minimumPitch, double maximumPitch);
@@ -85,4 +86,15 @@ Pitch Sound_to_Pitch_any (Sound me,
 		pitches above a certain value "voiceless".
 */
 
+Pitch LongSound_to_Pitch_any (LongSound me, double dt, double minimumPitch, double periodsPerWindow,
+	int maxnCandidates, int method, double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double maximumPitch);
+/*
+	The same analysis as Sound_to_Pitch_any, for recordings that need not fit into memory.
+	The samples are read from the file chunk by chunk, and the path finder works in streaming mode
+	(see Pitch_PathFinder in Pitch.h), so that the frames are decided while the analysis proceeds.
+	The result is identical to that of Sound_to_Pitch_any on the same samples,
+	unless the candidate paths fail to converge within 10 seconds.
+*/
+
 /* End of file Sound_to_Pitch.h */
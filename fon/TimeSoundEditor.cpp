@@ -611,9 +611,9 @@ void TimeSoundEditor_drawSound (TimeSoundEditor me, double globalMinimum, double
 			Graphics_function (my d_graphics, sound -> z [ichan], first, last,
 				Sampled_indexToX (sound, first), Sampled_indexToX (sound, last));
 		} else {
-			Graphics_setWindow (my d_graphics, my d_startWindow, my d_endWindow, minimum * 32768, maximum * 32768);
-			Graphics_function16 (my d_graphics,
-				longSound -> buffer - longSound -> imin * nchan + (ichan - 1), nchan - 1, first, last,
+			Graphics_setWindow (my d_graphics, my d_startWindow, my d_endWindow, minimum, maximum);
+			Graphics_function (my d_graphics,
+				longSound -> buffer [ichan] + 1 - longSound -> imin, first, last,
 				Sampled_indexToX (longSound, first), Sampled_indexToX (longSound, last));
 		}
 		Graphics_resetViewport (my d_graphics, vp);
@@ -2191,6 +2191,33 @@ LIST_ITEM (U"• @@OTGrammar: Generate inputs...@")
 LIST_ITEM (U"• @@OTGrammar & Strings: Inputs to outputs...@")
 MAN_END
 
+MAN_BEGIN (U"Strings: Analyse sound files...", U"agent", 20261018)
+INTRO (U"A command to measure pitch, formants and intensity in every sound file whose name is in the selected @Strings object.")
+ENTRY (U"Settings")
+TAG (U"##Directory")
+DEFINITION (U"the directory that the file names are relative to. If you leave this empty, "
+	"the file names are relative to the directory of the script (or to the default directory, if you are not running a script).")
+TAG (U"##Time step (s)#, ##Pitch floor (Hz)#, ##Pitch ceiling (Hz)")
+DEFINITION (U"the settings for @@Sound: To Pitch...@. The pitch floor is also the minimum pitch of @@Sound: To Intensity...@.")
+TAG (U"##Max. number of formants#, ##Maximum formant (Hz)#, ##Window length (s)#, ##Pre-emphasis from (Hz)")
+DEFINITION (U"the settings for @@Sound: To Formant (burg)...@.")
+ENTRY (U"Behaviour")
+NORMAL (U"For every file, Praat does the same as a script that reads the file as a @Sound "
+	"and performs @@Sound: To Pitch...@, @@Sound: To Formant (burg)...@ and @@Sound: To Intensity...@ on it, "
+	"where the formant and intensity analyses use the time step of the pitch analysis. "
+	"Several files are analysed at the same time, one file per processor core.")
+ENTRY (U"Output")
+NORMAL (U"Two new @Table objects appear in the list. The first, called %%strings%\_frames, "
+	"has one row for every pitch frame of every file, in the order of the file names, "
+	"with the columns %file, %time, %F0, %F1, %F2, %F3 and %intensity. "
+	"Values that cannot be measured (e.g. the F0 of a voiceless frame) are undefined.")
+NORMAL (U"The second, called %%strings%\_files, has one row for every file, "
+	"with the columns %file, %duration, %frames (the number of pitch frames), %analysisTime (in seconds), and %error. "
+	"If a file cannot be read or analysed, it contributes no rows to the first table, "
+	"and its %error cell contains the error message; the other files are analysed as usual.")
+NORMAL (U"The Info window shows the number of files, their total duration, and the time that the analysis took.")
+MAN_END
+
 MAN_BEGIN (U"Strings: To Distributions", U"ppgb", 19971025)
 INTRO (U"A command to analyse each selected @Strings object into a @Distributions object.")
 NORMAL (U"The resulting #Distributions will collect the occurrences of every string in the #Strings object, "
@@ -3241,6 +3241,10 @@ DEFINITION (U"Don't activate the plugins at start-up.")
 TAG (U"##--pref-dir=#/var/www/praat_plugins")
 DEFINITION (U"Set the preferences directory to /var/www/praat_plugins (for instance). "
 	"This can come in handy if you require access to preference files and/or plugins that are not in your home directory.")
+TAG (U"##--threads=#8")
+DEFINITION (U"Let analyses such as @@Sound: To Pitch...@ use at most 8 threads (for instance). "
+	"The default, 0, means that Praat uses one thread per processor. "
+	"From a script, you can change this with ##Set number of threads...# in the Technical submenu of the Praat menu.")
 MAN_END
 
 MAN_BEGIN (U"Scripting 7. Scripting the editors", U"ppgb", 20040222)
@@ -955,7 +955,7 @@ NORMAL (U"where \\De%t is the sampling period of the sound. Every sample %x__%i_
 FORMULA (U"%x__%i_ = %x__%i_ - %\\al %x__%i-1_")
 MAN_END
 
-MAN_BEGIN (U"Sound: Resample...", U"ppgb", 20040330)
+MAN_BEGIN (U"Sound: Resample...", U"ppgb", 20261018)
 INTRO (U"A command that creates new @Sound objects from the selected Sounds.")
 ENTRY (U"Purpose")
 NORMAL (U"High-precision resampling from any sampling frequency to any other sampling frequency.")
@@ -966,13 +966,16 @@ TAG (U"##Precision")
 DEFINITION (U"the depth of the interpolation, in samples (standard is 50). "
 	"This determines the quality of the interpolation used in resampling.")
 ENTRY (U"Algorithm")
-NORMAL (U"If #Precision is 1, the method is linear interpolation, which is inaccurate but fast.")
-/* BUG */
-NORMAL (U"If #Precision is greater than 1, the method is sin(%x)/%x (\"%sinc\") interpolation, "
-	"with a depth equal to #Precision. "
+NORMAL (U"If #Precision is 1 and the new sampling frequency is higher than the old one, "
+	"the method is linear interpolation, which is inaccurate but fast.")
+NORMAL (U"Otherwise, the method is sin(%x)/%x (\"%sinc\") interpolation with a Hann window, "
+	"with a depth of #Precision zero crossings on either side (but at least 4 if you lower the sampling frequency). "
 	"For higher #Precision, the algorithm is slower but more accurate.")
 NORMAL (U"If ##Sampling frequency# is less than the sampling frequency of the selected sound, "
-	"an anti-aliasing low-pass filtering is performed prior to resampling.")
+	"the sinc function is stretched so that it also serves as an anti-aliasing low-pass filter at the new Nyquist frequency.")
+NORMAL (U"If the ratio of the two sampling frequencies is a simple fraction (such as 44100 to 16000 Hz, i.e. 441 to 160), "
+	"the filter weights are computed only once for each of the possible positions of a new sample between two old samples, "
+	"which makes resampling much faster. Long sounds are resampled in blocks, with multiple threads.")
 ENTRY (U"Behaviour")
 NORMAL (U"A new Sound will appear in the list of objects, "
 	"bearing the same name as the original Sound, followed by the sampling frequency. "
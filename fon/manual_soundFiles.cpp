@@ -341,7 +341,7 @@ LIST_ITEM (U"• @@Save as NIST file...@ (little-endian)")
 LIST_ITEM (U"• @@Save as FLAC file...@")
 MAN_END
 
-MAN_BEGIN (U"LongSound", U"ppgb", 20110131)
+MAN_BEGIN (U"LongSound", U"ppgb", 20261018)
 INTRO (U"One of the @@types of objects@ in Praat. See the @@Sound files@ tutorial.")
 NORMAL (U"A LongSound object gives you the ability to view and label "
 	"a sound file that resides on disk. You will want to use it for sounds "
@@ -364,6 +364,12 @@ LIST_ITEM (U"1. Select the LongSound object.")
 LIST_ITEM (U"2. Choose @@LongSound: To TextGrid...@ and specify your tiers.")
 LIST_ITEM (U"3. Select the resulting @TextGrid object together with the LongSound object, and click ##View & Edit#.")
 NORMAL (U"A @TextGridEditor will appear on the screen, with a copy of the LongSound object in it.")
+ENTRY (U"How to analyse the pitch of a LongSound object")
+NORMAL (U"The commands ##To Pitch (ac)...# and ##To Pitch (cc)...# from the ##Analyse periodicity# menu "
+	"work like @@Sound: To Pitch (ac)...@ and @@Sound: To Pitch (cc)...@, "
+	"but read the sound file piece by piece, so that the recording does not have to fit into memory. "
+	"The resulting @Pitch object is the same as when you analyse the whole sound as a @Sound object, "
+	"except in the rare case that the path finder has not been able to decide between candidate paths for over 10 seconds.")
 ENTRY (U"Limitations")
 NORMAL (U"The length of the sound file is limited to 2 gigabytes, which is 3 hours of CD-quality stereo, "
 	"or 12 hours 16-bit mono sampled at 22050 Hz.")
@@ -3154,6 +3154,7 @@ LIST_ITEM (U"• @@Write to console")
 LIST_ITEM (U"• @@Save as text file...")
 LIST_ITEM (U"• @@Save as short text file...")
 LIST_ITEM (U"• @@Save as binary file...")
+LIST_ITEM (U"• @@Save as mapped binary file...")
 ENTRY (U"Dynamic commands")
 NORMAL (U"Depending on the type of the selected object, the following commands may be available "
 	"in the #Save menu:")
@@ -3173,6 +3174,22 @@ NORMAL (U"These files are in a device-independent binary format, "
 	"and can be written and read on any machine.")
 MAN_END
 
+MAN_BEGIN (U"Save as mapped binary file...", U"agent", 20261018)
+INTRO (U"One of the commands in the @@Save menu@.")
+ENTRY (U"Availability")
+NORMAL (U"You can choose this command after selecting one or more @objects.")
+ENTRY (U"Behaviour")
+NORMAL (U"As @@Save as binary file...@, but the file is meant for large objects such as long Sounds and Spectrograms. "
+	"When you read it again with @@Read from file...@, Praat does not read the numbers of the objects from disk at once, "
+	"but only when they are used (e.g. when you query or draw a part of a Sound), so that the objects appear at once, "
+	"whatever the size of the file.")
+NORMAL (U"If you change such an object, the changed numbers stay in memory; the file itself is never changed. "
+	"You can safely save the object to the same file again.")
+ENTRY (U"File format")
+NORMAL (U"The numbers are in the byte order of Intel and ARM processors. "
+	"The files can be read on any machine, but on other machines the numbers are read from disk at once.")
+MAN_END
+
 MAN_BEGIN (U"Save as short text file...", U"ppgb", 20110129)
 INTRO (U"One of the commands in the @@Save menu@.")
 ENTRY (U"Availability")
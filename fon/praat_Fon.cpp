@@ -39,6 +39,7 @@
 #include "Matrix_and_Pitch.h"
 #include "Matrix_and_PointProcess.h"
 #include "Matrix_and_Polygon.h"
+#include "MelderThread.h"
 #include "MovieWindow.h"
 #include "ParamCurve.h"
 #include "Photo.h"
@@ -56,6 +57,7 @@
 #include "Sound_and_Spectrogram.h"
 #include "Sound_and_Spectrum.h"
 #include "Sound_PointProcess.h"
+#include "SoundFileBatch.h"
 #include "SpectrogramEditor.h"
 #include "Spectrum_and_Spectrogram.h"
 #include "Spectrum_to_Excitation.h"
@@ -1778,6 +1780,21 @@ END
 
 DIRECT (Intensity_help) Melder_help (U"Intensity"); END
 
+DIRECT (Intensity_listValuesInAllFrames)
+	Intensity me = FIRST (Intensity);
+	if (interpreter && interpreter -> numericArrayQueryResult) {
+		autoNUMmatrix <double> values (1, my nx, 1, 1);
+		for (long iframe = 1; iframe <= my nx; iframe ++)
+			values [iframe] [1] = my z [1] [iframe];
+		Interpreter_returnNumericArray (interpreter, values.transfer(), my nx, 1);
+	} else {
+		MelderInfo_open ();
+		for (long iframe = 1; iframe <= my nx; iframe ++)
+			MelderInfo_writeLine (Melder_double (my z [1] [iframe]));
+		MelderInfo_close ();
+	}
+END
+
 DIRECT (Intensity_to_IntensityTier_peaks)
 	LOOP {
 		iam (Intensity);
@@ -3660,6 +3677,27 @@ END
 
 DIRECT (Pitch_help) Melder_help (U"Pitch"); END
 
+FORM (Pitch_listValuesInAllFrames, U"Pitch: List values in all frames", 0)
+	OPTIONMENU_ENUM (U"Unit", kPitch_unit, DEFAULT)
+	OK
+DO
+	enum kPitch_unit unit = GET_ENUM (kPitch_unit, U"Unit");
+	Pitch me = FIRST (Pitch);
+	autoNUMmatrix <double> values (1, my nx, 1, 1);
+	for (long iframe = 1; iframe <= my nx; iframe ++) {
+		double value = Sampled_getValueAtSample (me, iframe, Pitch_LEVEL_FREQUENCY, unit);
+		values [iframe] [1] = Function_convertToNonlogarithmic (me, value, Pitch_LEVEL_FREQUENCY, unit);
+	}
+	if (interpreter && interpreter -> numericArrayQueryResult) {
+		Interpreter_returnNumericArray (interpreter, values.transfer(), my nx, 1);
+	} else {
+		MelderInfo_open ();
+		for (long iframe = 1; iframe <= my nx; iframe ++)
+			MelderInfo_writeLine (Melder_double (values [iframe] [1]));
+		MelderInfo_close ();
+	}
+END
+
 DIRECT (Pitch_hum)
 	LOOP {
 		iam (Pitch);
@@ -5887,6 +5925,49 @@ DIRECT (Strings_to_Distributions)
 	}
 END
 
+FORM (Strings_analyseSoundFiles, U"Strings: Analyse sound files", U"Strings: Analyse sound files...")
+	LABEL (U"", U"The strings are file names, relative to:")
+	TEXTFIELD (U"Directory", U"")
+	REAL (U"Time step (s)", U"0.0 (= auto)")
+	POSITIVE (U"Pitch floor (Hz)", U"75.0")
+	POSITIVE (U"Pitch ceiling (Hz)", U"600.0")
+	POSITIVE (U"Max. number of formants", U"5")
+	REAL (U"Maximum formant (Hz)", U"5500 (= adult female)")
+	POSITIVE (U"Window length (s)", U"0.025")
+	POSITIVE (U"Pre-emphasis from (Hz)", U"50")
+	OK
+DO
+	LOOP {
+		iam (Strings);
+		double startingTime = Melder_clock ();
+		Table files_;
+		autoTable frames = SoundFileBatch_analyse (me, GET_STRING (U"Directory"),
+			GET_REAL (U"Time step"), GET_REAL (U"Pitch floor"), GET_REAL (U"Pitch ceiling"),
+			GET_REAL (U"Max. number of formants"), GET_REAL (U"Maximum formant"),
+			GET_REAL (U"Window length"), GET_REAL (U"Pre-emphasis from"), & files_);
+		autoTable files = files_;
+		double elapsedTime = Melder_clock () - startingTime;
+		long numberOfFailures = 0;
+		double totalDuration = 0.0;
+		for (long ifile = 1; ifile <= files -> rows -> size; ifile ++) {
+			if (Table_getStringValue_Assert (files.peek(), ifile, 5) [0] != U'\0')
+				numberOfFailures ++;
+			else
+				totalDuration += Table_getNumericValue_Assert (files.peek(), ifile, 2);
+		}
+		MelderInfo_open ();
+		MelderInfo_writeLine (U"Sound files: ", files -> rows -> size, U" (", numberOfFailures, U" failed)");
+		MelderInfo_writeLine (U"Total duration: ", Melder_fixed (totalDuration, 3), U" seconds");
+		MelderInfo_writeLine (U"Elapsed time: ", Melder_fixed (elapsedTime, 3), U" seconds, with up to ", MelderThread_getNumberOfThreads (), U" threads");
+		if (elapsedTime > 0.0)
+			MelderInfo_writeLine (U"Throughput: ", Melder_fixed (files -> rows -> size / elapsedTime, 2), U" files per second, ",
+				Melder_fixed (totalDuration / elapsedTime, 1), U" times real time");
+		MelderInfo_close ();
+		praat_new (frames.transfer(), my name, U"_frames");
+		praat_new (files.transfer(), my name, U"_files");
+	}
+END
+
 DIRECT (Strings_to_WordList)
 	LOOP {
 		iam (Strings);
@@ -6595,6 +6676,7 @@ praat_addAction1 (classFormantTier, 0, U"Down", 0, 0, 0);
 		praat_addAction1 (classIntensity, 1, U"-- get content --", 0, 1, 0);
 		praat_addAction1 (classIntensity, 1, U"Get value at time...", 0, 1, DO_Intensity_getValueAtTime);
 		praat_addAction1 (classIntensity, 1, U"Get value in frame...", 0, 1, DO_Intensity_getValueInFrame);
+		praat_addAction1 (classIntensity, 1, U"List values in all frames", 0, 1, DO_Intensity_listValuesInAllFrames);
 		praat_addAction1 (classIntensity, 1, U"-- get extreme --", 0, 1, 0);
 		praat_addAction1 (classIntensity, 1, U"Get minimum...", 0, 1, DO_Intensity_getMinimum);
 		praat_addAction1 (classIntensity, 1, U"Get time of minimum...", 0, 1, DO_Intensity_getTimeOfMinimum);
@@ -6821,6 +6903,7 @@ praat_addAction1 (classMatrix, 0, U"Analyse", 0, 0, 0);
 		praat_addAction1 (classPitch, 1, U"Count voiced frames", 0, 1, DO_Pitch_getNumberOfVoicedFrames);
 		praat_addAction1 (classPitch, 1, U"Get value at time...", 0, 1, DO_Pitch_getValueAtTime);
 		praat_addAction1 (classPitch, 1, U"Get value in frame...", 0, 1, DO_Pitch_getValueInFrame);
+		praat_addAction1 (classPitch, 1, U"List values in all frames...", 0, 1, DO_Pitch_listValuesInAllFrames);
 		praat_addAction1 (classPitch, 1, U"-- get extreme --", 0, 1, 0);
 		praat_addAction1 (classPitch, 1, U"Get minimum...", 0, 1, DO_Pitch_getMinimum);
 		praat_addAction1 (classPitch, 1, U"Get time of minimum...", 0, 1, DO_Pitch_getTimeOfMinimum);
@@ -7071,6 +7154,7 @@ praat_addAction1 (classPolygon, 0, U"Hack -", 0, 0, 0);
 		praat_addAction1 (classStrings, 0, U"Nativize", 0, 1, DO_Strings_nativize);
 	praat_addAction1 (classStrings, 0, U"Analyze", 0, 0, 0);
 		praat_addAction1 (classStrings, 0, U"To Distributions", 0, 0, DO_Strings_to_Distributions);
+		praat_addAction1 (classStrings, 1, U"Analyse sound files...", 0, 0, DO_Strings_analyseSoundFiles);
 	praat_addAction1 (classStrings, 0, U"Synthesize", 0, 0, 0);
 		praat_addAction1 (classStrings, 0, U"To WordList", 0, 0, DO_Strings_to_WordList);
 
@@ -171,6 +171,62 @@ DO
 	}
 END2 }
 
+FORM (LongSound_to_Pitch_ac, U"LongSound: To Pitch (ac)", U"Sound: To Pitch (ac)...") {
+	LABEL (U"", U"Finding the candidates")
+	REAL (U"Time step (s)", U"0.0 (= auto)")
+	POSITIVE (U"Pitch floor (Hz)", U"75.0")
+	NATURAL (U"Max. number of candidates", U"15")
+	BOOLEAN (U"Very accurate", 0)
+	LABEL (U"", U"Finding a path")
+	REAL (U"Silence threshold", U"0.03")
+	REAL (U"Voicing threshold", U"0.45")
+	REAL (U"Octave cost", U"0.01")
+	REAL (U"Octave-jump cost", U"0.35")
+	REAL (U"Voiced / unvoiced cost", U"0.14")
+	POSITIVE (U"Pitch ceiling (Hz)", U"600.0")
+	OK2
+DO
+	long maxnCandidates = GET_INTEGER (U"Max. number of candidates");
+	if (maxnCandidates <= 1) Melder_throw (U"Maximum number of candidates must be greater than 1.");
+	LOOP {
+		iam (LongSound);
+		autoPitch thee = LongSound_to_Pitch_any (me, GET_REAL (U"Time step"),
+			GET_REAL (U"Pitch floor"), 3.0, maxnCandidates, GET_INTEGER (U"Very accurate"),
+			GET_REAL (U"Silence threshold"), GET_REAL (U"Voicing threshold"),
+			GET_REAL (U"Octave cost"), GET_REAL (U"Octave-jump cost"),
+			GET_REAL (U"Voiced / unvoiced cost"), GET_REAL (U"Pitch ceiling"));
+		praat_new (thee.transfer(), my name);
+	}
+END2 }
+
+FORM (LongSound_to_Pitch_cc, U"LongSound: To Pitch (cc)", U"Sound: To Pitch (cc)...") {
+	LABEL (U"", U"Finding the candidates")
+	REAL (U"Time step (s)", U"0.0 (= auto)")
+	POSITIVE (U"Pitch floor (Hz)", U"75")
+	NATURAL (U"Max. number of candidates", U"15")
+	BOOLEAN (U"Very accurate", 0)
+	LABEL (U"", U"Finding a path")
+	REAL (U"Silence threshold", U"0.03")
+	REAL (U"Voicing threshold", U"0.45")
+	REAL (U"Octave cost", U"0.01")
+	REAL (U"Octave-jump cost", U"0.35")
+	REAL (U"Voiced / unvoiced cost", U"0.14")
+	POSITIVE (U"Pitch ceiling (Hz)", U"600")
+	OK2
+DO
+	long maxnCandidates = GET_INTEGER (U"Max. number of candidates");
+	if (maxnCandidates <= 1) Melder_throw (U"Maximum number of candidates must be greater than 1.");
+	LOOP {
+		iam (LongSound);
+		autoPitch thee = LongSound_to_Pitch_any (me, GET_REAL (U"Time step"),
+			GET_REAL (U"Pitch floor"), 1.0, maxnCandidates, 2 + GET_INTEGER (U"Very accurate"),
+			GET_REAL (U"Silence threshold"), GET_REAL (U"Voicing threshold"),
+			GET_REAL (U"Octave cost"), GET_REAL (U"Octave-jump cost"),
+			GET_REAL (U"Voiced / unvoiced cost"), GET_REAL (U"Pitch ceiling"));
+		praat_new (thee.transfer(), my name);
+	}
+END2 }
+
 DIRECT2 (LongSound_view) {
 	if (theCurrentPraatApplication -> batch) Melder_throw (U"Cannot view or edit a LongSound from batch.");
 	LOOP {
@@ -2363,6 +2419,9 @@ void praat_uvafon_Sound_init (void) {
 		praat_addAction1 (classLongSound, 0, U"Annotation tutorial", 0, 1, DO_AnnotationTutorial);
 		praat_addAction1 (classLongSound, 0, U"-- to text grid --", 0, 1, 0);
 		praat_addAction1 (classLongSound, 0, U"To TextGrid...", 0, 1, DO_LongSound_to_TextGrid);
+	praat_addAction1 (classLongSound, 0, U"Analyse periodicity -", 0, 0, 0);
+		praat_addAction1 (classLongSound, 0, U"To Pitch (ac)...", 0, 1, DO_LongSound_to_Pitch_ac);
+		praat_addAction1 (classLongSound, 0, U"To Pitch (cc)...", 0, 1, DO_LongSound_to_Pitch_cc);
 	praat_addAction1 (classLongSound, 0, U"Convert to Sound", 0, 0, 0);
 	praat_addAction1 (classLongSound, 0, U"Extract part...", 0, 0, DO_LongSound_extractPart);
 	praat_addAction1 (classLongSound, 0, U"Concatenate?", 0, 0, DO_LongSound_concatenate);
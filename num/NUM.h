@@ -409,6 +409,16 @@ double ** NUMmatrix_readBinary_r8 (long r1, long r2, long c1, long c2, FILE *f);
 	Throw an error message if anything went wrong.
 */
 
+extern thread_local bool NUMmatrix_mapBinary;
+/*
+	While this is on, NUMmatrix_writeBinary_r8 writes the elements as little-endian IEEE numbers,
+	the native format of nearly all current machines, starting at a multiple of 8 bytes from the start of the file;
+	NUMmatrix_readBinary_r8 then maps them copy-on-write into memory with MelderFile_map () instead of reading them,
+	so that they come from disk only when they are used. NUMmatrix_free releases the mapping.
+	Switched on and off by Data_writeToMappedBinaryFile () and Data_readFromBinaryFile ().
+	The switch is per thread, so that files that are read or written on other threads at the same time keep their own format.
+*/
+
 typedef struct structNUMlinprog *NUMlinprog;
 void NUMlinprog_delete (NUMlinprog me);
 NUMlinprog NUMlinprog_new (bool maximize);
@@ -173,7 +173,8 @@ void * NUMmatrix (long elementSize, long row1, long row2, long col1, long col2)
 void NUMmatrix_free (long elementSize, void *m, long row1, long col1) {
 	if (m == NULL) return;
 	char *dummy1 = ((char **) m) [row1] + col1 * elementSize;
-	Melder_free (dummy1);
+	if (! Melder_unmap (dummy1))   // the cells of a matrix from a mapped binary file
+		Melder_free (dummy1);
 	char **dummy2 = (char **) m + row1;
 	Melder_free (dummy2);
 	theTotalNumberOfArrays -= 1;
@@ -209,17 +210,106 @@ bool NUMmatrix_equal (long elementSize, void *m1, void *m2, long row1, long row2
 
 /*** Typed I/O routines for vectors and matrices. ***/
 
+/*
+	Binary and text I/O of a row of elements. Real numbers go in blocks; the other types one by one.
+*/
 #define FUNCTION(type,storage)  \
+	static void binget##storage##_row (type *x, long n, FILE *f) { \
+		for (long i = 0; i < n; i ++) x [i] = binget##storage (f); \
+	} \
+	static void binput##storage##_row (const type *x, long n, FILE *f) { \
+		for (long i = 0; i < n; i ++) binput##storage (x [i], f); \
+	} \
+	static void texput##storage##_row (MelderFile file, const type *x, long lo, long hi, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4) { \
+		autostring32 label3 = Melder_dup (s3);   /* because Melder_integer () reuses its buffers */ \
+		for (long i = lo; i <= hi; i ++) texput##storage (file, x [i], s1, s2, label3.peek (), s4, Melder_integer (i), U"]"); \
+	}
+FUNCTION (signed char, i1)
+FUNCTION (int, i2)
+FUNCTION (long, i4)
+FUNCTION (unsigned char, u1)
+FUNCTION (unsigned int, u2)
+FUNCTION (unsigned long, u4)
+FUNCTION (fcomplex, c8)
+FUNCTION (dcomplex, c16)
+#undef FUNCTION
+#define bingetr4_row  bingetr4s
+#define binputr4_row  binputr4s
+#define bingetr8_row  bingetr8s
+#define binputr8_row  binputr8s
+#define texputr4_row  texputr4s
+#define texputr8_row  texputr8s
+
+/*
+	Matrices in mapped binary files.
+*/
+thread_local bool NUMmatrix_mapBinary = false;
+
+static bool NUM_isLittleEndian () {
+	const uint16_t one = 1;
+	return * (const unsigned char *) & one == 1;
+}
+
+static void NUMmatrix_writeMapped (long elementSize, void *m, long row1, long row2, long col1, long col2, FILE *f) {
+	for (long position = ftell (f); position % 8 != 0; position ++)
+		fputc (0, f);
+	long rowSize = (col2 - col1 + 1) * elementSize;
+	for (long irow = row1; irow <= row2; irow ++) {
+		const char *row = ((char **) m) [irow] + col1 * elementSize;
+		if (NUM_isLittleEndian ()) {
+			fwrite (row, 1, rowSize, f);
+		} else {
+			for (long ibyte = 0; ibyte < rowSize; ibyte += elementSize)
+				for (long i = elementSize - 1; i >= 0; i --) fputc (row [ibyte + i], f);
+		}
+	}
+}
+
+static void * NUMmatrix_readMapped (long elementSize, long row1, long row2, long col1, long col2, FILE *f) {
+	long position = ftell (f);
+	position += (8 - position % 8) % 8;
+	int64 numberOfCells = (int64) (row2 - row1 + 1) * (col2 - col1 + 1);
+	char *cells = NUM_isLittleEndian () ? (char *) MelderFile_map (f, position, numberOfCells * elementSize) : NULL;
+	if (! cells) {
+		/*
+			Not mappable here (e.g. on a big-endian machine, or if the file is too short):
+			an ordinary matrix, filled from the file.
+		*/
+		fseek (f, position, SEEK_SET);
+		char **result = (char **) NUMmatrix (elementSize, row1, row2, col1, col2);
+		char *first = result [row1] + col1 * elementSize;
+		if ((int64) fread (first, elementSize, numberOfCells, f) != numberOfCells) {
+			NUMmatrix_free (elementSize, result, row1, col1);
+			Melder_throw (U"Early end of file.");
+		}
+		if (! NUM_isLittleEndian ())
+			for (char *cell = first; cell < first + numberOfCells * elementSize; cell += elementSize)
+				for (long i = 0, j = elementSize - 1; i < j; i ++, j --) { char b = cell [i]; cell [i] = cell [j]; cell [j] = b; }
+		return result;
+	}
+	fseek (f, position + numberOfCells * elementSize, SEEK_SET);
+	char **result = NULL;
+	try {
+		result = (char **) Melder_malloc (char *, row2 - row1 + 1) - row1;
+	} catch (MelderError) {
+		Melder_unmap (cells);
+		throw;
+	}
+	result [row1] = cells - col1 * elementSize;   // as in NUMmatrix (), so that NUMmatrix_free () finds the cells
+	for (long irow = row1 + 1; irow <= row2; irow ++) result [irow] = result [irow - 1] + (col2 - col1 + 1) * elementSize;
+	theTotalNumberOfArrays += 1;
+	return result;
+}
+
+#define FUNCTION(type,storage,mappable)  \
 	void NUMvector_writeText_##storage (const type *v, long lo, long hi, MelderFile file, const char32 *name) { \
 		texputintro (file, name, U" []: ", hi >= lo ? NULL : U"(empty)", 0,0,0); \
-		for (long i = lo; i <= hi; i ++) \
-			texput##storage (file, v [i], name, U" [", Melder_integer (i), U"]", 0,0); \
+		if (hi >= lo) texput##storage##_row (file, v, lo, hi, name, U" [", NULL, NULL); \
 		texexdent (file); \
 		if (feof (file -> filePointer) || ferror (file -> filePointer)) Melder_throw (U"Write error."); \
 	} \
 	void NUMvector_writeBinary_##storage (const type *v, long lo, long hi, FILE *f) { \
-		for (long i = lo; i <= hi; i ++) \
-			binput##storage (v [i], f); \
+		if (hi >= lo) binput##storage##_row (v + lo, hi - lo + 1, f); \
 		if (feof (f) || ferror (f)) Melder_throw (U"Write error."); \
 	} \
 	type * NUMvector_readText_##storage (long lo, long hi, MelderReadText text, const char *name) { \
@@ -243,9 +333,7 @@ bool NUMmatrix_equal (long elementSize, void *m1, void *m2, long row1, long row2
 		type *result = NULL; \
 		try { \
 			result = NUMvector <type> (lo, hi); \
-			for (long i = lo; i <= hi; i ++) { \
-				result [i] = binget##storage (f); \
-			} \
+			if (hi >= lo) binget##storage##_row (result + lo, hi - lo + 1, f); \
 			return result; \
 		} catch (MelderError) { \
 			NUMvector_free (result, lo); \
@@ -257,9 +345,7 @@ bool NUMmatrix_equal (long elementSize, void *m1, void *m2, long row1, long row2
 		if (row2 >= row1) { \
 			for (long irow = row1; irow <= row2; irow ++) { \
 				texputintro (file, name, U" [", Melder_integer (irow), U"]:", 0,0); \
-				for (long icol = col1; icol <= col2; icol ++) { \
-					texput##storage (file, m [irow] [icol], name, U" [", Melder_integer (irow), U"] [", Melder_integer (icol), U"]"); \
-				} \
+				if (col2 >= col1) texput##storage##_row (file, m [irow], col1, col2, name, U" [", Melder_integer (irow), U"] ["); \
 				texexdent (file); \
 			} \
 		} \
@@ -267,11 +353,11 @@ bool NUMmatrix_equal (long elementSize, void *m1, void *m2, long row1, long row2
 		if (feof (file -> filePointer) || ferror (file -> filePointer)) Melder_throw (U"Write error."); \
 	} \
 	void NUMmatrix_writeBinary_##storage (type **m, long row1, long row2, long col1, long col2, FILE *f) { \
-		if (row2 >= row1) { \
-			for (long irow = row1; irow <= row2; irow ++) { \
-				for (long icol = col1; icol <= col2; icol ++) \
-					binput##storage (m [irow] [icol], f); \
-			} \
+		if (mappable && NUMmatrix_mapBinary && row2 >= row1 && col2 >= col1) { \
+			NUMmatrix_writeMapped (sizeof (type), m, row1, row2, col1, col2, f); \
+		} else if (row2 >= row1) { \
+			for (long irow = row1; irow <= row2; irow ++) \
+				binput##storage##_row (m [irow] + col1, col2 - col1 + 1, f); \
 		} \
 		if (feof (f) || ferror (f)) Melder_throw (U"Write error."); \
 	} \
@@ -295,9 +381,11 @@ bool NUMmatrix_equal (long elementSize, void *m1, void *m2, long row1, long row2
 	type ** NUMmatrix_readBinary_##storage (long row1, long row2, long col1, long col2, FILE *f) { \
 		type **result = NULL; \
 		try { \
+			if (mappable && NUMmatrix_mapBinary && row2 >= row1 && col2 >= col1) \
+				return (type **) NUMmatrix_readMapped (sizeof (type), row1, row2, col1, col2, f); \
 			result = NUMmatrix <type> (row1, row2, col1, col2); \
-			for (long irow = row1; irow <= row2; irow ++) for (long icol = col1; icol <= col2; icol ++) \
-				result [irow] [icol] = binget##storage (f); \
+			if (row2 >= row1 && col2 >= col1)   /* the rows are contiguous */ \
+				binget##storage##_row (result [row1] + col1, (row2 - row1 + 1) * (col2 - col1 + 1), f); \
 			return result; \
 		} catch (MelderError) { \
 			NUMmatrix_free (result, row1, col1); \
@@ -305,16 +393,16 @@ bool NUMmatrix_equal (long elementSize, void *m1, void *m2, long row1, long row2
 		} \
 	}
 
-FUNCTION (signed char, i1)
-FUNCTION (int, i2)
-FUNCTION (long, i4)
-FUNCTION (unsigned char, u1)
-FUNCTION (unsigned int, u2)
-FUNCTION (unsigned long, u4)
-FUNCTION (double, r4)
-FUNCTION (double, r8)
-FUNCTION (fcomplex, c8)
-FUNCTION (dcomplex, c16)
+FUNCTION (signed char, i1, false)
+FUNCTION (int, i2, false)
+FUNCTION (long, i4, false)
+FUNCTION (unsigned char, u1, false)
+FUNCTION (unsigned int, u2, false)
+FUNCTION (unsigned long, u4, false)
+FUNCTION (double, r4, false)
+FUNCTION (double, r8, true)
+FUNCTION (fcomplex, c8, false)
+FUNCTION (dcomplex, c16, false)
 #undef FUNCTION
 
 /* End of file NUMarrays.cpp */
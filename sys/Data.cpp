@@ -153,25 +153,44 @@ void Data_writeBinary (Data me, FILE *f) {
 		Melder_throw (U"I/O error.");
 }
 
-void Data_writeToBinaryFile (Data me, MelderFile file) {
+static void _Data_writeToBinaryFile (Data me, MelderFile file, bool mapped) {
+	if (! Data_canWriteBinary (me))
+		Melder_throw (U"Objects of class ", my classInfo -> className, U" cannot be written to a generic binary file.");
+	autoMelderFile mfile = MelderFile_create (file);
+	if (fprintf (file -> filePointer, mapped ? "ooMappedBinaryFile" : "ooBinaryFile") < 0)
+		Melder_throw (U"Cannot write first bytes of file.");
+	binputw1 (
+		my classInfo -> version > 0 ?
+			Melder_cat (my classInfo -> className, U" ", my classInfo -> version) :
+			my classInfo -> className,
+		file -> filePointer);
+	NUMmatrix_mapBinary = mapped;
 	try {
-		if (! Data_canWriteBinary (me))
-			Melder_throw (U"Objects of class ", my classInfo -> className, U" cannot be written to a generic binary file.");
-		autoMelderFile mfile = MelderFile_create (file);
-		if (fprintf (file -> filePointer, "ooBinaryFile") < 0)
-			Melder_throw (U"Cannot write first bytes of file.");
-		binputw1 (
-			my classInfo -> version > 0 ?
-				Melder_cat (my classInfo -> className, U" ", my classInfo -> version) :
-				my classInfo -> className,
-			file -> filePointer);
 		Data_writeBinary (me, file -> filePointer);
-		mfile.close ();
+	} catch (MelderError) {
+		NUMmatrix_mapBinary = false;
+		throw;
+	}
+	NUMmatrix_mapBinary = false;
+	mfile.close ();
+}
+
+void Data_writeToBinaryFile (Data me, MelderFile file) {
+	try {
+		_Data_writeToBinaryFile (me, file, false);
 	} catch (MelderError) {
 		Melder_throw (me, U": not written to binary file ", file, U".");
 	}
 }
 
+void Data_writeToMappedBinaryFile (Data me, MelderFile file) {
+	try {
+		_Data_writeToBinaryFile (me, file, true);
+	} catch (MelderError) {
+		Melder_throw (me, U": not written to mapped binary file ", file, U".");
+	}
+}
+
 bool Data_canReadText (Data me) {
 	return my v_writable ();
 }
@@ -236,9 +255,10 @@ Data Data_readFromBinaryFile (MelderFile file) {
 		char line [200];
 		int n = fread (line, 1, 199, f); line [n] = '\0';
 		char *end = strstr (line, "ooBinaryFile");
+		bool mapped = ! end && strstr (line, "ooMappedBinaryFile");
 		autoData me = NULL;
-		if (end) {
-			fseek (f, strlen ("ooBinaryFile"), 0);
+		if (end || mapped) {
+			fseek (f, strlen (mapped ? "ooMappedBinaryFile" : "ooBinaryFile"), 0);
 			autostring8 klas = bingets1 (f);
 			me.reset ((Data) Thing_newFromClassName (Melder_peek8to32 (klas.peek())));
 		} else {
@@ -253,7 +273,14 @@ Data Data_readFromBinaryFile (MelderFile file) {
 			fread (line, 1, end - line + strlen ("BinaryFile"), f);
 		}
 		MelderFile_getParentDir (file, & Data_directoryBeingRead);
-		Data_readBinary (me.peek(), f);
+		NUMmatrix_mapBinary = mapped;
+		try {
+			Data_readBinary (me.peek(), f);
+		} catch (MelderError) {
+			NUMmatrix_mapBinary = false;
+			throw;
+		}
+		NUMmatrix_mapBinary = false;
 		file -> format = structMelderFile :: Format :: binary;
 		f.close (file);
 		return me.transfer();
@@ -181,6 +181,17 @@ void Data_writeToBinaryFile (Data me, MelderFile file);
 		The format of the file after this is the same as in Data_writeBinary.
 */
 
+void Data_writeToMappedBinaryFile (Data me, MelderFile file);
+/*
+	Message:
+		"try to write yourself as binary data to a file that can be mapped into memory when it is read".
+	Description:
+		As Data_writeToBinaryFile, but the file starts with "ooMappedBinaryFile",
+		and matrices of double-precision numbers are written in the native little-endian format,
+		so that Data_readFromBinaryFile can map them into memory instead of reading them (see NUMmatrix_mapBinary).
+		The file can then be opened at once, whatever its size, and only the parts that are used are read from disk.
+*/
+
 bool Data_canReadText (Data me);
 /*
 	Message:
@@ -247,6 +258,8 @@ Data Data_readFromBinaryFile (MelderFile file);
 		The Data's class name is read from the start of the file,
 		e.g., if the file starts with is "PersonBinaryFile", the Data will be a Person.
 		The format of the file after this is the same as in Data_readBinary.
+		In a file written by Data_writeToMappedBinaryFile, the matrices of double-precision numbers
+		are mapped into memory rather than read.
 	Return value:
 		the new object.
 	Failures:
@@ -34,6 +34,7 @@
 #include "longchar.h"
 #include "UiPause.h"
 #include "DemoEditor.h"
+#include "MelderThread.h"
 
 static Interpreter theInterpreter, theLocalInterpreter;
 static Data theSource;
@@ -1827,6 +1828,90 @@ static void Formula_print (FormulaInstruction f) {
 	} while (symbol != END_);
 }
 
+/*
+ * Compiled programs of scripts.
+ *
+ * A script evaluates the same expressions over and over again, e.g. in every pass through a loop.
+ * The program of an expression depends only on its text, on its type,
+ * and on the variables that its names refer to, which stay where they are
+ * until the interpreter removes all of its variables (local variables are found with the name of the current procedure).
+ * So the program is kept, and the next compilation of the same expression by the same interpreter only copies it back.
+ * Programs that refer to objects are not kept, because objects come and go, and some of their attributes are compiled as numbers.
+ * The cache is direct-mapped: a program simply replaces any other program that happens to have the same slot.
+ */
+#define FORMULA_CACHE_SIZE  1024   /* a power of 2 */
+
+typedef struct structFormulaCachedProgram {
+	Interpreter interpreter;   // NULL = empty slot
+	char32 *expression, *procedureName;
+	int expressionType, numberOfInstructions;
+	FormulaInstruction program;   // [1..numberOfInstructions]
+} *FormulaCachedProgram;
+
+static struct structFormulaCachedProgram theCachedPrograms [FORMULA_CACHE_SIZE];
+
+static bool symbolHasString (int symbol) {
+	return symbol == STRING_ || symbol == VARIABLE_NAME_ || symbol == INDEXED_NUMERIC_VARIABLE_ || symbol == INDEXED_STRING_VARIABLE_ || symbol == CALL_;
+}
+
+static void FormulaCachedProgram_empty (FormulaCachedProgram me) {
+	for (int i = 1; i <= my numberOfInstructions; i ++)
+		if (symbolHasString (my program [i]. symbol))
+			Melder_free (my program [i]. content.string);
+	Melder_free (my program);
+	Melder_free (my expression);
+	Melder_free (my procedureName);
+	my interpreter = NULL;
+	my numberOfInstructions = 0;
+}
+
+static FormulaCachedProgram Formula_findCachedProgram (const char32 *expression, int expressionType) {
+	const char32 *procedureName = theInterpreter -> procedureNames [theInterpreter -> callDepth];
+	uint32 hash = 2166136261U ^ (uint32) expressionType;
+	for (const char32 *p = expression; *p != U'\0'; p ++)
+		hash = (hash ^ (uint32) *p) * 16777619;   // FNV-1a
+	for (const char32 *p = procedureName; *p != U'\0'; p ++)
+		hash = (hash ^ (uint32) *p) * 16777619;
+	hash ^= (uint32) (uintptr_t) theInterpreter;
+	return & theCachedPrograms [(hash ^ (hash >> 16)) & (FORMULA_CACHE_SIZE - 1)];
+}
+
+static bool FormulaCachedProgram_matches (FormulaCachedProgram me, const char32 *expression, int expressionType) {
+	return my interpreter == theInterpreter && my expressionType == expressionType &&
+		str32equ (my expression, expression) && str32equ (my procedureName, theInterpreter -> procedureNames [theInterpreter -> callDepth]);
+}
+
+static void Formula_cacheProgram (FormulaCachedProgram me, const char32 *expression, int expressionType) {
+	for (int i = 1; lexan [i]. symbol != END_; i ++)
+		if (lexan [i]. symbol == MATRIKS_ || lexan [i]. symbol == MATRIKSSTR_) return;
+	FormulaCachedProgram_empty (me);
+	try {
+		my program = Melder_calloc (struct structFormulaInstruction, 1 + numberOfInstructions);
+		for (int i = 1; i <= numberOfInstructions; i ++) {
+			my program [i] = parse [i];
+			if (symbolHasString (parse [i]. symbol))
+				my program [i]. content.string = Melder_dup (parse [i]. content.string);
+			my numberOfInstructions = i;
+		}
+		my expression = Melder_dup (expression);
+		my procedureName = Melder_dup (theInterpreter -> procedureNames [theInterpreter -> callDepth]);
+		my expressionType = expressionType;
+		my interpreter = theInterpreter;
+	} catch (MelderError) {
+		Melder_clearError ();   // not being able to keep the program is no reason to stop the script
+		FormulaCachedProgram_empty (me);
+	}
+}
+
+void Formula_forgetCachedPrograms (Any interpreter) {
+	for (int islot = 0; islot < FORMULA_CACHE_SIZE; islot ++)
+		if (theCachedPrograms [islot]. interpreter == interpreter)
+			FormulaCachedProgram_empty (& theCachedPrograms [islot]);
+}
+
+static void Formula_compileFast (void);
+static void Formula_forgetFastProgram (void);
+
 void Formula_compile (Any interpreter, Any data, const char32 *expression, int expressionType, int optimize) {
 	theInterpreter = (Interpreter) interpreter;
 	if (theInterpreter == NULL) {
@@ -1834,12 +1919,24 @@ void Formula_compile (Any interpreter, Any data, const char32 *expression, int e
 			theLocalInterpreter = Interpreter_create (NULL, NULL);
 		}
 		theInterpreter = theLocalInterpreter;
-		Collection_removeAllItems (theInterpreter -> variables);
+		Interpreter_removeAllVariables (theInterpreter);
 	}
 	theSource = (Data) data;
 	theExpression = expression;
 	theExpressionType [theLevel] = expressionType;
 	theOptimize = optimize;
+	FormulaCachedProgram cachedProgram = NULL;
+	if (interpreter && ! data && ! optimize && Melder_debug != 49) {
+		cachedProgram = Formula_findCachedProgram (expression, expressionType);
+		if (FormulaCachedProgram_matches (cachedProgram, expression, expressionType)) {
+			if (! parse) parse = Melder_calloc_f (struct structFormulaInstruction, 3000);
+			for (int i = 1; i <= cachedProgram -> numberOfInstructions; i ++)
+				parse [i] = cachedProgram -> program [i];   // the strings stay with the cache, for reading only
+			numberOfInstructions = cachedProgram -> numberOfInstructions;
+			Formula_forgetFastProgram ();   // a cached program runs on the stack, which for a single evaluation is as fast
+			return;
+		}
+	}
 	if (! lexan) {
 		lexan = Melder_calloc_f (struct structFormulaInstruction, 3000);
 		lexan [3000 - 1]. symbol = END_;   /* Make sure that string cleaning always terminates. */
@@ -1873,6 +1970,8 @@ void Formula_compile (Any interpreter, Any data, const char32 *expression, int e
 	}
 	Formula_removeLabels ();
 	if (Melder_debug == 17) Formula_print (parse);
+	Formula_compileFast ();
+	if (cachedProgram) Formula_cacheProgram (cachedProgram, expression, expressionType);
 }
 
 /*
@@ -2017,6 +2116,46 @@ static void do_gt (void) {
 		Melder_throw (U"Cannot compare (>) ", Stackel_whichText (x), U" to ", Stackel_whichText (y), U".");
 	}
 }
+/*
+ * Arithmetic on numeric arrays works element by element;
+ * a number combines with every element of the array.
+ * The result takes over the memory of an array operand, so that no new array has to be made.
+ */
+static double arrayElementArithmetic (int operation, double x, double y) {
+	if (x == NUMundefined || y == NUMundefined) return NUMundefined;
+	switch (operation) {
+		case ADD_: return x + y;
+		case SUB_: return x - y;
+		case MUL_: return x * y;
+		default: return y == 0.0 ? NUMundefined : x / y;
+	}
+}
+static bool pushNumericArrayArithmetic (int operation, Stackel x, Stackel y) {
+	if (x->which == Stackel_NUMERIC_ARRAY && y->which == Stackel_NUMERIC_ARRAY) {
+		if (x->numericArray.numberOfRows != y->numericArray.numberOfRows ||
+			x->numericArray.numberOfColumns != y->numericArray.numberOfColumns)
+			Melder_throw (U"The numeric arrays have different sizes (",
+				x->numericArray.numberOfRows, U" x ", x->numericArray.numberOfColumns, U" and ",
+				y->numericArray.numberOfRows, U" x ", y->numericArray.numberOfColumns, U").");
+	} else if (! (x->which == Stackel_NUMERIC_ARRAY && y->which == Stackel_NUMBER) &&
+		! (x->which == Stackel_NUMBER && y->which == Stackel_NUMERIC_ARRAY))
+	{
+		return false;
+	}
+	Stackel array = x->which == Stackel_NUMERIC_ARRAY ? x : y;
+	struct Formula_NumericArray result = array->numericArray;
+	array->numericArray = theZeroNumericArray;   // the result becomes the owner
+	for (long irow = 1; irow <= result.numberOfRows; irow ++) {
+		double *resultRow = result.data [irow];
+		for (long icol = 1; icol <= result.numberOfColumns; icol ++) {
+			double xvalue = x->which == Stackel_NUMBER ? x->number : array == x ? resultRow [icol] : x->numericArray.data [irow] [icol];
+			double yvalue = y->which == Stackel_NUMBER ? y->number : array == y ? resultRow [icol] : y->numericArray.data [irow] [icol];
+			resultRow [icol] = arrayElementArithmetic (operation, xvalue, yvalue);
+		}
+	}
+	pushNumericArray (result.numberOfRows, result.numberOfColumns, result.data);
+	return true;
+}
 static void do_add (void) {
 	Stackel y = pop, x = pop;
 	if (x->which == Stackel_NUMBER && y->which == Stackel_NUMBER) {
@@ -2028,6 +2167,8 @@ static void do_add (void) {
 		str32cpy (result, x->string);
 		str32cpy (result + length1, y->string);
 		pushString (result);
+	} else if (pushNumericArrayArithmetic (ADD_, x, y)) {
+		;
 	} else {
 		Melder_throw (U"Cannot add ", Stackel_whichText (y), U" to ", Stackel_whichText (x), U".");
 	}
@@ -2048,6 +2189,8 @@ static void do_sub (void) {
 			result = Melder_dup (x->string);
 		}
 		pushString (result);
+	} else if (pushNumericArrayArithmetic (SUB_, x, y)) {
+		;
 	} else {
 		Melder_throw (U"Cannot subtract (-) ", Stackel_whichText (y), U" from ", Stackel_whichText (x), U".");
 	}
@@ -2057,6 +2200,8 @@ static void do_mul (void) {
 	if (x->which == Stackel_NUMBER && y->which == Stackel_NUMBER) {
 		pushNumber (x->number == NUMundefined || y->number == NUMundefined ? NUMundefined :
 			x->number * y->number);
+	} else if (pushNumericArrayArithmetic (MUL_, x, y)) {
+		;
 	} else {
 		Melder_throw (U"Cannot multiply (*) ", Stackel_whichText (x), U" by ", Stackel_whichText (y), U".");
 	}
@@ -2067,6 +2212,8 @@ static void do_rdiv (void) {
 		pushNumber (x->number == NUMundefined || y->number == NUMundefined ? NUMundefined :
 			y->number == 0.0 ? NUMundefined :
 			x->number / y->number);
+	} else if (pushNumericArrayArithmetic (RDIV_, x, y)) {
+		;
 	} else {
 		Melder_throw (U"Cannot divide (/) ", Stackel_whichText (x), U" by ", Stackel_whichText (y), U".");
 	}
@@ -2095,6 +2242,13 @@ static void do_minus (void) {
 	Stackel x = pop;
 	if (x->which == Stackel_NUMBER) {
 		pushNumber (x->number == NUMundefined ? NUMundefined : - x->number);
+	} else if (x->which == Stackel_NUMERIC_ARRAY) {
+		struct Formula_NumericArray result = x->numericArray;
+		x->numericArray = theZeroNumericArray;   // the result becomes the owner
+		for (long irow = 1; irow <= result.numberOfRows; irow ++)
+			for (long icol = 1; icol <= result.numberOfColumns; icol ++)
+				if (result.data [irow] [icol] != NUMundefined) result.data [irow] [icol] = - result.data [irow] [icol];
+		pushNumericArray (result.numberOfRows, result.numberOfColumns, result.data);
 	} else {
 		Melder_throw (U"Cannot take the opposite (-) of ", Stackel_whichText (x), U".");
 	}
@@ -4681,7 +4835,700 @@ static double NUMerf (double x) {
 	return 1.0 - NUMerfcc (x);
 }
 
+/*
+ * The numeric fast path.
+ *
+ * Most formulas that are run many times, such as those of Sound: Formula... and Matrix: Formula...,
+ * compute a number from numbers only. For such formulas, Formula_compile () translates the stack program
+ * into a program for a register machine. Every stack depth gets its own register, and so do the constants,
+ * the variables, and row, col, x and y; an instruction names its operands and its result register,
+ * so that it needs no type tests and no stack bookkeeping, and constants and variables cost no instructions.
+ * Formula_run () uses the register program if there is one. If an instruction meets a case
+ * that the register machine does not handle (e.g. "self" without an implicit row),
+ * the formula is run on the stack instead, which gives the same value or the same error message.
+ */
+
+enum { FAST_MOVE, FAST_NOT, FAST_EQ, FAST_NE, FAST_LE, FAST_LT, FAST_GE, FAST_GT,
+	FAST_ADD, FAST_SUB, FAST_MUL, FAST_RDIV, FAST_IDIV, FAST_MOD, FAST_MINUS, FAST_POWER, FAST_SQR,
+	FAST_MIN, FAST_MAX, FAST_FUNCTION1, FAST_FUNCTION2, FAST_FUNCTION3,
+	FAST_SELF0, FAST_SELF1, FAST_SELF2, FAST_SELF_FUNCTION1, FAST_SELF_FUNCTION2,
+	FAST_IFTRUE, FAST_IFFALSE, FAST_GOTO };
+
+/* How "self" is accessed, in the `c` field of FAST_SELF0, FAST_SELF1 and FAST_SELF_FUNCTION1. */
+#define FAST_SELF_CELL  1
+#define FAST_SELF_VECTOR  2
+#define FAST_SELF_MATRIX  3
+#define FAST_SELF_FUNCTION_OF_X  4
+#define FAST_SELF_FUNCTION_OF_XY  5
+
+typedef double (*FormulaFunction1) (double);
+typedef double (*FormulaFunction2) (double, double);
+typedef double (*FormulaFunction3) (double, double, double);
+
+typedef struct structFormulaFastInstruction {
+	int opcode;
+	int target, a, b, c;   // register numbers; register 0 is a dummy
+	union {
+		FormulaFunction1 function1;
+		FormulaFunction2 function2;
+		FormulaFunction3 function3;
+		int jump;   // during translation the parse location, afterwards the fast location
+	};
+} *FormulaFastInstruction;
+
+#define FAST_MAXIMUM_NUMBER_OF_INSTRUCTIONS  9000
+#define FAST_MAXIMUM_NUMBER_OF_REGISTERS  6010
+
+static FormulaFastInstruction fastProgram;
+static int numberOfFastInstructions = -1;   // -1 = no fast program for the current formula
+static double *fastRegisters;   // 1 .. numberOfInstructions: stack depths; above: constants and inputs
+static int numberOfFastRegisters, fastResultRegister;
+static int fastRowRegister, fastColRegister, fastXRegister, fastYRegister;   // 0 = not used
+static int numberOfFastVariables, *fastVariableRegisters;
+static bool fastProgramIsVectorizable;   // no side effects, and no cells of "self" other than the current one
+static InterpreterVariable *fastVariables;
+static int *fastStack, fastDepth;   // the register that holds each stack depth, during translation
+static int *fastTargetDepth, *fastLocation;   // per parse location, during translation
+
+static double fast_abs (double x) { return fabs (x); }
+static double fast_round (double x) { return floor (x + 0.5); }
+static double fast_floor (double x) { return floor (x); }
+static double fast_ceiling (double x) { return ceil (x); }
+static double fast_sqrt (double x) { return x < 0.0 ? NUMundefined : sqrt (x); }
+static double fast_sin (double x) { return sin (x); }
+static double fast_cos (double x) { return cos (x); }
+static double fast_tan (double x) { return tan (x); }
+static double fast_arcsin (double x) { return fabs (x) > 1.0 ? NUMundefined : asin (x); }
+static double fast_arccos (double x) { return fabs (x) > 1.0 ? NUMundefined : acos (x); }
+static double fast_arctan (double x) { return atan (x); }
+static double fast_exp (double x) { return exp (x); }
+static double fast_sinh (double x) { return sinh (x); }
+static double fast_cosh (double x) { return cosh (x); }
+static double fast_tanh (double x) { return tanh (x); }
+static double fast_log2 (double x) { return x <= 0.0 ? NUMundefined : log (x) * NUMlog2e; }
+static double fast_ln (double x) { return x <= 0.0 ? NUMundefined : log (x); }
+static double fast_log10 (double x) { return x <= 0.0 ? NUMundefined : log10 (x); }
+static double fast_randomInteger (double x, double y) { return NUMrandomInteger (lround (x), lround (y)); }
+static double fast_randomBinomial (double x, double y) { return NUMrandomBinomial (x, lround (y)); }
+static double fast_besselI (double x, double y) { return NUMbesselI (lround (x), y); }
+static double fast_besselK (double x, double y) { return NUMbesselK (lround (x), y); }
+
+/*
+ * The same functions as in Formula_run (), with the same treatment of undefined and out-of-domain arguments.
+ */
+static FormulaFunction1 fast_function1 (int symbol) {
+	switch (symbol) {
+		case ABS_: return fast_abs;
+		case ROUND_: return fast_round;
+		case FLOOR_: return fast_floor;
+		case CEILING_: return fast_ceiling;
+		case SQRT_: return fast_sqrt;
+		case SIN_: return fast_sin;
+		case COS_: return fast_cos;
+		case TAN_: return fast_tan;
+		case ARCSIN_: return fast_arcsin;
+		case ARCCOS_: return fast_arccos;
+		case ARCTAN_: return fast_arctan;
+		case SINC_: return NUMsinc;
+		case SINCPI_: return NUMsincpi;
+		case EXP_: return fast_exp;
+		case SINH_: return fast_sinh;
+		case COSH_: return fast_cosh;
+		case TANH_: return fast_tanh;
+		case ARCSINH_: return NUMarcsinh;
+		case ARCCOSH_: return NUMarccosh;
+		case ARCTANH_: return NUMarctanh;
+		case SIGMOID_: return NUMsigmoid;
+		case INV_SIGMOID_: return NUMinvSigmoid;
+		case ERF_: return NUMerf;
+		case ERFC_: return NUMerfcc;
+		case GAUSS_P_: return NUMgaussP;
+		case GAUSS_Q_: return NUMgaussQ;
+		case INV_GAUSS_Q_: return NUMinvGaussQ;
+		case RANDOM_POISSON_: return NUMrandomPoisson;
+		case LOG2_: return fast_log2;
+		case LN_: return fast_ln;
+		case LOG10_: return fast_log10;
+		case LN_GAMMA_: return NUMlnGamma;
+		case HERTZ_TO_BARK_: return NUMhertzToBark;
+		case BARK_TO_HERTZ_: return NUMbarkToHertz;
+		case PHON_TO_DIFFERENCE_LIMENS_: return NUMphonToDifferenceLimens;
+		case DIFFERENCE_LIMENS_TO_PHON_: return NUMdifferenceLimensToPhon;
+		case HERTZ_TO_MEL_: return NUMhertzToMel;
+		case MEL_TO_HERTZ_: return NUMmelToHertz;
+		case HERTZ_TO_SEMITONES_: return NUMhertzToSemitones;
+		case SEMITONES_TO_HERTZ_: return NUMsemitonesToHertz;
+		case ERB_: return NUMerb;
+		case HERTZ_TO_ERB_: return NUMhertzToErb;
+		case ERB_TO_HERTZ_: return NUMerbToHertz;
+		default: return NULL;
+	}
+}
+static FormulaFunction2 fast_function2 (int symbol) {
+	switch (symbol) {
+		case ARCTAN2_: return atan2;
+		case RANDOM_UNIFORM_: return NUMrandomUniform;
+		case RANDOM_INTEGER_: return fast_randomInteger;
+		case RANDOM_GAUSS_: return NUMrandomGauss;
+		case RANDOM_BINOMIAL_: return fast_randomBinomial;
+		case CHI_SQUARE_P_: return NUMchiSquareP;
+		case CHI_SQUARE_Q_: return NUMchiSquareQ;
+		case INCOMPLETE_GAMMAP_: return NUMincompleteGammaP;
+		case INV_CHI_SQUARE_Q_: return NUMinvChiSquareQ;
+		case STUDENT_P_: return NUMstudentP;
+		case STUDENT_Q_: return NUMstudentQ;
+		case INV_STUDENT_Q_: return NUMinvStudentQ;
+		case BETA_: return NUMbeta;
+		case BETA2_: return NUMbeta2;
+		case BESSEL_I_: return fast_besselI;
+		case BESSEL_K_: return fast_besselK;
+		case LN_BETA_: return NUMlnBeta;
+		case SOUND_PRESSURE_TO_PHON_: return NUMsoundPressureToPhon;
+		default: return NULL;
+	}
+}
+static FormulaFunction3 fast_function3 (int symbol) {
+	switch (symbol) {
+		case FISHER_P_: return NUMfisherP;
+		case FISHER_Q_: return NUMfisherQ;
+		case INV_FISHER_Q_: return NUMinvFisherQ;
+		case BINOMIAL_P_: return NUMbinomialP;
+		case BINOMIAL_Q_: return NUMbinomialQ;
+		case INCOMPLETE_BETA_: return NUMincompleteBeta;
+		case INV_BINOMIAL_P_: return NUMinvBinomialP;
+		case INV_BINOMIAL_Q_: return NUMinvBinomialQ;
+		default: return NULL;
+	}
+}
+
+static FormulaFastInstruction fast_emit (int opcode, int target, int a, int b, int c) {
+	if (numberOfFastInstructions >= FAST_MAXIMUM_NUMBER_OF_INSTRUCTIONS) return NULL;
+	FormulaFastInstruction f = & fastProgram [++ numberOfFastInstructions];
+	f -> opcode = opcode;
+	f -> target = target;
+	f -> a = a;
+	f -> b = b;
+	f -> c = c;
+	f -> function1 = NULL;
+	return f;
+}
+
+static int fast_newRegister (double value) {
+	if (numberOfFastRegisters >= FAST_MAXIMUM_NUMBER_OF_REGISTERS - 1) return 0;
+	fastRegisters [++ numberOfFastRegisters] = value;
+	return numberOfFastRegisters;
+}
+
+static bool fast_push (int reg) {
+	if (reg == 0) return false;
+	fastStack [++ fastDepth] = reg;
+	return true;
+}
+
+/*
+ * Replaces the `numberOfArguments` top stack elements with the result of an instruction.
+ * The result goes to the register of the lowest of these stack depths.
+ */
+static FormulaFastInstruction fast_operation (int opcode, int numberOfArguments) {
+	if (fastDepth < numberOfArguments) return NULL;
+	int first = fastDepth - numberOfArguments + 1;
+	FormulaFastInstruction f = fast_emit (opcode, first,
+		numberOfArguments > 0 ? fastStack [first] : 0,
+		numberOfArguments > 1 ? fastStack [first + 1] : 0,
+		numberOfArguments > 2 ? fastStack [first + 2] : 0);
+	fastDepth = first;
+	fastStack [first] = first;
+	return f;
+}
+
+/*
+ * Before a jump and at a jump target, every stack depth has to be in its own register,
+ * so that all paths into the target agree on where the stack elements are.
+ */
+static bool fast_materialize () {
+	for (int depth = 1; depth <= fastDepth; depth ++) {
+		if (fastStack [depth] != depth) {
+			if (! fast_emit (FAST_MOVE, depth, fastStack [depth], 0, 0)) return false;
+			fastStack [depth] = depth;
+		}
+	}
+	return true;
+}
+
+static bool fast_jump (int opcode, int location, int label) {
+	int condition = 0;
+	if (opcode != FAST_GOTO) {
+		if (fastDepth < 1) return false;
+		condition = fastStack [fastDepth --];
+	}
+	int target = label - theOptimize + 1;
+	if (target <= location || target > numberOfInstructions + 1) return false;   // only forward jumps
+	if (fastTargetDepth [target] >= 0 && fastTargetDepth [target] != fastDepth) return false;
+	fastTargetDepth [target] = fastDepth;
+	if (! fast_materialize ()) return false;
+	FormulaFastInstruction f = fast_emit (opcode, 0, condition, 0, 0);
+	if (! f) return false;
+	f -> jump = target;
+	return true;
+}
+
+static int fast_selfMode (int symbol) {
+	Data me = theSource;
+	if (me == NULL) return 0;   // the stack program will complain
+	switch (symbol) {
+		case SELF0_:
+			return my v_hasGetCell () ? FAST_SELF_CELL : my v_hasGetVector () ? FAST_SELF_VECTOR : my v_hasGetMatrix () ? FAST_SELF_MATRIX : 0;
+		case SELFMATRIKS1_:
+			return my v_hasGetVector () ? FAST_SELF_VECTOR : my v_hasGetMatrix () ? FAST_SELF_MATRIX : 0;
+		case SELFMATRIKS2_:
+			return my v_hasGetMatrix () ? FAST_SELF_MATRIX : 0;
+		case SELFFUNKTIE1_:
+			return my v_hasGetFunction1 () ? FAST_SELF_FUNCTION_OF_X :
+				my v_hasGetFunction2 () && my v_hasGetY () ? FAST_SELF_FUNCTION_OF_XY : 0;
+		case SELFFUNKTIE2_:
+			return my v_hasGetFunction2 () ? FAST_SELF_FUNCTION_OF_XY : 0;
+		default:
+			return 0;
+	}
+}
+
+/*
+ * Translates parse [1..numberOfInstructions] into fastProgram [1..numberOfFastInstructions],
+ * or sets numberOfFastInstructions to -1 if the formula contains anything but numbers.
+ */
+static bool Formula_translateFast () {
+	numberOfFastInstructions = 0;
+	numberOfFastRegisters = numberOfInstructions;   // the stack depths
+	fastRowRegister = fastColRegister = fastXRegister = fastYRegister = 0;
+	numberOfFastVariables = 0;
+	fastDepth = 0;
+	fastProgramIsVectorizable = true;
+	for (int i = 1; i <= numberOfInstructions + 1; i ++)
+		fastTargetDepth [i] = -1;
+	bool reachable = true;
+	for (int i = 1; i <= numberOfInstructions + 1; i ++) {
+		if (fastTargetDepth [i] >= 0) {
+			if (reachable) {
+				if (! fast_materialize () || fastDepth != fastTargetDepth [i]) return false;
+			} else {
+				fastDepth = fastTargetDepth [i];
+				for (int depth = 1; depth <= fastDepth; depth ++)
+					fastStack [depth] = depth;
+				reachable = true;
+			}
+		}
+		fastLocation [i] = numberOfFastInstructions + 1;
+		if (i > numberOfInstructions || ! reachable) continue;
+		FormulaInstruction f = & parse [i];
+		int symbol = f -> symbol;
+		switch (symbol) {
+			case NUMBER_: {
+				if (! fast_push (fast_newRegister (f -> content.number))) return false;
+			} break; case TRUE_: {
+				if (! fast_push (fast_newRegister (1.0))) return false;
+			} break; case FALSE_: {
+				if (! fast_push (fast_newRegister (0.0))) return false;
+			} break; case ROW_: {
+				if (! fastRowRegister) fastRowRegister = fast_newRegister (0.0);
+				if (! fast_push (fastRowRegister)) return false;
+			} break; case COL_: {
+				if (! fastColRegister) fastColRegister = fast_newRegister (0.0);
+				if (! fast_push (fastColRegister)) return false;
+			} break; case X_: {
+				if (theSource == NULL || ! theSource -> v_hasGetX ()) return false;
+				if (! fastXRegister) fastXRegister = fast_newRegister (0.0);
+				if (! fast_push (fastXRegister)) return false;
+			} break; case Y_: {
+				if (theSource == NULL || ! theSource -> v_hasGetY ()) return false;
+				if (! fastYRegister) fastYRegister = fast_newRegister (0.0);
+				if (! fast_push (fastYRegister)) return false;
+			} break; case NUMERIC_VARIABLE_: {
+				int ivar = 1;
+				while (ivar <= numberOfFastVariables && fastVariables [ivar] != f -> content.variable) ivar ++;
+				if (ivar > numberOfFastVariables) {
+					fastVariables [ivar] = f -> content.variable;
+					fastVariableRegisters [ivar] = fast_newRegister (0.0);
+					numberOfFastVariables = ivar;
+				}
+				if (! fast_push (fastVariableRegisters [ivar])) return false;
+			} break;
+			case NOT_: if (! fast_operation (FAST_NOT, 1)) return false; break;
+			case EQ_: if (! fast_operation (FAST_EQ, 2)) return false; break;
+			case NE_: if (! fast_operation (FAST_NE, 2)) return false; break;
+			case LE_: if (! fast_operation (FAST_LE, 2)) return false; break;
+			case LT_: if (! fast_operation (FAST_LT, 2)) return false; break;
+			case GE_: if (! fast_operation (FAST_GE, 2)) return false; break;
+			case GT_: if (! fast_operation (FAST_GT, 2)) return false; break;
+			case ADD_: if (! fast_operation (FAST_ADD, 2)) return false; break;
+			case SUB_: if (! fast_operation (FAST_SUB, 2)) return false; break;
+			case MUL_: if (! fast_operation (FAST_MUL, 2)) return false; break;
+			case RDIV_: if (! fast_operation (FAST_RDIV, 2)) return false; break;
+			case IDIV_: if (! fast_operation (FAST_IDIV, 2)) return false; break;
+			case MOD_: if (! fast_operation (FAST_MOD, 2)) return false; break;
+			case MINUS_: if (! fast_operation (FAST_MINUS, 1)) return false; break;
+			case POWER_: if (! fast_operation (FAST_POWER, 2)) return false; break;
+			case SQR_: if (! fast_operation (FAST_SQR, 1)) return false; break;
+			case MIN_: case MAX_: {
+				/*
+					The number of arguments is a constant on top of the stack.
+					Fold from the last argument down, as do_min () does; intermediate results go to the register of the top.
+				*/
+				if (parse [i - 1]. symbol != NUMBER_ || fastDepth < 1) return false;
+				long numberOfArguments = lround (fastRegisters [fastStack [fastDepth]]);
+				fastDepth --;
+				if (numberOfArguments < 1 || numberOfArguments > fastDepth) return false;
+				int first = fastDepth - numberOfArguments + 1, result = fastStack [fastDepth];
+				if (numberOfArguments == 1) {
+					if (! fast_emit (FAST_MOVE, first, result, 0, 0)) return false;
+				}
+				for (int depth = fastDepth - 1; depth >= first; depth --) {
+					int target = depth == first ? first : fastDepth;
+					if (! fast_emit (symbol == MIN_ ? FAST_MIN : FAST_MAX, target, result, fastStack [depth], 0)) return false;
+					result = target;
+				}
+				fastDepth = first;
+				fastStack [first] = first;
+			} break;
+			case IFTRUE_: if (! fast_jump (FAST_IFTRUE, i, f -> content.label)) return false; break;
+			case IFFALSE_: if (! fast_jump (FAST_IFFALSE, i, f -> content.label)) return false; break;
+			case GOTO_: {
+				if (! fast_jump (FAST_GOTO, i, f -> content.label)) return false;
+				reachable = false;
+			} break;
+			case LABEL_: break;
+			case SELF0_: case SELFMATRIKS1_: case SELFMATRIKS2_: case SELFFUNKTIE1_: case SELFFUNKTIE2_: {
+				int mode = fast_selfMode (symbol);
+				if (mode == 0) return false;
+				int opcode = symbol == SELF0_ ? FAST_SELF0 : symbol == SELFMATRIKS1_ ? FAST_SELF1 : symbol == SELFMATRIKS2_ ? FAST_SELF2 :
+					symbol == SELFFUNKTIE1_ ? FAST_SELF_FUNCTION1 : FAST_SELF_FUNCTION2;
+				int numberOfArguments = symbol == SELF0_ ? 0 : symbol == SELFMATRIKS2_ || symbol == SELFFUNKTIE2_ ? 2 : 1;
+				FormulaFastInstruction instruction = fast_operation (opcode, numberOfArguments);
+				if (! instruction) return false;
+				instruction -> c = mode;
+				if (opcode != FAST_SELF0) fastProgramIsVectorizable = false;
+			} break;
+			default: {
+				FormulaFastInstruction instruction;
+				if (symbol == RANDOM_POISSON_ || (symbol >= RANDOM_UNIFORM_ && symbol <= RANDOM_BINOMIAL_))
+					fastProgramIsVectorizable = false;   // the random numbers would be drawn in a different order
+				if (FormulaFunction1 function1 = fast_function1 (symbol)) {
+					if (! (instruction = fast_operation (FAST_FUNCTION1, 1))) return false;
+					instruction -> function1 = function1;
+				} else if (FormulaFunction2 function2 = fast_function2 (symbol)) {
+					if (! (instruction = fast_operation (FAST_FUNCTION2, 2))) return false;
+					instruction -> function2 = function2;
+				} else if (FormulaFunction3 function3 = fast_function3 (symbol)) {
+					if (! (instruction = fast_operation (FAST_FUNCTION3, 3))) return false;
+					instruction -> function3 = function3;
+				} else {
+					return false;   // strings, arrays, objects, side effects...
+				}
+			}
+		}
+	}
+	if (! reachable || fastDepth != 1) return false;
+	fastResultRegister = fastStack [1];
+	for (int i = 1; i <= numberOfFastInstructions; i ++) {
+		FormulaFastInstruction f = & fastProgram [i];
+		if (f -> opcode == FAST_IFTRUE || f -> opcode == FAST_IFFALSE || f -> opcode == FAST_GOTO)
+			f -> jump = fastLocation [f -> jump];
+	}
+	return true;
+}
+
+static void Formula_forgetFastProgram (void) {
+	numberOfFastInstructions = -1;
+}
+
+static void Formula_compileFast (void) {
+	numberOfFastInstructions = -1;
+	if (Melder_debug == 48) return;
+	if (theExpressionType [theLevel] != kFormula_EXPRESSION_TYPE_NUMERIC &&
+	    theExpressionType [theLevel] != kFormula_EXPRESSION_TYPE_UNKNOWN) return;
+	if (! fastProgram) {
+		fastProgram = Melder_calloc_f (struct structFormulaFastInstruction, 1 + FAST_MAXIMUM_NUMBER_OF_INSTRUCTIONS);
+		fastRegisters = Melder_calloc_f (double, FAST_MAXIMUM_NUMBER_OF_REGISTERS);
+		fastVariables = Melder_calloc_f (InterpreterVariable, 3000);
+		fastVariableRegisters = Melder_calloc_f (int, 3000);
+		fastStack = Melder_calloc_f (int, 3000);
+		fastTargetDepth = Melder_calloc_f (int, 3000 + 1);
+		fastLocation = Melder_calloc_f (int, 3000 + 1);
+	}
+	if (! Formula_translateFast ())
+		numberOfFastInstructions = -1;
+}
+
+/*
+ * The operations, shared by the cell-by-cell and the block-by-block register machines.
+ */
+#define FAST_UNDEFINED1(x)  ((x) == NUMundefined)
+#define FAST_UNDEFINED2(x,y)  ((x) == NUMundefined || (y) == NUMundefined)
+static inline double fast_not (double x) { return FAST_UNDEFINED1 (x) ? NUMundefined : x == 0.0 ? 1.0 : 0.0; }
+static inline double fast_eq (double x, double y) { return x == y ? 1.0 : 0.0; }
+static inline double fast_ne (double x, double y) { return x != y ? 1.0 : 0.0; }
+static inline double fast_le (double x, double y) { return FAST_UNDEFINED2 (x, y) ? NUMundefined : x <= y ? 1.0 : 0.0; }
+static inline double fast_lt (double x, double y) { return FAST_UNDEFINED2 (x, y) ? NUMundefined : x < y ? 1.0 : 0.0; }
+static inline double fast_ge (double x, double y) { return FAST_UNDEFINED2 (x, y) ? NUMundefined : x >= y ? 1.0 : 0.0; }
+static inline double fast_gt (double x, double y) { return FAST_UNDEFINED2 (x, y) ? NUMundefined : x > y ? 1.0 : 0.0; }
+static inline double fast_add (double x, double y) { return FAST_UNDEFINED2 (x, y) ? NUMundefined : x + y; }
+static inline double fast_sub (double x, double y) { return FAST_UNDEFINED2 (x, y) ? NUMundefined : x - y; }
+static inline double fast_mul (double x, double y) { return FAST_UNDEFINED2 (x, y) ? NUMundefined : x * y; }
+static inline double fast_rdiv (double x, double y) { return FAST_UNDEFINED2 (x, y) || y == 0.0 ? NUMundefined : x / y; }
+static inline double fast_idiv (double x, double y) { return FAST_UNDEFINED2 (x, y) || y == 0.0 ? NUMundefined : floor (x / y); }
+static inline double fast_mod (double x, double y) { return FAST_UNDEFINED2 (x, y) || y == 0.0 ? NUMundefined : x - floor (x / y) * y; }
+static inline double fast_minus (double x) { return FAST_UNDEFINED1 (x) ? NUMundefined : - x; }
+static inline double fast_power (double x, double y) { return FAST_UNDEFINED2 (x, y) ? NUMundefined : pow (x, y); }
+static inline double fast_sqr (double x) { return FAST_UNDEFINED1 (x) ? NUMundefined : x * x; }
+static inline double fast_min (double x, double y) { return FAST_UNDEFINED2 (x, y) ? NUMundefined : x < y ? x : y; }
+static inline double fast_max (double x, double y) { return FAST_UNDEFINED2 (x, y) ? NUMundefined : x > y ? x : y; }
+
+static void fast_loadVariables (double *r) {
+	for (int ivar = 1; ivar <= numberOfFastVariables; ivar ++)
+		r [fastVariableRegisters [ivar]] = fastVariables [ivar] -> numericValue;
+}
+
+/*
+ * Runs the register program for one cell, in the registers `r`, whose constants and variables have been set.
+ * Returns false if the stack program has to take over.
+ */
+static bool Formula_runFast (double *r, long row, long col, double *out_value) {
+	Data me = theSource;
+	if (fastRowRegister) r [fastRowRegister] = row;
+	if (fastColRegister) r [fastColRegister] = col;
+	if (fastXRegister) r [fastXRegister] = my v_getX (col);
+	if (fastYRegister) r [fastYRegister] = my v_getY (row);
+	for (int pc = 1; pc <= numberOfFastInstructions; pc ++) {
+		FormulaFastInstruction f = & fastProgram [pc];
+		double x = r [f -> a], y = r [f -> b];
+		switch (f -> opcode) {
+			case FAST_MOVE: r [f -> target] = x; break;
+			case FAST_NOT: r [f -> target] = fast_not (x); break;
+			case FAST_EQ: r [f -> target] = fast_eq (x, y); break;
+			case FAST_NE: r [f -> target] = fast_ne (x, y); break;
+			case FAST_LE: r [f -> target] = fast_le (x, y); break;
+			case FAST_LT: r [f -> target] = fast_lt (x, y); break;
+			case FAST_GE: r [f -> target] = fast_ge (x, y); break;
+			case FAST_GT: r [f -> target] = fast_gt (x, y); break;
+			case FAST_ADD: r [f -> target] = fast_add (x, y); break;
+			case FAST_SUB: r [f -> target] = fast_sub (x, y); break;
+			case FAST_MUL: r [f -> target] = fast_mul (x, y); break;
+			case FAST_RDIV: r [f -> target] = fast_rdiv (x, y); break;
+			case FAST_IDIV: r [f -> target] = fast_idiv (x, y); break;
+			case FAST_MOD: r [f -> target] = fast_mod (x, y); break;
+			case FAST_MINUS: r [f -> target] = fast_minus (x); break;
+			case FAST_POWER: r [f -> target] = fast_power (x, y); break;
+			case FAST_SQR: r [f -> target] = fast_sqr (x); break;
+			case FAST_MIN: r [f -> target] = fast_min (x, y); break;
+			case FAST_MAX: r [f -> target] = fast_max (x, y); break;
+			case FAST_FUNCTION1: r [f -> target] = FAST_UNDEFINED1 (x) ? NUMundefined : f -> function1 (x); break;
+			case FAST_FUNCTION2: r [f -> target] = FAST_UNDEFINED2 (x, y) ? NUMundefined : f -> function2 (x, y); break;
+			case FAST_FUNCTION3: {
+				double z = r [f -> c];
+				r [f -> target] = FAST_UNDEFINED2 (x, y) || FAST_UNDEFINED1 (z) ? NUMundefined : f -> function3 (x, y, z);
+			} break;
+			case FAST_SELF0: {
+				if (f -> c == FAST_SELF_CELL) {
+					r [f -> target] = my v_getCell ();
+				} else if (f -> c == FAST_SELF_VECTOR) {
+					if (col == 0) return false;
+					r [f -> target] = my v_getVector (row, col);
+				} else {
+					if (row == 0) return false;
+					r [f -> target] = my v_getMatrix (row, col);
+				}
+			} break;
+			case FAST_SELF1: {
+				if (f -> c == FAST_SELF_VECTOR) {
+					r [f -> target] = my v_getVector (row, lround (x));
+				} else {
+					if (row == 0) return false;
+					r [f -> target] = my v_getMatrix (row, lround (x));
+				}
+			} break;
+			case FAST_SELF2: r [f -> target] = my v_getMatrix (lround (x), lround (y)); break;
+			case FAST_SELF_FUNCTION1: {
+				r [f -> target] = f -> c == FAST_SELF_FUNCTION_OF_X ? my v_getFunction1 (row, x) : my v_getFunction2 (x, my v_getY (row));
+			} break;
+			case FAST_SELF_FUNCTION2: r [f -> target] = my v_getFunction2 (x, y); break;
+			case FAST_IFTRUE: if (x != 0.0) pc = f -> jump - 1; break;
+			case FAST_IFFALSE: if (x == 0.0) pc = f -> jump - 1; break;
+			case FAST_GOTO: pc = f -> jump - 1; break;
+		}
+	}
+	*out_value = r [fastResultRegister];
+	return true;
+}
+
+/*
+ * Whole rows.
+ *
+ * If the formula has no side effects (no random numbers) and looks at no cell of "self" other than the current one,
+ * the order in which the cells are computed cannot matter. Formula_runRows () then cuts the rows into blocks of cells
+ * and runs each instruction over a whole block, in simple loops that the compiler can vectorize;
+ * the blocks are distributed over the threads of the pool. A block whose cells do not all take the same branch
+ * of an if-then-else is computed cell by cell.
+ */
+#define FAST_BLOCK_SIZE  256
+
+Thing_define (FormulaBlocks, Thing) { public:
+	long firstRow, firstColumn, lastColumn, numberOfBlocksPerRow;
+	double **out;
+	autoNUMvector <double> registers;   // register k is the block [k * FAST_BLOCK_SIZE .. k * FAST_BLOCK_SIZE + FAST_BLOCK_SIZE - 1]
+	autoNUMvector <double> cellRegisters;   // for blocks that have to be computed cell by cell
+};
+Thing_implement (FormulaBlocks, Thing, 0);
+
+#define FAST_BLOCK_LOOP(expression)  for (long i = 0; i < n; i ++) t [i] = expression
+
+static bool FormulaBlocks_runBlock (FormulaBlocks me, long row, long firstColumn, long n, double *out) {
+	Data source = theSource;
+	double *r = my registers.peek();
+	if (fastRowRegister) {
+		double *t = r + fastRowRegister * FAST_BLOCK_SIZE;
+		FAST_BLOCK_LOOP (row);
+	}
+	if (fastColRegister) {
+		double *t = r + fastColRegister * FAST_BLOCK_SIZE;
+		FAST_BLOCK_LOOP (firstColumn + i);
+	}
+	if (fastXRegister) {
+		double *t = r + fastXRegister * FAST_BLOCK_SIZE;
+		FAST_BLOCK_LOOP (source -> v_getX (firstColumn + i));
+	}
+	if (fastYRegister) {
+		double *t = r + fastYRegister * FAST_BLOCK_SIZE, y = source -> v_getY (row);
+		FAST_BLOCK_LOOP (y);
+	}
+	for (int pc = 1; pc <= numberOfFastInstructions; pc ++) {
+		FormulaFastInstruction f = & fastProgram [pc];
+		double *t = r + f -> target * FAST_BLOCK_SIZE, *x = r + f -> a * FAST_BLOCK_SIZE, *y = r + f -> b * FAST_BLOCK_SIZE;
+		switch (f -> opcode) {
+			case FAST_MOVE: FAST_BLOCK_LOOP (x [i]); break;
+			case FAST_NOT: FAST_BLOCK_LOOP (fast_not (x [i])); break;
+			case FAST_EQ: FAST_BLOCK_LOOP (fast_eq (x [i], y [i])); break;
+			case FAST_NE: FAST_BLOCK_LOOP (fast_ne (x [i], y [i])); break;
+			case FAST_LE: FAST_BLOCK_LOOP (fast_le (x [i], y [i])); break;
+			case FAST_LT: FAST_BLOCK_LOOP (fast_lt (x [i], y [i])); break;
+			case FAST_GE: FAST_BLOCK_LOOP (fast_ge (x [i], y [i])); break;
+			case FAST_GT: FAST_BLOCK_LOOP (fast_gt (x [i], y [i])); break;
+			case FAST_ADD: FAST_BLOCK_LOOP (fast_add (x [i], y [i])); break;
+			case FAST_SUB: FAST_BLOCK_LOOP (fast_sub (x [i], y [i])); break;
+			case FAST_MUL: FAST_BLOCK_LOOP (fast_mul (x [i], y [i])); break;
+			case FAST_RDIV: FAST_BLOCK_LOOP (fast_rdiv (x [i], y [i])); break;
+			case FAST_IDIV: FAST_BLOCK_LOOP (fast_idiv (x [i], y [i])); break;
+			case FAST_MOD: FAST_BLOCK_LOOP (fast_mod (x [i], y [i])); break;
+			case FAST_MINUS: FAST_BLOCK_LOOP (fast_minus (x [i])); break;
+			case FAST_POWER: FAST_BLOCK_LOOP (fast_power (x [i], y [i])); break;
+			case FAST_SQR: FAST_BLOCK_LOOP (fast_sqr (x [i])); break;
+			case FAST_MIN: FAST_BLOCK_LOOP (fast_min (x [i], y [i])); break;
+			case FAST_MAX: FAST_BLOCK_LOOP (fast_max (x [i], y [i])); break;
+			case FAST_FUNCTION1: {
+				FormulaFunction1 function = f -> function1;
+				FAST_BLOCK_LOOP (FAST_UNDEFINED1 (x [i]) ? NUMundefined : function (x [i]));
+			} break;
+			case FAST_FUNCTION2: {
+				FormulaFunction2 function = f -> function2;
+				FAST_BLOCK_LOOP (FAST_UNDEFINED2 (x [i], y [i]) ? NUMundefined : function (x [i], y [i]));
+			} break;
+			case FAST_FUNCTION3: {
+				FormulaFunction3 function = f -> function3;
+				double *z = r + f -> c * FAST_BLOCK_SIZE;
+				FAST_BLOCK_LOOP (FAST_UNDEFINED2 (x [i], y [i]) || FAST_UNDEFINED1 (z [i]) ? NUMundefined : function (x [i], y [i], z [i]));
+			} break;
+			case FAST_SELF0: {
+				if (f -> c == FAST_SELF_CELL) {
+					double value = source -> v_getCell ();
+					FAST_BLOCK_LOOP (value);
+				} else if (f -> c == FAST_SELF_VECTOR) {
+					FAST_BLOCK_LOOP (source -> v_getVector (row, firstColumn + i));
+				} else {
+					FAST_BLOCK_LOOP (source -> v_getMatrix (row, firstColumn + i));
+				}
+			} break;
+			case FAST_IFTRUE: case FAST_IFFALSE: {
+				long numberOfTrueCells = 0;
+				for (long i = 0; i < n; i ++)
+					numberOfTrueCells += x [i] != 0.0;
+				if (numberOfTrueCells != 0 && numberOfTrueCells != n) return false;   // the cells go different ways
+				if ((numberOfTrueCells != 0) == (f -> opcode == FAST_IFTRUE)) pc = f -> jump - 1;
+			} break;
+			case FAST_GOTO: pc = f -> jump - 1; break;
+			default: Melder_fatal (U"Formula: instruction ", f -> opcode, U" cannot run on a block.");
+		}
+	}
+	double *result = r + fastResultRegister * FAST_BLOCK_SIZE;
+	for (long i = 0; i < n; i ++)
+		out [i] = result [i];
+	return true;
+}
+
+static void FormulaBlocks_run (FormulaBlocks me, long firstBlock, long lastBlock) {
+	for (long iblock = firstBlock; iblock <= lastBlock; iblock ++) {
+		long row = my firstRow + (iblock - 1) / my numberOfBlocksPerRow;
+		long firstColumn = my firstColumn + ((iblock - 1) % my numberOfBlocksPerRow) * FAST_BLOCK_SIZE;
+		long lastColumn = firstColumn + FAST_BLOCK_SIZE - 1;
+		if (lastColumn > my lastColumn) lastColumn = my lastColumn;
+		if (! FormulaBlocks_runBlock (me, row, firstColumn, lastColumn - firstColumn + 1, & my out [row] [firstColumn])) {
+			for (long col = firstColumn; col <= lastColumn; col ++) {
+				bool ok = Formula_runFast (my cellRegisters.peek(), row, col, & my out [row] [col]);
+				Melder_assert (ok);   // only "self" without a row or column can fail, and row and column are positive here
+			}
+		}
+	}
+}
+
+void Formula_runRows (long firstRow, long lastRow, long firstColumn, long lastColumn, double **out) {
+	if (numberOfFastInstructions < 0 || ! fastProgramIsVectorizable || firstRow < 1 || firstColumn < 1) {
+		struct Formula_Result result;
+		for (long row = firstRow; row <= lastRow; row ++) {
+			for (long col = firstColumn; col <= lastColumn; col ++) {
+				Formula_run (row, col, & result);
+				out [row] [col] = result. result.numericResult;
+			}
+		}
+		return;
+	}
+	if (lastRow < firstRow || lastColumn < firstColumn) return;
+	fast_loadVariables (fastRegisters);
+	long numberOfBlocksPerRow = (lastColumn - firstColumn) / FAST_BLOCK_SIZE + 1;
+	long numberOfBlocks = numberOfBlocksPerRow * (lastRow - firstRow + 1);
+	int numberOfThreads = MelderThread_computeNumberOfThreads (numberOfBlocks, 16);
+	autoFormulaBlocks args [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+	for (int ithread = 0; ithread < numberOfThreads; ithread ++) {
+		args [ithread].reset (Thing_new (FormulaBlocks));
+		FormulaBlocks me = args [ithread]. peek();
+		my firstRow = firstRow;
+		my firstColumn = firstColumn;
+		my lastColumn = lastColumn;
+		my numberOfBlocksPerRow = numberOfBlocksPerRow;
+		my out = out;
+		my registers.reset (0, (numberOfFastRegisters + 1) * FAST_BLOCK_SIZE - 1);
+		my cellRegisters.reset (0, numberOfFastRegisters);
+		/*
+			Constants and variables are the same in every cell.
+		*/
+		for (int k = numberOfInstructions + 1; k <= numberOfFastRegisters; k ++) {
+			double *t = & my registers [k * FAST_BLOCK_SIZE];
+			for (long i = 0; i < FAST_BLOCK_SIZE; i ++)
+				t [i] = fastRegisters [k];
+			my cellRegisters [k] = fastRegisters [k];
+		}
+	}
+	MelderThread_run (FormulaBlocks_run, args, numberOfThreads, 1, numberOfBlocks, 1);
+}
+
 void Formula_run (long row, long col, struct Formula_Result *result) {
+	if (numberOfFastInstructions >= 0) {
+		try {
+			fast_loadVariables (fastRegisters);
+			if (Formula_runFast (fastRegisters, row, col, & result -> result.numericResult)) {
+				result -> expressionType = kFormula_EXPRESSION_TYPE_NUMERIC;
+				return;
+			}
+		} catch (MelderError) {
+			Melder_throw (U"Formula not run.");
+		}
+	}
 	FormulaInstruction f = parse;
 	programPointer = 1;   // first symbol of the program
 	if (theStack == NULL) theStack = Melder_calloc_f (struct structStackel, 10000);
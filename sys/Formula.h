@@ -63,5 +63,21 @@ void Formula_compile (Any interpreter, Any data, const char32 *expression, int e
 
 void Formula_run (long row, long col, struct Formula_Result *result);
 
+void Formula_forgetCachedPrograms (Any interpreter);
+/*
+	Formula_compile () keeps the programs that it compiles for an interpreter without a current object,
+	and reuses them when the interpreter compiles the same expression again, in the same procedure.
+	The programs refer to the variables of the interpreter,
+	so they have to be forgotten before the interpreter removes its variables.
+*/
+
+void Formula_runRows (long firstRow, long lastRow, long firstColumn, long lastColumn, double **out);
+/*
+	Runs a numeric formula for all cells from [firstRow, firstColumn] to [lastRow, lastColumn],
+	with the same results as Formula_run () on each cell in turn, followed by putting the result in out [row] [col].
+	Formulas without side effects that look at no other cell of "self" than the current one
+	are run a block of cells at a time, on several threads.
+*/
+
 /* End of file Formula.h */
 #endif
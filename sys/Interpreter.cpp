@@ -109,14 +109,16 @@ void structInterpreter :: v_destroy () {
 	Melder_free (environmentName);
 	for (int ipar = 1; ipar <= Interpreter_MAXNUM_PARAMETERS; ipar ++)
 		Melder_free (arguments [ipar]);
+	Formula_forgetCachedPrograms (this);
 	forget (variables);
+	Melder_free (variableHashTable);
 	Interpreter_Parent :: v_destroy ();
 }
 
 Interpreter Interpreter_create (char32 *environmentName, ClassInfo editorClass) {
 	try {
 		autoInterpreter me = Thing_new (Interpreter);
-		my variables = SortedSetOfString_create ();
+		my variables = Ordered_create ();
 		my environmentName = Melder_dup (environmentName);
 		my editorClass = editorClass;
 		return me.transfer();
@@ -629,37 +631,89 @@ void Interpreter_getArgumentsFromArgs (Interpreter me, int narg, Stackel args) {
 	}
 }
 
+/*
+ * The variables are found by name in a hash table with open addressing,
+ * so that finding a variable takes the same time whether the script has ten variables or a million
+ * (scripts easily create many, with names like a'i' or a [i]).
+ * A local variable is hashed and compared as if the name of the current procedure preceded the dot,
+ * without that name actually being built.
+ */
+static inline uint32 Interpreter_hashName (uint32 hash, const char32 *name) {
+	for (; *name != U'\0'; name ++)
+		hash = (hash ^ (uint32) *name) * 16777619;   // FNV-1a
+	return hash;
+}
+
+static InterpreterVariable *Interpreter_findHashSlot (Interpreter me, const char32 *prefix, const char32 *key) {
+	int64 prefixLength = str32len (prefix);
+	uint32 hash = Interpreter_hashName (Interpreter_hashName (2166136261U, prefix), key);
+	long mask = my variableHashTableSize - 1;
+	for (long islot = hash & mask;; islot = (islot + 1) & mask) {
+		InterpreterVariable var = my variableHashTable [islot];
+		if (var == NULL || (str32nequ (var -> string, prefix, prefixLength) && str32equ (var -> string + prefixLength, key)))
+			return & my variableHashTable [islot];   // an empty slot if the variable does not exist
+	}
+}
+
+static void Interpreter_addVariable (Interpreter me, InterpreterVariable variable_owned) {
+	autoInterpreterVariable variable = variable_owned;
+	if (2 * (my variables -> size + 1) > my variableHashTableSize) {
+		/*
+		 * Keep the table at most half full, so that the search for an empty slot stays short.
+		 */
+		long newSize = my variableHashTableSize == 0 ? 256 : 2 * my variableHashTableSize;
+		InterpreterVariable *newTable = Melder_calloc (InterpreterVariable, newSize);
+		Melder_free (my variableHashTable);
+		my variableHashTable = newTable;
+		my variableHashTableSize = newSize;
+		for (long ivar = 1; ivar <= my variables -> size; ivar ++) {
+			InterpreterVariable var = (InterpreterVariable) my variables -> item [ivar];
+			*Interpreter_findHashSlot (me, U"", var -> string) = var;
+		}
+	}
+	InterpreterVariable *slot = Interpreter_findHashSlot (me, U"", variable -> string);
+	if (*slot) return;   // a variable with this name exists already (e.g. a form field); keep that one
+	InterpreterVariable variable_ref = variable.peek();
+	Collection_addItem (my variables, variable.transfer());
+	*slot = variable_ref;
+}
+
+void Interpreter_removeAllVariables (Interpreter me) {
+	Formula_forgetCachedPrograms (me);   // their variables are about to disappear
+	Collection_removeAllItems (my variables);
+	for (long islot = 0; islot < my variableHashTableSize; islot ++)
+		my variableHashTable [islot] = NULL;
+}
+
 static void Interpreter_addNumericVariable (Interpreter me, const char32 *key, double value) {
 	autoInterpreterVariable variable = InterpreterVariable_create (key);
 	variable -> numericValue = value;
-	Collection_addItem (my variables, variable.transfer());
+	Interpreter_addVariable (me, variable.transfer());
 }
 
 static void Interpreter_addStringVariable (Interpreter me, const char32 *key, const char32 *value) {
 	autoInterpreterVariable variable = InterpreterVariable_create (key);
 	variable -> stringValue = Melder_dup (value);
-	Collection_addItem (my variables, variable.transfer());
+	Interpreter_addVariable (me, variable.transfer());
 }
 
 InterpreterVariable Interpreter_hasVariable (Interpreter me, const char32 *key) {
 	Melder_assert (key != NULL);
-	long variableNumber = SortedSetOfString_lookUp (my variables,
-		key [0] == U'.' ? Melder_cat (my procedureNames [my callDepth], key) : key);
-	return variableNumber ? (InterpreterVariable) my variables -> item [variableNumber] : NULL;
+	if (my variableHashTableSize == 0) return NULL;
+	return *Interpreter_findHashSlot (me, key [0] == U'.' ? my procedureNames [my callDepth] : U"", key);
 }
 
 InterpreterVariable Interpreter_lookUpVariable (Interpreter me, const char32 *key) {
 	Melder_assert (key != NULL);
-	const char32 *variableNameIncludingProcedureName =
-		key [0] == U'.' ? Melder_cat (my procedureNames [my callDepth], key) : key;
-	long variableNumber = SortedSetOfString_lookUp (my variables, variableNameIncludingProcedureName);
-	if (variableNumber) return (InterpreterVariable) my variables -> item [variableNumber];   // already exists
+	InterpreterVariable var = Interpreter_hasVariable (me, key);
+	if (var) return var;   // already exists
 	/*
 	 * The variable doesn't yet exist: create a new one.
 	 */
-	autoInterpreterVariable variable = InterpreterVariable_create (variableNameIncludingProcedureName);
+	autoInterpreterVariable variable = InterpreterVariable_create (
+		key [0] == U'.' ? Melder_cat (my procedureNames [my callDepth], key) : key);
 	InterpreterVariable variable_ref = variable.peek();
-	Collection_addItem (my variables, variable.transfer());
+	Interpreter_addVariable (me, variable.transfer());
 	return variable_ref;
 }
 
@@ -690,6 +744,76 @@ static bool isCommand (const char32 *p) {
 	return *p != '_';
 }
 
+static double numericQuery (Interpreter me, char32 *command) {
+	/*
+	 * Get the value of the query.
+	 */
+	static MelderString valueString { 0 };   // to divert the info
+	MelderString_empty (& valueString);
+	autoMelderDivertInfo divert (& valueString);
+	MelderString_appendCharacter (& valueString, 1);   // will be overwritten by something totally different if any MelderInfo function is called...
+	int status = praat_executeCommand (me, command);
+	if (status == 0) {
+		return NUMundefined;
+	} else if (valueString.string [0] == 1) {   // ...not overwritten by any MelderInfo function? then the return value will be the selected object
+		int IOBJECT, result = 0, found = 0;
+		WHERE (SELECTED) { result = IOBJECT; found += 1; }
+		if (found > 1) {
+			Melder_throw (U"Multiple objects selected. Cannot assign ID to variable.");
+		} else if (found == 0) {
+			Melder_throw (U"No objects selected. Cannot assign ID to variable.");
+		} else {
+			return theCurrentPraatObjects -> list [result]. id;
+		}
+	} else {
+		return Melder_atof (valueString.string);   // including --undefined--
+	}
+}
+
+void Interpreter_returnNumericArray (Interpreter me, double **data, long numberOfRows, long numberOfColumns) {
+	Melder_assert (my numericArrayQueryResult);
+	NUMmatrix_free (my numericArrayQueryResult -> data, 1, 1);
+	my numericArrayQueryResult -> data = data;
+	my numericArrayQueryResult -> numberOfRows = numberOfRows;
+	my numericArrayQueryResult -> numberOfColumns = numberOfColumns;
+}
+
+static void numericArrayQuery (Interpreter me, char32 *command, struct Formula_NumericArray *value) {
+	/*
+	 * The command hands its values to Interpreter_returnNumericArray () instead of listing them in the Info window.
+	 */
+	value -> numberOfRows = value -> numberOfColumns = 0;
+	value -> data = NULL;
+	my numericArrayQueryResult = value;
+	try {
+		praat_executeCommand (me, command);
+		my numericArrayQueryResult = NULL;
+	} catch (MelderError) {
+		my numericArrayQueryResult = NULL;
+		NUMmatrix_free (value -> data, 1, 1);
+		value -> data = NULL;
+		throw;
+	}
+	if (! value -> data)
+		Melder_throw (U"The command \"", command, U"\" does not give a numeric array.");
+}
+
+static void modifyNumber (double *x, int typeOfAssignment, double value) {
+	if (*x == NUMundefined) {
+		/* Keep it that way. */
+	} else if (typeOfAssignment == 1) {
+		*x += value;
+	} else if (typeOfAssignment == 2) {
+		*x -= value;
+	} else if (typeOfAssignment == 3) {
+		*x *= value;
+	} else if (value == 0) {
+		*x = NUMundefined;
+	} else {
+		*x /= value;
+	}
+}
+
 static void parameterToVariable (Interpreter me, int type, const char32 *in_parameter, int ipar) {
 	char32 parameter [200];
 	Melder_assert (type != 0);
@@ -708,8 +832,238 @@ static void parameterToVariable (Interpreter me, int type, const char32 *in_para
 	}
 }
 
+#define wordEnd(c)  (c == U'\0' || c == U' ' || c == U'\t')
+
+/*
+ * Where a control-flow line continues depends only on the lines of the script,
+ * so the interpreter searches for the matching line only the first time that it performs the control-flow line.
+ * Variable substitution could turn a line into a different statement; hence the kind of jump.
+ */
+enum { JUMP_UNKNOWN, JUMP_ENDFOR, JUMP_ENDWHILE, JUMP_ELSE, JUMP_ELSIF, JUMP_FOR, JUMP_IF,
+	JUMP_PROCEDURE, JUMP_UNTIL, JUMP_WHILE, JUMP_CALL };
+
+typedef struct structInterpreterJump {
+	int kind;
+	long lineNumber;   // the line to continue after, or (for JUMP_CALL) the line with the procedure definition
+	bool fromif;   // continue at an 'elsif'
+	long endifLineNumber;   // for an 'elsif' after a branch that was taken; 0 = not yet known
+} *InterpreterJump;
+
+static void InterpreterJump_set (InterpreterJump me, int kind, long lineNumber, bool fromif = false) {
+	my kind = kind;
+	my lineNumber = lineNumber;
+	my fromif = fromif;
+}
+
+static void InterpreterJump_findFor (InterpreterJump me, char32 **lines, long lineNumber) {   // from 'endfor'
+	int depth = 0;
+	for (long iline = lineNumber - 1; iline > 0; iline --) {
+		char32 *line = lines [iline];
+		if (line [0] == U'f' && line [1] == U'o' && line [2] == U'r' && line [3] == U' ') {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_ENDFOR, iline - 1); return; }   // go before 'for'
+			else depth --;
+		} else if (str32nequ (lines [iline], U"endfor", 6) && wordEnd (lines [iline] [6])) {
+			depth ++;
+		}
+	}
+	Melder_throw (U"Unmatched 'endfor'.");
+}
+
+static void InterpreterJump_findWhile (InterpreterJump me, char32 **lines, long lineNumber) {   // from 'endwhile'
+	int depth = 0;
+	for (long iline = lineNumber - 1; iline > 0; iline --) {
+		if (str32nequ (lines [iline], U"while ", 6)) {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_ENDWHILE, iline - 1); return; }   // go before 'while'
+			else depth --;
+		} else if (str32nequ (lines [iline], U"endwhile", 8) && wordEnd (lines [iline] [8])) {
+			depth ++;
+		}
+	}
+	Melder_throw (U"Unmatched 'endwhile'.");
+}
+
+static void InterpreterJump_findEndifFromElse (InterpreterJump me, char32 **lines, long numberOfLines, long lineNumber) {
+	int depth = 0;
+	for (long iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
+		if (str32nequ (lines [iline], U"endif", 5) && wordEnd (lines [iline] [5])) {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_ELSE, iline); return; }   // go after 'endif'
+			else depth --;
+		} else if (str32nequ (lines [iline], U"if ", 3)) {
+			depth ++;
+		}
+	}
+	Melder_throw (U"Unmatched 'else'.");
+}
+
+static void InterpreterJump_findNextBranchFromElsif (InterpreterJump me, char32 **lines, long numberOfLines, long lineNumber) {
+	int depth = 0;
+	for (long iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
+		if (str32nequ (lines [iline], U"endif", 5) && wordEnd (lines [iline] [5])) {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_ELSIF, iline); return; }   // go after 'endif'
+			else depth --;
+		} else if (str32nequ (lines [iline], U"else", 4) && wordEnd (lines [iline] [4])) {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_ELSIF, iline); return; }   // go after 'else'
+		} else if ((str32nequ (lines [iline], U"elsif", 5) && wordEnd (lines [iline] [5]))
+			|| (str32nequ (lines [iline], U"elif", 4) && wordEnd (lines [iline] [4]))) {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_ELSIF, iline - 1, true); return; }   // go at next 'elsif' or 'elif'
+		} else if (str32nequ (lines [iline], U"if ", 3)) {
+			depth ++;
+		}
+	}
+	Melder_throw (U"Unmatched 'elsif'.");
+}
+
+static void InterpreterJump_findEndifFromElsif (InterpreterJump me, char32 **lines, long numberOfLines, long lineNumber) {
+	int depth = 0;
+	for (long iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
+		if (str32nequ (lines [iline], U"endif", 5) && wordEnd (lines [iline] [5])) {
+			if (depth == 0) { my endifLineNumber = iline; return; }   // go after 'endif'
+			else depth --;
+		} else if (str32nequ (lines [iline], U"if ", 3)) {
+			depth ++;
+		}
+	}
+	Melder_throw (U"'elsif' not matched with 'endif'.");
+}
+
+static void InterpreterJump_findEndfor (InterpreterJump me, char32 **lines, long numberOfLines, long lineNumber) {
+	int depth = 0;
+	for (long iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
+		if (str32nequ (lines [iline], U"endfor", 6)) {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_FOR, iline); return; }   // go after 'endfor'
+			else depth --;
+		} else if (str32nequ (lines [iline], U"for ", 4)) {
+			depth ++;
+		}
+	}
+	Melder_throw (U"Unmatched 'for'.");
+}
+
+static void InterpreterJump_findNextBranchFromIf (InterpreterJump me, char32 **lines, long numberOfLines, long lineNumber) {
+	int depth = 0;
+	for (long iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
+		if (str32nequ (lines [iline], U"endif", 5)) {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_IF, iline); return; }   // go after 'endif'
+			else depth --;
+		} else if (str32nequ (lines [iline], U"else", 4)) {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_IF, iline); return; }   // go after 'else'
+		} else if (str32nequ (lines [iline], U"elsif ", 6) || str32nequ (lines [iline], U"elif ", 5)) {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_IF, iline - 1, true); return; }   // go at 'elsif'
+		} else if (str32nequ (lines [iline], U"if ", 3)) {
+			depth ++;
+		}
+	}
+	Melder_throw (U"Unmatched 'if'.");
+}
+
+static void InterpreterJump_findEndproc (InterpreterJump me, char32 **lines, long numberOfLines, long lineNumber) {
+	for (long iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
+		if (str32nequ (lines [iline], U"endproc", 7) && wordEnd (lines [iline] [7])) {
+			InterpreterJump_set (me, JUMP_PROCEDURE, iline);   // go after 'endproc'
+			return;
+		}
+	}
+	Melder_throw (U"Unmatched 'proc'.");
+}
+
+static void InterpreterJump_findRepeat (InterpreterJump me, char32 **lines, long lineNumber) {   // from 'until'
+	int depth = 0;
+	for (long iline = lineNumber - 1; iline > 0; iline --) {
+		if (str32nequ (lines [iline], U"repeat", 6) && wordEnd (lines [iline] [6])) {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_UNTIL, iline); return; }   // go after 'repeat'
+			else depth --;
+		} else if (str32nequ (lines [iline], U"until ", 6)) {
+			depth ++;
+		}
+	}
+	Melder_throw (U"Unmatched 'until'.");
+}
+
+static void InterpreterJump_findEndwhile (InterpreterJump me, char32 **lines, long numberOfLines, long lineNumber) {
+	int depth = 0;
+	for (long iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
+		if (str32nequ (lines [iline], U"endwhile", 8) && wordEnd (lines [iline] [8])) {
+			if (depth == 0) { InterpreterJump_set (me, JUMP_WHILE, iline); return; }   // go after 'endwhile'
+			else depth --;
+		} else if (str32nequ (lines [iline], U"while ", 6)) {
+			depth ++;
+		}
+	}
+	Melder_throw (U"Unmatched 'while'.");
+}
+
+/*
+ * A line without variable substitution always means the same statement,
+ * so the interpreter remembers what it found the first time it analysed such a line
+ * (the kind of statement, and where the variable name and the expression are),
+ * and the next time performs the statement without analysing the line again.
+ */
+enum { STATEMENT_UNKNOWN, STATEMENT_ASSIGNMENT, STATEMENT_FOR, STATEMENT_ENDFOR, STATEMENT_IF, STATEMENT_ELSE,
+	STATEMENT_ENDIF, STATEMENT_WHILE, STATEMENT_ENDWHILE };
+
+typedef struct structInterpreterStatement {
+	int kind;
+	int typeOfAssignment;   // 0 = "=", 1 = "+=", 2 = "-=", 3 = "*=", 4 = "/="
+	char32 *variableName, *endOfVariableName;   // in the line
+	InterpreterVariable variable;   // once found, for a global name; a local name depends on the current procedure
+	const char32 *expression;   // in the line, up to its end
+} *InterpreterStatement;
+
+static void InterpreterStatement_set (InterpreterStatement me, int kind, char32 *line, const char32 *command,
+	const char32 *variableName = NULL, const char32 *endOfVariableName = NULL, const char32 *expression = NULL, int typeOfAssignment = 0)
+{
+	/*
+	 * The pointers point into the analysed copy of the line; translate them to the line itself.
+	 */
+	my kind = kind;
+	my typeOfAssignment = typeOfAssignment;
+	my variableName = variableName ? line + (variableName - command) : NULL;
+	my endOfVariableName = endOfVariableName ? line + (endOfVariableName - command) : NULL;
+	my variable = NULL;
+	my expression = expression ? line + (expression - command) : NULL;
+}
+
+static InterpreterVariable InterpreterStatement_variable (InterpreterStatement me, Interpreter interpreter, bool mustExist) {
+	if (my variable) return my variable;
+	char32 save = *my endOfVariableName;
+	*my endOfVariableName = U'\0';   // close the variable name for a moment
+	try {
+		InterpreterVariable var = mustExist ? Interpreter_hasVariable (interpreter, my variableName) :
+			Interpreter_lookUpVariable (interpreter, my variableName);
+		if (! var) Melder_throw (U"Unknown variable ", my variableName, U".");
+		*my endOfVariableName = save;
+		if (my variableName [0] != U'.') my variable = var;   // variables stay where they are until the next run
+		return var;
+	} catch (MelderError) {
+		*my endOfVariableName = save;
+		throw;
+	}
+}
+
+static void InterpreterStatement_assign (InterpreterStatement me, Interpreter interpreter, double value) {
+	if (my typeOfAssignment == 0) {
+		InterpreterStatement_variable (me, interpreter, false) -> numericValue = value;
+		return;
+	}
+	modifyNumber (& InterpreterStatement_variable (me, interpreter, true) -> numericValue, my typeOfAssignment, value);
+}
+
+/*
+ * Whether line `line` is the definition of procedure `callName`.
+ */
+static bool isProcedureDefinition (const char32 *line, const char32 *callName, int64 callLength) {
+	if (! str32nequ (line, U"procedure ", 10)) return false;
+	const char32 *q = line + 10;
+	while (*q == U' ' || *q == U'\t') q ++;
+	const char32 *procName = q;
+	while (*q != U'\0' && *q != U' ' && *q != U'\t' && *q != U'(' && *q != U':') q ++;
+	return q - procName == callLength && str32nequ (procName, callName, callLength);
+}
+
 void Interpreter_run (Interpreter me, char32 *text) {
 	autoNUMvector <char32 *> lines;   // not autostringvector, because the elements are reference copies
+	autoNUMvector <struct structInterpreterJump> jumps;
+	autoNUMvector <struct structInterpreterStatement> statements;
 	long lineNumber = 0;
 	bool assertionFailed = false;
 	try {
@@ -748,6 +1102,8 @@ void Interpreter_run (Interpreter me, char32 *text) {
 		 * Remember line starts and labels.
 		 */
 		lines.reset (1, numberOfLines);
+		jumps.reset (1, numberOfLines);   // all JUMP_UNKNOWN
+		statements.reset (1, numberOfLines);   // all STATEMENT_UNKNOWN
 		for (lineNumber = 1, command = text; lineNumber <= numberOfLines; lineNumber ++, command += str32len (command) + 1 + chopped) {
 			int length;
 			while (*command == U' ' || *command == U'\t' || *command == UNICODE_NO_BREAK_SPACE) command ++;   // nbsp can occur for scripts copied from the manual
@@ -787,8 +1143,7 @@ void Interpreter_run (Interpreter me, char32 *text) {
 		/*
 		 * Copy the parameter names and argument values into the array of variables.
 		 */
-		forget (my variables);
-		my variables = SortedSetOfString_create ();
+		Interpreter_removeAllVariables (me);
 		for (ipar = 1; ipar <= my numberOfParameters; ipar ++) {
 			char32 parameter [200];
 			/*
@@ -844,7 +1199,6 @@ void Interpreter_run (Interpreter me, char32 *text) {
 		/*
 		 * Execute commands.
 		 */
-		#define wordEnd(c)  (c == U'\0' || c == U' ' || c == U'\t')
 		trace (U"going to handle ", numberOfLines, U" lines");
 		//for (lineNumber = 1; lineNumber <= numberOfLines; lineNumber ++) {
 			//trace (U"line ", lineNumber, U": ", lines [lineNumber]);
@@ -858,6 +1212,72 @@ void Interpreter_run (Interpreter me, char32 *text) {
 			try {
 				char32 c0;
 				bool fail = false;
+				InterpreterStatement statement = & statements [lineNumber];
+				if (statement -> kind != STATEMENT_UNKNOWN && assertErrorLineNumber == 0 && Melder_debug != 49) {
+					/*
+					 * Perform the statement that this line turned out to be the previous time.
+					 */
+					bool performed = true;
+					double value;
+					switch (statement -> kind) {
+						case STATEMENT_ASSIGNMENT: {
+							Interpreter_numericExpression (me, statement -> expression, & value);
+							InterpreterStatement_assign (statement, me, value);
+						} break;
+						case STATEMENT_FOR: {
+							if (! fromendfor) { performed = false; break; }   // the start of the loop may have a 'from'
+							fromendfor = FALSE;
+							InterpreterVariable var = InterpreterStatement_variable (statement, me, false);
+							Interpreter_numericExpression (me, statement -> expression, & value);
+							var -> numericValue += 1.0;
+							if (var -> numericValue > value) {
+								InterpreterJump jump = & jumps [lineNumber];
+								if (jump -> kind != JUMP_FOR) InterpreterJump_findEndfor (jump, lines.peek(), numberOfLines, lineNumber);
+								lineNumber = jump -> lineNumber;
+							}
+						} break;
+						case STATEMENT_ENDFOR: {
+							InterpreterJump jump = & jumps [lineNumber];
+							if (jump -> kind != JUMP_ENDFOR) InterpreterJump_findFor (jump, lines.peek(), lineNumber);
+							lineNumber = jump -> lineNumber;
+							fromendfor = TRUE;
+						} break;
+						case STATEMENT_IF: {
+							Interpreter_numericExpression (me, statement -> expression, & value);
+							if (value == 0.0) {
+								InterpreterJump jump = & jumps [lineNumber];
+								if (jump -> kind != JUMP_IF) InterpreterJump_findNextBranchFromIf (jump, lines.peek(), numberOfLines, lineNumber);
+								lineNumber = jump -> lineNumber;
+								if (jump -> fromif) fromif = TRUE;
+							} else if (value == NUMundefined) {
+								Melder_throw (U"The value of the 'if' condition is undefined.");
+							}
+						} break;
+						case STATEMENT_ELSE: {
+							InterpreterJump jump = & jumps [lineNumber];
+							if (jump -> kind != JUMP_ELSE) InterpreterJump_findEndifFromElse (jump, lines.peek(), numberOfLines, lineNumber);
+							lineNumber = jump -> lineNumber;
+						} break;
+						case STATEMENT_ENDIF: {
+						} break;
+						case STATEMENT_WHILE: {
+							Interpreter_numericExpression (me, statement -> expression, & value);
+							if (value == 0.0) {
+								InterpreterJump jump = & jumps [lineNumber];
+								if (jump -> kind != JUMP_WHILE) InterpreterJump_findEndwhile (jump, lines.peek(), numberOfLines, lineNumber);
+								lineNumber = jump -> lineNumber;
+							}
+						} break;
+						case STATEMENT_ENDWHILE: {
+							InterpreterJump jump = & jumps [lineNumber];
+							if (jump -> kind != JUMP_ENDWHILE) InterpreterJump_findWhile (jump, lines.peek(), lineNumber);
+							lineNumber = jump -> lineNumber;
+						} break;
+						default: performed = false;
+					}
+					if (performed) continue;
+				}
+				bool cacheable = ! str32chr (lines [lineNumber], U'\'');   // no variable substitution
 				MelderString_copy (& command2, lines [lineNumber]);
 				c0 = command2. string [0];
 				if (c0 == U'\0') continue;
@@ -942,7 +1362,9 @@ void Interpreter_run (Interpreter me, char32 *text) {
 							p ++;   // step over parenthesis or colon
 						}
 						int64 callLength = str32len (callName);
-						long iline = 1;
+						InterpreterJump jump = & jumps [lineNumber];
+						long iline = jump -> kind == JUMP_CALL && isProcedureDefinition (lines [jump -> lineNumber], callName, callLength) ?
+							jump -> lineNumber : 1;
 						for (; iline <= numberOfLines; iline ++) {
 							char32 *linei = lines [iline], *q;
 							if (linei [0] != U'p' || linei [1] != U'r' || linei [2] != U'o' || linei [3] != U'c' ||
@@ -957,6 +1379,7 @@ void Interpreter_run (Interpreter me, char32 *text) {
 								/*
 								 * We found the procedure definition.
 								 */
+								InterpreterJump_set (jump, JUMP_CALL, iline);
 								if (++ my callDepth > Interpreter_MAX_CALL_DEPTH)
 									Melder_throw (U"Call depth greater than ", Interpreter_MAX_CALL_DEPTH, U".");
 								str32cpy (my procedureNames [my callDepth], callName);
@@ -1072,7 +1495,10 @@ void Interpreter_run (Interpreter me, char32 *text) {
 							hasArguments = *p != U'\0';
 							*p = U'\0';   // close procedure name
 							callLength = str32len (callName);
-							for (iline = 1; iline <= numberOfLines; iline ++) {
+							InterpreterJump jump = & jumps [lineNumber];
+							iline = jump -> kind == JUMP_CALL && isProcedureDefinition (lines [jump -> lineNumber], callName, callLength) ?
+								jump -> lineNumber : 1;
+							for (; iline <= numberOfLines; iline ++) {
 								char32 *linei = lines [iline], *q;
 								int hasParameters;
 								if (linei [0] != U'p' || linei [1] != U'r' || linei [2] != U'o' || linei [3] != U'c' ||
@@ -1089,6 +1515,7 @@ void Interpreter_run (Interpreter me, char32 *text) {
 										Melder_throw (U"Call to procedure \"", callName, U"\" has too many arguments.");
 									if (hasParameters && ! hasArguments)
 										Melder_throw (U"Call to procedure \"", callName, U"\" has too few arguments.");
+									InterpreterJump_set (jump, JUMP_CALL, iline);
 									if (++ my callDepth > Interpreter_MAX_CALL_DEPTH)
 										Melder_throw (U"Call depth greater than ", Interpreter_MAX_CALL_DEPTH, U".");
 									str32cpy (my procedureNames [my callDepth], callName);
@@ -1167,84 +1594,43 @@ void Interpreter_run (Interpreter me, char32 *text) {
 					case U'e':
 						if (command2.string [1] == 'n' && command2.string [2] == 'd') {
 							if (str32nequ (command2.string, U"endif", 5) && wordEnd (command2.string [5])) {
-								/* Ignore. */
+								if (cacheable) InterpreterStatement_set (statement, STATEMENT_ENDIF, lines [lineNumber], command2.string);
 							} else if (str32nequ (command2.string, U"endfor", 6) && wordEnd (command2.string [6])) {
-								int depth = 0;
-								long iline;
-								for (iline = lineNumber - 1; iline > 0; iline --) {
-									char32 *line = lines [iline];
-									if (line [0] == U'f' && line [1] == U'o' && line [2] == U'r' && line [3] == U' ') {
-										if (depth == 0) { lineNumber = iline - 1; fromendfor = TRUE; break; }   // go before 'for'
-										else depth --;
-									} else if (str32nequ (lines [iline], U"endfor", 6) && wordEnd (lines [iline] [6])) {
-										depth ++;
-									}
-								}
-								if (iline <= 0) Melder_throw (U"Unmatched 'endfor'.");
+								if (cacheable) InterpreterStatement_set (statement, STATEMENT_ENDFOR, lines [lineNumber], command2.string);
+								InterpreterJump jump = & jumps [lineNumber];
+								if (jump -> kind != JUMP_ENDFOR) InterpreterJump_findFor (jump, lines.peek(), lineNumber);
+								lineNumber = jump -> lineNumber;
+								fromendfor = TRUE;
 							} else if (str32nequ (command2.string, U"endwhile", 8) && wordEnd (command2.string [8])) {
-								int depth = 0;
-								long iline;
-								for (iline = lineNumber - 1; iline > 0; iline --) {
-									if (str32nequ (lines [iline], U"while ", 6)) {
-										if (depth == 0) { lineNumber = iline - 1; break; }   // go before 'while'
-										else depth --;
-									} else if (str32nequ (lines [iline], U"endwhile", 8) && wordEnd (lines [iline] [8])) {
-										depth ++;
-									}
-								}
-								if (iline <= 0) Melder_throw (U"Unmatched 'endwhile'.");
+								if (cacheable) InterpreterStatement_set (statement, STATEMENT_ENDWHILE, lines [lineNumber], command2.string);
+								InterpreterJump jump = & jumps [lineNumber];
+								if (jump -> kind != JUMP_ENDWHILE) InterpreterJump_findWhile (jump, lines.peek(), lineNumber);
+								lineNumber = jump -> lineNumber;
 							} else if (str32nequ (command2.string, U"endproc", 7) && wordEnd (command2.string [7])) {
 								if (callDepth == 0) Melder_throw (U"Unmatched 'endproc'.");
 								lineNumber = callStack [callDepth --];
 								-- my callDepth;
 							} else fail = true;
 						} else if (str32nequ (command2.string, U"else", 4) && wordEnd (command2.string [4])) {
-							int depth = 0;
-							long iline;
-							for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
-								if (str32nequ (lines [iline], U"endif", 5) && wordEnd (lines [iline] [5])) {
-									if (depth == 0) { lineNumber = iline; break; }   // go after 'endif'
-									else depth --;
-								} else if (str32nequ (lines [iline], U"if ", 3)) {
-									depth ++;
-								}
-							}
-							if (iline > numberOfLines) Melder_throw (U"Unmatched 'else'.");
+							if (cacheable) InterpreterStatement_set (statement, STATEMENT_ELSE, lines [lineNumber], command2.string);
+							InterpreterJump jump = & jumps [lineNumber];
+							if (jump -> kind != JUMP_ELSE) InterpreterJump_findEndifFromElse (jump, lines.peek(), numberOfLines, lineNumber);
+							lineNumber = jump -> lineNumber;
 						} else if (str32nequ (command2.string, U"elsif ", 6) || str32nequ (command2.string, U"elif ", 5)) {
 							if (fromif) {
 								double value;
 								fromif = FALSE;
 								Interpreter_numericExpression (me, command2.string + 5, & value);
 								if (value == 0.0) {
-									int depth = 0;
-									long iline;
-									for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
-										if (str32nequ (lines [iline], U"endif", 5) && wordEnd (lines [iline] [5])) {
-											if (depth == 0) { lineNumber = iline; break; }   // go after 'endif'
-											else depth --;
-										} else if (str32nequ (lines [iline], U"else", 4) && wordEnd (lines [iline] [4])) {
-											if (depth == 0) { lineNumber = iline; break; }   // go after 'else'
-										} else if ((str32nequ (lines [iline], U"elsif", 5) && wordEnd (lines [iline] [5]))
-											|| (str32nequ (lines [iline], U"elif", 4) && wordEnd (lines [iline] [4]))) {
-											if (depth == 0) { lineNumber = iline - 1; fromif = TRUE; break; }   // go at next 'elsif' or 'elif'
-										} else if (str32nequ (lines [iline], U"if ", 3)) {
-											depth ++;
-										}
-									}
-									if (iline > numberOfLines) Melder_throw (U"Unmatched 'elsif'.");
+									InterpreterJump jump = & jumps [lineNumber];
+									if (jump -> kind != JUMP_ELSIF) InterpreterJump_findNextBranchFromElsif (jump, lines.peek(), numberOfLines, lineNumber);
+									lineNumber = jump -> lineNumber;
+									if (jump -> fromif) fromif = TRUE;
 								}
 							} else {
-								int depth = 0;
-								long iline;
-								for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
-									if (str32nequ (lines [iline], U"endif", 5) && wordEnd (lines [iline] [5])) {
-										if (depth == 0) { lineNumber = iline; break; }   /* Go after 'endif'. */
-										else depth --;
-									} else if (str32nequ (lines [iline], U"if ", 3)) {
-										depth ++;
-									}
-								}
-								if (iline > numberOfLines) Melder_throw (U"'elsif' not matched with 'endif'.");
+								InterpreterJump jump = & jumps [lineNumber];
+								if (jump -> endifLineNumber == 0) InterpreterJump_findEndifFromElsif (jump, lines.peek(), numberOfLines, lineNumber);
+								lineNumber = jump -> endifLineNumber;
 							}
 						} else if (str32nequ (command2.string, U"exit", 4)) {
 							if (command2.string [4] == U'\0') {
@@ -1269,6 +1655,8 @@ void Interpreter_run (Interpreter me, char32 *text) {
 							while (*endvar == U' ') { *endvar = '\0'; endvar --; }
 							while (*varpos == U' ') varpos ++;
 							if (endvar - varpos < 0) Melder_throw (U"Missing loop variable after \'for\'.");
+							if (cacheable) InterpreterStatement_set (statement, STATEMENT_FOR, lines [lineNumber], command2.string,
+								varpos, varpos + str32len (varpos), topos + 4);
 							InterpreterVariable var = Interpreter_lookUpVariable (me, varpos);
 							Interpreter_numericExpression (me, topos + 4, & toValue);
 							if (fromendfor) {
@@ -1282,17 +1670,9 @@ void Interpreter_run (Interpreter me, char32 *text) {
 							}
 							var -> numericValue = loopVariable;
 							if (loopVariable > toValue) {
-								int depth = 0;
-								long iline;
-								for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
-									if (str32nequ (lines [iline], U"endfor", 6)) {
-										if (depth == 0) { lineNumber = iline; break; }   // go after 'endfor'
-										else depth --;
-									} else if (str32nequ (lines [iline], U"for ", 4)) {
-										depth ++;
-									}
-								}
-								if (iline > numberOfLines) Melder_throw (U"Unmatched 'for'.");
+								InterpreterJump jump = & jumps [lineNumber];
+								if (jump -> kind != JUMP_FOR) InterpreterJump_findEndfor (jump, lines.peek(), numberOfLines, lineNumber);
+								lineNumber = jump -> lineNumber;
 							}
 						} else if (str32nequ (command2.string, U"form ", 5)) {
 							long iline;
@@ -1328,23 +1708,14 @@ void Interpreter_run (Interpreter me, char32 *text) {
 					case U'i':
 						if (command2.string [1] == U'f' && command2.string [2] == U' ') {   // if_
 							double value;
+							if (cacheable) InterpreterStatement_set (statement, STATEMENT_IF, lines [lineNumber], command2.string,
+								NULL, NULL, command2.string + 3);
 							Interpreter_numericExpression (me, command2.string + 3, & value);
 							if (value == 0.0) {
-								int depth = 0;
-								long iline;
-								for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
-									if (str32nequ (lines [iline], U"endif", 5)) {
-										if (depth == 0) { lineNumber = iline; break; }   // go after 'endif'
-										else depth --;
-									} else if (str32nequ (lines [iline], U"else", 4)) {
-										if (depth == 0) { lineNumber = iline; break; }   // go after 'else'
-									} else if (str32nequ (lines [iline], U"elsif ", 6) || str32nequ (lines [iline], U"elif ", 5)) {
-										if (depth == 0) { lineNumber = iline - 1; fromif = TRUE; break; }   // go at 'elsif'
-									} else if (str32nequ (lines [iline], U"if ", 3)) {
-										depth ++;
-									}
-								}
-								if (iline > numberOfLines) Melder_throw (U"Unmatched 'if'.");
+								InterpreterJump jump = & jumps [lineNumber];
+								if (jump -> kind != JUMP_IF) InterpreterJump_findNextBranchFromIf (jump, lines.peek(), numberOfLines, lineNumber);
+								lineNumber = jump -> lineNumber;
+								if (jump -> fromif) fromif = TRUE;
 							} else if (value == NUMundefined) {
 								Melder_throw (U"The value of the 'if' condition is undefined.");
 							}
@@ -1375,14 +1746,9 @@ void Interpreter_run (Interpreter me, char32 *text) {
 						break;
 					case U'p':
 						if (str32nequ (command2.string, U"procedure ", 10)) {
-							long iline = lineNumber + 1;
-							for (; iline <= numberOfLines; iline ++) {
-								if (str32nequ (lines [iline], U"endproc", 7) && wordEnd (lines [iline] [7])) {
-									lineNumber = iline;
-									break;
-								}   // go after 'endproc'
-							}
-							if (iline > numberOfLines) Melder_throw (U"Unmatched 'proc'.");
+							InterpreterJump jump = & jumps [lineNumber];
+							if (jump -> kind != JUMP_PROCEDURE) InterpreterJump_findEndproc (jump, lines.peek(), numberOfLines, lineNumber);
+							lineNumber = jump -> lineNumber;
 						} else if (str32nequ (command2.string, U"print", 5)) {
 							/*
 							 * Make sure that lines like "print = 3" will not be regarded as assignments.
@@ -1413,17 +1779,9 @@ void Interpreter_run (Interpreter me, char32 *text) {
 							double value;
 							Interpreter_numericExpression (me, command2.string + 6, & value);
 							if (value == 0.0) {
-								int depth = 0;
-								long iline;
-								for (iline = lineNumber - 1; iline > 0; iline --) {
-									if (str32nequ (lines [iline], U"repeat", 6) && wordEnd (lines [iline] [6])) {
-										if (depth == 0) { lineNumber = iline; break; }   // go after 'repeat'
-										else depth --;
-									} else if (str32nequ (lines [iline], U"until ", 6)) {
-										depth ++;
-									}
-								}
-								if (iline <= 0) Melder_throw (U"Unmatched 'until'.");
+								InterpreterJump jump = & jumps [lineNumber];
+								if (jump -> kind != JUMP_UNTIL) InterpreterJump_findRepeat (jump, lines.peek(), lineNumber);
+								lineNumber = jump -> lineNumber;
 							}
 						} else fail = true;
 						break;
@@ -1433,19 +1791,13 @@ void Interpreter_run (Interpreter me, char32 *text) {
 					case U'w':
 						if (str32nequ (command2.string, U"while ", 6)) {
 							double value;
+							if (cacheable) InterpreterStatement_set (statement, STATEMENT_WHILE, lines [lineNumber], command2.string,
+								NULL, NULL, command2.string + 6);
 							Interpreter_numericExpression (me, command2.string + 6, & value);
 							if (value == 0.0) {
-								int depth = 0;
-								long iline;
-								for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
-									if (str32nequ (lines [iline], U"endwhile", 8) && wordEnd (lines [iline] [8])) {
-										if (depth == 0) { lineNumber = iline; break; }   // go after 'endwhile'
-										else depth --;
-									} else if (str32nequ (lines [iline], U"while ", 6)) {
-										depth ++;
-									}
-								}
-								if (iline > numberOfLines) Melder_throw (U"Unmatched 'while'.");
+								InterpreterJump jump = & jumps [lineNumber];
+								if (jump -> kind != JUMP_WHILE) InterpreterJump_findEndwhile (jump, lines.peek(), numberOfLines, lineNumber);
+								lineNumber = jump -> lineNumber;
 							}
 						} else fail = true;
 						break;
@@ -1585,20 +1937,88 @@ void Interpreter_run (Interpreter me, char32 *text) {
 						 */
 						char32 *endOfVariable = ++ p;
 						while (*p == U' ' || *p == U'\t') p ++;   // go to first token after variable name
-						if (*p == U'=') {
-							;
-						} else Melder_throw (U"Missing '=' after variable ", command2.string, U".");
-						*endOfVariable = U'\0';
-						p ++;
-						while (*p == U' ' || *p == U'\t') p ++;   // go to first token after assignment or I/O symbol
-						if (*p == U'\0') {
-							Melder_throw (U"Missing expression after variable ", command2.string, U".");
+						if (*p == U'[') {
+							/*
+							 * Assign to an element of an existing array, e.g.
+							 *    f0# [iframe] = Get value in frame: iframe, "Hertz"
+							 *    sums# [irow, icol] += x
+							 */
+							*endOfVariable = U'\0';
+							InterpreterVariable var = Interpreter_hasVariable (me, command2.string);
+							if (! var || ! var -> numericArrayValue. data)
+								Melder_throw (U"Unknown array variable ", command2.string, U".");
+							long index [2] = { 1, 1 };   // row and column
+							int numberOfIndices = 0;
+							for (;;) {
+								p ++;   // skip opening bracket or comma
+								static MelderString indexString { 0 };
+								MelderString_empty (& indexString);
+								int depth = 0;
+								while ((depth > 0 || (*p != U',' && *p != U']')) && *p != U'\n' && *p != U'\0') {
+									MelderString_appendCharacter (& indexString, *p);
+									if (*p == U'[') depth ++;
+									else if (*p == U']') depth --;
+									p ++;
+								}
+								if (*p == U'\n' || *p == U'\0')
+									Melder_throw (U"Missing closing bracket (]) in array element.");
+								if (numberOfIndices == 2)
+									Melder_throw (U"An array element has one or two indices.");
+								double indexValue;
+								Interpreter_numericExpression (me, indexString.string, & indexValue);
+								if (indexValue == NUMundefined)
+									Melder_throw (U"The index is undefined.");
+								index [numberOfIndices ++] = lround (indexValue);
+								if (*p == U']') break;
+							}
+							p ++;   // skip closing bracket
+							while (*p == U' ' || *p == U'\t') p ++;
+							if (! (*p == U'=' || ((*p == U'+' || *p == U'-' || *p == U'*' || *p == U'/') && p [1] == U'=')))
+								Melder_throw (U"Missing '=' after element of ", command2.string, U".");
+							int typeOfAssignment = *p == U'+' ? 1 : *p == U'-' ? 2 : *p == U'*' ? 3 : *p == U'/' ? 4 : 0;
+							p += typeOfAssignment == 0 ? 1 : 2;
+							while (*p == U' ' || *p == U'\t') p ++;
+							if (*p == U'\0')
+								Melder_throw (U"Missing expression after element of ", command2.string, U".");
+							double value;
+							if (isCommand (p)) {
+								value = numericQuery (me, p);
+							} else {
+								Interpreter_numericExpression (me, p, & value);
+							}
+							if (index [0] < 1 || index [0] > var -> numericArrayValue. numberOfRows)
+								Melder_throw (U"Row index out of bounds.");
+							if (index [1] < 1 || index [1] > var -> numericArrayValue. numberOfColumns)
+								Melder_throw (U"Column index out of bounds.");
+							double *element = & var -> numericArrayValue. data [index [0]] [index [1]];
+							if (typeOfAssignment == 0) {
+								*element = value;
+							} else {
+								modifyNumber (element, typeOfAssignment, value);
+							}
+						} else {
+							if (*p == U'=') {
+								;
+							} else Melder_throw (U"Missing '=' after variable ", command2.string, U".");
+							*endOfVariable = U'\0';
+							p ++;
+							while (*p == U' ' || *p == U'\t') p ++;   // go to first token after assignment or I/O symbol
+							if (*p == U'\0') {
+								Melder_throw (U"Missing expression after variable ", command2.string, U".");
+							}
+							struct Formula_NumericArray value;
+							if (isCommand (p)) {
+								/*
+								 * Example: f0# = List values in all frames: "Hertz"
+								 */
+								numericArrayQuery (me, p, & value);
+							} else {
+								Interpreter_numericArrayExpression (me, p, & value);
+							}
+							InterpreterVariable var = Interpreter_lookUpVariable (me, command2.string);
+							NUMmatrix_free (var -> numericArrayValue. data, 1, 1);
+							var -> numericArrayValue = value;
 						}
-						struct Formula_NumericArray value;
-						Interpreter_numericArrayExpression (me, p, & value);
-						InterpreterVariable var = Interpreter_lookUpVariable (me, command2.string);
-						NUMmatrix_free (var -> numericArrayValue. data, 1, 1);
-						var -> numericArrayValue = value;
 					} else {
 						/*
 						 * Try to assign to a numeric variable.
@@ -1671,32 +2091,14 @@ void Interpreter_run (Interpreter me, char32 *text) {
 						 *    var = Object creation
 						 */
 						if (isCommand (p)) {
-							/*
-							 * Get the value of the query.
-							 */
-							MelderString_empty (& valueString);
-							autoMelderDivertInfo divert (& valueString);
-							MelderString_appendCharacter (& valueString, 1);   // will be overwritten by something totally different if any MelderInfo function is called...
-							int status = praat_executeCommand (me, p);
-							if (status == 0) {
-								value = NUMundefined;
-							} else if (valueString.string [0] == 1) {   // ...not overwritten by any MelderInfo function? then the return value will be the selected object
-								int IOBJECT, result = 0, found = 0;
-								WHERE (SELECTED) { result = IOBJECT; found += 1; }
-								if (found > 1) {
-									Melder_throw (U"Multiple objects selected. Cannot assign ID to variable.");
-								} else if (found == 0) {
-									Melder_throw (U"No objects selected. Cannot assign ID to variable.");
-								} else {
-									value = theCurrentPraatObjects -> list [result]. id;
-								}
-							} else {
-								value = Melder_atof (valueString.string);   // including --undefined--
-							}
+							value = numericQuery (me, p);
 						} else {
 							/*
 							 * Get the value of the formula.
 							 */
+							if (cacheable && variableName == command2.string)
+								InterpreterStatement_set (statement, STATEMENT_ASSIGNMENT, lines [lineNumber], command2.string,
+									variableName, endOfVariable, p, typeOfAssignment);
 							Interpreter_numericExpression (me, p, & value);
 						}
 						/*
@@ -52,14 +52,24 @@ Thing_define (Interpreter, Thing) {
 	char32 labelNames [1+Interpreter_MAXNUM_LABELS] [1+Interpreter_MAX_LABEL_LENGTH];
 	long labelLines [1+Interpreter_MAXNUM_LABELS];
 	char32 dialogTitle [1+100], procedureNames [1+Interpreter_MAX_CALL_DEPTH] [100];
-	SortedSetOfString variables;
+	Ordered variables;   // the owner of the variables, in the order of creation
+	InterpreterVariable *variableHashTable;   // [0..variableHashTableSize-1], for finding the variables by name; NULL = empty
+	long variableHashTableSize;
 	bool running, stopped;
+	struct Formula_NumericArray *numericArrayQueryResult;   // while a command runs whose values go into an array variable; NULL otherwise
 
 	void v_destroy ()
 		override;
 };
 
 Interpreter Interpreter_create (char32 *environmentName, ClassInfo editorClass);
+
+void Interpreter_returnNumericArray (Interpreter me, double **data, long numberOfRows, long numberOfColumns);
+/*
+	For commands that list numbers: a script that assigns the command to an array variable,
+	as in "f0# = List values in all frames: "Hertz"", receives the values directly (the Interpreter takes over data [1..numberOfRows] [1..numberOfColumns]).
+	Call only if me && my numericArrayQueryResult; otherwise, list the values in the Info window.
+*/
 Interpreter Interpreter_createFromEnvironment (Editor editor);
 
 void Melder_includeIncludeFiles (char32 **text);
@@ -82,6 +92,7 @@ void Interpreter_anyExpression (Interpreter me, const char32 *expression, struct
 
 InterpreterVariable Interpreter_hasVariable (Interpreter me, const char32 *key);
 InterpreterVariable Interpreter_lookUpVariable (Interpreter me, const char32 *key);
+void Interpreter_removeAllVariables (Interpreter me);
 
 /* End of file Interpreter.h */
 #endif
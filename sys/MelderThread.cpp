@@ -0,0 +1,560 @@
+/* MelderThread.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "MelderThread.h"
+#if USE_PTHREADS
+	#include <unistd.h>
+#elif USE_CPPTHREADS
+	#include <condition_variable>
+#endif
+
+/********** PROCESSORS AND PREFERENCES **********/
+
+int MelderThread_getNumberOfProcessors () {
+	static int numberOfProcessors = 0;
+	if (numberOfProcessors == 0) {
+		#if USE_WINTHREADS
+			SYSTEM_INFO systemInfo;
+			GetSystemInfo (& systemInfo);
+			numberOfProcessors = (int) systemInfo. dwNumberOfProcessors;
+		#elif USE_PTHREADS
+			numberOfProcessors = (int) sysconf (_SC_NPROCESSORS_ONLN);
+		#elif USE_CPPTHREADS
+			numberOfProcessors = (int) std::thread::hardware_concurrency ();
+		#else
+			numberOfProcessors = 1;
+		#endif
+		if (numberOfProcessors < 1) numberOfProcessors = 1;
+	}
+	return numberOfProcessors;
+}
+
+static int theNumberOfThreadsPreference = 0;   // automatic
+
+void MelderThread_setNumberOfThreads (int numberOfThreads) {
+	if (numberOfThreads < 0)
+		Melder_throw (U"The number of threads should not be negative (0 means automatic).");
+	theNumberOfThreadsPreference = numberOfThreads;
+}
+
+int MelderThread_getNumberOfThreadsPreference () {
+	return theNumberOfThreadsPreference;
+}
+
+int MelderThread_getNumberOfThreads () {
+	int numberOfThreads = theNumberOfThreadsPreference > 0 ? theNumberOfThreadsPreference : MelderThread_getNumberOfProcessors ();
+	if (numberOfThreads > MelderThread_MAXIMUM_NUMBER_OF_THREADS) numberOfThreads = MelderThread_MAXIMUM_NUMBER_OF_THREADS;
+	#if ! USE_WINTHREADS && ! USE_PTHREADS && ! USE_CPPTHREADS
+		numberOfThreads = 1;
+	#endif
+	return numberOfThreads;
+}
+
+int MelderThread_computeNumberOfThreads (long numberOfSteps, long minimumNumberOfStepsPerThread) {
+	if (minimumNumberOfStepsPerThread < 1) minimumNumberOfStepsPerThread = 1;
+	long numberOfThreads = numberOfSteps <= 0 ? 1 : (numberOfSteps - 1) / minimumNumberOfStepsPerThread + 1;
+	const int maximumNumberOfThreads = MelderThread_getNumberOfThreads ();
+	if (numberOfThreads > maximumNumberOfThreads) numberOfThreads = maximumNumberOfThreads;
+	return (int) numberOfThreads;
+}
+
+/********** PRIMITIVES **********/
+
+/*
+ * A mutex and a condition variable on each platform.
+ * Unlike the MelderThread_MUTEX macros, these are not static,
+ * so that every chunk range of a job can have its own lock.
+ */
+#if USE_WINTHREADS
+	typedef CRITICAL_SECTION pool_mutex;
+	typedef CONDITION_VARIABLE pool_condition;
+	static void pool_mutex_init (pool_mutex *m) { InitializeCriticalSection (m); }
+	static void pool_mutex_exit (pool_mutex *m) { DeleteCriticalSection (m); }
+	static void pool_lock (pool_mutex *m) { EnterCriticalSection (m); }
+	static void pool_unlock (pool_mutex *m) { LeaveCriticalSection (m); }
+	static void pool_condition_init (pool_condition *c) { InitializeConditionVariable (c); }
+	static void pool_wait (pool_condition *c, pool_mutex *m) { SleepConditionVariableCS (c, m, INFINITE); }
+	static void pool_signalAll (pool_condition *c) { WakeAllConditionVariable (c); }
+#elif USE_PTHREADS
+	typedef pthread_mutex_t pool_mutex;
+	typedef pthread_cond_t pool_condition;
+	static void pool_mutex_init (pool_mutex *m) { pthread_mutex_init (m, NULL); }
+	static void pool_mutex_exit (pool_mutex *m) { pthread_mutex_destroy (m); }
+	static void pool_lock (pool_mutex *m) { pthread_mutex_lock (m); }
+	static void pool_unlock (pool_mutex *m) { pthread_mutex_unlock (m); }
+	static void pool_condition_init (pool_condition *c) { pthread_cond_init (c, NULL); }
+	static void pool_wait (pool_condition *c, pool_mutex *m) { pthread_cond_wait (c, m); }
+	static void pool_signalAll (pool_condition *c) { pthread_cond_broadcast (c); }
+#elif USE_CPPTHREADS
+	typedef std::mutex pool_mutex;
+	typedef std::condition_variable_any pool_condition;
+	static void pool_mutex_init (pool_mutex *) { }
+	static void pool_mutex_exit (pool_mutex *) { }
+	static void pool_lock (pool_mutex *m) { m -> lock (); }
+	static void pool_unlock (pool_mutex *m) { m -> unlock (); }
+	static void pool_condition_init (pool_condition *) { }
+	static void pool_wait (pool_condition *c, pool_mutex *m) { c -> wait (*m); }
+	static void pool_signalAll (pool_condition *c) { c -> notify_all (); }
+#endif
+
+/********** JOBS **********/
+
+struct ChunkRange {
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		pool_mutex mutex;
+	#endif
+	std::atomic <long> nextChunk, endChunk;   // the chunks still to do are nextChunk .. endChunk - 1
+};
+
+struct Job {
+	MelderThread_ChunkProc chunkProc;
+	MelderThread_ProgressProc progressProc;
+	void *closure;
+	int numberOfThreads;
+	long firstStep, lastStep, chunkSize, numberOfChunks;
+	MelderThread_CancelToken *cancelToken;
+	ChunkRange *ranges;   // one per thread
+	std::atomic <long> numberOfChunksDone;
+	std::atomic <bool> failed;
+	std::atomic <bool> haveWorkerError;
+	char32 workerError [2000+1];   // the message of the first pool thread that failed
+};
+
+static thread_local bool theThreadIsWorker = false;   // one of the threads of the pool
+static thread_local bool theThreadIsRunningJob = false;   // the calling thread of a multithreaded job
+
+/*
+ * Progress windows and warnings belong to the interface thread.
+ * Analyses that run on another thread, such as a whole file of a batch, should not try to show them.
+ * Error messages are kept per thread (see melder_error.cpp);
+ * the message of a failing pool thread is handed to the calling thread through the job.
+ */
+static void thread_silence () {
+	Melder_progressOff ();
+	Melder_warningOff ();
+}
+
+#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+static bool Job_takeOwnChunk (Job *me, int ithread, long *out_chunk) {
+	ChunkRange *range = & my ranges [ithread];
+	bool found = false;
+	pool_lock (& range -> mutex);
+	if (range -> nextChunk < range -> endChunk) {
+		*out_chunk = range -> nextChunk ++;
+		found = true;
+	}
+	pool_unlock (& range -> mutex);
+	return found;
+}
+
+static bool Job_stealChunks (Job *me, int ithread) {
+	/*
+	 * Find the thread with the most chunks left, and take over the upper half of them.
+	 * The counts are read without locking; they only serve as a hint.
+	 */
+	for (;;) {
+		int victim = -1;
+		long mostChunksLeft = 0;
+		for (int jthread = 0; jthread < my numberOfThreads; jthread ++) {
+			if (jthread == ithread) continue;
+			long chunksLeft = my ranges [jthread]. endChunk - my ranges [jthread]. nextChunk;
+			if (chunksLeft > mostChunksLeft) {
+				mostChunksLeft = chunksLeft;
+				victim = jthread;
+			}
+		}
+		if (victim < 0) return false;
+		long firstStolenChunk = 0, endStolenChunk = 0;
+		ChunkRange *range = & my ranges [victim];
+		pool_lock (& range -> mutex);
+		long chunksLeft = range -> endChunk - range -> nextChunk;
+		if (chunksLeft > 0) {
+			long numberOfStolenChunks = (chunksLeft + 1) / 2;
+			endStolenChunk = range -> endChunk;
+			firstStolenChunk = endStolenChunk - numberOfStolenChunks;
+			range -> endChunk = firstStolenChunk;
+		}
+		pool_unlock (& range -> mutex);
+		if (endStolenChunk > firstStolenChunk) {
+			ChunkRange *ownRange = & my ranges [ithread];
+			pool_lock (& ownRange -> mutex);
+			ownRange -> nextChunk = firstStolenChunk;
+			ownRange -> endChunk = endStolenChunk;
+			pool_unlock (& ownRange -> mutex);
+			return true;
+		}
+		// somebody else was quicker; look again
+	}
+}
+#endif
+
+static bool Job_nextChunk (Job *me, int ithread, long *out_chunk) {
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		for (;;) {
+			if (Job_takeOwnChunk (me, ithread, out_chunk)) return true;
+			if (! Job_stealChunks (me, ithread)) return false;
+		}
+	#else
+		ChunkRange *range = & my ranges [ithread];
+		if (range -> nextChunk >= range -> endChunk) return false;
+		*out_chunk = range -> nextChunk ++;
+		return true;
+	#endif
+}
+
+static void Job_fail (Job *me, int ithread) {
+	if (ithread > 0) {
+		if (! my haveWorkerError. exchange (true)) {
+			str32ncpy (my workerError, Melder_getError (), 2000);
+			my workerError [2000] = U'\0';
+		}
+		Melder_clearError ();
+	}
+	my failed = true;
+	my cancelToken -> cancel ();
+}
+
+static void Job_work (Job *me, int ithread) {
+	long ichunk;
+	while (! my cancelToken -> isCancelled () && Job_nextChunk (me, ithread, & ichunk)) {
+		long firstStep = my firstStep + ichunk * my chunkSize;
+		long lastStep = firstStep + my chunkSize - 1;
+		if (lastStep > my lastStep) lastStep = my lastStep;
+		try {
+			my chunkProc (my closure, ithread, firstStep, lastStep);
+			long numberOfChunksDone = ++ my numberOfChunksDone;
+			if (ithread == 0 && my progressProc && ! theThreadIsWorker)   // never report from outside the calling thread
+				my progressProc (my closure, (double) numberOfChunksDone / my numberOfChunks);
+		} catch (MelderError) {
+			Job_fail (me, ithread);
+		} catch (...) {
+			Melder_appendError (U"Unexpected error in thread ", ithread, U".");
+			Job_fail (me, ithread);
+		}
+	}
+}
+
+/********** THE POOL **********/
+
+#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+
+static struct {
+	bool inited;
+	pool_mutex mutex;   // protects everything below
+	pool_condition workAvailable, workDone;
+	int numberOfWorkers;   // not counting the calling thread
+	long generation;   // incremented for every new job
+	Job *job;
+	int numberOfBusyWorkers;
+} thePool;
+
+static pool_mutex theRunMutex;   // one job at a time
+
+static void pool_workerLoop (int ithread) {
+	theThreadIsWorker = true;
+	thread_silence ();
+	long seenGeneration = 0;
+	for (;;) {
+		pool_lock (& thePool. mutex);
+		while (thePool. generation == seenGeneration)
+			pool_wait (& thePool. workAvailable, & thePool. mutex);
+		seenGeneration = thePool. generation;
+		Job *job = thePool. job;
+		pool_unlock (& thePool. mutex);
+		if (job && ithread < job -> numberOfThreads) {   // job can be NULL if we woke up late
+			Job_work (job, ithread);
+			pool_lock (& thePool. mutex);
+			if (-- thePool. numberOfBusyWorkers == 0)
+				pool_signalAll (& thePool. workDone);
+			pool_unlock (& thePool. mutex);
+		}
+	}
+}
+
+#if USE_WINTHREADS
+	static DWORD WINAPI pool_threadMain (void *arg) {
+		pool_workerLoop ((int) (intptr_t) arg);
+		return 0;
+	}
+#elif USE_PTHREADS
+	static void * pool_threadMain (void *arg) {
+		pool_workerLoop ((int) (intptr_t) arg);
+		return NULL;
+	}
+#endif
+
+static void pool_init () {
+	if (thePool. inited) return;
+	pool_mutex_init (& thePool. mutex);
+	pool_condition_init (& thePool. workAvailable);
+	pool_condition_init (& thePool. workDone);
+	pool_mutex_init (& theRunMutex);
+	thePool. inited = true;
+}
+
+static void pool_growTo (int numberOfThreads) {
+	/*
+	 * Worker threads are numbered 1 and up; 0 is the calling thread.
+	 */
+	while (thePool. numberOfWorkers < numberOfThreads - 1) {
+		int ithread = thePool. numberOfWorkers + 1;
+		bool started;
+		#if USE_WINTHREADS
+			HANDLE thread = CreateThread (NULL, 0, pool_threadMain, (void *) (intptr_t) ithread, 0, NULL);
+			started = thread != NULL;
+			if (started) CloseHandle (thread);
+		#elif USE_PTHREADS
+			pthread_t thread;
+			started = pthread_create (& thread, NULL, pool_threadMain, (void *) (intptr_t) ithread) == 0;
+			if (started) pthread_detach (thread);
+		#elif USE_CPPTHREADS
+			try {
+				std::thread (pool_workerLoop, ithread). detach ();
+				started = true;
+			} catch (...) {
+				started = false;
+			}
+		#endif
+		if (! started) break;   // make do with the threads we have
+		thePool. numberOfWorkers += 1;
+	}
+}
+
+#endif
+
+void MelderThread_runChunks (MelderThread_ChunkProc chunkProc, MelderThread_ProgressProc progressProc, void *closure,
+	int numberOfThreads, long firstStep, long lastStep, long chunkSize, MelderThread_CancelToken *cancelToken)
+{
+	if (lastStep < firstStep) return;
+	if (chunkSize < 1) chunkSize = 1;
+	MelderThread_CancelToken ownCancelToken;
+	if (! cancelToken) cancelToken = & ownCancelToken;
+	long numberOfChunks = (lastStep - firstStep) / chunkSize + 1;
+	if (numberOfThreads > numberOfChunks) numberOfThreads = (int) numberOfChunks;
+	if (numberOfThreads > MelderThread_MAXIMUM_NUMBER_OF_THREADS) numberOfThreads = MelderThread_MAXIMUM_NUMBER_OF_THREADS;
+	if (numberOfThreads < 1) numberOfThreads = 1;
+
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		if (theThreadIsWorker || theThreadIsRunningJob) numberOfThreads = 1;   // nested: don't wait for the threads that we are part of
+		if (numberOfThreads > 1) {
+			pool_init ();
+			pool_lock (& theRunMutex);
+			pool_lock (& thePool. mutex);
+			pool_growTo (numberOfThreads);
+			pool_unlock (& thePool. mutex);
+			if (numberOfThreads > thePool. numberOfWorkers + 1) numberOfThreads = thePool. numberOfWorkers + 1;
+			if (numberOfThreads == 1) pool_unlock (& theRunMutex);
+		}
+	#else
+		numberOfThreads = 1;
+	#endif
+
+	ChunkRange ranges [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+	Job job;
+	job. chunkProc = chunkProc;
+	job. progressProc = progressProc;
+	job. closure = closure;
+	job. numberOfThreads = numberOfThreads;
+	job. firstStep = firstStep;
+	job. lastStep = lastStep;
+	job. chunkSize = chunkSize;
+	job. numberOfChunks = numberOfChunks;
+	job. cancelToken = cancelToken;
+	job. ranges = ranges;
+	job. numberOfChunksDone = 0;
+	job. failed = false;
+	job. haveWorkerError = false;
+	job. workerError [0] = U'\0';
+	for (int ithread = 0; ithread < numberOfThreads; ithread ++) {
+		#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+			pool_mutex_init (& ranges [ithread]. mutex);
+		#endif
+		ranges [ithread]. nextChunk = numberOfChunks * ithread / numberOfThreads;
+		ranges [ithread]. endChunk = numberOfChunks * (ithread + 1) / numberOfThreads;
+	}
+
+	if (numberOfThreads == 1) {
+		Job_work (& job, 0);
+	} else {
+		#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+			pool_lock (& thePool. mutex);
+			thePool. job = & job;
+			thePool. numberOfBusyWorkers = numberOfThreads - 1;
+			thePool. generation += 1;
+			pool_signalAll (& thePool. workAvailable);
+			pool_unlock (& thePool. mutex);
+
+			theThreadIsRunningJob = true;   // nested calls from the chunk procedure run serially
+			Job_work (& job, 0);
+			theThreadIsRunningJob = false;
+
+			pool_lock (& thePool. mutex);
+			while (thePool. numberOfBusyWorkers > 0)
+				pool_wait (& thePool. workDone, & thePool. mutex);
+			thePool. job = NULL;
+			pool_unlock (& thePool. mutex);
+			pool_unlock (& theRunMutex);
+		#endif
+	}
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		for (int ithread = 0; ithread < numberOfThreads; ithread ++)
+			pool_mutex_exit (& ranges [ithread]. mutex);
+	#endif
+	if (job. failed) {
+		if (! Melder_hasError ())   // the calling thread itself did not fail
+			Melder_appendError_noLine (job. workerError);
+		throw MelderError ();
+	}
+}
+
+/********** BACKGROUND THREADS **********/
+
+struct MelderThread_Monitor {
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		pool_mutex mutex;
+		pool_condition condition;
+	#endif
+};
+
+MelderThread_Monitor * MelderThread_Monitor_create () {
+	MelderThread_Monitor *me = new MelderThread_Monitor;
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		pool_mutex_init (& my mutex);
+		pool_condition_init (& my condition);
+	#endif
+	return me;
+}
+
+void MelderThread_Monitor_delete (MelderThread_Monitor *me) {
+	if (! me) return;
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		pool_mutex_exit (& my mutex);
+		#if USE_PTHREADS
+			pthread_cond_destroy (& my condition);
+		#endif
+	#endif
+	delete me;
+}
+
+void MelderThread_Monitor_lock (MelderThread_Monitor *me) {
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		pool_lock (& my mutex);
+	#else
+		(void) me;
+	#endif
+}
+
+void MelderThread_Monitor_unlock (MelderThread_Monitor *me) {
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		pool_unlock (& my mutex);
+	#else
+		(void) me;
+	#endif
+}
+
+void MelderThread_Monitor_wait (MelderThread_Monitor *me) {
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		pool_wait (& my condition, & my mutex);
+	#else
+		(void) me;
+	#endif
+}
+
+void MelderThread_Monitor_signalAll (MelderThread_Monitor *me) {
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		pool_signalAll (& my condition);
+	#else
+		(void) me;
+	#endif
+}
+
+struct MelderThread_Background {
+	void (*proc) (void *closure);
+	void *closure;
+	#if USE_WINTHREADS
+		HANDLE thread;
+	#elif USE_PTHREADS
+		pthread_t thread;
+	#elif USE_CPPTHREADS
+		std::thread thread;
+	#endif
+};
+
+static void background_run (MelderThread_Background *me) {
+	thread_silence ();
+	my proc (my closure);
+}
+
+#if USE_WINTHREADS
+	static DWORD WINAPI background_threadMain (void *arg) {
+		background_run ((MelderThread_Background *) arg);
+		return 0;
+	}
+#elif USE_PTHREADS
+	static void * background_threadMain (void *arg) {
+		background_run ((MelderThread_Background *) arg);
+		return NULL;
+	}
+#endif
+
+MelderThread_Background * MelderThread_Background_start (void (*proc) (void *closure), void *closure) {
+	#if USE_WINTHREADS || USE_PTHREADS || USE_CPPTHREADS
+		MelderThread_Background *me = new MelderThread_Background;
+		my proc = proc;
+		my closure = closure;
+		bool started;
+		#if USE_WINTHREADS
+			my thread = CreateThread (NULL, 0, background_threadMain, me, 0, NULL);
+			started = my thread != NULL;
+		#elif USE_PTHREADS
+			started = pthread_create (& my thread, NULL, background_threadMain, me) == 0;
+		#elif USE_CPPTHREADS
+			try {
+				my thread = std::thread (background_run, me);
+				started = true;
+			} catch (...) {
+				started = false;
+			}
+		#endif
+		if (! started) {
+			delete me;
+			return NULL;
+		}
+		return me;
+	#else
+		(void) proc;
+		(void) closure;
+		return NULL;
+	#endif
+}
+
+void MelderThread_Background_join (MelderThread_Background *me) {
+	if (! me) return;
+	#if USE_WINTHREADS
+		WaitForSingleObject (my thread, INFINITE);
+		CloseHandle (my thread);
+	#elif USE_PTHREADS
+		pthread_join (my thread, NULL);
+	#elif USE_CPPTHREADS
+		my thread. join ();
+	#endif
+	delete me;
+}
+
+/* End of file MelderThread.cpp */
@@ -3,6 +3,7 @@
 /* MelderThread.h
  *
  * Copyright (C) 2014 Paul Boersma
+ * Copyright (C) 2026 agent
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -19,7 +20,7 @@
  * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
-#include <vector>
+#include <atomic>
 #include "Thing.h"
 
 #if defined (_WIN32)
@@ -80,94 +81,126 @@
 	#define MelderThread_UNLOCK(_mutex)  _mutex = 0
 #endif
 
-static int MelderThread_getNumberOfProcessors () {
-	#if USE_WINTHREADS
-		return 8;
-	#elif USE_PTHREADS
-		return 8;
-	#elif USE_CPPTHREADS
-		return std::thread::hardware_concurrency ();
-	#else
-		return 1;
-	#endif
-}
+/*
+ * The shared thread pool.
+ *
+ * Analyses that consist of many independent steps (e.g. one per frame) hand a range of step indices
+ * to MelderThread_run (), which cuts the range into chunks and distributes the chunks
+ * over the calling thread and the persistent worker threads of the pool.
+ * Every thread starts with its own contiguous share of the chunks;
+ * a thread that has finished its share steals half of the remaining chunks of the busiest other thread,
+ * so that short and long steps balance out.
+ *
+ * The worker threads are created on first use and live until the program ends.
+ * A MelderThread_run () that is called from within a pool thread runs on the calling thread only,
+ * so that analyses can be nested without deadlock.
+ */
 
-#if USE_WINTHREADS
-	template <class T> void MelderThread_run (DWORD (WINAPI *func) (T *), _Thing_auto <T> *args, int numberOfThreads) {
-		if (numberOfThreads == 1) {
-			func (args [0].peek());
-		} else {
-			std::vector <HANDLE> threads (numberOfThreads);
-			try {
-				for (int ithread = 1; ithread < numberOfThreads; ithread ++) {
-					threads [ithread - 1] = CreateThread (NULL, 0,
-						(DWORD (WINAPI *)(void *)) func, (void *) args [ithread - 1].peek(), 0, NULL);
-				}
-				func (args [numberOfThreads - 1].peek());
-			} catch (MelderError) {
-				for (int ithread = 1; ithread < numberOfThreads; ithread ++) {
-					WaitForSingleObject (threads [ithread - 1], INFINITE);
-					CloseHandle (threads [ithread - 1]);
-				}
-				throw;
-			}
-			for (int ithread = 1; ithread < numberOfThreads; ithread ++) {
-				WaitForSingleObject (threads [ithread - 1], INFINITE);
-				CloseHandle (threads [ithread - 1]);
-			}
-		}
-	}
-#elif USE_PTHREADS
-	template <class T> void MelderThread_run (void * (*func) (T *), _Thing_auto <T> *args, int numberOfThreads) {
-		if (numberOfThreads == 1) {
-			func (args [0].peek());
-		} else {
-			std::vector <pthread_t> threads (numberOfThreads);
-			try {
-				for (int ithread = 1; ithread < numberOfThreads; ithread ++) {
-					(void) pthread_create (& threads [ithread - 1],
-						NULL, (void*(*)(void *)) func, (void *) args [ithread - 1].peek());
-				}
-				func (args [numberOfThreads - 1].peek());
-			} catch (MelderError) {
-				for (int ithread = 1; ithread < numberOfThreads; ithread ++) {
-					pthread_join (threads [ithread - 1], NULL);
-				}
-				throw;
-			}
-			for (int ithread = 1; ithread < numberOfThreads; ithread ++) {
-				pthread_join (threads [ithread - 1], NULL);
-			}
-		}
-	}
-#elif USE_CPPTHREADS
-	template <class T> void MelderThread_run (void * (*func) (T *), _Thing_auto <T> *args, int numberOfThreads) {
-		if (numberOfThreads == 1) {
-			func (args [0].peek());
-		} else {
-			std::vector <std::thread> thread (numberOfThreads);
-			try {
-				for (int ithread = 1; ithread < numberOfThreads; ithread ++) {
-					thread [ithread - 1] = std::thread (func, args [ithread - 1].peek());
-				}
-				func (args [numberOfThreads - 1].peek());
-			} catch (MelderError) {
-				for (int ithread = 1; ithread < numberOfThreads; ithread ++) {
-					if (thread [ithread - 1]. joinable ())
-						thread [ithread - 1]. join ();
-				}
-				throw;
-			}
-			for (int ithread = 1; ithread < numberOfThreads; ithread ++) {
-				thread [ithread - 1]. join ();
-			}
-		}
+#define MelderThread_MAXIMUM_NUMBER_OF_THREADS  256
+
+int MelderThread_getNumberOfProcessors ();
+
+void MelderThread_setNumberOfThreads (int numberOfThreads);   // 0 = automatic, i.e. one thread per processor
+int MelderThread_getNumberOfThreadsPreference ();   // as set, i.e. 0 if automatic
+int MelderThread_getNumberOfThreads ();   // the effective number, between 1 and MelderThread_MAXIMUM_NUMBER_OF_THREADS
+
+/*
+ * The number of threads worth using for `numberOfSteps` steps,
+ * if a thread should get at least `minimumNumberOfStepsPerThread` steps.
+ */
+int MelderThread_computeNumberOfThreads (long numberOfSteps, long minimumNumberOfStepsPerThread);
+
+/*
+ * A cancellation token replaces the `volatile int cancelled` of earlier threaded code.
+ * The pool checks it between chunks; an analysis with long chunks can check it itself.
+ */
+struct MelderThread_CancelToken {
+	std::atomic <bool> d_cancelled;
+	MelderThread_CancelToken () : d_cancelled (false) { }
+	void cancel () { d_cancelled. store (true, std::memory_order_relaxed); }
+	bool isCancelled () const { return d_cancelled. load (std::memory_order_relaxed); }
+};
+
+/*
+ * A lock for short critical sections, such as a lookup in a process-wide cache.
+ * Unlike MelderThread_MUTEX, it needs no run-time initialization on any platform,
+ * so it can be a static variable of any module.
+ */
+struct MelderThread_SpinLock {
+	std::atomic <bool> d_locked;
+	constexpr MelderThread_SpinLock () : d_locked (false) { }
+	void lock () { while (d_locked. exchange (true, std::memory_order_acquire)) { } }
+	void unlock () { d_locked. store (false, std::memory_order_release); }
+};
+
+struct autoMelderThread_SpinLock {
+	MelderThread_SpinLock *d_lock;
+	autoMelderThread_SpinLock (MelderThread_SpinLock *lock) : d_lock (lock) { d_lock -> lock (); }
+	~autoMelderThread_SpinLock () { d_lock -> unlock (); }
+};
+
+/*
+ * The untyped engine. Use MelderThread_run () instead.
+ */
+typedef void (*MelderThread_ChunkProc) (void *closure, int ithread, long firstStep, long lastStep);
+typedef void (*MelderThread_ProgressProc) (void *closure, double fraction);
+void MelderThread_runChunks (MelderThread_ChunkProc chunkProc, MelderThread_ProgressProc progressProc, void *closure,
+	int numberOfThreads, long firstStep, long lastStep, long chunkSize, MelderThread_CancelToken *cancelToken);
+
+template <class T>
+struct _MelderThread_Closure {
+	void (*func) (T *, long, long);
+	void (*progress) (T *, double);
+	_Thing_auto <T> *args;
+	static void chunk (void *void_me, int ithread, long firstStep, long lastStep) {
+		_MelderThread_Closure *me = static_cast <_MelderThread_Closure *> (void_me);
+		me -> func (me -> args [ithread]. peek(), firstStep, lastStep);
 	}
-#else
-	template <class T> void MelderThread_run (void (*func) (T *), _Thing_auto <T> *args, int numberOfThreads) {
-		func (args [0].peek());
+	static void report (void *void_me, double fraction) {
+		_MelderThread_Closure *me = static_cast <_MelderThread_Closure *> (void_me);
+		me -> progress (me -> args [0]. peek(), fraction);
 	}
-#endif
+};
+
+/*
+ * Performs func (args [ithread], firstStep, lastStep) for consecutive chunks of at most `chunkSize` steps
+ * that together cover `firstStep` through `lastStep`, in any order and on up to `numberOfThreads` threads.
+ * `args [0]` belongs to the calling thread, `args [1]` through `args [numberOfThreads - 1]` to the pool threads;
+ * a chunk is always processed with the `args` of the thread that processes it,
+ * so each `args` can own the scratch buffers of its thread.
+ * After each chunk on the calling thread, `progress (args [0], fractionDone)` is called (if not NULL);
+ * it may throw a MelderError, e.g. if the user clicks Cancel.
+ * If any chunk or progress call throws, all threads stop at their next chunk boundary,
+ * and MelderThread_run () throws after all threads have stopped.
+ */
+template <class T> void MelderThread_run (void (*func) (T *, long, long), _Thing_auto <T> *args, int numberOfThreads,
+	long firstStep, long lastStep, long chunkSize,
+	void (*progress) (T *, double) = NULL, MelderThread_CancelToken *cancelToken = NULL)
+{
+	_MelderThread_Closure <T> closure { func, progress, args };
+	MelderThread_runChunks (_MelderThread_Closure <T> :: chunk, progress ? _MelderThread_Closure <T> :: report : NULL,
+		& closure, numberOfThreads, firstStep, lastStep, chunkSize, cancelToken);
+}
+
+/*
+ * A thread of its own, for work that should go on while the calling thread does other things,
+ * such as decoding the next part of a compressed sound file.
+ * The thread and its caller communicate through data that they share under a MelderThread_Monitor.
+ * MelderThread_Background_start () returns NULL if the platform cannot start a thread;
+ * the caller should then do the work itself, when it is needed.
+ * MelderThread_Background_join () waits until `proc` has returned and frees the thread.
+ */
+struct MelderThread_Monitor;
+MelderThread_Monitor * MelderThread_Monitor_create ();
+void MelderThread_Monitor_delete (MelderThread_Monitor *me);
+void MelderThread_Monitor_lock (MelderThread_Monitor *me);
+void MelderThread_Monitor_unlock (MelderThread_Monitor *me);
+void MelderThread_Monitor_wait (MelderThread_Monitor *me);   // call with the lock held
+void MelderThread_Monitor_signalAll (MelderThread_Monitor *me);   // call with the lock held
+
+struct MelderThread_Background;
+MelderThread_Background * MelderThread_Background_start (void (*proc) (void *closure), void *closure);
+void MelderThread_Background_join (MelderThread_Background *me);
 
 #endif
 /* End of file MelderThread.h */
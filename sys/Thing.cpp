@@ -19,9 +19,10 @@
 
 #include <stdarg.h>
 #include <time.h>
+#include <atomic>
 #include "Thing.h"
 
-static long theTotalNumberOfThings;
+static std::atomic <long> theTotalNumberOfThings (0);   // Things are created from several threads at the same time
 
 void structThing :: v_info ()
 {
@@ -216,8 +217,8 @@ void Thing_info (Thing me) {
 char32 * Thing_getName (Thing me) { return my name; }
 
 char32 * Thing_messageName (Thing me) {
-	static MelderString buffers [19] { { 0 } };
-	static int ibuffer = 0;
+	static thread_local MelderString buffers [19] { { 0 } };
+	static thread_local int ibuffer = 0;
 	if (++ ibuffer == 19) ibuffer = 0;
 	if (my name) {
 		MelderString_copy (& buffers [ibuffer], my classInfo -> className, U" \"", my name, U"\"");
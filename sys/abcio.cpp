@@ -36,6 +36,7 @@
 #include "melder.h"
 #include "NUM.h"
 #include <ctype.h>
+#include <float.h>
 #ifdef macintosh
 	#include <TargetConditionals.h>
 #endif
@@ -43,9 +44,59 @@
 
 /********** text I/O **********/
 
+/*
+	Skips the labels and white space in front of the next value in 8-bit text, directly on the bytes,
+	which is many times faster than doing it character by character with MelderReadText_getChar ().
+	Stops at anything that needs the scrutiny of the loops below (numbers, strings, enumerated values, comments,
+	the end of the text), always at the start of a word, so that these loops carry on as if they had done the skipping themselves.
+*/
+static void skipLabels8 (MelderReadText me) {
+	const char *p = me -> readPointer8;
+	if (p == NULL) return;
+	for (;;) {
+		char c = *p;
+		if (c == ' ' || c == '\n' || c == '\t' || c == '\r') {
+			p ++;
+			continue;
+		}
+		if (c == '\0' || c == '-' || c == '+' || (c >= '0' && c <= '9') || c == '!' || c == '\"' || c == '<')
+			break;
+		const char *word = p;
+		while (*p != ' ' && *p != '\n' && *p != '\t' && *p != '\r' && *p != '\0')
+			p ++;
+		if (*p == '\0') {
+			p = word;   // let the loops below report the early end of the text
+			break;
+		}
+	}
+	me -> readPointer8 = (char *) p;
+}
+
+/*
+	Copies the number at which skipLabels8 () stopped into `buffer`, and moves on as the loops below would,
+	if the number is plain ASCII of at most 40 characters; otherwise leaves it to these loops.
+*/
+static bool getNumber8 (MelderReadText me, char *buffer) {
+	const char *p = me -> readPointer8;
+	if (p == NULL || ! (*p == '-' || *p == '+' || (*p >= '0' && *p <= '9')))
+		return false;
+	const char *q = p;
+	while (q - p < 40 && *q != ' ' && *q != '\n' && *q != '\t' && *q != '\r' && *q != '\0' && (unsigned char) *q < 0x80)
+		q ++;
+	if (*q != ' ' && *q != '\n' && *q != '\t' && *q != '\r' && *q != '\0')
+		return false;   // long or strange text
+	if (q - p == 1 && *p == '+')
+		return false;   // a single '+', which occurs in complex numbers
+	memcpy (buffer, p, q - p);
+	buffer [q - p] = '\0';
+	me -> readPointer8 = (char *) (*q == '\0' ? q : q + 1);
+	return true;
+}
+
 static long getInteger (MelderReadText me) {
 	char buffer [41];
 	char32 c;
+	skipLabels8 (me);
 	/*
 	 * Look for the first numeric character.
 	 */
@@ -86,6 +137,7 @@ static long getInteger (MelderReadText me) {
 static unsigned long getUnsigned (MelderReadText me) {
 	char buffer [41];
 	char32 c;
+	skipLabels8 (me);
 	for (c = MelderReadText_getChar (me); ! isdigit ((int) c) && c != U'+'; c = MelderReadText_getChar (me)) {
 		if (c == U'\0')
 			Melder_throw (U"Early end of text detected while looking for an unsigned integer (line ", MelderReadText_getLineNumber (me), U").");
@@ -122,10 +174,26 @@ static unsigned long getUnsigned (MelderReadText me) {
 	return strtoul (buffer, NULL, 10);
 }
 
+static double bufferToReal (char *buffer) {
+	char *slash = strchr (buffer, '/');
+	if (slash) {
+		double numerator, denominator;
+		*slash = '\0';
+		numerator = Melder_a8tof (buffer), denominator = Melder_a8tof (slash + 1);
+		if (numerator == HUGE_VAL || denominator == HUGE_VAL || denominator == 0.0)
+			return HUGE_VAL;
+		return numerator / denominator;
+	}
+	return Melder_a8tof (buffer);
+}
+
 static double getReal (MelderReadText me) {
 	int i;
-	char buffer [41], *slash;
+	char buffer [41];
 	char32 c;
+	skipLabels8 (me);
+	if (getNumber8 (me, buffer))
+		return bufferToReal (buffer);
 	do {
 		for (c = MelderReadText_getChar (me); c != U'-' && ! isdigit ((int) c) && c != U'+'; c = MelderReadText_getChar (me)) {
 			if (c == U'\0')
@@ -156,22 +224,15 @@ static double getReal (MelderReadText me) {
 		}
 		if (i >= 40)
 			Melder_throw (U"Found long text while searching for a real number in text (line ", MelderReadText_getLineNumber (me), U").");
+		skipLabels8 (me);   // in case of a single '+'
 	} while (i == 0 && buffer [0] == '+');   // guard against single '+' symbols, which occur in complex numbers
 	buffer [i + 1] = '\0';
-	slash = strchr (buffer, '/');
-	if (slash) {
-		double numerator, denominator;
-		*slash = '\0';
-		numerator = Melder_a8tof (buffer), denominator = Melder_a8tof (slash + 1);
-		if (numerator == HUGE_VAL || denominator == HUGE_VAL || denominator == 0.0)
-			return HUGE_VAL;
-		return numerator / denominator;
-	}
-	return Melder_a8tof (buffer);
+	return bufferToReal (buffer);
 }
 
 static short getEnum (MelderReadText me, int (*getValue) (const char32 *)) {
 	char32 buffer [41], c;
+	skipLabels8 (me);
 	for (c = MelderReadText_getChar (me); c != U'<'; c = MelderReadText_getChar (me)) {
 		if (c == U'\0')
 			Melder_throw (U"Early end of text detected while looking for an enumerated value (line ", MelderReadText_getLineNumber (me), U").");
@@ -214,6 +275,7 @@ static short getEnum (MelderReadText me, int (*getValue) (const char32 *)) {
 static char32 * getString (MelderReadText me) {
 	static MelderString buffer { 0 };
 	MelderString_empty (& buffer);
+	skipLabels8 (me);
 	for (char32 c = MelderReadText_getChar (me); c != U'\"'; c = MelderReadText_getChar (me)) {
 		if (c == U'\0')
 			Melder_throw (U"Early end of text detected while looking for a string (line ", MelderReadText_getLineNumber (me), U").");
@@ -345,12 +407,19 @@ void texindent (MelderFile file) { file -> indent += 4; }
 void texexdent (MelderFile file) { file -> indent -= 4; }
 void texresetindent (MelderFile file) { file -> indent = 0; }
 
+static const char32 *theSpaces = U"                                                                "
+	U"                                                                ";   // 128
+
+static void writeIndent (MelderFile file) {
+	const int numberOfSpaces = (int) str32len (theSpaces);
+	for (int remaining = file -> indent; remaining > 0; remaining -= numberOfSpaces)
+		MelderFile_write (file, & theSpaces [numberOfSpaces - (remaining < numberOfSpaces ? remaining : numberOfSpaces)]);
+}
+
 void texputintro (MelderFile file, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4, const char32 *s5, const char32 *s6) {
 	if (file -> verbose) {
 		MelderFile_write (file, U"\n");
-		for (int iindent = 1; iindent <= file -> indent; iindent ++) {
-			MelderFile_write (file, U" ");
-		}
+		writeIndent (file);
 		MelderFile_write (file,
 			s1 && s1 [0] == U'd' && s1 [1] == U'_' ? & s1 [2] : & s1 [0],
 			s2 && s2 [0] == U'd' && s2 [1] == U'_' ? & s2 [2] : & s2 [0],
@@ -365,9 +434,7 @@ void texputintro (MelderFile file, const char32 *s1, const char32 *s2, const cha
 #define PUTLEADER  \
 	MelderFile_write (file, U"\n"); \
 	if (file -> verbose) { \
-		for (int iindent = 1; iindent <= file -> indent; iindent ++) { \
-			MelderFile_write (file, U" "); \
-		} \
+		writeIndent (file); \
 		MelderFile_write (file, \
 			s1 && s1 [0] == U'd' && s1 [1] == U'_' ? & s1 [2] : & s1 [0], \
 			s2 && s2 [0] == U'd' && s2 [1] == U'_' ? & s2 [2] : & s2 [0], \
@@ -409,6 +476,51 @@ void texputr8 (MelderFile file, double x, const char32 *s1, const char32 *s2, co
 	PUTLEADER
 	MelderFile_write (file, file -> verbose ? U" = " : NULL, x, file -> verbose ? U" " : NULL);
 }
+/*
+	The leader and the value of every element go into one string, which goes to the file in large blocks.
+*/
+static void texputreals (MelderFile file, const double *x, long lo, long hi, bool single, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4) {
+	if (Melder_debug == 50) {   // one by one, as in the other writers
+		autostring32 label3 = Melder_dup (s3);
+		for (long i = lo; i <= hi; i ++) {
+			if (single)
+				texputr4 (file, x [i], s1, s2, label3.peek (), s4, Melder_integer (i), U"]");
+			else
+				texputr8 (file, x [i], s1, s2, label3.peek (), s4, Melder_integer (i), U"]");
+		}
+		return;
+	}
+	autoMelderString leader, block;
+	MelderString_appendCharacter (& leader, U'\n');
+	if (file -> verbose) {
+		for (int iindent = 1; iindent <= file -> indent; iindent ++)
+			MelderString_appendCharacter (& leader, U' ');
+		const char32 *labels [4] = { s1, s2, s3, s4 };
+		for (int ilabel = 0; ilabel < 4; ilabel ++) {
+			const char32 *label = labels [ilabel];
+			if (label) MelderString_append (& leader, label [0] == U'd' && label [1] == U'_' ? & label [2] : & label [0]);
+		}
+	}
+	for (long i = lo; i <= hi; i ++) {
+		MelderString_append (& block, leader.string);
+		if (file -> verbose)
+			MelderString_append (& block, Melder_integer (i), U"] = ");
+		MelderString_append (& block, single ? Melder_single (x [i]) : Melder_double (x [i]));
+		if (file -> verbose)
+			MelderString_appendCharacter (& block, U' ');
+		if (block.length > 1000) {   // well below the size at which MelderString_empty () would free the buffer
+			MelderFile_write (file, block.string);
+			MelderString_empty (& block);
+		}
+	}
+	MelderFile_write (file, block.string);
+}
+void texputr4s (MelderFile file, const double *x, long lo, long hi, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4) {
+	texputreals (file, x, lo, hi, true, s1, s2, s3, s4);
+}
+void texputr8s (MelderFile file, const double *x, long lo, long hi, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4) {
+	texputreals (file, x, lo, hi, false, s1, s2, s3, s4);
+}
 void texputc8 (MelderFile file, fcomplex z, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4, const char32 *s5, const char32 *s6) {
 	PUTLEADER
 	MelderFile_write (file, file -> verbose ? U" = " : NULL, Melder_single (z.re),
@@ -1377,6 +1489,149 @@ void binputr8 (double x, FILE *f) {
 	}
 }
 
+/*
+	The block routines do what the routines above do for each number,
+	but read or write thousands of numbers at a time, and reverse the byte order of a whole block in memory;
+	compilers turn the loops into byte-swap (or vector shuffle) instructions.
+*/
+
+#if defined (__BYTE_ORDER__) && defined (__ORDER_LITTLE_ENDIAN__) && defined (__ORDER_BIG_ENDIAN__)
+	#define binario_littleEndian  (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	#define binario_bigEndian  (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#elif defined (_WIN32) || defined (macintosh) && TARGET_RT_LITTLE_ENDIAN == 1
+	#define binario_littleEndian  1
+	#define binario_bigEndian  0
+#elif defined (macintosh) && TARGET_RT_BIG_ENDIAN == 1
+	#define binario_littleEndian  0
+	#define binario_bigEndian  1
+#else
+	#define binario_littleEndian  0
+	#define binario_bigEndian  0
+#endif
+#define binario_ieeeBlocks  ((binario_littleEndian || binario_bigEndian) && \
+	sizeof (float) == 4 && FLT_MANT_DIG == 24 && sizeof (double) == 8 && DBL_MANT_DIG == 53 && Melder_debug != 18)
+
+#define binario_BLOCK_SIZE  4096
+
+static inline uint32 binario_swap4 (uint32 x) {
+	#if defined (__GNUC__)
+		return __builtin_bswap32 (x);
+	#else
+		return (x >> 24) | ((x >> 8) & 0x0000FF00) | ((x << 8) & 0x00FF0000) | (x << 24);
+	#endif
+}
+
+static inline uint64_t binario_swap8 (uint64_t x) {
+	#if defined (__GNUC__)
+		return __builtin_bswap64 (x);
+	#else
+		return (uint64_t) binario_swap4 ((uint32) x) << 32 | binario_swap4 ((uint32) (x >> 32));
+	#endif
+}
+
+void bingetr4s (double *x, long n, FILE *f) {
+	try {
+		if (! binario_ieeeBlocks) {
+			for (long i = 0; i < n; i ++) x [i] = bingetr4 (f);
+			return;
+		}
+		uint32 block [binario_BLOCK_SIZE];
+		for (long offset = 0; offset < n; offset += binario_BLOCK_SIZE) {
+			long blockSize = n - offset < binario_BLOCK_SIZE ? n - offset : binario_BLOCK_SIZE;
+			if ((long) fread (block, 4, blockSize, f) != blockSize) readError (f, U"a block of 32-bit floating-point numbers.");
+			if (binario_littleEndian)
+				for (long i = 0; i < blockSize; i ++) block [i] = binario_swap4 (block [i]);
+			for (long i = 0; i < blockSize; i ++) {
+				uint32 bits = block [i];
+				if ((bits & 0x7F800000) == 0x7F800000) bits &= 0xFF800000;   // NaN becomes infinity, as in bingetr4
+				float value;
+				memcpy (& value, & bits, 4);
+				x [offset + i] = value;
+			}
+		}
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not read from 4 bytes each in binary file.");
+	}
+}
+
+void bingetr8s (double *x, long n, FILE *f) {
+	try {
+		if (! binario_ieeeBlocks) {
+			for (long i = 0; i < n; i ++) x [i] = bingetr8 (f);
+			return;
+		}
+		if ((long) fread (x, 8, n, f) != n) readError (f, U"a block of 64-bit floating-point numbers.");
+		for (long i = 0; i < n; i ++) {
+			uint64_t bits;
+			memcpy (& bits, & x [i], 8);
+			if (binario_littleEndian) bits = binario_swap8 (bits);
+			if ((bits & 0x7FF0000000000000ULL) == 0x7FF0000000000000ULL) bits &= 0xFFF0000000000000ULL;   // NaN becomes infinity, as in bingetr8
+			memcpy (& x [i], & bits, 8);
+		}
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not read from 8 bytes each in binary file.");
+	}
+}
+
+void binputr4s (const double *x, long n, FILE *f) {
+	try {
+		if (! binario_ieeeBlocks) {
+			for (long i = 0; i < n; i ++) binputr4 (x [i], f);
+			return;
+		}
+		uint32 block [binario_BLOCK_SIZE];
+		for (long offset = 0; offset < n; offset += binario_BLOCK_SIZE) {
+			long blockSize = n - offset < binario_BLOCK_SIZE ? n - offset : binario_BLOCK_SIZE;
+			for (long i = 0; i < blockSize; i ++) {
+				double value = x [offset + i];
+				float value4;
+				/*
+				 * binputr4 truncates towards zero, not to the nearest float;
+				 * it writes NaN as +infinity, and negative zero as zero.
+				 */
+				if (value == 0.0) {
+					value4 = 0.0;
+				} else if (value != value) {
+					value4 = HUGE_VAL;
+				} else if (fabs (value) >= ldexp (1.0, 128)) {   // binputr4's exponent > 128
+					value4 = value < 0.0 ? - HUGE_VAL : HUGE_VAL;
+				} else {
+					value4 = (float) value;
+					if (fabs ((double) value4) > fabs (value)) value4 = nextafterf (value4, 0.0f);
+				}
+				memcpy (& block [i], & value4, 4);
+				if (binario_littleEndian) block [i] = binario_swap4 (block [i]);
+			}
+			if ((long) fwrite (block, 4, blockSize, f) != blockSize) writeError (U"a block of 32-bit floating-point numbers.");
+		}
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not written to 4 bytes each in binary file.");
+	}
+}
+
+void binputr8s (const double *x, long n, FILE *f) {
+	try {
+		if (! binario_ieeeBlocks) {
+			for (long i = 0; i < n; i ++) binputr8 (x [i], f);
+			return;
+		}
+		uint64_t block [binario_BLOCK_SIZE];
+		for (long offset = 0; offset < n; offset += binario_BLOCK_SIZE) {
+			long blockSize = n - offset < binario_BLOCK_SIZE ? n - offset : binario_BLOCK_SIZE;
+			for (long i = 0; i < blockSize; i ++) {
+				double value = x [offset + i];
+				if (value == 0.0) value = 0.0;   // binputr8 writes negative zero as zero...
+				else if (value != value) value = HUGE_VAL;   // ...and NaN as +infinity
+				memcpy (& block [i], & value, 8);
+				if (binario_littleEndian) block [i] = binario_swap8 (block [i]);
+			}
+			if ((long) fwrite (block, 8, blockSize, f) != blockSize) writeError (U"a block of 64-bit floating-point numbers.");
+		}
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not written to 8 bytes each in binary file.");
+	}
+}
+
 void binputr10 (double x, FILE *f) {
 	try {
 		unsigned char bytes [10];
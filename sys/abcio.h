@@ -62,6 +62,12 @@ void texputu2 (MelderFile file, unsigned int u, const char32 *s1, const char32 *
 void texputu4 (MelderFile file, unsigned long u, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4, const char32 *s5, const char32 *s6);
 void texputr4 (MelderFile file, double x, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4, const char32 *s5, const char32 *s6);
 void texputr8 (MelderFile file, double x, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4, const char32 *s5, const char32 *s6);
+void texputr4s (MelderFile file, const double *x, long lo, long hi, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4);
+void texputr8s (MelderFile file, const double *x, long lo, long hi, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4);
+/*
+	Write x [lo..hi] as texputr4 () or texputr8 () would with the labels s1, s2, s3, s4, i, "]", but faster.
+	The labels are used before any number is formatted, so they can come from Melder_integer ().
+*/
 void texputc8 (MelderFile file, fcomplex z, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4, const char32 *s5, const char32 *s6);
 void texputc16 (MelderFile file, dcomplex z, const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4, const char32 *s5, const char32 *s6);
 void texpute1 (MelderFile file, int i, const char32 * (*getText) (int), const char32 *s1, const char32 *s2, const char32 *s3, const char32 *s4, const char32 *s5, const char32 *s6);
@@ -167,6 +173,15 @@ double bingetr8 (FILE *f);   void binputr8 (double x, FILE *f);
 	This is the native format of a 'double' on Silicon Graphics Iris and PowerMac.
 */
 
+void bingetr4s (double *x, long n, FILE *f);   void binputr4s (const double *x, long n, FILE *f);
+void bingetr8s (double *x, long n, FILE *f);   void binputr8s (const double *x, long n, FILE *f);
+/*
+	Read or write the n real numbers x [0..n-1] in the format of bingetr4 and binputr4 (or bingetr8 and binputr8),
+	with exactly the same results, including the treatment of NaN's, negative zero, and (for r4) loss of precision.
+	On machines with IEEE numbers these read and write blocks of numbers at a time,
+	and reverse the byte order in memory if the machine is little-endian.
+*/
+
 double bingetr10 (FILE *f);   void binputr10 (double x, FILE *f);
 /*
 	Read or write a real number from or to 10 bytes in the stream 'f',
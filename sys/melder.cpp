@@ -129,7 +129,7 @@ static struct {
 
 /********** PROGRESS **********/
 
-static int theProgressDepth = 0;
+static thread_local int theProgressDepth = 0;   // the threads of the pool switch progress off for themselves
 static bool theProgressCancelled = false;
 void Melder_progressOff (void) { theProgressDepth --; }
 void Melder_progressOn (void) { theProgressDepth ++; }
@@ -336,7 +336,7 @@ static void _Melder_progress (double progress, const char32 *message) {
 	#endif
 }
 
-static MelderString theProgressBuffer = { 0 };
+static thread_local MelderString theProgressBuffer = { 0 };
 
 void Melder_progress (double progress) {
 	_Melder_progress (progress, U"");
@@ -548,11 +548,11 @@ void Melder_search (void) {
 
 /********** WARNING **********/
 
-static int theWarningDepth = 0;
+static thread_local int theWarningDepth = 0;
 void Melder_warningOff (void) { theWarningDepth --; }
 void Melder_warningOn (void) { theWarningDepth ++; }
 
-static MelderString theWarningBuffer = { 0 };
+static thread_local MelderString theWarningBuffer = { 0 };
 
 void Melder_warning (Melder_1_ARG) {
 	if (theWarningDepth < 0) return;
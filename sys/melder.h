@@ -388,6 +388,8 @@ void Melder_fwrite32to8 (const char32 *ptr, int64 n, FILE *f);
 
 struct FLAC__StreamDecoder;
 struct FLAC__StreamEncoder;
+struct FLAC__StreamMetadata;
+struct _MP3_FILE;
 
 #define kMelder_MAXPATH 1023   /* excluding the null byte */
 
@@ -399,6 +401,7 @@ struct structMelderFile {
 	unsigned long outputEncoding;
 	int indent;
 	struct FLAC__StreamEncoder *flacEncoder;
+	struct FLAC__StreamMetadata *flacSeekTable;   // written by flacEncoder, so it has to live as long
 };
 typedef struct structMelderFile *MelderFile;
 
@@ -443,12 +446,33 @@ bool MelderFile_exists (MelderFile file);
 bool MelderFile_readable (MelderFile file);
 long MelderFile_length (MelderFile file);
 void MelderFile_delete (MelderFile file);
+bool MelderFile_replace (MelderFile file, MelderFile newFile);
+/*
+	Renames `newFile` to `file`, replacing `file` if it exists, in one step,
+	so that other processes see either the old or the new `file`, never a partly written one.
+	Returns false if that was impossible.
+*/
 
 /* The following two should be combined with each other and with Windows extension setting: */
 FILE * Melder_fopen (MelderFile file, const char *type);
 void Melder_fclose (MelderFile file, FILE *stream);
 void Melder_files_cleanUp (void);
 
+void * MelderFile_map (FILE *f, int64 offset, int64 size);
+/*
+	Maps `size` bytes of the open file `f`, starting at `offset`, into memory, copy-on-write:
+	the bytes are read from disk only when they are first touched, and changes to them never reach the file.
+	The memory stays valid after the file is closed; if a file with the same name is created later,
+	Melder_fopen () first removes the old file, so that the mapped bytes do not change (not on Windows,
+	where a mapped file cannot be overwritten).
+	Returns NULL if the bytes cannot be mapped (e.g. if the file is too short); the caller should then read them itself.
+*/
+bool Melder_unmap (void *data);
+/*
+	Releases the memory that MelderFile_map () returned.
+	Returns false, and does nothing, if `data` did not come from MelderFile_map ().
+*/
+
 /* Use the following functions to pass unchanged text or file names to Melder_* functions. */
 /* Backslashes are replaced by "\bs". */
 /* The trick is that they return one of 11 cyclically used static strings, */
@@ -753,14 +777,22 @@ int64 MelderString_deallocationSize (void);
 
 struct structMelderReadText {
 	char32 *string32, *readPointer32;
-	char *string8, *readPointer8;
+	char *string8, *readPointer8;   // files are read as 8-bit text: UTF-8 (also if the file is UTF-16), or another 8-bit encoding
 	unsigned long input8Encoding;
 };
 typedef struct structMelderReadText *MelderReadText;
 
 MelderReadText MelderReadText_createFromFile (MelderFile file);
 MelderReadText MelderReadText_createFromString (const char32 *string);
-char32 MelderReadText_getChar (MelderReadText text);
+char32 _MelderReadText_getChar (MelderReadText text);
+inline static char32 MelderReadText_getChar (MelderReadText me) {
+	/*
+		ASCII (except the final null byte) is the same in every 8-bit encoding, and needs no decoding.
+	*/
+	if (me -> readPointer8 != NULL && (unsigned char) * me -> readPointer8 - 1u < 0x7Fu)
+		return (char32) * me -> readPointer8 ++;
+	return _MelderReadText_getChar (me);
+}
 char32 * MelderReadText_readLine (MelderReadText text);
 wchar_t * MelderReadText_readLineW (MelderReadText text);
 int64 MelderReadText_getNumberOfLines (MelderReadText me);
@@ -1309,10 +1341,19 @@ int MelderFile_checkSoundFile (MelderFile file, int *numberOfChannels, int *enco
  * The return value is the audio file type, or 0 if it is not a sound file or in case of error.
  * The data start at 'startOfData' bytes from the start of the file.
  */
+void MelderFile_analyzeMp3 (MelderFile file, struct _MP3_FILE *mp3f, bool saveIndex);
+/* Gives 'mp3f', which reads from the just opened 'file', the offset of every MP3 frame,
+ * from the seek index in the preferences directory if that index is still valid for 'file',
+ * else by scanning the whole file (and, if 'saveIndex' is on, saving the new index for next time).
+ */
 int Melder_bytesPerSamplePoint (int encoding);
 void Melder_readAudioToFloat (FILE *f, int numberOfChannels, int encoding, double **buffer, long numberOfSamples);
 /* Reads channels into buffer [ichannel], which are base-1.
  */
+void Melder_decodeAudioToFloat (const unsigned char *bytes, int numberOfChannels, int encoding, double **buffer, long numberOfSamples);
+/* Like Melder_readAudioToFloat, but from interleaved sample data in memory (e.g. a mapped file),
+ * for the uncompressed encodings only.
+ */
 void Melder_readAudioToShort (FILE *f, int numberOfChannels, int encoding, short *buffer, long numberOfSamples);
 /* If stereo, buffer will contain alternating left and right values.
  * Buffer is base-0.
@@ -33,9 +33,13 @@
 #include "melder.h"
 #include <wctype.h>
 #include <assert.h>
+#include <atomic>
 
-static int64 totalNumberOfAllocations = 0, totalNumberOfDeallocations = 0, totalAllocationSize = 0,
-	totalNumberOfMovingReallocs = 0, totalNumberOfReallocsInSitu = 0;
+/*
+ * The statistics are atomic, because analyses allocate from several threads at the same time.
+ */
+static std::atomic <int64> totalNumberOfAllocations (0), totalNumberOfDeallocations (0), totalAllocationSize (0),
+	totalNumberOfMovingReallocs (0), totalNumberOfReallocsInSitu (0);
 
 /*
  * The rainy-day fund.
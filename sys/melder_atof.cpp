@@ -27,6 +27,7 @@
 
 #include "melder.h"
 #include "NUM.h"
+#include <float.h>
 
 static const char32 *findEndOfNumericString_nothrow (const char32 *string) {
 	const char32 *p = & string [0];
@@ -162,11 +163,66 @@ bool Melder_isStringNumeric_nothrow (const char32 *string) {
 	return *p == '\0';
 }
 
+/*
+	Most numbers in text files have a short mantissa and a small exponent, e.g. "0.0125" or "-372.5",
+	and can then be computed exactly from their digits with a single multiplication or division,
+	as strtod () would do after a much longer deliberation (Clinger's fast path).
+	Returns false for the numbers that need strtod () (mantissas above 2^53, large exponents),
+	and on machines that compute with more precision than that of a double.
+*/
+static bool fastStrtod (const char *string, const char *end, double *value) {
+	#if ! defined (FLT_EVAL_METHOD) || FLT_EVAL_METHOD != 0
+		(void) string; (void) end; (void) value;
+		return false;
+	#else
+		static const double powersOfTen [] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+			1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+		if (*end == 'x' || *end == 'X') return false;   // "0x...": strtod () would read on as hexadecimal
+		const char *p = string;
+		while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p ++;
+		bool negative = *p == '-';
+		if (*p == '+' || *p == '-') p ++;
+		uint64_t mantissa = 0;
+		int numberOfDigits = 0, exponent = 0;
+		for (; *p >= '0' && *p <= '9'; p ++) {
+			if (mantissa != 0 || *p != '0') numberOfDigits ++;
+			mantissa = 10 * mantissa + (uint64_t) (*p - '0');
+		}
+		if (*p == '.') {
+			for (p ++; *p >= '0' && *p <= '9'; p ++) {
+				if (mantissa != 0 || *p != '0') numberOfDigits ++;
+				mantissa = 10 * mantissa + (uint64_t) (*p - '0');
+				exponent --;
+			}
+		}
+		if (numberOfDigits > 19 || mantissa > (uint64_t) 1 << 53) return false;   // not exact in a double (or overflowed)
+		if (*p == 'e' || *p == 'E') {
+			p ++;
+			bool negativeExponent = *p == '-';
+			if (*p == '+' || *p == '-') p ++;
+			int explicitExponent = 0;
+			for (; *p >= '0' && *p <= '9'; p ++) {
+				if (explicitExponent > 1000) return false;
+				explicitExponent = 10 * explicitExponent + (*p - '0');
+			}
+			exponent += negativeExponent ? - explicitExponent : explicitExponent;
+		}
+		if (p != end) return false;   // e.g. a percent sign
+		if (exponent < -22 || exponent > 22) return false;
+		double result = (double) mantissa;   // exact
+		result = exponent < 0 ? result / powersOfTen [- exponent] : result * powersOfTen [exponent];   // a single rounding
+		*value = negative ? - result : result;
+		return true;
+	#endif
+}
+
 double Melder_a8tof (const char *string) {
 	if (string == NULL) return NUMundefined;
 	const char *p = findEndOfNumericString_nothrow (string);
 	if (p == NULL) return NUMundefined;
 	Melder_assert (p - string > 0);
+	double value;
+	if (fastStrtod (string, p, & value)) return value;
 	return p [-1] == '%' ? 0.01 * strtod (string, NULL) : strtod (string, NULL);
 }
 
@@ -36,9 +36,17 @@
  * pb 2011/05/03 fix WAV files with negative data chunk sizes
  */
 
+#include <sys/stat.h>
+#if defined (_WIN32)
+	#include <process.h>   // _getpid
+#else
+	#include <unistd.h>   // getpid
+#endif
 #include "melder.h"
 #include "abcio.h"
+#include "NUM.h"
 #include "math.h"
+#include "MelderThread.h"
 #include "flac_FLAC_metadata.h"
 #include "flac_FLAC_stream_decoder.h"
 #include "flac_FLAC_stream_encoder.h"
@@ -223,11 +231,28 @@ void MelderFile_writeAudioFileHeader (MelderFile file, int audioFileType, long s
 					FLAC__stream_encoder_set_channels (encoder, numberOfChannels);
 					FLAC__stream_encoder_set_sample_rate (encoder, sampleRate);
 					FLAC__stream_encoder_set_total_samples_estimate (encoder, numberOfSamples);
+					/*
+						A seek point every 10 seconds (as with "flac -S 10s"), filled in by the encoder when it finishes,
+						lets readers of the file (such as a LongSound) jump directly to any part.
+					*/
+					FLAC__StreamMetadata *seekTable = NULL;
+					if (numberOfSamples > 0 && (seekTable = FLAC__metadata_object_new (FLAC__METADATA_TYPE_SEEKTABLE)) != NULL) {
+						if (FLAC__metadata_object_seektable_template_append_spaced_points_by_samples (seekTable, 10 * sampleRate, numberOfSamples) &&
+							FLAC__metadata_object_seektable_template_sort (seekTable, true))
+						{
+							FLAC__stream_encoder_set_metadata (encoder, & seekTable, 1);
+						} else {
+							FLAC__metadata_object_delete (seekTable);
+							seekTable = NULL;
+						}
+					}
 					if (FLAC__stream_encoder_init_FILE (encoder, file -> filePointer, NULL, NULL) != FLAC__STREAM_ENCODER_INIT_STATUS_OK) {
 						FLAC__stream_encoder_delete (encoder);
+						if (seekTable) FLAC__metadata_object_delete (seekTable);
 						Melder_throw (U"Error creating FLAC stream encoder");
 					}
 					file -> flacEncoder = encoder;   // only after we know it's correct (for MelderFile_close)
+					file -> flacSeekTable = seekTable;
 					file -> outputEncoding = kMelder_textOutputEncoding_FLAC;   // only after we know it's correct (for MelderFile_close)
 				} catch (MelderError) {
 					Melder_throw (U"FLAC header not written.");
@@ -700,14 +725,156 @@ static void Melder_checkFlacFile (MelderFile file, int *numberOfChannels, int *e
 		Melder_throw (U"FLAC file too long.");
 }
 
-static void Melder_checkMp3File (FILE *f, int *numberOfChannels, int *encoding,
+/*
+	The seek index of an MP3 file, i.e. the offset of every frame, costs a scan of the whole file,
+	and a LongSound is typically opened again and again, each time by both MelderFile_checkSoundFile and LongSound_open.
+	We therefore keep the index of every MP3 file that is opened as a LongSound
+	in a file in the directory "mp3index" in the preferences directory,
+	rather than next to the sound file, which may well be on a read-only disk.
+	Other readers use an index that exists, but do not create one, so that a batch of sound files leaves no trace.
+	The name of the index file is derived from a hash of the path of the sound file, with only 256 possible names,
+	so that the directory never holds more than 256 indexes;
+	the index file starts with that path and with the size and modification time of the sound file,
+	so that a changed sound file, or another sound file with the same hash, is scanned again.
+	An index is written into a temporary file that is then renamed, so that a reader never sees half an index.
+*/
+#define MP3_INDEX_MAGIC  U"Praat MP3 seek index 1"
+
+static void MelderFile_getMp3IndexFile (MelderFile file, MelderFile indexFile, bool createDirectory) {
+	extern structMelderDir praatDir;
+	if (MelderDir_isNull (& praatDir))
+		Melder_throw (U"No preferences directory.");
+	if (createDirectory) {
+		#if defined (UNIX) || defined (macintosh)
+			Melder_createDirectory (& praatDir, U"mp3index", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+		#else
+			Melder_createDirectory (& praatDir, U"mp3index", 0);
+		#endif
+	}
+	structMelderDir indexDir = { };
+	MelderDir_getSubdir (& praatDir, U"mp3index", & indexDir);
+	uint64_t hash = 14695981039346656037ULL;   // FNV-1a
+	for (const char32 *p = file -> path; *p != U'\0'; p ++) {
+		hash ^= (uint64_t) *p;
+		hash *= 1099511628211ULL;
+	}
+	char name [40];
+	snprintf (name, 40, "%02x.index", (unsigned int) (hash & 0xFF));
+	MelderDir_getFile (& indexDir, Melder_peek8to32 (name), indexFile);
+}
+
+static bool Melder_getFileStatus (FILE *f, double *size, double *modificationTime) {
+	#if defined (_WIN32)
+		struct _stat64 fileStatus;
+		if (_fstat64 (_fileno (f), & fileStatus) != 0) return false;
+	#else
+		struct stat fileStatus;
+		if (fstat (fileno (f), & fileStatus) != 0) return false;
+	#endif
+	*size = (double) fileStatus. st_size;
+	*modificationTime = (double) fileStatus. st_mtime;
+	return true;
+}
+
+static bool MelderFile_readMp3Index (MelderFile file, MP3_FILE mp3f, double size, double modificationTime) {
+	try {
+		structMelderFile indexFile = { };
+		MelderFile_getMp3IndexFile (file, & indexFile, false);
+		if (! MelderFile_exists (& indexFile))
+			return false;
+		autofile f = Melder_fopen (& indexFile, "rb");
+		autostring32 magic = bingetw2 (f);
+		if (! str32equ (magic.peek(), MP3_INDEX_MAGIC)) return false;
+		autostring32 path = bingetw2 (f);
+		if (! str32equ (path.peek(), file -> path)) return false;   // a hash collision
+		if (bingetr8 (f) != size || bingetr8 (f) != modificationTime) return false;   // changed since
+		unsigned channels = bingetu4 (f), frequency = bingetu4 (f), samplesPerFrame = bingetu4 (f), numberOfFrames = bingetu4 (f);
+		if (numberOfFrames == 0 || numberOfFrames > size) return false;
+		autoNUMvector <MP3F_OFFSET> offsets ((long) 0, (long) numberOfFrames - 1);
+		for (unsigned iframe = 0; iframe < numberOfFrames; iframe ++) {
+			double offset = bingetr8 (f);
+			if (offset < 0.0 || offset >= size) return false;
+			offsets [iframe] = (MP3F_OFFSET) offset;
+		}
+		f.close (& indexFile);
+		/*
+			A file that was rewritten within the same second with the same size would still pass.
+			So check that the first and last offsets point to frame headers.
+		*/
+		FILE *soundFile = file -> filePointer;
+		for (int iend = 0; iend < 2; iend ++) {
+			unsigned char header [2];
+			if (fseek (soundFile, offsets [iend == 0 ? 0 : numberOfFrames - 1], SEEK_SET) != 0 ||
+				fread (header, 1, 2, soundFile) != 2 || header [0] != 0xFF || (header [1] & 0xE0) != 0xE0)
+			{
+				rewind (soundFile);
+				return false;
+			}
+		}
+		rewind (soundFile);
+		return mp3f_set_frame_offsets (mp3f, channels, frequency, samplesPerFrame, numberOfFrames, & offsets [0]) != 0;
+	} catch (MelderError) {
+		Melder_clearError ();   // an unreadable index is rebuilt
+		return false;
+	}
+}
+
+static void MelderFile_writeMp3Index (MelderFile file, MP3_FILE mp3f, double size, double modificationTime) {
+	structMelderFile indexFile = { }, temporaryFile = { };
+	try {
+		MelderFile_getMp3IndexFile (file, & indexFile, true);
+		char suffix [60];   // unique for every thread of every process
+		#if defined (_WIN32)
+			unsigned long processID = (unsigned long) _getpid ();
+		#else
+			unsigned long processID = (unsigned long) getpid ();
+		#endif
+		snprintf (suffix, 60, ".%lu.%llx.tmp", processID, (unsigned long long) (uintptr_t) & temporaryFile);
+		str32cpy (temporaryFile. path, Melder_cat (indexFile. path, Melder_peek8to32 (suffix)));
+		autofile f = Melder_fopen (& temporaryFile, "wb");
+		binputw2 (MP3_INDEX_MAGIC, f);
+		binputw2 (file -> path, f);
+		binputr8 (size, f);
+		binputr8 (modificationTime, f);
+		binputu4 (mp3f_channels (mp3f), f);
+		binputu4 (mp3f_frequency (mp3f), f);
+		binputu4 (mp3f_samples_per_frame (mp3f), f);
+		unsigned numberOfFrames = mp3f_frames (mp3f);
+		binputu4 (numberOfFrames, f);
+		const MP3F_OFFSET *offsets = mp3f_frame_offsets (mp3f);
+		for (unsigned iframe = 0; iframe < numberOfFrames; iframe ++)
+			binputr8 ((double) offsets [iframe], f);
+		f.close (& temporaryFile);
+		if (! MelderFile_replace (& indexFile, & temporaryFile))
+			MelderFile_delete (& temporaryFile);
+	} catch (MelderError) {
+		Melder_clearError ();   // no index, no problem: the next open just scans the file again
+		if (! MelderFile_isNull (& temporaryFile))
+			MelderFile_delete (& temporaryFile);
+	}
+}
+
+void MelderFile_analyzeMp3 (MelderFile file, MP3_FILE mp3f, bool saveIndex) {
+	double size, modificationTime;
+	bool haveStatus = Melder_getFileStatus (file -> filePointer, & size, & modificationTime);
+	if (haveStatus && MelderFile_readMp3Index (file, mp3f, size, modificationTime))
+		return;
+	if (! mp3f_analyze (mp3f))
+		Melder_throw (U"Cannot analyze MP3 file");
+	if (saveIndex && haveStatus)
+		MelderFile_writeMp3Index (file, mp3f, size, modificationTime);
+}
+
+static void Melder_checkMp3File (MelderFile file, int *numberOfChannels, int *encoding,
 	double *sampleRate, long *startOfData, int32 *numberOfSamples)
 {
 	MP3_FILE mp3f = mp3f_new ();
-	mp3f_set_file (mp3f, f);
-	if (! mp3f_analyze (mp3f)) {
+	mp3f_set_file (mp3f, file -> filePointer);
+	try {
+		MelderFile_analyzeMp3 (file, mp3f, false);
+	} catch (MelderError) {
 		mp3f_delete (mp3f);
-		Melder_throw (U"Cannot analyze MP3 file");
+		throw;
 	}
 	*encoding = Melder_MPEG_COMPRESSION_16;
 	*numberOfChannels = mp3f_channels (mp3f);
@@ -751,7 +918,7 @@ int MelderFile_checkSoundFile (MelderFile file, int *numberOfChannels, int *enco
 		return Melder_FLAC;
 	}
 	if (mp3_recognize (16, data)) {
-		Melder_checkMp3File (f, numberOfChannels, encoding, sampleRate, startOfData, numberOfSamples);
+		Melder_checkMp3File (file, numberOfChannels, encoding, sampleRate, startOfData, numberOfSamples);
 		return Melder_MP3;
 	}
 	return 0;   // not a recognized sound file
@@ -880,352 +1047,226 @@ static void Melder_readMp3File (FILE *f, int numberOfChannels, double **buffer,
 		Melder_throw (U"Error decoding MP3 file.");
 }
 
+/*
+	Uncompressed samples are read a chunk at a time. While the threads of the pool decode one chunk,
+	each thread a stretch of its frames for all channels, a background thread reads the next chunks from the file,
+	so that a large file is read nearly as fast as the disk can deliver it.
+*/
+#define Melder_AUDIO_CHUNK_SIZE  4194304   /* bytes */
+#define Melder_AUDIO_NUMBER_OF_CHUNKS  3   /* in memory at the same time */
+#define Melder_AUDIO_FRAMES_PER_DECODING_STEP  4096
+
+struct MelderAudioChunks {
+	FILE *f;
+	int numberOfChannels, encoding;
+	long frameSize;   // bytes
+	long numberOfSamples, samplesPerChunk, numberOfChunks;
+	autoNUMvector <unsigned char> chunks [Melder_AUDIO_NUMBER_OF_CHUNKS];
+	long numberOfSamplesInChunk [Melder_AUDIO_NUMBER_OF_CHUNKS];   // complete frames read
+	long numberOfTrailingBytes [Melder_AUDIO_NUMBER_OF_CHUNKS];   // bytes read of the frame after these, if the file ended there
+	/*
+		Shared with the reading thread, under the monitor.
+	*/
+	MelderThread_Monitor *monitor;
+	long numberOfChunksRead, numberOfChunksDecoded;
+	bool readerDone, stopping;
+};
+
+static long MelderAudioChunks_expectedNumberOfSamples (MelderAudioChunks *me, long ichunk) {
+	long firstSample = ichunk * my samplesPerChunk;
+	return my numberOfSamples - firstSample < my samplesPerChunk ? my numberOfSamples - firstSample : my samplesPerChunk;
+}
+
+static void MelderAudioChunks_read (MelderAudioChunks *me, long ichunk) {
+	int islot = (int) (ichunk % Melder_AUDIO_NUMBER_OF_CHUNKS);
+	size_t numberOfBytes = (size_t) (MelderAudioChunks_expectedNumberOfSamples (me, ichunk) * my frameSize);
+	size_t numberOfBytesRead = fread (my chunks [islot]. peek (), 1, numberOfBytes, my f);
+	my numberOfSamplesInChunk [islot] = (long) (numberOfBytesRead / (size_t) my frameSize);
+	my numberOfTrailingBytes [islot] = (long) (numberOfBytesRead % (size_t) my frameSize);
+}
+
+static void MelderAudioChunks_threadMain (void *void_me) {
+	MelderAudioChunks *me = (MelderAudioChunks *) void_me;
+	MelderThread_Monitor_lock (my monitor);
+	for (long ichunk = 0; ichunk < my numberOfChunks; ichunk ++) {
+		while (! my stopping && ichunk - my numberOfChunksDecoded >= Melder_AUDIO_NUMBER_OF_CHUNKS)
+			MelderThread_Monitor_wait (my monitor);
+		if (my stopping) break;
+		MelderThread_Monitor_unlock (my monitor);
+		MelderAudioChunks_read (me, ichunk);
+		MelderThread_Monitor_lock (my monitor);
+		my numberOfChunksRead = ichunk + 1;
+		MelderThread_Monitor_signalAll (my monitor);
+		if (my numberOfSamplesInChunk [ichunk % Melder_AUDIO_NUMBER_OF_CHUNKS] < MelderAudioChunks_expectedNumberOfSamples (me, ichunk))
+			break;   // end of file
+	}
+	my readerDone = true;
+	MelderThread_Monitor_signalAll (my monitor);
+	MelderThread_Monitor_unlock (my monitor);
+}
+
+Thing_define (MelderAudioChunks_Args, Thing) { public:
+	MelderAudioChunks *chunks;
+	const unsigned char *bytes;   // the chunk that is being decoded
+	double **buffer;
+	long offset;   // the sample number in `buffer` just before the chunk
+	autoNUMvector <double *> rows;
+};
+
+Thing_implement (MelderAudioChunks_Args, Thing, 0);
+
+static void MelderAudioChunks_decode (MelderAudioChunks_Args me, long firstSample, long lastSample) {
+	MelderAudioChunks *chunks = my chunks;
+	for (int ichan = 1; ichan <= chunks -> numberOfChannels; ichan ++)
+		my rows [ichan] = my buffer [ichan] + my offset + firstSample - 1;
+	Melder_decodeAudioToFloat (my bytes + (firstSample - 1) * chunks -> frameSize, chunks -> numberOfChannels, chunks -> encoding,
+		my rows.peek (), lastSample - firstSample + 1);
+}
+
+/*
+	A file that ends in the middle of a frame has the samples of that frame decoded as they were by the sample-by-sample reader:
+	linear samples of 16 bits or more as if the missing bytes were zero,
+	the other encodings only for the channels whose bytes are complete.
+*/
+static void MelderAudioChunks_decodeTrailingFrame (MelderAudioChunks *me, unsigned char *bytes, long numberOfBytes, double **buffer, long isamp) {
+	int numberOfBytesPerSamplePoint = Melder_bytesPerSamplePoint (my encoding);
+	int numberOfChannels = my numberOfChannels;
+	if (numberOfBytesPerSamplePoint >= 2 && my encoding != Melder_IEEE_FLOAT_32_BIG_ENDIAN && my encoding != Melder_IEEE_FLOAT_32_LITTLE_ENDIAN)
+		memset (bytes + numberOfBytes, 0, (size_t) (my frameSize - numberOfBytes));
+	else
+		numberOfChannels = numberOfBytes / numberOfBytesPerSamplePoint;   // the first channels of a frame are laid out as a frame with fewer channels
+	if (numberOfChannels < 1) return;
+	autoNUMvector <double *> rows (1, numberOfChannels);
+	for (int ichan = 1; ichan <= numberOfChannels; ichan ++)
+		rows [ichan] = buffer [ichan] + isamp - 1;
+	Melder_decodeAudioToFloat (bytes, numberOfChannels, my encoding, rows.peek (), 1);
+}
+
+/*
+	Returns the number of complete samples per channel that could be read; any samples after these are set to zero,
+	except those in a last incomplete frame (see MelderAudioChunks_decodeTrailingFrame).
+*/
+static long Melder_readUncompressedAudio (FILE *f, int numberOfChannels, int encoding, double **buffer, long numberOfSamples) {
+	if (numberOfSamples <= 0) return numberOfSamples;
+	MelderAudioChunks chunks, *me = & chunks;
+	my f = f;
+	my numberOfChannels = numberOfChannels;
+	my encoding = encoding;
+	my frameSize = (long) numberOfChannels * Melder_bytesPerSamplePoint (encoding);
+	my numberOfSamples = numberOfSamples;
+	my samplesPerChunk = Melder_AUDIO_CHUNK_SIZE / my frameSize;
+	if (my samplesPerChunk < 1) my samplesPerChunk = 1;
+	if (my samplesPerChunk > numberOfSamples) my samplesPerChunk = numberOfSamples;
+	my numberOfChunks = (numberOfSamples - 1) / my samplesPerChunk + 1;
+	int numberOfSlots = my numberOfChunks < Melder_AUDIO_NUMBER_OF_CHUNKS ? (int) my numberOfChunks : Melder_AUDIO_NUMBER_OF_CHUNKS;
+	for (int islot = 0; islot < numberOfSlots; islot ++)
+		my chunks [islot]. reset (0, my samplesPerChunk * my frameSize - 1);
+	my numberOfChunksRead = my numberOfChunksDecoded = 0;
+	my readerDone = my stopping = false;
+	my monitor = NULL;
+	MelderThread_Background *reader = NULL;
+	if (my numberOfChunks > 1) {
+		my monitor = MelderThread_Monitor_create ();
+		reader = MelderThread_Background_start (MelderAudioChunks_threadMain, me);
+		if (! reader) {
+			MelderThread_Monitor_delete (my monitor);
+			my monitor = NULL;   // read the chunks on this thread
+		}
+	}
+	const int numberOfThreads = MelderThread_computeNumberOfThreads (my samplesPerChunk, 2 * Melder_AUDIO_FRAMES_PER_DECODING_STEP);
+	autoMelderAudioChunks_Args args [MelderThread_MAXIMUM_NUMBER_OF_THREADS];
+	long numberOfSamplesRead = 0;
+	unsigned char *trailingFrame = NULL;
+	long numberOfTrailingBytes = 0;
+	try {
+		for (int ithread = 0; ithread < numberOfThreads; ithread ++) {
+			args [ithread]. reset (Thing_new (MelderAudioChunks_Args));
+			args [ithread] -> chunks = me;
+			args [ithread] -> buffer = buffer;
+			args [ithread] -> rows. reset (1, numberOfChannels);
+		}
+		for (long ichunk = 0; ichunk < my numberOfChunks; ichunk ++) {
+			int islot = (int) (ichunk % Melder_AUDIO_NUMBER_OF_CHUNKS);
+			bool available = true;
+			if (reader) {
+				MelderThread_Monitor_lock (my monitor);
+				while (my numberOfChunksRead <= ichunk && ! my readerDone)
+					MelderThread_Monitor_wait (my monitor);
+				available = my numberOfChunksRead > ichunk;
+				MelderThread_Monitor_unlock (my monitor);
+			} else {
+				MelderAudioChunks_read (me, ichunk);
+			}
+			long numberOfSamplesInChunk = available ? my numberOfSamplesInChunk [islot] : 0;
+			for (int ithread = 0; ithread < numberOfThreads; ithread ++) {
+				args [ithread] -> bytes = my chunks [islot]. peek ();
+				args [ithread] -> offset = numberOfSamplesRead;
+			}
+			if (numberOfSamplesInChunk > 0)
+				MelderThread_run (MelderAudioChunks_decode, args, numberOfThreads, 1, numberOfSamplesInChunk, Melder_AUDIO_FRAMES_PER_DECODING_STEP);
+			numberOfSamplesRead += numberOfSamplesInChunk;
+			if (reader) {
+				MelderThread_Monitor_lock (my monitor);
+				my numberOfChunksDecoded = ichunk + 1;
+				MelderThread_Monitor_signalAll (my monitor);
+				MelderThread_Monitor_unlock (my monitor);
+			}
+			if (numberOfSamplesInChunk < MelderAudioChunks_expectedNumberOfSamples (me, ichunk)) {
+				if (available && my numberOfTrailingBytes [islot] > 0) {
+					trailingFrame = & my chunks [islot] [numberOfSamplesInChunk * my frameSize];
+					numberOfTrailingBytes = my numberOfTrailingBytes [islot];
+				}
+				break;
+			}
+		}
+	} catch (MelderError) {
+		if (reader) {
+			MelderThread_Monitor_lock (my monitor);
+			my stopping = true;
+			MelderThread_Monitor_signalAll (my monitor);
+			MelderThread_Monitor_unlock (my monitor);
+			MelderThread_Background_join (reader);
+			MelderThread_Monitor_delete (my monitor);
+		}
+		throw;
+	}
+	if (reader) {
+		MelderThread_Background_join (reader);
+		MelderThread_Monitor_delete (my monitor);
+	}
+	for (int ichan = 1; ichan <= numberOfChannels; ichan ++)
+		for (long isamp = numberOfSamplesRead + 1; isamp <= numberOfSamples; isamp ++)
+			buffer [ichan] [isamp] = 0.0;
+	if (trailingFrame)
+		MelderAudioChunks_decodeTrailingFrame (me, trailingFrame, numberOfTrailingBytes, buffer, numberOfSamplesRead + 1);
+	return numberOfSamplesRead;
+}
+
 void Melder_readAudioToFloat (FILE *f, int numberOfChannels, int encoding, double **buffer, long numberOfSamples) {
 	try {
 		switch (encoding) {
-			case Melder_LINEAR_8_SIGNED: {
-				try {
-					for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							int8 value;
-							if (fread (& value, 1, 1, f) < 1) throw MelderError ();
-							buffer [ichan] [isamp] = value * (1.0 / 128);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 8-bit).\nMissing samples set to zero.");
-				}
-			} break;
+			case Melder_LINEAR_8_SIGNED:
 			case Melder_LINEAR_8_UNSIGNED:
-				try {
-					for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = bingetu1 (f) * (1.0 / 128) - 1.0;
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 8-bit).\nMissing samples set to zero.");
-				}
-				break;
 			case Melder_LINEAR_16_BIG_ENDIAN:
 			case Melder_LINEAR_16_LITTLE_ENDIAN:
 			case Melder_LINEAR_24_BIG_ENDIAN:
 			case Melder_LINEAR_24_LITTLE_ENDIAN:
 			case Melder_LINEAR_32_BIG_ENDIAN:
 			case Melder_LINEAR_32_LITTLE_ENDIAN:
-			{
-				int numberOfBytesPerSamplePerChannel =
-					encoding == Melder_LINEAR_16_BIG_ENDIAN || encoding == Melder_LINEAR_16_LITTLE_ENDIAN ? 2 :
-					encoding == Melder_LINEAR_24_BIG_ENDIAN || encoding == Melder_LINEAR_24_LITTLE_ENDIAN ? 3 : 4;
-				double numberOfBytes_f = (double) numberOfChannels * (double) numberOfSamples * (double) numberOfBytesPerSamplePerChannel;
-				if (isinf (numberOfBytes_f) || numberOfBytes_f > (double) (1LL << 53)) {
-					Melder_throw (U"Cannot read ", numberOfBytes_f, U" bytes, "
-						U"because that crosses the 9-petabyte limit.");
-				}
-				if (numberOfBytes_f > (double) SIZE_MAX) {
-					Melder_throw (U"Cannot read ", numberOfBytes_f, U" bytes. "
-						U"Perhaps try a 64-bit edition of Praat?");
-				}
-				Melder_assert (numberOfBytes_f >= 0.0);
-				size_t numberOfBytes = (size_t) numberOfBytes_f;   // cast is safe because overflow and signedness have been checked
-				uint8 *bytes = (uint8 *) & buffer [numberOfChannels] [numberOfSamples] + sizeof (double) - numberOfBytes;
-				/*
-				 * Read 16-bit data into the last quarter of the buffer,
-				 * or 24-bit data into the last three-eighths of the buffer,
-				 * or 32-bit data into the last half of the buffer.
-				 */
-				size_t numberOfBytesRead = fread (bytes, 1, numberOfBytes, f);
-				if (numberOfChannels == 1) {
-					switch (encoding) {
-						case Melder_LINEAR_16_BIG_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++;
-								int value = (int) (int16_t) (((uint16_t) byte1 << 8) | (uint16_t) byte2);   // extend sign
-								buffer [1] [isamp] = value * (1.0 / 32768);
-							}
-						} break;
-						case Melder_LINEAR_16_LITTLE_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++;
-								int value = (int) (int16_t) (((uint16_t) byte2 << 8) | (uint16_t) byte1);   // extend sign
-								buffer [1] [isamp] = value * (1.0 / 32768);
-							}
-						} break;
-						case Melder_LINEAR_24_BIG_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-								int32 value = (int32)
-									((uint32) ((uint32) byte1 << 24) |
-									 (uint32) ((uint32) byte2 << 16) |
-											  ((uint32) byte3 << 8));
-								buffer [1] [isamp] = value * (1.0 / 32768 / 65536);
-							}
-						} break;
-						case Melder_LINEAR_24_LITTLE_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-								int32 value = (int32)
-									((uint32) ((uint32) byte3 << 24) |
-									 (uint32) ((uint32) byte2 << 16) |
-											  ((uint32) byte1 << 8));
-								buffer [1] [isamp] = value * (1.0 / 32768 / 65536);
-							}
-						} break;
-						case Melder_LINEAR_32_BIG_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-								int32 value = (int32)
-									((uint32) ((uint32) byte1 << 24) |
-									 (uint32) ((uint32) byte2 << 16) |
-									 (uint32) ((uint32) byte3 << 8) |
-											   (uint32) byte4);
-								buffer [1] [isamp] = value * (1.0 / 32768 / 65536);
-							}
-						} break;
-						case Melder_LINEAR_32_LITTLE_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-								int32 value = (int32)
-									((uint32) ((uint32) byte4 << 24) |
-									 (uint32) ((uint32) byte3 << 16) |
-									 (uint32) ((uint32) byte2 << 8) |
-											   (uint32) byte1);
-								buffer [1] [isamp] = value * (1.0 / 32768 / 65536);
-							}
-						} break;
-					}
-				} else if (numberOfChannels <= (int) sizeof (double) / numberOfBytesPerSamplePerChannel) {
-					switch (encoding) {
-						case Melder_LINEAR_16_BIG_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++;
-									int value = (int) (int16) (uint16) ((uint16) ((uint16) byte1 << 8) | (uint16) byte2);
-									buffer [ichan] [isamp] = value * (1.0 / 32768);
-								}
-							}
-						} break;
-						case Melder_LINEAR_16_LITTLE_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++;
-									int value = (int) (int16) (uint16) ((uint16) ((uint16) byte2 << 8) | (uint16) byte1);
-									buffer [ichan] [isamp] = value * (1.0 / 32768);
-								}
-							}
-						} break;
-						case Melder_LINEAR_24_BIG_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-									uint32 unsignedValue =
-										(uint32) ((uint32) byte1 << 16) |
-										(uint32) ((uint32) byte2 << 8) |
-												  (uint32) byte3;
-									if ((byte1 & 128) != 0) unsignedValue |= 0xFF000000;   // extend sign
-									buffer [ichan] [isamp] = (int32_t) unsignedValue * (1.0 / 8388608);
-								}
-							}
-						} break;
-						case Melder_LINEAR_24_LITTLE_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-									uint32 unsignedValue = ((uint32) byte3 << 16) | ((uint32) byte2 << 8) | (uint32) byte1;
-									if ((byte3 & 128) != 0) unsignedValue |= 0xFF000000;
-									buffer [ichan] [isamp] = (int32) unsignedValue * (1.0 / 8388608);
-								}
-							}
-						} break;
-						case Melder_LINEAR_32_BIG_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-									int32 value = (int32)
-										((uint32) ((uint32) byte1 << 24) |
-										 (uint32) ((uint32) byte2 << 16) |
-										 (uint32) ((uint32) byte3 << 8) |
-												   (uint32) byte4);
-									buffer [ichan] [isamp] = value * (1.0 / 32768 / 65536);
-								}
-							}
-						} break;
-						case Melder_LINEAR_32_LITTLE_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-									int32 value = (int32)
-										((uint32) ((uint32) byte4 << 24) |
-										 (uint32) ((uint32) byte3 << 16) |
-										 (uint32) ((uint32) byte2 << 8) |
-												   (uint32) byte1);
-									buffer [ichan] [isamp] = value * (1.0 / 32768 / 65536);
-								}
-							}
-						} break;
-					}
-				} else {
-					Melder_assert (sizeof (double) == 8);
-					int32_t *ints = (int32_t *) & buffer [1] [1];
-					switch (encoding) {
-						case Melder_LINEAR_16_BIG_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++;
-									int32 value = (int32)
-										((uint32) ((uint32) byte1 << 24) |
-										 (uint32) ((uint32) byte2 << 16));
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						} break;
-						case Melder_LINEAR_16_LITTLE_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++;
-									int32 value = (int32)
-										(((uint32) byte2 << 24) |
-										 ((uint32) byte1 << 16));
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						} break;
-						case Melder_LINEAR_24_BIG_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-									int32 value = (int32)
-										(((uint32) byte1 << 24) |
-										 ((uint32) byte2 << 16) |
-										 ((uint32) byte3 << 8));
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						} break;
-						case Melder_LINEAR_24_LITTLE_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-									int32 value = (int32)
-										(((uint32) byte3 << 24) |
-										 ((uint32) byte2 << 16) |
-										 ((uint32) byte1 << 8));
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						} break;
-						case Melder_LINEAR_32_BIG_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-									int32 value = (int32)
-										(((uint32) byte1 << 24) |
-										 ((uint32) byte2 << 16) |
-										 ((uint32) byte3 << 8) |
-										  (uint32) byte4);
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						} break;
-						case Melder_LINEAR_32_LITTLE_ENDIAN: {
-							for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-									int32 value = (int32)
-										(((uint32) byte4 << 24) |
-										 ((uint32) byte3 << 16) |
-										 ((uint32) byte2 << 8) |
-										  (uint32) byte1);
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						}
-					}
-					double *doubles = & buffer [1] [1];
-					long n = numberOfSamples * numberOfChannels;
-					for (long i = 0; i < n; i ++) {
-						int32_t *valuePosition = (int32_t *) & doubles [i];
-						int32_t *markerPosition = valuePosition + 1;
-						if (! *markerPosition) {
-							int32_t value = *valuePosition;
-							long ichan = i / numberOfSamples, isamp = i % numberOfSamples;
-							for (long other = isamp * numberOfChannels + ichan; other != i; ) {
-								int32_t *otherValuePosition = (int32_t *) & doubles [other];
-								*valuePosition = *otherValuePosition;
-								*markerPosition = 1;
-								valuePosition = otherValuePosition;
-								markerPosition = valuePosition + 1;
-								ichan = other / numberOfSamples, isamp = other % numberOfSamples;
-								other = isamp * numberOfChannels + ichan;
-							}
-							*valuePosition = value;
-							*markerPosition = 1;
-						}
-					}
-					for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = * (int32_t *) & buffer [ichan] [isamp] * (1.0 / 32768 / 65536);
-						}
-					}
-				}
-				if (numberOfBytesRead < numberOfBytes)
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel ", numberOfBytesPerSamplePerChannel * 8, U"-bit).\n"
-						U"Missing samples were set to zero.");
-			} break;
 			case Melder_IEEE_FLOAT_32_BIG_ENDIAN:
-				try {
-					for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = bingetr4 (f);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 32-bit floating point).\nMissing samples set to zero.");
-				}
-				break;
 			case Melder_IEEE_FLOAT_32_LITTLE_ENDIAN:
-				try {
-					for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = bingetr4LE (f);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 32-bit floating point).\nMissing samples set to zero.");
-				}
-				break;
 			case Melder_MULAW:
-				try {
-					for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = ulaw2linear [bingetu1 (f)] * (1.0 / 32768);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 8-bit " "-law).\nMissing samples set to zero.");
-				}
-				break;
 			case Melder_ALAW:
-				try {
-					for (long isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (long ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = alaw2linear [bingetu1 (f)] * (1.0 / 32768);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 8-bit A-law).\nMissing samples set to zero.");
+				if (Melder_readUncompressedAudio (f, numberOfChannels, encoding, buffer, numberOfSamples) < numberOfSamples) {
+					int numberOfBits = 8 * Melder_bytesPerSamplePoint (encoding);
+					if (encoding == Melder_MULAW || encoding == Melder_ALAW)
+						Melder_warning (U"File too small (", numberOfChannels, U"-channel 8-bit ", encoding == Melder_ALAW ? U"A" : U"", U"-law).\n"
+							U"Missing samples set to zero.");
+					else if (encoding == Melder_IEEE_FLOAT_32_BIG_ENDIAN || encoding == Melder_IEEE_FLOAT_32_LITTLE_ENDIAN)
+						Melder_warning (U"File too small (", numberOfChannels, U"-channel 32-bit floating point).\nMissing samples set to zero.");
+					else
+						Melder_warning (U"File too small (", numberOfChannels, U"-channel ", numberOfBits, U"-bit).\n"
+							U"Missing samples ", numberOfBits == 8 ? U"" : U"were ", U"set to zero.");
 				}
 				break;
 			case Melder_FLAC_COMPRESSION_16:
@@ -1246,6 +1287,69 @@ void Melder_readAudioToFloat (FILE *f, int numberOfChannels, int encoding, doubl
 	}
 }
 
+static inline double floatFromBits (uint32 bits) {
+	union { uint32 bits; float value; } sample;
+	sample. bits = bits;
+	return sample. value;
+}
+
+/*
+	The samples are decoded channel by channel, so that every inner loop writes to consecutive doubles
+	and reads with a fixed stride, which compilers can vectorize.
+*/
+#define DECODE_CHANNELS(sampleSize, expression) \
+	for (int ichan = 1; ichan <= numberOfChannels; ichan ++) { \
+		const unsigned char *p = bytes + (ichan - 1) * (sampleSize); \
+		double *to = buffer [ichan]; \
+		for (long isamp = 1; isamp <= numberOfSamples; isamp ++, p += frameSize) \
+			to [isamp] = expression; \
+	}
+
+void Melder_decodeAudioToFloat (const unsigned char *bytes, int numberOfChannels, int encoding, double **buffer, long numberOfSamples) {
+	const long frameSize = (long) numberOfChannels * Melder_bytesPerSamplePoint (encoding);
+	switch (encoding) {
+		case Melder_LINEAR_8_SIGNED:
+			DECODE_CHANNELS (1, (int8) p [0] * (1.0 / 128))
+			break;
+		case Melder_LINEAR_8_UNSIGNED:
+			DECODE_CHANNELS (1, p [0] * (1.0 / 128) - 1.0)
+			break;
+		case Melder_LINEAR_16_BIG_ENDIAN:
+			DECODE_CHANNELS (2, (int16_t) (((uint16_t) p [0] << 8) | (uint16_t) p [1]) * (1.0 / 32768))
+			break;
+		case Melder_LINEAR_16_LITTLE_ENDIAN:
+			DECODE_CHANNELS (2, (int16_t) (((uint16_t) p [1] << 8) | (uint16_t) p [0]) * (1.0 / 32768))
+			break;
+		case Melder_LINEAR_24_BIG_ENDIAN:
+			DECODE_CHANNELS (3, (int32) (((uint32) p [0] << 24) | ((uint32) p [1] << 16) | ((uint32) p [2] << 8)) * (1.0 / 32768 / 65536))
+			break;
+		case Melder_LINEAR_24_LITTLE_ENDIAN:
+			DECODE_CHANNELS (3, (int32) (((uint32) p [2] << 24) | ((uint32) p [1] << 16) | ((uint32) p [0] << 8)) * (1.0 / 32768 / 65536))
+			break;
+		case Melder_LINEAR_32_BIG_ENDIAN:
+			DECODE_CHANNELS (4, (int32) (((uint32) p [0] << 24) | ((uint32) p [1] << 16) | ((uint32) p [2] << 8) | (uint32) p [3]) * (1.0 / 32768 / 65536))
+			break;
+		case Melder_LINEAR_32_LITTLE_ENDIAN:
+			DECODE_CHANNELS (4, (int32) (((uint32) p [3] << 24) | ((uint32) p [2] << 16) | ((uint32) p [1] << 8) | (uint32) p [0]) * (1.0 / 32768 / 65536))
+			break;
+		case Melder_IEEE_FLOAT_32_BIG_ENDIAN:
+			DECODE_CHANNELS (4, floatFromBits (((uint32) p [0] << 24) | ((uint32) p [1] << 16) | ((uint32) p [2] << 8) | (uint32) p [3]))
+			break;
+		case Melder_IEEE_FLOAT_32_LITTLE_ENDIAN:
+			DECODE_CHANNELS (4, floatFromBits (((uint32) p [3] << 24) | ((uint32) p [2] << 16) | ((uint32) p [1] << 8) | (uint32) p [0]))
+			break;
+		case Melder_MULAW:
+			DECODE_CHANNELS (1, ulaw2linear [p [0]] * (1.0 / 32768))
+			break;
+		case Melder_ALAW:
+			DECODE_CHANNELS (1, alaw2linear [p [0]] * (1.0 / 32768))
+			break;
+		default:
+			Melder_throw (U"Cannot decode audio samples with encoding ", encoding, U" from memory.");
+	}
+}
+#undef DECODE_CHANNELS
+
 void Melder_readAudioToShort (FILE *f, int numberOfChannels, int encoding, short *buffer, long numberOfSamples) {
 	try {
 		long n = numberOfSamples * numberOfChannels, i;
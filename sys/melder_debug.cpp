@@ -78,6 +78,9 @@ the behaviour of that program changes in the following way:
 45: tracing structMatrix :: read ()
 46: trace GTK parent sizes in _GuiObject_position ()
 47: force resampling in OTGrammar RIP
+48: no register program for numeric formulas in Formula.cpp
+49: no cached programs and statements for scripts in Formula.cpp and Interpreter.cpp
+50: old "%.15g" number formatting in Melder8_double, and element-by-element writing of real arrays in abcio.cpp
 900: use DG Meta Serif Science instead of Palatino
 1264: Mac: Sound_recordFixedTime uses microphone "FW Solo (1264)"
 
@@ -65,13 +65,21 @@ using namespace std;
     #endif
 	#include "macport_off.h"
 #endif
+#if defined (_WIN32)
+	#include <io.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
 #include <errno.h>
 #include "abcio.h"
 #include "melder.h"
+#include "MelderThread.h"
 
 //#include "flac_FLAC_stream_encoder.h"
 extern "C" int  FLAC__stream_encoder_finish (FLAC__StreamEncoder *);
 extern "C" void FLAC__stream_encoder_delete (FLAC__StreamEncoder *);
+extern "C" void FLAC__metadata_object_delete (FLAC__StreamMetadata *);
 
 #if defined (macintosh)
 	#include <sys/stat.h>
@@ -542,6 +550,109 @@ static size_t read_URL_data_from_file (void *buffer, size_t size, size_t nmemb,
 }
 #endif
 
+/*
+	The regions of files that are mapped into memory.
+	The list is short (one entry per matrix read from a mapped binary file), so it is searched linearly.
+*/
+struct MelderFile_Mapping {
+	void *data;   // as seen by the caller
+	void *base;   // the start of the mapping, which has to be at a page boundary of the file
+	size_t size;   // from base
+	#if ! defined (_WIN32)
+		dev_t device;
+		ino_t inode;
+	#endif
+};
+static MelderFile_Mapping *theMappings;
+static long theMaximumNumberOfMappings;
+static std::atomic <long> theNumberOfMappings (0);   // read without the lock, so that Melder_unmap () is cheap if nothing is mapped
+static MelderThread_SpinLock theMappingsLock;
+
+void * MelderFile_map (FILE *f, int64 offset, int64 size) {
+	if (offset < 0 || size <= 0) return NULL;
+	MelderFile_Mapping mapping = { 0 };
+	#if defined (_WIN32)
+		HANDLE file = (HANDLE) _get_osfhandle (_fileno (f));
+		LARGE_INTEGER fileSize;
+		if (file == INVALID_HANDLE_VALUE || ! GetFileSizeEx (file, & fileSize) || fileSize. QuadPart < offset + size)
+			return NULL;
+		SYSTEM_INFO systemInfo;
+		GetSystemInfo (& systemInfo);
+		int64 base = offset - offset % systemInfo. dwAllocationGranularity;
+		if ((uint64_t) (offset - base + size) > SIZE_MAX) return NULL;
+		mapping. size = (size_t) (offset - base + size);
+		HANDLE fileMapping = CreateFileMapping (file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+		if (! fileMapping) return NULL;
+		mapping. base = MapViewOfFile (fileMapping, FILE_MAP_COPY, (DWORD) (base >> 32), (DWORD) (base & 0xFFFFFFFF), mapping. size);
+		CloseHandle (fileMapping);   // the view keeps the mapping alive
+		if (! mapping. base) return NULL;
+	#else
+		struct stat fileStatus;
+		if (fstat (fileno (f), & fileStatus) != 0 || fileStatus. st_size < offset + size)
+			return NULL;   // a mapping beyond the end of the file would crash when touched
+		long pageSize = sysconf (_SC_PAGESIZE);
+		int64 base = offset - offset % pageSize;
+		if ((uint64_t) (offset - base + size) > SIZE_MAX) return NULL;
+		mapping. size = (size_t) (offset - base + size);
+		mapping. base = mmap (NULL, mapping. size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno (f), (off_t) base);
+		if (mapping. base == MAP_FAILED) return NULL;
+		mapping. device = fileStatus. st_dev;
+		mapping. inode = fileStatus. st_ino;
+	#endif
+	mapping. data = (char *) mapping. base + (offset - base);
+	autoMelderThread_SpinLock lock (& theMappingsLock);
+	long numberOfMappings = theNumberOfMappings;
+	if (numberOfMappings == theMaximumNumberOfMappings) {
+		MelderFile_Mapping *mappings = (MelderFile_Mapping *) realloc (theMappings, (2 * numberOfMappings + 10) * sizeof (MelderFile_Mapping));
+		if (! mappings) {
+			#if defined (_WIN32)
+				UnmapViewOfFile (mapping. base);
+			#else
+				munmap (mapping. base, mapping. size);
+			#endif
+			return NULL;
+		}
+		theMappings = mappings;
+		theMaximumNumberOfMappings = 2 * numberOfMappings + 10;
+	}
+	theMappings [numberOfMappings] = mapping;
+	theNumberOfMappings = numberOfMappings + 1;
+	return mapping. data;
+}
+
+bool Melder_unmap (void *data) {
+	if (theNumberOfMappings == 0 || data == NULL) return false;
+	MelderFile_Mapping mapping;
+	{
+		autoMelderThread_SpinLock lock (& theMappingsLock);
+		long numberOfMappings = theNumberOfMappings, imapping = 0;
+		while (imapping < numberOfMappings && theMappings [imapping]. data != data) imapping ++;
+		if (imapping == numberOfMappings) return false;
+		mapping = theMappings [imapping];
+		theMappings [imapping] = theMappings [numberOfMappings - 1];
+		theNumberOfMappings = numberOfMappings - 1;
+	}
+	#if defined (_WIN32)
+		UnmapViewOfFile (mapping. base);
+	#else
+		munmap (mapping. base, mapping. size);
+	#endif
+	return true;
+}
+
+#if ! defined (_WIN32)
+static bool isMapped (const char *utf8path) {
+	if (theNumberOfMappings == 0) return false;
+	struct stat fileStatus;
+	if (stat (utf8path, & fileStatus) != 0) return false;
+	autoMelderThread_SpinLock lock (& theMappingsLock);
+	for (long imapping = 0; imapping < theNumberOfMappings; imapping ++)
+		if (theMappings [imapping]. device == fileStatus. st_dev && theMappings [imapping]. inode == fileStatus. st_ino)
+			return true;
+	return false;
+}
+#endif
+
 FILE * Melder_fopen (MelderFile file, const char *type) {
 	if (MelderFile_isNull (file)) Melder_throw (U"Cannot open null file.");
 	if (! Melder_isTracing)
@@ -601,6 +712,8 @@ FILE * Melder_fopen (MelderFile file, const char *type) {
 		#ifdef _WIN32
 			f = _wfopen (Melder_peek32toW (file -> path), Melder_peek32toW (Melder_peek8to32 (type)));
 		#else
+			if (type [0] == 'w' && isMapped (utf8path))
+				unlink (utf8path);   // rather than truncating the file under the mapped memory, which would crash when touched
 			f = fopen ((char *) utf8path, type);
 		#endif
 	}
@@ -747,6 +860,17 @@ void MelderFile_delete (MelderFile file) {
 	#endif
 }
 
+bool MelderFile_replace (MelderFile file, MelderFile newFile) {
+	#if defined (_WIN32)
+		return MoveFileExW (Melder_peek32toW (newFile -> path), Melder_peek32toW (file -> path), MOVEFILE_REPLACE_EXISTING) != 0;
+	#else
+		char utf8path [kMelder_MAXPATH+1], utf8newPath [kMelder_MAXPATH+1];
+		Melder_str32To8bitFileRepresentation_inline (file -> path, utf8path);
+		Melder_str32To8bitFileRepresentation_inline (newFile -> path, utf8newPath);
+		return rename (utf8newPath, utf8path) == 0;
+	#endif
+}
+
 char32 * Melder_peekExpandBackslashes (const char32 *message) {
 	static char32 names [11] [kMelder_MAXPATH+1];
 	static int index = 0;
@@ -911,6 +1035,8 @@ static void _MelderFile_close (MelderFile me, bool mayThrow) {
 			FLAC__stream_encoder_finish (my flacEncoder);   // This already calls fclose! BUG: we cannot get any error messages out.
 			FLAC__stream_encoder_delete (my flacEncoder);
 		}
+		if (my flacSeekTable)
+			FLAC__metadata_object_delete (my flacSeekTable);
 	} else if (my filePointer != NULL) {
 		if (mayThrow) {
 			Melder_fclose (me, my filePointer);
@@ -923,6 +1049,7 @@ static void _MelderFile_close (MelderFile me, bool mayThrow) {
 	my openForWriting = my openForReading = false;
 	my indent = 0;
 	my flacEncoder = NULL;
+	my flacSeekTable = NULL;
 }
 void MelderFile_close (MelderFile me) {
 	_MelderFile_close (me, true);
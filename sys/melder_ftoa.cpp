@@ -37,6 +37,7 @@
 
 #include "melder.h"
 #include "NUM.h"
+#include <float.h>
 
 /********** NUMBER TO STRING CONVERSION **********/
 
@@ -45,9 +46,13 @@
 #define MAXIMUM_NUMERIC_STRING_LENGTH  400
 	/* = sign + 324 + point + 60 + e + sign + 3 + null byte + ("·10^^" - "e") + 4 extra */
 
-static  char   buffers8  [NUMBER_OF_BUFFERS] [MAXIMUM_NUMERIC_STRING_LENGTH + 1];
-static  char32 buffers32 [NUMBER_OF_BUFFERS] [MAXIMUM_NUMERIC_STRING_LENGTH + 1];
-static int ibuffer = 0;
+/*
+	One set of buffers per thread, because analyses that run in a worker thread
+	format numbers too (e.g. in their error messages).
+*/
+static thread_local char   buffers8  [NUMBER_OF_BUFFERS] [MAXIMUM_NUMERIC_STRING_LENGTH + 1];
+static thread_local char32 buffers32 [NUMBER_OF_BUFFERS] [MAXIMUM_NUMERIC_STRING_LENGTH + 1];
+static thread_local int ibuffer = 0;
 
 #define CONVERT_BUFFER_TO_CHAR32 \
 	char32 *q = buffers32 [ibuffer]; \
@@ -155,9 +160,103 @@ const char32 * Melder_boolean (bool value) {
 	return value ? U"yes" : U"no";
 }
 
+/*
+	Melder8_double () writes the shortest of "%.15g", "%.16g" and "%.17g" that reads back as the same number.
+	All three can be derived from the 17 digits of a single "%.16e", because rounding these to 15 or 16 digits
+	gives the same result as rounding the number itself, except if the digits that are dropped are "50" or "5".
+	Whether a candidate reads back as the same number can mostly be decided without strtod (),
+	because a mantissa of at most 2^53 times or divided by a power of ten of at most 10^22
+	is exactly what strtod () gives (Clinger 1990), if doubles are computed without extended precision.
+*/
+static bool readsBackAs (bool negative, int64 mantissa, int exponent, double value) {
+	#if defined (FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+		static const double powersOfTen [] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+			1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+		if (mantissa <= 9007199254740992LL && exponent >= -22 && exponent <= 22) {
+			double result = exponent >= 0 ? (double) mantissa * powersOfTen [exponent] : (double) mantissa / powersOfTen [- exponent];
+			return (negative ? - result : result) == value;
+		}
+	#endif
+	char text [40];
+	sprintf (text, "%s%lld.e%d", negative ? "-" : "", (long long) mantissa, exponent);
+	return strtod (text, NULL) == value;
+}
+
+static void formatLikeG (char *text, bool negative, const char *digits, int numberOfDigits, int exponent, int precision) {
+	char *q = text;
+	if (negative) *q ++ = '-';
+	while (numberOfDigits > 1 && digits [numberOfDigits - 1] == '0') numberOfDigits --;   // as %g does
+	if (exponent < -4 || exponent >= precision) {
+		*q ++ = digits [0];
+		if (numberOfDigits > 1) {
+			*q ++ = '.';
+			for (int i = 1; i < numberOfDigits; i ++) *q ++ = digits [i];
+		}
+		sprintf (q, "e%c%02d", exponent < 0 ? '-' : '+', exponent < 0 ? - exponent : exponent);
+		return;
+	}
+	if (exponent < 0) {
+		*q ++ = '0';
+		*q ++ = '.';
+		for (int i = -1; i > exponent; i --) *q ++ = '0';
+		for (int i = 0; i < numberOfDigits; i ++) *q ++ = digits [i];
+	} else {
+		for (int i = 0; i <= exponent; i ++) *q ++ = i < numberOfDigits ? digits [i] : '0';
+		if (numberOfDigits > exponent + 1) {
+			*q ++ = '.';
+			for (int i = exponent + 1; i < numberOfDigits; i ++) *q ++ = digits [i];
+		}
+	}
+	*q = '\0';
+}
+
+static void formatShortest (char *text, double value) {
+	char all [40];
+	sprintf (all, "%.16e", value);   // e.g. "-1.2345678901234567e-05"
+	bool negative = all [0] == '-';
+	const char *p = all + negative;
+	char digits [17];
+	digits [0] = p [0];
+	memcpy (digits + 1, p + 2, 16);
+	int exponent = atoi (p + 19);
+	for (int precision = 15; precision <= 16; precision ++) {
+		if (digits [precision] == '5' && (precision == 16 || digits [16] == '0')) {
+			/*
+				Too close to halfway for the 17 digits to tell which way to round.
+			*/
+			sprintf (text, "%.*g", precision, value);
+			if (strtod (text, NULL) == value) return;
+			continue;
+		}
+		int64 mantissa = 0;
+		for (int i = 0; i < precision; i ++) mantissa = 10 * mantissa + (digits [i] - '0');
+		int roundedExponent = exponent;
+		if (digits [precision] >= '5') {
+			mantissa += 1;
+			int64 limit = 1;
+			for (int i = 0; i < precision; i ++) limit *= 10;
+			if (mantissa == limit) {
+				mantissa /= 10;
+				roundedExponent += 1;
+			}
+		}
+		if (readsBackAs (negative, mantissa, roundedExponent - (precision - 1), value)) {
+			char rounded [17];
+			for (int i = precision - 1; i >= 0; i --, mantissa /= 10) rounded [i] = (char) ('0' + mantissa % 10);
+			formatLikeG (text, negative, rounded, precision, roundedExponent, precision);
+			return;
+		}
+	}
+	formatLikeG (text, negative, digits, 17, exponent, 17);
+}
+
 const char * Melder8_double (double value) {
 	if (value == NUMundefined) return "--undefined--";
 	if (++ ibuffer == NUMBER_OF_BUFFERS) ibuffer = 0;
+	if (value != 0.0 && isfinite (value) && Melder_debug != 50) {
+		formatShortest (buffers8 [ibuffer], value);
+		return buffers8 [ibuffer];
+	}
 	sprintf (buffers8 [ibuffer], "%.15g", value);
 	if (strtod (buffers8 [ibuffer], NULL) != value) {
 		sprintf (buffers8 [ibuffer], "%.16g", value);
@@ -321,8 +420,8 @@ const char32 * Melder_character (char32 kar) {
 	return buffers32 [ibuffer];
 }
 
-static MelderString thePadBuffers [NUMBER_OF_BUFFERS];
-static int iPadBuffer { 0 };
+static thread_local MelderString thePadBuffers [NUMBER_OF_BUFFERS];
+static thread_local int iPadBuffer { 0 };
 
 const char32 * Melder_pad (int64 width, const char32 *string) {
 	if (++ iPadBuffer == NUMBER_OF_BUFFERS) iPadBuffer = 0;
@@ -32,7 +32,7 @@
 #include "abcio.h"
 #define my  me ->
 
-char32 MelderReadText_getChar (MelderReadText me) {
+char32 _MelderReadText_getChar (MelderReadText me) {
 	if (my string32 != NULL) {
 		if (* my readPointer32 == '\0') return 0;
 		return * my readPointer32 ++;
@@ -163,7 +163,69 @@ static size_t fread_multi (char *buffer, size_t numberOfBytes, FILE *f) {
 	return numberOfBytesRead;
 }
 
-static char32 * _MelderFile_readText (MelderFile file, char **string8) {
+/*
+	Decodes `numberOfCodes` UTF-16 codes from `f`, a block at a time, with unpaired surrogates replaced,
+	into `text32` or (if that is NULL) into UTF-8 in `text8`, which should have room for 3 bytes per code.
+	Returns the number of characters (or bytes) written, without a closing null.
+*/
+static int64 decodeUtf16 (FILE *f, int64 numberOfCodes, bool bigEndian, char32 *text32, char *text8) {
+	const long blockSize = 32768;
+	unsigned char block [2 * blockSize];
+	int64 n = 0;
+	char32 highSurrogate = 0;
+	for (int64 offset = 0; offset < numberOfCodes; offset += blockSize) {
+		long numberOfCodesInBlock = numberOfCodes - offset < blockSize ? (long) (numberOfCodes - offset) : blockSize;
+		if ((long) fread (block, 2, numberOfCodesInBlock, f) != numberOfCodesInBlock)
+			Melder_throw (U"Early end of file.");
+		for (long i = 0; i < numberOfCodesInBlock; i ++) {
+			char32 code = bigEndian ? (char32) block [2 * i] << 8 | block [2 * i + 1] : (char32) block [2 * i + 1] << 8 | block [2 * i];
+			char32 kar;
+			if (highSurrogate != 0) {
+				kar = code >= 0xDC00 && code <= 0xDFFF ?
+					(char32) (0x010000 + ((highSurrogate & 0x0003FF) << 10) + (code & 0x0003FF)) : UNICODE_REPLACEMENT_CHARACTER;
+				highSurrogate = 0;
+			} else if (code >= 0xD800 && code < 0xDC00) {
+				highSurrogate = code;
+				continue;
+			} else if (code >= 0xDC00 && code < 0xE000) {
+				kar = UNICODE_REPLACEMENT_CHARACTER;
+			} else {
+				kar = code;
+			}
+			if (text32) {
+				text32 [n ++] = kar;
+			} else if (kar <= 0x00007F) {
+				text8 [n ++] = (char) kar;
+			} else if (kar <= 0x0007FF) {
+				text8 [n ++] = (char) (0xC0 | (kar >> 6));
+				text8 [n ++] = (char) (0x80 | (kar & 0x00003F));
+			} else if (kar <= 0x00FFFF) {
+				text8 [n ++] = (char) (0xE0 | (kar >> 12));
+				text8 [n ++] = (char) (0x80 | ((kar >> 6) & 0x00003F));
+				text8 [n ++] = (char) (0x80 | (kar & 0x00003F));
+			} else {   // from a surrogate pair, i.e. two codes
+				text8 [n ++] = (char) (0xF0 | (kar >> 18));
+				text8 [n ++] = (char) (0x80 | ((kar >> 12) & 0x00003F));
+				text8 [n ++] = (char) (0x80 | ((kar >> 6) & 0x00003F));
+				text8 [n ++] = (char) (0x80 | (kar & 0x00003F));
+			}
+		}
+	}
+	if (highSurrogate != 0) {
+		if (text32)
+			text32 [n ++] = UNICODE_REPLACEMENT_CHARACTER;
+		else {
+			text8 [n ++] = (char) 0xEF, text8 [n ++] = (char) 0xBF, text8 [n ++] = (char) 0xBD;
+		}
+	}
+	return n;
+}
+
+/*
+	If `string8` is not NULL, the text comes back in *string8, as 8-bit text;
+	text in UTF-16 is then converted to UTF-8, and *string8IsUtf8 is set.
+*/
+static char32 * _MelderFile_readText (MelderFile file, char **string8, bool *string8IsUtf8) {
 	try {
 		int type = 0;   // 8-bit
 		autostring32 text;
@@ -192,27 +254,23 @@ static char32 * _MelderFile_readText (MelderFile file, char **string8) {
 					numberOfBytesRead, U" of them.");
 			text8bit [length] = '\0';
 			/*
-			 * Count and repair null bytes.
+			 * Count and remove null bytes.
 			 */
-			if (length > 0) {
-				int64_t numberOfNullBytes = 0;
-				for (char *p = & text8bit [length - 1]; (int64_t) (p - text8bit.peek()) >= 0; p --) {
-					if (*p == '\0') {
-						numberOfNullBytes += 1;
-						/*
-						 * Shift.
-						 */
-						for (char *q = p; (int64_t) (q - text8bit.peek()) < length; q ++) {
-							*q = q [1];
-						}
-					}
-				}
-				if (numberOfNullBytes > 0) {
-					Melder_warning (U"Ignored ", numberOfNullBytes, U" null bytes in text file ", file, U".");
-				}
+			char *end = text8bit.peek() + length;
+			char *to = (char *) memchr (text8bit.peek(), '\0', (size_t) length);   // normally NULL
+			int64_t numberOfNullBytes = 0;
+			if (to != NULL) {
+				for (const char *from = to; from < end; from ++)
+					if (*from != '\0') *to ++ = *from;
+				numberOfNullBytes = end - to;
+				*to = '\0';
+			}
+			if (numberOfNullBytes > 0) {
+				Melder_warning (U"Ignored ", numberOfNullBytes, U" null bytes in text file ", file, U".");
 			}
 			if (string8 != NULL) {
 				*string8 = text8bit.transfer();
+				*string8IsUtf8 = false;
 				(void) Melder_killReturns_inline (*string8);
 				return NULL;   // OK
 			} else {
@@ -220,53 +278,22 @@ static char32 * _MelderFile_readText (MelderFile file, char **string8) {
 			}
 		} else {
 			length = length / 2 - 1;   // Byte Order Mark subtracted. Length = number of UTF-16 codes
-			text.reset (Melder_malloc (char32, length + 1));
-			if (type == 1) {
-				for (int64_t i = 0; i < length; i ++) {
-					char16 kar1 = bingetu2 (f);
-					if (kar1 < 0xD800) {
-						text [i] = (char32) kar1;   // convert up without sign extension
-					} else if (kar1 < 0xDC00) {
-						length --;
-						char16 kar2 = bingetu2 (f);
-						if (kar2 >= 0xDC00 && kar2 <= 0xDFFF) {
-							text [i] = (char32) (0x010000 +
-								(char32) (((char32) kar1 & 0x0003FF) << 10) +
-								(char32)  ((char32) kar2 & 0x0003FF));
-						} else {
-							text [i] = UNICODE_REPLACEMENT_CHARACTER;
-						}
-					} else if (kar1 < 0xE000) {
-						text [i] = UNICODE_REPLACEMENT_CHARACTER;
-					} else {
-						text [i] = (char32) kar1;   // convert up without sign extension
-					}
-				}
-			} else {
-				for (int64_t i = 0; i < length; i ++) {
-					char16 kar1 = bingetu2LE (f);
-					if (kar1 < 0xD800) {
-						text [i] = (char32) kar1;   // convert up without sign extension
-					} else if (kar1 < 0xDC00) {
-						length --;
-						char16 kar2 = bingetu2LE (f);
-						if (kar2 >= 0xDC00 && kar2 <= 0xDFFF) {
-							text [i] = (char32) (0x010000 +
-								(char32) (((char32) kar1 & 0x0003FF) << 10) +
-								(char32)  ((char32) kar2 & 0x0003FF));
-						} else {
-							text [i] = UNICODE_REPLACEMENT_CHARACTER;
-						}
-					} else if (kar1 < 0xE000) {
-						text [i] = UNICODE_REPLACEMENT_CHARACTER;
-					} else if (kar1 <= 0xFFFF) {
-						text [i] = (char32) kar1;   // convert up without sign extension
-					} else {
-						Melder_fatal (U"MelderFile_readText: unsigned short greater than 0xFFFF: should not occur.");
-					}
-				}
+			if (string8 != NULL) {
+				/*
+				 * UTF-8 takes less memory than UTF-32, and is quicker to read (see MelderReadText_getChar).
+				 */
+				autostring8 text8 = Melder_malloc (char, 3 * length + 1);
+				int64 numberOfBytes = decodeUtf16 (f, length, type == 1, NULL, text8.peek());
+				text8 [numberOfBytes] = '\0';
+				f.close (file);
+				(void) Melder_killReturns_inline (text8.peek());
+				*string8 = (char *) Melder_realloc_f (text8.transfer(), numberOfBytes + 1);   // give back what ASCII did not use
+				*string8IsUtf8 = true;
+				return NULL;   // OK
 			}
-			text [length] = '\0';
+			text.reset (Melder_malloc (char32, length + 1));
+			int64 numberOfCharacters = decodeUtf16 (f, length, type == 1, text.peek(), NULL);
+			text [numberOfCharacters] = '\0';
 			(void) Melder_killReturns_inline (text.peek());
 		}
 		f.close (file);
@@ -277,22 +304,23 @@ static char32 * _MelderFile_readText (MelderFile file, char **string8) {
 }
 
 char32 * MelderFile_readText (MelderFile file) {
-	return _MelderFile_readText (file, NULL);
+	return _MelderFile_readText (file, NULL, NULL);
 }
 
 MelderReadText MelderReadText_createFromFile (MelderFile file) {
 	autoMelderReadText me = Melder_calloc (struct structMelderReadText, 1);
-	my string32 = _MelderFile_readText (file, & my string8);
+	bool string8IsUtf8 = false;
+	my string32 = _MelderFile_readText (file, & my string8, & string8IsUtf8);
 	if (my string32 != NULL) {
 		my readPointer32 = & my string32 [0];
 	} else {
 		Melder_assert (my string8 != NULL);
 		my readPointer8 = & my string8 [0];
-		my input8Encoding = Melder_getInputEncoding ();
-		if (my input8Encoding == kMelder_textInputEncoding_UTF8 ||
+		my input8Encoding = string8IsUtf8 ? kMelder_textInputEncoding_UTF8 : Melder_getInputEncoding ();
+		if (! string8IsUtf8 && (my input8Encoding == kMelder_textInputEncoding_UTF8 ||
 			my input8Encoding == kMelder_textInputEncoding_UTF8_THEN_ISO_LATIN1 ||
 			my input8Encoding == kMelder_textInputEncoding_UTF8_THEN_WINDOWS_LATIN1 ||
-			my input8Encoding == kMelder_textInputEncoding_UTF8_THEN_MACROMAN)
+			my input8Encoding == kMelder_textInputEncoding_UTF8_THEN_MACROMAN))
 		{
 			if (Melder_str8IsValidUtf8 (my string8)) {
 				my input8Encoding = kMelder_textInputEncoding_UTF8;
@@ -770,8 +770,8 @@ int64 MelderString_deallocationSize (void) {
 }
 
 #define NUMBER_OF_CAT_BUFFERS  33
-static MelderString theCatBuffers [NUMBER_OF_CAT_BUFFERS] = { { 0 } };
-static int iCatBuffer = 0;
+static thread_local MelderString theCatBuffers [NUMBER_OF_CAT_BUFFERS] = { { 0 } };
+static thread_local int iCatBuffer = 0;
 
 const char32 * Melder_cat (Melder_2_ARGS) {
 	if (++ iCatBuffer == NUMBER_OF_CAT_BUFFERS) iCatBuffer = 0;
@@ -95,7 +95,15 @@ bool Melder_isEncodable (const char32 *text, int outputEncoding) {
 }
 
 bool Melder_str8IsValidUtf8 (const char *string) {
+	const char8 *end = (const char8 *) & string [0] + strlen (string);
 	for (const char8 *p = (const char8 *) & string [0]; *p != '\0'; p ++) {
+		/*
+			Skip ASCII eight bytes at a time.
+		*/
+		uint64_t eightBytes;
+		while (end - p >= 8 && (memcpy (& eightBytes, p, 8), (eightBytes & 0x8080808080808080ULL) == 0))
+			p += 8;
+		if (*p == '\0') break;
 		char32 kar = (char32) *p;
 		if (kar <= 0x7F) {
 			;
@@ -118,9 +126,12 @@ bool Melder_str8IsValidUtf8 (const char *string) {
 }
 
 long Melder_killReturns_inline (char *text) {
+	char *firstReturn = strchr (text, 13);
+	if (firstReturn == NULL)   // as in most files
+		return (long) strlen (text);
 	const char *from;
 	char *to;
-	for (from = text, to = text; *from != '\0'; from ++, to ++) {
+	for (from = firstReturn, to = firstReturn; *from != '\0'; from ++, to ++) {
 		if (*from == 13) {   // carriage return?
 			if (from [1] == '\n') {   // followed by linefeed? Must be a Windows text
 				from ++;   // ignore carriage return
@@ -208,8 +219,8 @@ size_t str32len_utf16 (const char32 *string, bool nativizeNewlines) {
 
 char32 * Melder_peek8to32 (const char *textA) {
 	if (textA == NULL) return NULL;
-	static MelderString buffers [19] { { 0 } };
-	static int ibuffer = 0;
+	static thread_local MelderString buffers [19] { { 0 } };
+	static thread_local int ibuffer = 0;
 	if (++ ibuffer == 11) ibuffer = 0;
 	MelderString_empty (& buffers [ibuffer]);
 	unsigned long n = strlen (textA), i, j;
@@ -435,8 +446,8 @@ char32 * Melder_8to32 (const char *string) {
 
 char32 * Melder_peek16to32 (const char16 *text) {
 	if (text == NULL) return nullptr;
-	static MelderString buffers [19] { { 0 } };
-	static int ibuffer = 0;
+	static thread_local MelderString buffers [19] { { 0 } };
+	static thread_local int ibuffer = 0;
 	if (++ ibuffer == 19) ibuffer = 0;
 	MelderString_empty (& buffers [ibuffer]);
 	for (;;) {
@@ -501,9 +512,9 @@ char * Melder_32to8 (const char32 *string) {
 
 char * Melder_peek32to8 (const char32 *text) {
 	if (text == NULL) return NULL;
-	static char *buffer [19] = { NULL };
-	static int64 bufferSize [19] = { 0 };
-	static int ibuffer = 0;
+	static thread_local char *buffer [19] = { NULL };
+	static thread_local int64 bufferSize [19] = { 0 };
+	static thread_local int ibuffer = 0;
 	if (++ ibuffer == 19) ibuffer = 0;
 	int64 sizeNeeded = str32len (text) * 4 + 1;
 	if ((bufferSize [ibuffer] - sizeNeeded) * (int64) sizeof (char) >= 10000) {
@@ -521,8 +532,8 @@ char * Melder_peek32to8 (const char32 *text) {
 
 char16 * Melder_peek32to16 (const char32 *text, bool nativizeNewlines) {
 	if (text == NULL) return NULL;
-	static MelderString16 buffers [19] = { { 0 } };
-	static int ibuffer = 0;
+	static thread_local MelderString16 buffers [19] = { { 0 } };
+	static thread_local int ibuffer = 0;
 	if (++ ibuffer == 19) ibuffer = 0;
 	MelderString16_empty (& buffers [ibuffer]);
 	int64_t n = str32len (text);
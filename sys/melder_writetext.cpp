@@ -243,51 +243,64 @@ void MelderFile_appendText (MelderFile file, const char32 *text) {
 	}
 }
 
+/*
+	The characters are encoded into a buffer that goes to the file a block at a time,
+	because a putc () for every byte is what made saving big objects as text slow.
+*/
 static void _MelderFile_write (MelderFile file, const char32 *string) {
 	if (string == NULL) return;
-	int64 length = str32len (string);
 	FILE *f = file -> filePointer;
+	const int bufferSize = 4096;
+	unsigned char buffer [bufferSize + 8];   // room for a CR and the longest encoded character beyond the limit
+	int n = 0;
 	if (file -> outputEncoding == kMelder_textOutputEncoding_ASCII || file -> outputEncoding == kMelder_textOutputEncoding_ISO_LATIN1) {
-		for (int64 i = 0; i < length; i ++) {
-			char kar = (char) (char8) string [i];   // truncate
-			if (kar == '\n' && file -> requiresCRLF) putc (13, f);
-			putc (kar, f);
+		for (const char32 *p = string; *p != U'\0'; p ++) {
+			char32 kar = *p;
+			if (kar == U'\n' && file -> requiresCRLF) buffer [n ++] = 13;
+			buffer [n ++] = (unsigned char) (char8) kar;   // truncate
+			if (n >= bufferSize) { fwrite (buffer, 1, n, f); n = 0; }
 		}
 	} else if (file -> outputEncoding == kMelder_textOutputEncoding_UTF8) {
-		for (int64 i = 0; i < length; i ++) {
-			char32 kar = string [i];
+		for (const char32 *p = string; *p != U'\0'; p ++) {
+			char32 kar = *p;
 			if (kar <= 0x00007F) {
-				if (kar == U'\n' && file -> requiresCRLF) putc (13, f);
-				putc ((int) kar, f);   // guarded conversion down
+				if (kar == U'\n' && file -> requiresCRLF) buffer [n ++] = 13;
+				buffer [n ++] = (unsigned char) kar;   // guarded conversion down
 			} else if (kar <= 0x0007FF) {
-				putc (0xC0 | (kar >> 6), f);
-				putc (0x80 | (kar & 0x00003F), f);
+				buffer [n ++] = (unsigned char) (0xC0 | (kar >> 6));
+				buffer [n ++] = (unsigned char) (0x80 | (kar & 0x00003F));
 			} else if (kar <= 0x00FFFF) {
-				putc (0xE0 | (kar >> 12), f);
-				putc (0x80 | ((kar >> 6) & 0x00003F), f);
-				putc (0x80 | (kar & 0x00003F), f);
+				buffer [n ++] = (unsigned char) (0xE0 | (kar >> 12));
+				buffer [n ++] = (unsigned char) (0x80 | ((kar >> 6) & 0x00003F));
+				buffer [n ++] = (unsigned char) (0x80 | (kar & 0x00003F));
 			} else {
-				putc (0xF0 | (kar >> 18), f);
-				putc (0x80 | ((kar >> 12) & 0x00003F), f);
-				putc (0x80 | ((kar >> 6) & 0x00003F), f);
-				putc (0x80 | (kar & 0x00003F), f);
+				buffer [n ++] = (unsigned char) (0xF0 | (kar >> 18));
+				buffer [n ++] = (unsigned char) (0x80 | ((kar >> 12) & 0x00003F));
+				buffer [n ++] = (unsigned char) (0x80 | ((kar >> 6) & 0x00003F));
+				buffer [n ++] = (unsigned char) (0x80 | (kar & 0x00003F));
 			}
+			if (n >= bufferSize) { fwrite (buffer, 1, n, f); n = 0; }
 		}
 	} else {
-		for (int64 i = 0; i < length; i ++) {
-			char32 kar = string [i];
-			if (kar == U'\n' && file -> requiresCRLF) binputu2 (13, f);
+		for (const char32 *p = string; *p != U'\0'; p ++) {
+			char32 kar = *p;
+			if (kar == U'\n' && file -> requiresCRLF) { buffer [n ++] = 0; buffer [n ++] = 13; }
+			if (kar > 0x10FFFF) kar = UNICODE_REPLACEMENT_CHARACTER;
 			if (kar <= 0x00FFFF) {
-				binputu2 ((char16_t) kar, f);
-			} else if (kar <= 0x10FFFF) {
-				kar -= 0x010000;
-				binputu2 (0xD800 | (char16_t) (kar >> 10), f);
-				binputu2 (0xDC00 | (char16_t) ((char16_t) kar & 0x03ff), f);
+				buffer [n ++] = (unsigned char) (kar >> 8);   // big-endian, as binputu2 ()
+				buffer [n ++] = (unsigned char) (kar & 0xFF);
 			} else {
-				binputu2 (UNICODE_REPLACEMENT_CHARACTER, f);
+				kar -= 0x010000;
+				char16_t high = (char16_t) (0xD800 | (kar >> 10)), low = (char16_t) (0xDC00 | (kar & 0x0003ff));
+				buffer [n ++] = (unsigned char) (high >> 8);
+				buffer [n ++] = (unsigned char) (high & 0xFF);
+				buffer [n ++] = (unsigned char) (low >> 8);
+				buffer [n ++] = (unsigned char) (low & 0xFF);
 			}
+			if (n >= bufferSize) { fwrite (buffer, 1, n, f); n = 0; }
 		}
 	}
+	if (n > 0) fwrite (buffer, 1, n, f);
 }
 
 void MelderFile_writeCharacter (MelderFile file, char32 kar) {
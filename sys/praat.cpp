@@ -45,6 +45,7 @@
 #include "Printer.h"
 #include "ScriptEditor.h"
 #include "Strings_.h"
+#include "MelderThread.h"
 
 #if gtk
 	#include <gdk/gdkx.h>
@@ -1069,6 +1070,9 @@ void praat_init (const char32 *title, unsigned int argc, char **argv) {
 			} else if (strnequ (argv [iarg_batchName], "--pref-dir=", 11)) {
 				Melder_pathToDir (Melder_peek8to32 (argv [iarg_batchName] + 11), & praatDir);
 				iarg_batchName += 1;
+			} else if (strnequ (argv [iarg_batchName], "--threads=", 10)) {
+				MelderThread_setNumberOfThreads (atoi (argv [iarg_batchName] + 10));
+				iarg_batchName += 1;
 			#if defined (macintosh)
 			} else if (strequ (argv [iarg_batchName], "-NSDocumentRevisionsDebugMode")) {
 				(void) 0;   // ignore this option, which was added by Xcode
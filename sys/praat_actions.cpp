@@ -636,7 +636,7 @@ void praat_actions_show (void) {
 					if (! praat_writeMenuSeparator) {
 						if (writeMenuGoingToSeparate)
 							praat_writeMenuSeparator = GuiMenu_addSeparator (parentMenu);
-						else if (str32equ (my title, U"Save as binary file..."))
+						else if (str32equ (my title, U"Save as mapped binary file..."))
 							writeMenuGoingToSeparate = TRUE;
 					}
 				}
@@ -25,6 +25,7 @@
 #include "DataEditor.h"
 #include "site.h"
 #include "GraphicsP.h"
+#include "MelderThread.h"
 //#include <string>
 
 #undef iam
@@ -384,6 +385,17 @@ DO
 	Melder_debug = GET_INTEGER (U"Debug option");
 END2 }
 
+FORM (praat_setNumberOfThreads, U"Set number of threads", 0) {
+	LABEL (U"", Melder_cat (U"This computer has ", MelderThread_getNumberOfProcessors (), U" processors."))
+	LABEL (U"", U"Analyses such as Sound: To Pitch will use at most this many threads")
+	LABEL (U"", U"(0 means: one thread per processor).")
+	INTEGER (U"Number of threads", U"0")
+	OK2
+SET_INTEGER (U"Number of threads", MelderThread_getNumberOfThreadsPreference ())
+DO
+	MelderThread_setNumberOfThreads (GET_INTEGER (U"Number of threads"));
+END2 }
+
 DIRECT2 (praat_listReadableTypesOfObjects) {
 	Thing_listReadableClasses ();
 END2 }
@@ -468,6 +480,18 @@ FORM_WRITE2 (Data_writeToBinaryFile, U"Save Object(s) as one binary file", 0, 0)
 	}
 END2 }
 
+FORM_WRITE2 (Data_writeToMappedBinaryFile, U"Save Object(s) as one mapped binary file", 0, 0) {
+	if (theCurrentPraatObjects -> totalSelection == 1) {
+		LOOP {
+			iam (Data);
+			Data_writeToMappedBinaryFile (me, file);
+		}
+	} else {
+		autoCollection set = praat_getSelectedObjects ();
+		Data_writeToMappedBinaryFile (set.peek(), file);
+	}
+END2 }
+
 FORM (ManPages_saveToHtmlDirectory, U"Save all pages as HTML files", 0) {
 	LABEL (U"", U"Type a directory name:")
 	TEXTFIELD (U"directory", U"")
@@ -683,6 +707,7 @@ void praat_addMenus (GuiWindow window) {
 	praat_addMenuCommand (U"Objects", U"Technical", U"Report text properties", 0, 0, DO_praat_reportTextProperties);
 	praat_addMenuCommand (U"Objects", U"Technical", U"Report graphical properties", 0, 0, DO_praat_reportGraphicalProperties);
 	praat_addMenuCommand (U"Objects", U"Technical", U"Debug...", 0, 0, DO_praat_debug);
+	praat_addMenuCommand (U"Objects", U"Technical", U"Set number of threads...", 0, 0, DO_praat_setNumberOfThreads);
 
 	praat_addMenuCommand (U"Objects", U"Open", U"Read from file...", 0, praat_ATTRACTIVE + 'O', DO_Data_readFromFile);
 
@@ -692,6 +717,7 @@ void praat_addMenus (GuiWindow window) {
 	praat_addAction1 (classData, 0, U"Write to short text file...", 0, praat_HIDDEN, DO_Data_writeToShortTextFile);
 	praat_addAction1 (classData, 0, U"Save as binary file...", 0, 0, DO_Data_writeToBinaryFile);
 	praat_addAction1 (classData, 0, U"Write to binary file...", 0, praat_HIDDEN, DO_Data_writeToBinaryFile);
+	praat_addAction1 (classData, 0, U"Save as mapped binary file...", 0, 0, DO_Data_writeToMappedBinaryFile);
 
 	praat_addAction1 (classManPages, 1, U"Save to HTML directory...", 0, 0, DO_ManPages_saveToHtmlDirectory);
 	praat_addAction1 (classManPages, 1, U"View", 0, 0, DO_ManPages_view);